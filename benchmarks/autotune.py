@@ -0,0 +1,219 @@
+#!/usr/bin/env python3
+"""Offline autotuner of the operators' launch configurations.
+
+Sweeps the compile-time block size and items per thread of every operator
+kernel (see include/gunrock/framework/operators/launch.hxx) for one
+algorithm on one architecture, and emits the header specializing
+`operators::launch::tuned_t` for that algorithm.
+
+Every candidate configuration is compiled into the benchmark harness
+(`-DESSENTIALS_LAUNCH_BOXES=<candidate>.hxx`) and timed with
+`benchmark --algorithm <algorithm>` over the datasets; the score is the
+geometric mean of the median times. The kernels are tuned one after the
+other (coordinate descent), each one with the best configuration found so
+far for the others; a candidate replaces the current one only if it is
+faster by more than `--threshold`.
+
+The results are kept per architecture (<output>/<algorithm>.sm_<arch>.json),
+the header (<output>/<algorithm>.hxx) holds the configurations of all the
+architectures tuned so far, plus the defaults as the fallback:
+
+  ./benchmarks/autotune.py --algorithm bfs --arch 80 --output tuned \\
+      datasets/chesapeake/chesapeake.mtx
+  cmake -DESSENTIALS_LAUNCH_BOXES_DIR=$PWD/tuned ..  # bin/bfs uses tuned/bfs.hxx
+"""
+
+import argparse
+import glob
+import json
+import math
+import os
+import subprocess
+import sys
+
+# Kernel: (default (block size, items per thread), block sizes, items).
+KERNELS = {
+    "advance_block_mapped": ((128, 1), [64, 128, 256, 512], [1, 2, 4]),
+    "advance_warp_mapped": ((128, 1), [64, 128, 256, 512, 1024], [1]),
+    "advance_work_stealing": ((256, 8), [128, 256, 512, 1024], [2, 4, 8, 16]),
+    "advance_merge_path": ((128, 11), [64, 128, 256], [3, 7, 11, 15]),
+    "advance_captured": ((256, 1), [128, 256, 512, 1024], [1]),
+    "advance_persistent": ((256, 1), [128, 256, 512, 1024], [1]),
+    "advance_streamed": ((256, 1), [128, 256, 512, 1024], [1]),
+    "advance_filter": ((128, 1), [64, 128, 256, 512], [1]),
+    "spmv": ((128, 7), [64, 128, 256], [3, 5, 7, 11]),
+    "uniquify_hash": ((256, 1), [128, 256, 512, 1024], [1]),
+    "neighbors_reduce": ((128, 1), [64, 128, 256, 512], [1]),
+}
+
+ALGORITHMS = ["bfs", "sssp", "bc", "color", "kcore", "pr", "ppr"]
+
+SOURCE_DIR = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+
+def write_candidate(path, configuration):
+    """Header of a candidate, every kernel with its (fallback) config."""
+    lines = [
+        "#pragma once",
+        "",
+        "namespace gunrock {",
+        "namespace operators {",
+        "namespace launch {",
+        "",
+    ]
+    for kernel, (block, items) in sorted(configuration.items()):
+        lines += [
+            "template <>",
+            "struct tuned_t<kernel_t::%s> {" % kernel,
+            "  using type ="
+            " launch_box_t<launch_params_1d_t<fallback, %d, %d>>;" % (block,
+                                                                      items),
+            "};",
+            "",
+        ]
+    lines += [
+        "}  // namespace launch",
+        "}  // namespace operators",
+        "}  // namespace gunrock",
+    ]
+    with open(path, "w") as f:
+        f.write("\n".join(lines) + "\n")
+
+
+def write_header(path, algorithm, results):
+    """Header of the tuned configurations, `results` maps every architecture
+    to its configuration (kernel: (block size, items per thread))."""
+    lines = [
+        "/**",
+        " * @file %s.hxx" % algorithm,
+        " * @brief Tuned launch configurations of %s (generated by" % algorithm,
+        " * benchmarks/autotune.py, do not edit).",
+        " */",
+        "",
+        "#pragma once",
+        "",
+        "namespace gunrock {",
+        "namespace operators {",
+        "namespace launch {",
+        "",
+    ]
+    for kernel, (default, _, _) in sorted(KERNELS.items()):
+        params = [
+            "launch_params_1d_t<sm_%s, %d, %d>" % (arch, config[kernel][0],
+                                                   config[kernel][1])
+            for arch, config in sorted(results.items())
+            if kernel in config and tuple(config[kernel]) != default
+        ]
+        if not params:
+            continue
+        params.append("launch_params_1d_t<fallback, %d, %d>" % default)
+        lines += [
+            "template <>",
+            "struct tuned_t<kernel_t::%s> {" % kernel,
+            "  using type = launch_box_t<",
+            "      " + ",\n      ".join(params) + ">;",
+            "};",
+            "",
+        ]
+    lines += [
+        "}  // namespace launch",
+        "}  // namespace operators",
+        "}  // namespace gunrock",
+    ]
+    with open(path, "w") as f:
+        f.write("\n".join(lines) + "\n")
+
+
+def measure(args, build_dir, candidate):
+    """Build the benchmark with `candidate` and return its score (ms)."""
+    subprocess.check_call([
+        "cmake", "-S", SOURCE_DIR, "-B", build_dir,
+        "-DESSENTIALS_BUILD_BENCHMARKS=ON",
+        "-DESSENTIALS_BUILD_EXAMPLES=OFF",
+        "-DESSENTIALS_ARCHITECTURE=%s" % args.arch,
+        "-DESSENTIALS_LAUNCH_BOXES=%s" % candidate
+    ], stdout=subprocess.DEVNULL)
+    subprocess.check_call([
+        "cmake", "--build", build_dir, "--target", "benchmark", "-j",
+        str(os.cpu_count() or 1)
+    ], stdout=subprocess.DEVNULL)
+
+    report = os.path.join(build_dir, "autotune.json")
+    subprocess.check_call([
+        os.path.join(build_dir, "bin", "benchmark"), "--algorithm",
+        args.algorithm, "--warmup", str(args.warmup), "--trials",
+        str(args.trials), "--json", report
+    ] + args.datasets, stdout=subprocess.DEVNULL)
+
+    with open(report) as f:
+        times = json.load(f)["median-time"]
+    times = [max(t, 1e-6) for t in times]
+    return math.exp(sum(math.log(t) for t in times) / len(times))
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Tune the operators' launch configurations.")
+    parser.add_argument("--algorithm", required=True, choices=ALGORITHMS)
+    parser.add_argument("--arch", required=True, help="SM version, e.g. 80")
+    parser.add_argument("--output", required=True, help="output directory")
+    parser.add_argument("--build", default="_autotune", help="build dir")
+    parser.add_argument("--kernels", nargs="+", choices=sorted(KERNELS),
+                        default=sorted(KERNELS), help="kernels to tune")
+    parser.add_argument("--warmup", type=int, default=2)
+    parser.add_argument("--trials", type=int, default=10)
+    parser.add_argument("--threshold", type=float, default=0.02,
+                        help="minimum relative speedup of a candidate")
+    parser.add_argument("datasets", nargs="+")
+    args = parser.parse_args()
+
+    os.makedirs(args.output, exist_ok=True)
+    os.makedirs(args.build, exist_ok=True)
+    candidate = os.path.abspath(os.path.join(args.build, "candidate.hxx"))
+
+    configuration = {k: default for k, (default, _, _) in KERNELS.items()}
+    write_candidate(candidate, configuration)
+    best = measure(args, args.build, candidate)
+    print("%s sm_%s default: %.3f ms" % (args.algorithm, args.arch, best))
+
+    for kernel in args.kernels:
+        _, blocks, items = KERNELS[kernel]
+        for block in blocks:
+            for item in items:
+                trial = dict(configuration)
+                trial[kernel] = (block, item)
+                if trial[kernel] == configuration[kernel]:
+                    continue
+                write_candidate(candidate, trial)
+                try:
+                    score = measure(args, args.build, candidate)
+                except subprocess.CalledProcessError:
+                    # e.g. too much shared memory for the architecture.
+                    print("%s <%d, %d>: failed" % (kernel, block, item))
+                    continue
+                print("%s <%d, %d>: %.3f ms" % (kernel, block, item, score))
+                if score < best * (1 - args.threshold):
+                    best = score
+                    configuration = trial
+        print("%s: <%d, %d>" % ((kernel, ) + configuration[kernel]))
+
+    results_file = os.path.join(args.output,
+                                "%s.sm_%s.json" % (args.algorithm, args.arch))
+    with open(results_file, "w") as f:
+        json.dump({k: list(v) for k, v in configuration.items()}, f,
+                  indent=2)
+
+    # All the architectures tuned so far.
+    results = {}
+    prefix = os.path.join(args.output, "%s.sm_" % args.algorithm)
+    for path in glob.glob(prefix + "*.json"):
+        with open(path) as f:
+            results[path[len(prefix):-len(".json")]] = json.load(f)
+
+    header = os.path.join(args.output, "%s.hxx" % args.algorithm)
+    write_header(header, args.algorithm, results)
+    print("wrote %s (%.3f ms)" % (header, best))
+
+
+if __name__ == "__main__":
+    sys.exit(main())
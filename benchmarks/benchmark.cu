@@ -0,0 +1,346 @@
+#include <gunrock/algorithms/algorithms.hxx>
+#include <gunrock/algorithms/bfs.hxx>
+#include <gunrock/algorithms/sssp.hxx>
+#include <gunrock/algorithms/bc.hxx>
+#include <gunrock/algorithms/color.hxx>
+#include <gunrock/algorithms/kcore.hxx>
+#include <gunrock/algorithms/pr.hxx>
+#include <gunrock/algorithms/ppr.hxx>
+
+#include "benchmark.hxx"
+
+using namespace gunrock;
+using namespace memory;
+
+using vertex_t = int;
+using edge_t = int;
+using weight_t = float;
+
+using context_ptr_t = std::shared_ptr<cuda::multi_context_t>;
+
+std::string to_string(operators::load_balance_t lb) {
+  switch (lb) {
+    case operators::load_balance_t::thread_mapped:
+      return "thread_mapped";
+    case operators::load_balance_t::warp_mapped:
+      return "warp_mapped";
+    case operators::load_balance_t::block_mapped:
+      return "block_mapped";
+    case operators::load_balance_t::merge_path:
+      return "merge_path";
+    case operators::load_balance_t::work_stealing:
+      return "work_stealing";
+    case operators::load_balance_t::automatic:
+      return "automatic";
+    default:
+      return "unknown";
+  }
+}
+
+std::string to_string(operators::filter_algorithm_t filter) {
+  switch (filter) {
+    case operators::filter_algorithm_t::remove:
+      return "remove";
+    case operators::filter_algorithm_t::predicated:
+      return "predicated";
+    case operators::filter_algorithm_t::compact:
+      return "compact";
+    case operators::filter_algorithm_t::bypass:
+      return "bypass";
+    default:
+      return "unknown";
+  }
+}
+
+/**
+ * @brief Level-synchronous BFS written directly with the `lb` advance and
+ * the `filter` filter, such that every operator combination runs the same
+ * traversal.
+ */
+template <operators::load_balance_t lb,
+          operators::filter_algorithm_t filter,
+          typename graph_t>
+float traverse(graph_t& G,
+               vertex_t single_source,
+               vertex_t* depths,
+               context_ptr_t& multi_context) {
+  auto& context = *(multi_context->get_context(0));
+  auto policy = context.execution_policy();
+  std::size_t n = G.get_number_of_vertices();
+  std::size_t m = G.get_number_of_edges();
+
+  thrust::fill(policy, depths, depths + n, -1);
+  thrust::fill(policy, depths + single_source, depths + single_source + 1, 0);
+
+  frontier_t<vertex_t> input, output;
+  input.reserve(std::max(n, m));
+  output.reserve(std::max(n, m));
+  vector_t<vertex_t, memory_space_t::device> segments(n);
+  input.push_back(single_source);
+
+  auto& timer = context.timer();
+  timer.begin();
+  for (vertex_t level = 0; !input.is_empty(); ++level) {
+    auto search = [depths, level] __device__(
+                      vertex_t const& source, vertex_t const& neighbor,
+                      edge_t const& edge, weight_t const& weight) -> bool {
+      if (depths[neighbor] != -1)
+        return false;
+      return (math::atomic::cas(&depths[neighbor], -1, level + 1) == -1);
+    };
+    auto keep = [] __device__(vertex_t const& v) -> bool { return true; };
+
+    operators::advance::execute<lb, operators::advance_direction_t::forward,
+                                operators::advance_io_type_t::vertices,
+                                operators::advance_io_type_t::vertices>(
+        G, search, &input, &output, segments, context);
+    operators::filter::execute<filter>(G, keep, &output, &input, context);
+  }
+  return timer.end();
+}
+
+template <operators::load_balance_t lb, typename graph_t>
+void sweep_filters(std::string const& dataset,
+                   graph_t& G,
+                   vertex_t source,
+                   vertex_t* depths,
+                   benchmark::options_t const& options,
+                   std::vector<benchmark::record_t>& records) {
+  using operators::filter_algorithm_t;
+  std::size_t m = G.get_number_of_edges();
+  auto config = [&](filter_algorithm_t filter) {
+    return to_string(lb) + "+" + to_string(filter);
+  };
+
+  records.push_back(benchmark::measure(
+      dataset, "bfs", config(filter_algorithm_t::compact), m, options,
+      [&](context_ptr_t& context) {
+        return traverse<lb, filter_algorithm_t::compact>(G, source, depths,
+                                                         context);
+      }));
+  records.push_back(benchmark::measure(
+      dataset, "bfs", config(filter_algorithm_t::predicated), m, options,
+      [&](context_ptr_t& context) {
+        return traverse<lb, filter_algorithm_t::predicated>(G, source, depths,
+                                                            context);
+      }));
+  records.push_back(benchmark::measure(
+      dataset, "bfs", config(filter_algorithm_t::remove), m, options,
+      [&](context_ptr_t& context) {
+        return traverse<lb, filter_algorithm_t::remove>(G, source, depths,
+                                                        context);
+      }));
+  records.push_back(benchmark::measure(
+      dataset, "bfs", config(filter_algorithm_t::bypass), m, options,
+      [&](context_ptr_t& context) {
+        return traverse<lb, filter_algorithm_t::bypass>(G, source, depths,
+                                                        context);
+      }));
+}
+
+void benchmark_dataset(std::string const& dataset,
+                       benchmark::options_t const& options,
+                       std::vector<benchmark::record_t>& records) {
+  using csr_t =
+      format::csr_t<memory_space_t::device, vertex_t, edge_t, weight_t>;
+  csr_t csr;
+
+  if (util::is_market(dataset)) {
+    io::matrix_market_t<vertex_t, edge_t, weight_t> mm;
+    mm.load_csr(dataset, csr);
+  } else if (util::is_binary_csr(dataset)) {
+    csr.read_binary(dataset);
+  } else {
+    std::cerr << "Unknown file format: " << dataset << std::endl;
+    exit(1);
+  }
+
+  // Relabel the vertices, the source follows.
+  vertex_t source = options.source;
+  if (!options.reorder.empty()) {
+    auto algorithm = (options.reorder == "degree") ? format::reorder::degree
+                     : (options.reorder == "bfs")  ? format::reorder::bfs
+                                                   : format::reorder::rcm;
+    auto permutation = format::reorder::execute(csr, algorithm, source);
+    source = permutation.get_reordered_id(source);
+  }
+
+  thrust::device_vector<vertex_t> row_indices(csr.number_of_nonzeros);
+  thrust::device_vector<edge_t> column_offsets(csr.number_of_columns + 1);
+  thrust::device_vector<weight_t> column_values(csr.number_of_nonzeros);
+
+  auto G =
+      graph::build::from_csr<memory_space_t::device,
+                             graph::view_t::csr | graph::view_t::csc>(
+          csr.number_of_rows,               // rows
+          csr.number_of_columns,            // columns
+          csr.number_of_nonzeros,           // nonzeros
+          csr.row_offsets.data().get(),     // row_offsets
+          csr.column_indices.data().get(),  // column_indices
+          csr.nonzero_values.data().get(),  // values
+          row_indices.data().get(),         // row_indices
+          column_offsets.data().get(),      // column_offsets
+          column_values.data().get()        // column-major values (CSC)
+      );
+
+  vertex_t n = G.get_number_of_vertices();
+  std::size_t m = G.get_number_of_edges();
+
+  thrust::device_vector<vertex_t> vertices_a(n);
+  thrust::device_vector<vertex_t> vertices_b(n);
+  thrust::device_vector<weight_t> weights(n);
+  thrust::device_vector<int> cores(n);
+
+  // --
+  // Operator sweep: every load-balanced advance with every filter.
+
+  using operators::load_balance_t;
+  auto depths = vertices_a.data().get();
+  if (options.algorithm.empty()) {
+    sweep_filters<load_balance_t::thread_mapped>(dataset, G, source, depths,
+                                                 options, records);
+    sweep_filters<load_balance_t::warp_mapped>(dataset, G, source, depths,
+                                               options, records);
+    sweep_filters<load_balance_t::block_mapped>(dataset, G, source, depths,
+                                                options, records);
+    sweep_filters<load_balance_t::merge_path>(dataset, G, source, depths,
+                                              options, records);
+    sweep_filters<load_balance_t::work_stealing>(dataset, G, source, depths,
+                                                 options, records);
+    sweep_filters<load_balance_t::automatic>(dataset, G, source, depths,
+                                             options, records);
+  }
+
+  // --
+  // Algorithms, with their own operator configuration.
+
+  if (options.is_selected("bfs"))
+    records.push_back(benchmark::measure(
+        dataset, "bfs", "default", m, options, [&](context_ptr_t& context) {
+          return gunrock::bfs::run(G, source, vertices_a.data().get(),
+                                   vertices_b.data().get(), context);
+        }));
+
+  // One persistent (cooperative) kernel for all the iterations.
+  enactor_properties_t persistent;
+  persistent.persistent_iterations = true;
+
+  if (options.is_selected("bfs"))
+    records.push_back(benchmark::measure(
+        dataset, "bfs", "persistent", m, options,
+        [&](context_ptr_t& context) {
+          return gunrock::bfs::run(G, source, vertices_a.data().get(),
+                                   vertices_b.data().get(), context,
+                                   persistent);
+        }));
+
+  if (options.is_selected("sssp"))
+    records.push_back(benchmark::measure(
+        dataset, "sssp", "default", m, options, [&](context_ptr_t& context) {
+          return gunrock::sssp::run(G, source, weights.data().get(),
+                                    vertices_b.data().get(), nullptr, 0,
+                                    context);
+        }));
+
+  if (options.is_selected("sssp"))
+    records.push_back(benchmark::measure(
+        dataset, "sssp", "persistent", m, options,
+        [&](context_ptr_t& context) {
+          return gunrock::sssp::run(G, source, weights.data().get(),
+                                    vertices_b.data().get(), nullptr, 0,
+                                    context, persistent);
+        }));
+
+  // Single-source jobs over a pool of workers (one stream, memory pool and
+  // sssp session each), created once and reused by every trial.
+  if (options.is_selected("sssp")) {
+    operators::batch::executor_t executor(4);
+    std::size_t number_of_jobs = 8 * executor.size();
+
+    struct worker_t {
+      gunrock::sssp::session_t<decltype(G)> session;
+      thrust::device_vector<weight_t> distances;
+      thrust::device_vector<vertex_t> predecessors;
+      worker_t(decltype(G)& G, context_ptr_t& context, vertex_t n)
+          : session(G, 0, context), distances(n), predecessors(n) {}
+    };
+
+    auto record = benchmark::measure(
+        dataset, "sssp", "batch-" + std::to_string(executor.size()), 0,
+        options, [&](context_ptr_t&) {
+          auto report = executor.execute(
+              [&](context_ptr_t& context) {
+                return std::make_shared<worker_t>(G, context, n);
+              },
+              [&](std::shared_ptr<worker_t>& worker, std::size_t job,
+                  context_ptr_t& context) -> float {
+                vertex_t job_source = (source + job) % n;
+                return worker->session.run(
+                    job_source, worker->distances.data().get(),
+                    worker->predecessors.data().get());
+              },
+              number_of_jobs);
+          return report.elapsed;
+        });
+
+    // The jobs allocate from the workers' pools, not the measured context.
+    record.peak_bytes = 0;
+    for (std::size_t w = 0; w < executor.size(); ++w)
+      record.peak_bytes +=
+          executor.get_context(w)->get_context(0)->pool()->get_reserved_bytes();
+    record.jobs_per_second =
+        (record.time.median > 0)
+            ? (1000.0f * number_of_jobs) / record.time.median
+            : 0;
+    std::cout << std::string(24, ' ') << number_of_jobs << " jobs on "
+              << executor.size() << " workers: " << record.jobs_per_second
+              << " jobs/s, " << (record.peak_bytes >> 20) << " MiB"
+              << std::endl;
+    records.push_back(record);
+  }
+
+  if (options.is_selected("bc"))
+    records.push_back(benchmark::measure(
+        dataset, "bc", "default", 0, options, [&](context_ptr_t& context) {
+          return gunrock::bc::run(G, source, weights.data().get(), context);
+        }));
+
+  if (options.is_selected("color"))
+    records.push_back(benchmark::measure(
+        dataset, "color", "default", 0, options, [&](context_ptr_t& context) {
+          return gunrock::color::run(G, vertices_a.data().get(), context);
+        }));
+
+  if (options.is_selected("kcore"))
+    records.push_back(benchmark::measure(
+        dataset, "kcore", "default", 0, options, [&](context_ptr_t& context) {
+          return gunrock::kcore::run(G, cores.data().get(), context);
+        }));
+
+  weight_t alpha = 0.85;
+  weight_t tol = 1e-6;
+  if (options.is_selected("pr"))
+    records.push_back(benchmark::measure(
+        dataset, "pr", "default", 0, options, [&](context_ptr_t& context) {
+          return gunrock::pr::run(G, alpha, tol, weights.data().get(), context);
+        }));
+
+  weight_t ppr_alpha = 0.15;
+  weight_t epsilon = 1e-6;
+  if (options.is_selected("ppr"))
+    records.push_back(benchmark::measure(
+        dataset, "ppr", "default", 0, options, [&](context_ptr_t& context) {
+          return gunrock::ppr::run(G, source, weights.data().get(), ppr_alpha,
+                                   epsilon, context);
+        }));
+}
+
+int main(int argc, char** argv) {
+  benchmark::options_t options(argc, argv);
+
+  std::vector<benchmark::record_t> records;
+  for (auto& dataset : options.datasets)
+    benchmark_dataset(dataset, options, records);
+
+  benchmark::write(records, options);
+}
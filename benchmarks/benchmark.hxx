@@ -0,0 +1,216 @@
+/**
+ * @file benchmark.hxx
+ * @author Muhammad Osama (mosama@ucdavis.edu)
+ * @brief Warm-up and repeated trials, robust summaries (median, p95) and json
+ * output of the benchmark harness.
+ * @version 0.1
+ * @date 2021-06-14
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gunrock/cuda/context.hxx>
+#include <gunrock/io/json.hxx>
+
+namespace gunrock {
+namespace benchmark {
+
+/**
+ * @brief Command line options, `[--warmup N] [--trials N] [--json file]
+ * [--source v] [--reorder degree|bfs|rcm] [--algorithm name] dataset...`
+ * (datasets are .mtx or binary .csr files). With `--algorithm`, only the
+ * default configuration of that algorithm runs (see `autotune.py`).
+ */
+struct options_t {
+  int warmup = 2;
+  int trials = 10;
+  int source = 0;
+  std::string json = "";
+  std::string reorder = "";  // vertex order, see `format::reorder`.
+  std::string algorithm = "";  // only this algorithm, all if empty.
+  std::vector<std::string> datasets;
+
+  options_t(int argc, char** argv) {
+    for (int i = 1; i < argc; ++i) {
+      std::string arg = argv[i];
+      if (arg == "--warmup" && i + 1 < argc)
+        warmup = std::atoi(argv[++i]);
+      else if (arg == "--trials" && i + 1 < argc)
+        trials = std::atoi(argv[++i]);
+      else if (arg == "--source" && i + 1 < argc)
+        source = std::atoi(argv[++i]);
+      else if (arg == "--json" && i + 1 < argc)
+        json = argv[++i];
+      else if (arg == "--reorder" && i + 1 < argc)
+        reorder = argv[++i];
+      else if (arg == "--algorithm" && i + 1 < argc)
+        algorithm = argv[++i];
+      else
+        datasets.push_back(arg);
+    }
+
+    bool known_order = reorder.empty() || reorder == "degree" ||
+                       reorder == "bfs" || reorder == "rcm";
+    if (datasets.empty() || trials < 1 || !known_order) {
+      std::cerr << "usage: ./bin/benchmark [--warmup N] [--trials N] "
+                   "[--source v] [--json file] [--reorder degree|bfs|rcm] "
+                   "[--algorithm name] dataset.mtx ..."
+                << std::endl;
+      exit(1);
+    }
+  }
+
+  /**
+   * @brief True if (the default configuration of) `name` is benchmarked.
+   */
+  bool is_selected(std::string const& name) const {
+    return algorithm.empty() || algorithm == name;
+  }
+};
+
+/**
+ * @brief Summary of the trials, times in milliseconds.
+ */
+struct summary_t {
+  int trials = 0;
+  float min = 0;
+  float median = 0;
+  float p95 = 0;
+  float mean = 0;
+};
+
+inline summary_t summarize(std::vector<float> times) {
+  summary_t s;
+  if (times.empty())
+    return s;
+
+  std::sort(times.begin(), times.end());
+  std::size_t n = times.size();
+  s.trials = n;
+  s.min = times.front();
+  s.median = (n % 2) ? times[n / 2] : (times[n / 2 - 1] + times[n / 2]) / 2;
+  s.p95 = times[std::min(n - 1, (std::size_t)std::ceil(0.95 * n) - 1)];
+  for (auto t : times)
+    s.mean += t;
+  s.mean /= n;
+  return s;
+}
+
+/**
+ * @brief One benchmarked configuration (algorithm and operators) on one
+ * dataset.
+ */
+struct record_t {
+  std::string dataset;
+  std::string algorithm;
+  std::string configuration;
+  summary_t time;
+  float mteps;  // traversed edges per median time, 0 if not a traversal.
+  std::size_t peak_bytes;
+  float jobs_per_second = 0;  // jobs per median time, 0 if not batched.
+};
+
+/**
+ * @brief Run `run(context) -> float` (milliseconds) `warmup` times, then
+ * `trials` times, on a context of its own, such that the peak of its memory
+ * pool (which never releases memory) is the configuration's peak device
+ * memory.
+ *
+ * @param traversed_edges edges of the graph, for single traversals (bfs,
+ * sssp), whose MTEPS are reported; `0` for the other algorithms (iterative,
+ * batched or vertex-centric), for which |E| / time is not a traversal rate.
+ */
+template <typename run_t>
+record_t measure(std::string dataset,
+                 std::string algorithm,
+                 std::string configuration,
+                 std::size_t traversed_edges,
+                 options_t const& options,
+                 run_t run) {
+  auto context = std::make_shared<cuda::multi_context_t>(0);
+
+  for (int i = 0; i < options.warmup; ++i)
+    run(context);
+
+  std::vector<float> times;
+  for (int i = 0; i < options.trials; ++i)
+    times.push_back(run(context));
+
+  record_t record;
+  record.dataset = dataset;
+  record.algorithm = algorithm;
+  record.configuration = configuration;
+  record.time = summarize(times);
+  record.mteps = (traversed_edges && record.time.median > 0)
+                     ? traversed_edges / (record.time.median * 1e3)
+                     : 0;
+  record.peak_bytes = context->get_context(0)->pool()->get_reserved_bytes();
+
+  std::string name = dataset.substr(dataset.find_last_of('/') + 1);
+  std::cout << std::left << std::setw(24) << name << std::setw(8)
+            << algorithm << std::setw(28) << configuration << std::right
+            << std::setw(12) << record.time.median << " ms" << std::setw(12)
+            << record.time.p95 << " ms" << std::setw(12);
+  if (record.mteps > 0)
+    std::cout << record.mteps << " MTEPS";
+  else
+    std::cout << "-" << std::string(6, ' ');  // not a traversal.
+  std::cout << std::setw(12) << (record.peak_bytes >> 20)
+            << " MiB" << std::endl;
+  return record;
+}
+
+/**
+ * @brief Write the records (one array per field, indexed by record) through
+ * `io::json`.
+ */
+inline void write(std::vector<record_t> const& records,
+                  options_t const& options) {
+  std::vector<std::string> datasets, algorithms, configurations;
+  std::vector<float> median, p95, min, mean, mteps, jobs_per_second;
+  std::vector<std::size_t> peak;
+  for (auto& r : records) {
+    datasets.push_back(r.dataset);
+    algorithms.push_back(r.algorithm);
+    configurations.push_back(r.configuration);
+    median.push_back(r.time.median);
+    p95.push_back(r.time.p95);
+    min.push_back(r.time.min);
+    mean.push_back(r.time.mean);
+    mteps.push_back(r.mteps);
+    peak.push_back(r.peak_bytes);
+    jobs_per_second.push_back(r.jobs_per_second);
+  }
+
+  io::json json("benchmark", options.json);
+  json.set_val("warmup", options.warmup);
+  json.set_val("trials", options.trials);
+  json.set_val("reorder", options.reorder.empty() ? std::string("none")
+                                                  : options.reorder);
+  json.set_val("dataset", datasets);
+  json.set_val("algorithm", algorithms);
+  json.set_val("configuration", configurations);
+  json.set_val("median-time", median);
+  json.set_val("p95-time", p95);
+  json.set_val("min-time", min);
+  json.set_val("mean-time", mean);
+  json.set_val("mteps", mteps);
+  json.set_val("peak-device-bytes", peak);
+  json.set_val("jobs-per-second", jobs_per_second);
+  json.write();
+}
+
+}  // namespace benchmark
+}  // namespace gunrock
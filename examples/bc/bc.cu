@@ -26,7 +26,7 @@ void test_bc(int num_arguments, char** argument_array) {
   using csr_t =
       format::csr_t<memory_space_t::device, vertex_t, edge_t, weight_t>;
   csr_t csr;
-  csr.from_coo(mm.load(filename));
+  mm.load_csr(filename, csr);
 
   // --
   // Build graph
@@ -27,18 +27,18 @@ void test_bfs(int num_arguments, char** argument_array) {
   using csr_t =
       format::csr_t<memory_space_t::device, vertex_t, edge_t, weight_t>;
   csr_t csr;
-  csr.from_coo(mm.load(filename));
+  mm.load_csr(filename, csr);
 
   thrust::device_vector<vertex_t> row_indices(csr.number_of_nonzeros);
-  thrust::device_vector<vertex_t> column_indices(csr.number_of_nonzeros);
   thrust::device_vector<edge_t> column_offsets(csr.number_of_columns + 1);
+  thrust::device_vector<weight_t> column_values(csr.number_of_nonzeros);
 
   // --
-  // Build graph + metadata
+  // Build graph + metadata (CSR + CSC for direction-optimized advance)
 
   auto G =
       graph::build::from_csr<memory_space_t::device,
-                             graph::view_t::csr /* | graph::view_t::csc */>(
+                             graph::view_t::csr | graph::view_t::csc>(
           csr.number_of_rows,               // rows
           csr.number_of_columns,            // columns
           csr.number_of_nonzeros,           // nonzeros
@@ -46,7 +46,8 @@ void test_bfs(int num_arguments, char** argument_array) {
           csr.column_indices.data().get(),  // column_indices
           csr.nonzero_values.data().get(),  // values
           row_indices.data().get(),         // row_indices
-          column_offsets.data().get()       // column_offsets
+          column_offsets.data().get(),      // column_offsets
+          column_values.data().get()        // column-major values (CSC)
       );
 
   // --
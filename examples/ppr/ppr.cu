@@ -32,7 +32,7 @@ void test_ppr(int num_arguments, char** argument_array) {
 
   if (util::is_market(filename)) {
     io::matrix_market_t<vertex_t, edge_t, weight_t> mm;
-    csr.from_coo(mm.load(filename));
+    mm.load_csr(filename, csr);
   } else if (util::is_binary_csr(filename)) {
     csr.read_binary(filename);
   } else {
@@ -27,7 +27,7 @@ void test_pr(int num_arguments, char** argument_array) {
 
   if (util::is_market(filename)) {
     io::matrix_market_t<vertex_t, edge_t, weight_t> mm;
-    csr.from_coo(mm.load(filename));
+    mm.load_csr(filename, csr);
   } else if (util::is_binary_csr(filename)) {
     csr.read_binary(filename);
   } else {
@@ -35,17 +35,26 @@ void test_pr(int num_arguments, char** argument_array) {
     exit(1);
   }
 
+  thrust::device_vector<vertex_t> row_indices(csr.number_of_nonzeros);
+  thrust::device_vector<edge_t> column_offsets(csr.number_of_columns + 1);
+  thrust::device_vector<weight_t> column_values(csr.number_of_nonzeros);
+
   // --
-  // Build graph
-
-  auto G = graph::build::from_csr<memory_space_t::device, graph::view_t::csr>(
-      csr.number_of_rows,               // rows
-      csr.number_of_columns,            // columns
-      csr.number_of_nonzeros,           // nonzeros
-      csr.row_offsets.data().get(),     // row_offsets
-      csr.column_indices.data().get(),  // column_indices
-      csr.nonzero_values.data().get()   // values
-  );  // supports row_indices and column_offsets (default = nullptr)
+  // Build graph (CSR + CSC for the pull-based, atomic-free PageRank)
+
+  auto G =
+      graph::build::from_csr<memory_space_t::device,
+                             graph::view_t::csr | graph::view_t::csc>(
+          csr.number_of_rows,               // rows
+          csr.number_of_columns,            // columns
+          csr.number_of_nonzeros,           // nonzeros
+          csr.row_offsets.data().get(),     // row_offsets
+          csr.column_indices.data().get(),  // column_indices
+          csr.nonzero_values.data().get(),  // values
+          row_indices.data().get(),         // row_indices
+          column_offsets.data().get(),      // column_offsets
+          column_values.data().get()        // column-major values (CSC)
+      );
 
   // --
   // Params and memory allocation
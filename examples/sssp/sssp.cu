@@ -27,7 +27,7 @@ void test_sssp(int num_arguments, char** argument_array) {
   using csr_t =
       format::csr_t<memory_space_t::device, vertex_t, edge_t, weight_t>;
   csr_t csr;
-  csr.from_coo(mm.load(filename));
+  mm.load_csr(filename, csr);
 
   // --
   // Build graph
@@ -54,8 +54,10 @@ void test_sssp(int num_arguments, char** argument_array) {
   // --
   // GPU Run
 
-  float gpu_elapsed = gunrock::sssp::run(
-      G, single_source, distances.data().get(), predecessors.data().get());
+  std::size_t edges_relaxed = 0;
+  float gpu_elapsed =
+      gunrock::sssp::run(G, single_source, distances.data().get(),
+                         predecessors.data().get(), &edges_relaxed);
 
   // --
   // CPU Run
@@ -79,6 +81,7 @@ void test_sssp(int num_arguments, char** argument_array) {
 
   std::cout << "GPU Elapsed Time : " << gpu_elapsed << " (ms)" << std::endl;
   std::cout << "CPU Elapsed Time : " << cpu_elapsed << " (ms)" << std::endl;
+  std::cout << "Edges Relaxed    : " << edges_relaxed << std::endl;
   std::cout << "Number of errors : " << n_errors << std::endl;
 }
 
@@ -94,7 +94,8 @@ struct enactor_t : gunrock::enactor_t<problem_t> {
   void prepare_frontier(frontier_t<vertex_t>* f,
                         cuda::multi_context_t& context) override {
     auto P = this->get_problem();
-    this->frontiers[0].push_back(P->param.single_source);
+    this->frontiers[0].push_back(P->param.single_source,
+                                 context.get_context(0)->stream());
   }
 
   void loop(cuda::multi_context_t& context) override {
@@ -212,7 +213,10 @@ struct enactor_t : gunrock::enactor_t<problem_t> {
 template <typename graph_t>
 float run(graph_t& G,
           typename graph_t::vertex_type single_source,
-          typename graph_t::weight_type* bc_values) {
+          typename graph_t::weight_type* bc_values,
+          std::shared_ptr<cuda::multi_context_t> multi_context =
+              nullptr  // Context (optional, default: GPU 0)
+) {
   // <user-defined>
   using vertex_t = typename graph_t::vertex_type;
   using weight_t = typename graph_t::weight_type;
@@ -225,8 +229,9 @@ float run(graph_t& G,
   // </user-defined>
 
   // <boiler-plate>
-  auto multi_context =
-      std::shared_ptr<cuda::multi_context_t>(new cuda::multi_context_t(0));
+  if (!multi_context)
+    multi_context =
+        std::shared_ptr<cuda::multi_context_t>(new cuda::multi_context_t(0));
 
   using problem_type = problem_t<graph_t, param_type, result_type>;
   using enactor_type = enactor_t<problem_type>;
@@ -245,6 +250,170 @@ float run(graph_t& G,
   // </boiler-plate>
 }
 
+/**
+ * @brief Betweenness centrality accumulated over multiple sources at once,
+ * the sources are processed in batches of up to 32 or 64 (one bit per source
+ * in a `mask_t`, fewer if the per-lane storage does not fit in the free
+ * device memory): the forward (sigma) and backward (delta) passes of a batch
+ * scan the edges of a level once for all its sources. The contributions are
+ * added to `bc_values`, which is not cleared.
+ *
+ * @tparam mask_t `std::uint32_t` or `std::uint64_t` (default), width of a
+ * batch.
+ * @param G graph.
+ * @param sources sources (host).
+ * @param number_of_sources number of sources.
+ * @param bc_values output (device), `n` entries.
+ * @param multi_context context (optional, default: GPU 0).
+ * @return float elapsed time (ms).
+ */
+template <typename mask_t = std::uint64_t, typename graph_t>
+float run_multi_source(graph_t& G,
+                       typename graph_t::vertex_type const* sources,
+                       std::size_t number_of_sources,
+                       typename graph_t::weight_type* bc_values,
+                       std::shared_ptr<cuda::multi_context_t> multi_context =
+                           nullptr) {
+  using vertex_t = typename graph_t::vertex_type;
+  using edge_t = typename graph_t::edge_type;
+  using weight_t = typename graph_t::weight_type;
+  namespace multi_source = operators::batch::multi_source;
+
+  if (!multi_context)
+    multi_context =
+        std::shared_ptr<cuda::multi_context_t>(new cuda::multi_context_t(0));
+  auto context = multi_context->get_context(0);
+  auto policy = context->execution_policy();
+
+  std::size_t n = G.get_number_of_vertices();
+  multi_source::state_t<vertex_t, mask_t> state(n);
+
+  // Lanes per batch, bounded by (half of) the free device memory: a lane
+  // holds a label, a sigma and a delta per vertex, and the saved levels hold
+  // at most a vertex and a mask per vertex and lane.
+  std::size_t free_bytes = 0, total_bytes = 0;
+  error::throw_if_exception(cudaMemGetInfo(&free_bytes, &total_bytes));
+  std::size_t lane_bytes = std::max<std::size_t>(
+      1, n * (2 * sizeof(vertex_t) + 2 * sizeof(weight_t) + sizeof(mask_t)));
+  int lanes = (int)std::min<std::size_t>(state.lanes,
+                                         (free_bytes / 2) / lane_bytes);
+  if (lanes == 0)
+    error::throw_if_exception(cudaErrorMemoryAllocation,
+                              "Not enough device memory for a bc lane.");
+
+  // Per-lane labels, sigmas and deltas, lane `l` at `l * n`.
+  vector_t<vertex_t, memory_space_t::device> labels(lanes * n);
+  vector_t<weight_t, memory_space_t::device> sigmas(lanes * n);
+  vector_t<weight_t, memory_space_t::device> deltas(lanes * n);
+  auto d_labels = labels.data().get();
+  auto d_sigmas = sigmas.data().get();
+  auto d_deltas = deltas.data().get();
+
+  // Levels of the forward pass (vertices and the lanes they are in).
+  std::vector<vector_t<vertex_t, memory_space_t::device>> level_vertices;
+  std::vector<vector_t<mask_t, memory_space_t::device>> level_masks;
+
+  auto forward_op = [=] __device__(vertex_t const& src, vertex_t const& dst,
+                                   edge_t const& edge,
+                                   weight_t const& weight,
+                                   mask_t const& lanes) -> mask_t {
+    mask_t discovered = 0;
+    multi_source::for_each_lane(lanes, [&](int lane) {
+      auto lane_labels = d_labels + lane * n;
+      auto lane_sigmas = d_sigmas + lane * n;
+      auto new_label = lane_labels[src] + 1;
+      auto old_label = math::atomic::cas(lane_labels + dst, -1, new_label);
+
+      if ((old_label != -1) && (new_label != old_label))
+        return;
+
+      math::atomic::add(lane_sigmas + dst, lane_sigmas[src]);
+      if (old_label == -1)
+        discovered |= mask_t(1) << lane;
+    });
+    return discovered;
+  };
+
+  auto backward_op = [=] __device__(vertex_t const& src, vertex_t const& dst,
+                                    edge_t const& edge,
+                                    weight_t const& weight,
+                                    mask_t const& lanes) -> mask_t {
+    multi_source::for_each_lane(lanes, [&](int lane) {
+      auto offset = lane * n;
+      if (d_labels[offset + src] + 1 != d_labels[offset + dst])
+        return;
+
+      auto update = d_sigmas[offset + src] / d_sigmas[offset + dst] *
+                    (1 + d_deltas[offset + dst]);
+      math::atomic::add(d_deltas + offset + src, update);
+      math::atomic::add(bc_values + src, 0.5f * update);  // scaled output
+    });
+    return 0;
+  };
+
+  auto& timer = context->timer();
+  timer.begin();
+
+  for (std::size_t first = 0; first < number_of_sources;
+       first += lanes) {
+    int count = (int)std::min<std::size_t>(lanes, number_of_sources - first);
+
+    thrust::fill(policy, labels.begin(), labels.end(), vertex_t(-1));
+    thrust::fill(policy, sigmas.begin(), sigmas.end(), weight_t(0));
+    thrust::fill(policy, deltas.begin(), deltas.end(), weight_t(0));
+
+    state.track_visited = true;
+    state.reset(sources + first, count, *context);
+    multi_source::for_each_active(
+        state,
+        [=] __device__(vertex_t const& v, mask_t const& lanes) {
+          multi_source::for_each_lane(lanes, [&](int lane) {
+            d_labels[lane * n + v] = 0;
+            d_sigmas[lane * n + v] = 1;
+          });
+        },
+        *context);
+
+    // Forward pass, level 0 (the sources) is not needed by the backward pass.
+    std::size_t depth = 0;
+    while (true) {
+      multi_source::advance(G, state, forward_op, *context);
+      multi_source::commit(state, *context);
+      if (state.is_empty())
+        break;
+
+      ++depth;
+      if (level_vertices.size() < depth) {
+        level_vertices.emplace_back();
+        level_masks.emplace_back();
+      }
+
+      auto size = state.active.get_number_of_elements();
+      auto& vertices = level_vertices[depth - 1];
+      auto& masks = level_masks[depth - 1];
+      vertices.resize(size);
+      masks.resize(size);
+      thrust::copy(policy, state.active.begin(), state.active.end(),
+                   vertices.begin());
+      auto frontier = state.frontier.data().get();
+      thrust::transform(
+          policy, state.active.begin(), state.active.end(), masks.begin(),
+          [=] __device__(vertex_t const& v) -> mask_t { return frontier[v]; });
+    }
+
+    // Backward pass, from the deepest level up to level 1.
+    state.track_visited = false;
+    for (; depth > 0; --depth) {
+      state.assign(level_vertices[depth - 1].data().get(),
+                   level_masks[depth - 1].data().get(),
+                   level_vertices[depth - 1].size(), *context);
+      multi_source::advance(G, state, backward_op, *context);
+    }
+  }
+
+  return timer.end();
+}
+
 template <typename graph_t>
 float run(graph_t& G, typename graph_t::weight_type* bc_values) {
   using vertex_t = typename graph_t::vertex_type;
@@ -254,15 +423,10 @@ float run(graph_t& G, typename graph_t::weight_type* bc_values) {
   auto d_bc_values = thrust::device_pointer_cast(bc_values);
   thrust::fill_n(thrust::device, d_bc_values, n_vertices, (weight_t)0);
 
-  auto f = [&](std::size_t job_idx) -> float {
-    return bc::run(G, (vertex_t)job_idx, bc_values);
-  };
-
-  std::size_t n_jobs = n_vertices;
-  thrust::host_vector<float> total_elapsed(1);
-  operators::batch::execute(f, n_jobs, total_elapsed.data());
-
-  return total_elapsed[0];
+  // All the vertices are sources, batched up to 64 at a time.
+  thrust::host_vector<vertex_t> sources(n_vertices);
+  thrust::sequence(sources.begin(), sources.end(), vertex_t(0));
+  return run_multi_source(G, sources.data(), sources.size(), bc_values);
 }
 
 }  // namespace bc
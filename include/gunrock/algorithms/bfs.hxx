@@ -11,6 +11,9 @@
 #pragma once
 
 #include <gunrock/algorithms/algorithms.hxx>
+#include <thrust/copy.h>
+#include <thrust/for_each.h>
+#include <thrust/iterator/counting_iterator.h>
 
 namespace gunrock {
 namespace bfs {
@@ -48,15 +51,38 @@ struct problem_t : gunrock::problem_t<graph_t> {
 
   thrust::device_vector<vertex_t> visited;  /// @todo not used.
 
-  void init() override {}
+  /*!
+   * Distances the enactor works on: `result.distances`, or on multiple GPUs
+   * the striped `staged_distances`, copied to `result.distances` once
+   * converged (`finalize()`).
+   */
+  vertex_t* distances = nullptr;
+  vertex_array_t<vertex_t> staged_distances;
+
+  void init() override {
+    if (this->context->size() > 1)
+      staged_distances.allocate(this->get_graph().get_number_of_vertices(),
+                                *(this->context));
+  }
 
   void reset() override {
+    distances = staged_distances.is_striped() ? staged_distances.data()
+                                              : this->result.distances;
     auto n_vertices = this->get_graph().get_number_of_vertices();
-    auto d_distances = thrust::device_pointer_cast(this->result.distances);
+    auto d_distances = thrust::device_pointer_cast(distances);
     thrust::fill(thrust::device, d_distances + 0, d_distances + n_vertices, -1);
     thrust::fill(thrust::device, d_distances + this->param.single_source,
                  d_distances + this->param.single_source + 1, 0);
   }
+
+  void finalize() override {
+    if (!staged_distances.is_striped())
+      return;
+    auto policy = this->get_single_context()->execution_policy();
+    thrust::copy(policy, distances, distances + staged_distances.size(),
+                 this->result.distances);
+    this->get_single_context()->synchronize();
+  }
 };
 
 template <typename problem_t>
@@ -69,10 +95,93 @@ struct enactor_t : gunrock::enactor_t<problem_t> {
   using edge_t = typename problem_t::edge_t;
   using weight_t = typename problem_t::weight_t;
 
+  /*!
+   * Device-sized queues of the captured iterations (or of the persistent
+   * traversal).
+   */
+  operators::advance::captured::queues_t<vertex_t> queues;
+
+  /*!
+   * Dense (bitmap) frontiers of the dense iterations, the input is
+   * `dense_frontiers[dense_selector]` (see
+   * `enactor_properties_t::dense_frontier_threshold`).
+   */
+  frontier_t<vertex_t, frontier_storage_t::bitmap> dense_frontiers[2];
+  int dense_selector = 0;
+  bool is_dense = false;
+
+  void reset() override {
+    gunrock::enactor_t<problem_t>::reset();
+    is_dense = false;
+    dense_selector = 0;
+  }
+
   void prepare_frontier(frontier_t<vertex_t>* f,
                         cuda::multi_context_t& context) override {
     auto P = this->get_problem();
-    f->push_back(P->param.single_source);
+    f->push_back(P->param.single_source,
+                context.get_context(0)->stream());
+    if (this->properties.capture_iterations ||
+        this->properties.persistent_iterations) {
+      // The captured queues do not grow, a vertex is queued at most once.
+      auto n_vertices = P->get_graph().get_number_of_vertices();
+      this->frontiers[0].reserve(n_vertices);
+      this->frontiers[1].reserve(n_vertices);
+      queues.bind(this->frontiers[0], this->frontiers[1],
+                  *(context.get_context(0)));
+    }
+  }
+
+  bool is_capturable() override { return true; }
+
+  void loop_captured(cuda::standard_context_t& context) override {
+    auto P = this->get_problem();
+    auto G = P->get_graph();
+
+    auto distances = P->distances;
+    auto iteration = queues.get_iteration();
+
+    auto search = [distances, iteration] __device__(
+                      vertex_t const& source,    // ... source
+                      vertex_t const& neighbor,  // neighbor
+                      edge_t const& edge,        // edge
+                      weight_t const& weight     // weight (tuple).
+                      ) -> bool {
+      if (distances[neighbor] != -1)
+        return false;
+      vertex_t depth = (vertex_t)(*iteration) + 1;
+      return (math::atomic::cas(&distances[neighbor], -1, depth) == -1);
+    };
+
+    operators::advance::captured::execute(
+        G, search, queues, this->work_remains.data().get(), context);
+  }
+
+  bool is_persistent() override { return true; }
+
+  void loop_persistent(cuda::standard_context_t& context) override {
+    auto P = this->get_problem();
+    auto G = P->get_graph();
+
+    auto distances = P->distances;
+    auto iteration = queues.get_iteration();
+
+    auto search = [distances, iteration] __device__(
+                      vertex_t const& source,    // ... source
+                      vertex_t const& neighbor,  // neighbor
+                      edge_t const& edge,        // edge
+                      weight_t const& weight     // weight (tuple).
+                      ) -> bool {
+      if (distances[neighbor] != -1)
+        return false;
+      vertex_t depth = (vertex_t)(*iteration) + 1;
+      return (math::atomic::cas(&distances[neighbor], -1, depth) == -1);
+    };
+
+    operators::advance::persistent::execute(G, search, queues, context);
+
+    // The last iteration is the one with an empty output.
+    this->iteration = queues.get_number_of_iterations(context) + 1;
   }
 
   void loop(cuda::multi_context_t& context) override {
@@ -82,7 +191,7 @@ struct enactor_t : gunrock::enactor_t<problem_t> {
     auto G = P->get_graph();
 
     auto single_source = P->param.single_source;
-    auto distances = P->result.distances;
+    auto distances = P->distances;
     auto visited = P->visited.data().get();
 
     auto iteration = this->iteration;
@@ -106,13 +215,74 @@ struct enactor_t : gunrock::enactor_t<problem_t> {
       return true;
     };
 
-    // Execute advance operator on the provided lambda
-    operators::advance::execute<operators::load_balance_t::merge_path>(
-        G, E, search, context);
+    // If the graph carries a CSC view as well, use the direction-optimized
+    // (push-pull) advance followed by a filter. Otherwise, use the fused
+    // advance and filter operator that only writes the discovered vertices.
+    using graph_type = decltype(G);
+    if constexpr (graph_type::template contains_representation<
+                      typename graph_type::graph_csc_view_t>()) {
+      operators::advance::execute<operators::load_balance_t::merge_path,
+                                  operators::advance_direction_t::optimized>(
+          G, E, search, context);
 
-    // Execute filter operator on the provided lambda
-    operators::filter::execute<operators::filter_algorithm_t::compact>(
-        G, E, remove_visited, context);
+      // Execute filter operator on the provided lambda
+      operators::filter::execute<operators::filter_algorithm_t::compact>(
+          G, E, remove_visited, context);
+    } else if (this->properties.dense_frontier_threshold > 0 &&
+               context.size() == 1) {
+      loop_switching(G, search, remove_visited, context);
+    } else {
+      operators::advance_filter::execute<
+          operators::load_balance_t::block_mapped>(G, E, search, remove_visited,
+                                                   context);
+    }
+  }
+
+  /**
+   * @brief An iteration with the (sparse) fused advance-filter or, once the
+   * frontier is dense enough, the bitmap advance (every bit a discovered
+   * vertex, no compaction or uniquification), switching representation
+   * when the density crosses `dense_frontier_threshold` (down: half of it).
+   * The enactor's (sparse) input frontier is only written when switching
+   * back, which always happens before convergence (an empty frontier).
+   */
+  template <typename graph_type, typename search_t, typename filter_t>
+  void loop_switching(graph_type& G,
+                      search_t search,
+                      filter_t remove_visited,
+                      cuda::multi_context_t& multi_context) {
+    auto E = this->get_enactor();
+    auto& context = *(multi_context.get_context(0));
+    std::size_t n = G.get_number_of_vertices();
+    float threshold = this->properties.dense_frontier_threshold;
+
+    if (!is_dense &&
+        frontier::get_density(E->get_input_frontier(), n) >= threshold) {
+      frontier::to_dense(E->get_input_frontier(),
+                         &dense_frontiers[dense_selector], n, context);
+      is_dense = true;
+    }
+
+    if (!is_dense) {
+      operators::advance_filter::execute<
+          operators::load_balance_t::block_mapped>(G, E, search, remove_visited,
+                                                   multi_context);
+      return;
+    }
+
+    auto input = &dense_frontiers[dense_selector];
+    auto output = &dense_frontiers[dense_selector ^ 1];
+    operators::advance::execute<operators::load_balance_t::thread_mapped,
+                                operators::advance_direction_t::forward,
+                                operators::advance_io_type_t::vertices,
+                                operators::advance_io_type_t::vertices>(
+        G, search, input, output, this->scanned_work_domain, context);
+    dense_selector ^= 1;
+
+    if (frontier::get_density(output, n) < threshold / 2) {
+      frontier::to_sparse(output, E->get_input_frontier(), context);
+      is_dense = false;
+    }
   }
 
 };  // struct enactor_t
@@ -121,7 +291,11 @@ template <typename graph_t>
 float run(graph_t& G,
           typename graph_t::vertex_type& single_source,  // Parameter
           typename graph_t::vertex_type* distances,      // Output
-          typename graph_t::vertex_type* predecessors    // Output
+          typename graph_t::vertex_type* predecessors,   // Output
+          std::shared_ptr<cuda::multi_context_t> multi_context =
+              nullptr,  // Context (optional, default: GPU 0)
+          enactor_properties_t properties =
+              enactor_properties_t()  // Properties (optional)
 ) {
   // <user-defined>
   using vertex_t = typename graph_t::vertex_type;
@@ -133,8 +307,9 @@ float run(graph_t& G,
   // </user-defined>
 
   // <boiler-plate>
-  auto multi_context =
-      std::shared_ptr<cuda::multi_context_t>(new cuda::multi_context_t(0));
+  if (!multi_context)
+    multi_context =
+        std::shared_ptr<cuda::multi_context_t>(new cuda::multi_context_t(0));
 
   using problem_type = problem_t<graph_t, param_type, result_type>;
   using enactor_type = enactor_t<problem_type>;
@@ -143,10 +318,373 @@ float run(graph_t& G,
   problem.init();
   problem.reset();
 
-  enactor_type enactor(&problem, multi_context);
+  enactor_type enactor(&problem, multi_context, properties);
   return enactor.enact();
   // </boiler-plate>
 }
 
+/**
+ * @brief Breadth-First Search bound to a graph for repeated queries: the
+ * problem, the enactor (frontiers and scratch space) and the context are
+ * built once, every `run()` only resets them.
+ *
+ * @par Example
+ * \code
+ * bfs::session_t<decltype(G)> session(G);
+ * for (auto source : sources)
+ *   session.run(source, distances, predecessors);
+ * \endcode
+ */
+template <typename graph_t>
+struct session_t {
+  using vertex_t = typename graph_t::vertex_type;
+  using param_type = param_t<vertex_t>;
+  using result_type = result_t<vertex_t>;
+  using problem_type = problem_t<graph_t, param_type, result_type>;
+  using enactor_type = enactor_t<problem_type>;
+
+  session_t(graph_t& G,
+            std::shared_ptr<cuda::multi_context_t> multi_context = nullptr,
+            enactor_properties_t properties = enactor_properties_t())
+      : session(multi_context,
+                properties,
+                G,
+                param_type(0),
+                result_type(nullptr, nullptr)) {}
+
+  /**
+   * @brief Breadth-First Search from `single_source`.
+   *
+   * @param single_source source vertex.
+   * @param distances output (device), `n` entries.
+   * @param predecessors output (device), `n` entries.
+   * @return float elapsed time (ms).
+   */
+  float run(vertex_t const& single_source,
+            vertex_t* distances,
+            vertex_t* predecessors) {
+    auto& problem = session.get_problem();
+    problem.param.single_source = single_source;
+    problem.result = result_type(distances, predecessors);
+    return session.enact();
+  }
+
+  gunrock::session_t<problem_type, enactor_type> session;
+};
+
+/**
+ * @brief Breadth-First Search from multiple sources at once, the sources are
+ * processed in batches of 32 or 64 (one bit per source in a `mask_t`), and
+ * every batch scans the edges of a level once for all its sources.
+ *
+ * @tparam mask_t `std::uint32_t` or `std::uint64_t` (default), width of a
+ * batch.
+ * @param G graph.
+ * @param sources sources (host).
+ * @param number_of_sources number of sources.
+ * @param distances output (device), `number_of_sources * n` entries, the
+ * distances from source `i` are at `distances + i * n` (`-1` if unreached).
+ * @param multi_context context (optional, default: GPU 0).
+ * @return float elapsed time (ms).
+ */
+template <typename mask_t = std::uint64_t, typename graph_t>
+float run_multi_source(graph_t& G,
+                       typename graph_t::vertex_type const* sources,
+                       std::size_t number_of_sources,
+                       typename graph_t::vertex_type* distances,
+                       std::shared_ptr<cuda::multi_context_t> multi_context =
+                           nullptr) {
+  using vertex_t = typename graph_t::vertex_type;
+  using edge_t = typename graph_t::edge_type;
+  using weight_t = typename graph_t::weight_type;
+  namespace multi_source = operators::batch::multi_source;
+
+  if (!multi_context)
+    multi_context =
+        std::shared_ptr<cuda::multi_context_t>(new cuda::multi_context_t(0));
+  auto context = multi_context->get_context(0);
+
+  std::size_t n = G.get_number_of_vertices();
+  multi_source::state_t<vertex_t, mask_t> state(n);
+
+  auto& timer = context->timer();
+  timer.begin();
+
+  auto d_distances = thrust::device_pointer_cast(distances);
+  thrust::fill(context->execution_policy(), d_distances,
+               d_distances + number_of_sources * n, vertex_t(-1));
+
+  auto search = [] __device__(vertex_t const& source,
+                              vertex_t const& neighbor, edge_t const& edge,
+                              weight_t const& weight,
+                              mask_t const& lanes) -> mask_t {
+    // Lanes `neighbor` was already visited in are masked out.
+    return lanes;
+  };
+
+  for (std::size_t first = 0; first < number_of_sources;
+       first += state.lanes) {
+    int count = (int)std::min<std::size_t>(state.lanes,
+                                           number_of_sources - first);
+    auto batch = distances + first * n;
+
+    state.reset(sources + first, count, *context);
+    multi_source::for_each_active(
+        state,
+        [=] __device__(vertex_t const& v, mask_t const& lanes) {
+          multi_source::for_each_lane(
+              lanes, [&](int lane) { batch[lane * n + v] = 0; });
+        },
+        *context);
+
+    for (vertex_t depth = 1; !state.is_empty(); ++depth) {
+      multi_source::advance(G, state, search, *context);
+      multi_source::commit(
+          state,
+          [=] __device__(vertex_t const& v, mask_t const& lanes) {
+            multi_source::for_each_lane(
+                lanes, [&](int lane) { batch[lane * n + v] = depth; });
+          },
+          *context);
+    }
+  }
+
+  return timer.end();
+}
+
+/**
+ * @brief Breadth-First Search over a dynamic graph (`format::dynamic_csr_t`),
+ * kept up-to-date across batches of edge insertions and deletions instead of
+ * searching the whole graph again; only the distances of the vertices the
+ * batch affects are touched.
+ *
+ * @par Overview
+ * `update()` applies the batches to the graph itself (the graph view is
+ * built again after every batch, see `graph::build::from_dynamic_csr()`):
+ * - Deletions (symmetric graphs): the destination of a deleted tree edge
+ *   (`d[v] == d[u] + 1`) keeps its distance if another neighbor is one level
+ *   up (its support). Unsupported vertices are invalidated, and their
+ *   children (neighbors one level down) checked in turn, until no vertex
+ *   loses its support. The invalidated vertices are then repaired from their
+ *   valid neighbors.
+ * - Insertions: the reached sources of the inserted edges relax them.
+ * Both propagate with a label-correcting search (a distance may be lowered
+ * more than once), a vertex is queued again whenever its distance drops.
+ * Deletions on a directed graph (the in-neighbors are not stored) search
+ * the whole graph again, see `run()`.
+ *
+ * @par Example
+ * \code
+ * bfs::incremental_t<vertex_t, edge_t, weight_t> bfs(D, source, distances);
+ * bfs.run();
+ * bfs.update(inserts, deletes);
+ * \endcode
+ */
+template <typename vertex_t, typename edge_t, typename weight_t>
+struct incremental_t {
+  using csr_type =
+      format::dynamic_csr_t<memory_space_t::device, vertex_t, edge_t, weight_t>;
+  using batch_type = format::edge_batch_t<vertex_t, weight_t>;
+  using frontier_type = frontier_t<vertex_t>;
+
+  /**
+   * @param _D dynamic graph (device), updated by `update()`.
+   * @param _single_source source vertex.
+   * @param _distances output (device), `n` entries, `-1` if unreached.
+   * @param _symmetric the graph (and every batch) holds both directions of
+   * every edge.
+   * @param _multi_context context (optional, default: GPU 0).
+   */
+  incremental_t(csr_type& _D,
+                vertex_t _single_source,
+                vertex_t* _distances,
+                bool _symmetric = true,
+                std::shared_ptr<cuda::multi_context_t> _multi_context = nullptr)
+      : D(_D),
+        single_source(_single_source),
+        distances(_distances),
+        symmetric(_symmetric),
+        multi_context(_multi_context),
+        epoch(0),
+        previous(_D.number_of_rows),
+        stamps(_D.number_of_rows, -1),
+        segments(_D.number_of_rows) {
+    if (!multi_context)
+      multi_context =
+          std::shared_ptr<cuda::multi_context_t>(new cuda::multi_context_t(0));
+    input = &frontiers[0];
+    output = &frontiers[1];
+  }
+
+  /**
+   * @brief Breadth-First Search of the whole (current) graph.
+   * @return float elapsed time (ms).
+   */
+  float run() {
+    auto G = graph::build::from_dynamic_csr<memory_space_t::device>(D);
+    return bfs::run(G, single_source, distances, (vertex_t*)nullptr,
+                    multi_context);
+  }
+
+  /**
+   * @brief Delete, then insert, batches of edges and update the distances.
+   *
+   * @param inserts edges to insert (device).
+   * @param deletes edges to delete (device).
+   * @return float elapsed time (ms).
+   */
+  float update(batch_type const& inserts, batch_type const& deletes) {
+    if (deletes.size > 0 && !symmetric) {
+      D.delete_edges(deletes);
+      D.insert_edges(inserts);
+      return run();
+    }
+
+    auto context = multi_context->get_context(0);
+    auto policy = context->execution_policy();
+    auto& timer = context->timer();
+    timer.begin();
+
+    auto d = distances;
+    auto keep = [] __device__(vertex_t const& v) -> bool { return true; };
+
+    // Destinations of the deleted tree edges.
+    input->set_number_of_elements(0);
+    if (deletes.size > 0) {
+      auto src = deletes.sources;
+      auto dst = deletes.destinations;
+      input->reserve(deletes.size);
+      auto end = thrust::copy_if(
+          policy, dst, dst + deletes.size,
+          thrust::make_counting_iterator<std::size_t>(0), input->data(),
+          [=] __device__(std::size_t const& i) {
+            vertex_t level = d[src[i]];
+            return level != -1 && d[dst[i]] == level + 1;
+          });
+      input->set_number_of_elements(end - input->data());
+      D.delete_edges(deletes);
+    }
+
+    // Invalidate the vertices that lost their support.
+    affected.set_number_of_elements(0);
+    if (!input->is_empty()) {
+      auto G = graph::build::from_dynamic_csr<memory_space_t::device>(D);
+      operators::filter::execute<operators::filter_algorithm_t::compact>(
+          G, keep, input, output, *context);
+      std::swap(input, output);
+
+      auto levels = previous.data().get();
+      auto marks = stamps.data().get();
+      while (!input->is_empty()) {
+        int round = ++epoch;
+        auto f = input->data();
+        std::size_t size = input->get_number_of_elements();
+        thrust::for_each(
+            policy, thrust::make_counting_iterator<std::size_t>(0),
+            thrust::make_counting_iterator<std::size_t>(size),
+            [=] __device__(std::size_t const& i) {
+              vertex_t v = f[i];
+              vertex_t level = d[v];
+              if (level <= 0)  // unreached, invalidated or the source.
+                return;
+              edge_t e = G.get_starting_edge(v);
+              edge_t end = e + G.get_number_of_neighbors(v);
+              for (; e < end; ++e)
+                if (d[G.get_destination_vertex(e)] == level - 1)
+                  return;
+              levels[v] = level;
+              d[v] = -1;
+              marks[v] = round;
+            });
+
+        std::size_t count = affected.get_number_of_elements();
+        affected.reserve(count + size);
+        auto last =
+            thrust::copy_if(policy, f, f + size, affected.data() + count,
+                            [=] __device__(vertex_t const& v) {
+                              return marks[v] == round;
+                            });
+        affected.set_number_of_elements(last - affected.data());
+
+        // Children of the invalidated vertices.
+        auto children = [=] __device__(vertex_t const& source,
+                                       vertex_t const& neighbor,
+                                       edge_t const& edge,
+                                       weight_t const& weight) -> bool {
+          return marks[source] == round && d[neighbor] == levels[source] + 1;
+        };
+        operators::advance_filter::step(G, children, keep, input, output,
+                                        segments, *context);
+      }
+    }
+
+    D.insert_edges(inserts);
+    auto G = graph::build::from_dynamic_csr<memory_space_t::device>(D);
+
+    // Seeds, the valid neighbors of the invalidated vertices and the reached
+    // sources of the insertions.
+    auto reached = [=] __device__(vertex_t const& source,
+                                  vertex_t const& neighbor, edge_t const& edge,
+                                  weight_t const& weight) -> bool {
+      return d[neighbor] != -1;
+    };
+    output->set_number_of_elements(0);
+    if (!affected.is_empty())
+      operators::advance::execute<operators::load_balance_t::block_mapped,
+                                  operators::advance_direction_t::forward,
+                                  operators::advance_io_type_t::vertices,
+                                  operators::advance_io_type_t::vertices>(
+          G, reached, &affected, output, segments, *context);
+
+    if (inserts.size > 0) {
+      std::size_t count = output->get_number_of_elements();
+      output->reserve(count + inserts.size);
+      auto last = thrust::copy_if(
+          policy, inserts.sources, inserts.sources + inserts.size,
+          output->data() + count,
+          [=] __device__(vertex_t const& v) { return d[v] != -1; });
+      output->set_number_of_elements(last - output->data());
+    }
+
+    operators::filter::execute<operators::filter_algorithm_t::compact>(
+        G, keep, output, input, *context);
+
+    // Label-correcting propagation.
+    auto relax = [=] __device__(vertex_t const& source,
+                                vertex_t const& neighbor, edge_t const& edge,
+                                weight_t const& weight) -> bool {
+      vertex_t level = d[source] + 1;
+      vertex_t current = d[neighbor];
+      while (current == -1 || level < current) {
+        vertex_t old = math::atomic::cas(&d[neighbor], current, level);
+        if (old == current)
+          return true;
+        current = old;
+      }
+      return false;
+    };
+    while (!input->is_empty())
+      operators::advance_filter::step(G, relax, keep, input, output, segments,
+                                      *context);
+
+    return timer.end();
+  }
+
+  csr_type& D;
+  vertex_t single_source;
+  vertex_t* distances;
+  bool symmetric;
+  std::shared_ptr<cuda::multi_context_t> multi_context;
+
+  int epoch;  // current invalidation round.
+  vector_t<vertex_t, memory_space_t::device> previous;  // invalidated at.
+  vector_t<int, memory_space_t::device> stamps;  // round of invalidation.
+  vector_t<edge_t, memory_space_t::device> segments;
+  frontier_type frontiers[2];
+  frontier_type affected;  // invalidated vertices.
+  frontier_type* input;
+  frontier_type* output;
+};
+
 }  // namespace bfs
 }  // namespace gunrock
\ No newline at end of file
@@ -94,55 +94,61 @@ struct enactor_t : gunrock::enactor_t<problem_t> {
     auto randoms = P->randoms.data().get();
     auto iteration = E->iteration;
 
-    auto color_me_in = [G, colors, randoms, iteration] __host__ __device__(
-                           vertex_t const& vertex) -> bool {
-      edge_t start_edge = G.get_starting_edge(vertex);
-      edge_t num_neighbors = G.get_number_of_neighbors(vertex);
-
-      bool colormax = true;
-      bool colormin = true;
-
-      // Color two nodes at the same time.
-      int color = iteration * 2;
-
-      // Main loop that goes over all the neighbors and finds the maximum or
-      // minimum random number vertex.
-      for (edge_t e = start_edge; e < start_edge + num_neighbors; ++e) {
-        vertex_t u = G.get_destination_vertex(e);
-
-        if (gunrock::util::limits::is_valid(colors[u]) &&
-                (colors[u] != color + 1) && (colors[u] != color + 2) ||
-            (vertex == u))
-          continue;
-        if (randoms[vertex] <= randoms[u])
-          colormax = false;
-        if (randoms[vertex] >= randoms[u])
-          colormin = false;
-      }
-
-      // Color if the node has the maximum OR minimum random number, this way,
-      // per iteration we can possibly fill 2 colors at the same time.
-      if (colormax) {
+    auto f = this->get_input_frontier();
+
+    // Color two nodes at the same time.
+    int color = iteration * 2;
+
+    // Per neighbor, whether the vertex can still be the maximum (bit 0) or
+    // the minimum (bit 1) random number vertex; reduced over all the
+    // neighbors (warp-cooperatively) with a bitwise and.
+    auto compare = [colors, randoms, color] __host__ __device__(
+                       vertex_t const& vertex, vertex_t const& u,
+                       edge_t const& edge, weight_t const& weight) -> int {
+      if (gunrock::util::limits::is_valid(colors[u]) &&
+              (colors[u] != color + 1) && (colors[u] != color + 2) ||
+          (vertex == u))
+        return 3;
+      int colormax = randoms[vertex] > randoms[u];
+      int colormin = randoms[vertex] < randoms[u];
+      return colormax | (colormin << 1);
+    };
+
+    auto both = [] __host__ __device__(int const& a, int const& b) -> int {
+      return a & b;
+    };
+
+    // Color if the node has the maximum OR minimum random number, this way,
+    // per iteration we can possibly fill 2 colors at the same time.
+    auto color_me_in = [colors, color] __host__ __device__(
+                           vertex_t const& vertex, int const& extrema) {
+      if (extrema & 1)
         colors[vertex] = color + 1;
-        return false;  // remove (colored).
-      } else if (colormin) {
+      else if (extrema & 2)
         colors[vertex] = color + 2;
-        return false;  // remove (colored).
-      } else {
-        return true;  // keep (not colored).
-      }
+    };
+
+    operators::neighbors_reduce::execute<
+        operators::load_balance_t::warp_mapped>(G, f, compare, both, 3,
+                                                color_me_in, context);
+
+    auto uncolored = [colors] __host__ __device__(
+                         vertex_t const& vertex) -> bool {
+      return !gunrock::util::limits::is_valid(colors[vertex]);
     };
 
     // Execute filter operator on the provided lambda.
     operators::filter::execute<operators::filter_algorithm_t::compact>(
-        G, E, color_me_in, context);
+        G, E, uncolored, context);
   }
   // </user-defined>
 };  // struct enactor_t
 
 template <typename graph_t>
 float run(graph_t& G,
-          typename graph_t::vertex_type* colors  // Output
+          typename graph_t::vertex_type* colors,  // Output
+          std::shared_ptr<cuda::multi_context_t> multi_context =
+              nullptr  // Context (optional, default: GPU 0)
 ) {
   // <user-defined>
   using vertex_t = typename graph_t::vertex_type;
@@ -155,8 +161,9 @@ float run(graph_t& G,
   // </user-defined>
 
   // <boiler-plate>
-  auto multi_context =
-      std::shared_ptr<cuda::multi_context_t>(new cuda::multi_context_t(0));
+  if (!multi_context)
+    multi_context =
+        std::shared_ptr<cuda::multi_context_t>(new cuda::multi_context_t(0));
 
   using problem_type = problem_t<graph_t, param_type, result_type>;
   using enactor_type = enactor_t<problem_type>;
@@ -37,35 +37,11 @@ __device__ __host__ __forceinline__ float degrees(float a) {
 }
 
 /**
- * @brief Compute the mean of all latitudues and longitudes in a given set.
+ * @brief Whether both the latitude and the longitude are valid.
  */
-template <typename graph_t, typename vertex_t = typename graph_t::vertex_type>
-__device__ __host__ coordinates_t mean(graph_t const& G,
-                                       coordinates_t const* coordinates,
-                                       std::size_t const& length,
-                                       vertex_t const& v) {
-  // Calculate mean;
-  float a = 0;
-  float b = 0;
-
-  auto start_edge = G.get_starting_edge(v);
-  auto num_neighbors = G.get_number_of_neighbors(v);
-
-  for (auto e = start_edge; e < start_edge + num_neighbors; e++) {
-    vertex_t u = G.get_destination_vertex(e);
-    if (gunrock::util::limits::is_valid(coordinates[u].latitude) &&
-        gunrock::util::limits::is_valid(coordinates[u].longitude)) {
-      // Accumulate the valid latitude and longitude values
-      a += coordinates[u].latitude;
-      b += coordinates[u].longitude;
-    }
-  }
-
-  a /= length;
-  b /= length;
-
-  // mean latitude and longitude
-  return {a, b};
+__device__ __host__ __forceinline__ bool is_located(coordinates_t const& p) {
+  return gunrock::util::limits::is_valid(p.latitude) &&
+         gunrock::util::limits::is_valid(p.longitude);
 }
 
 /**
@@ -125,7 +101,61 @@ __device__ __host__ float haversine(coordinates_t n,
 }
 
 /**
- * @brief Compute spatial median of a set of > 2 points.
+ * @brief Located neighbors of a vertex: their number, the sum of their
+ * coordinates (for the mean) and two of them (valid up to `count`).
+ */
+struct neighborhood_t {
+  int count;
+  coordinates_t sum;
+  coordinates_t first;
+  coordinates_t second;
+};
+
+/**
+ * @brief Union of two sets of located neighbors (`neighborhood_t{}` is the
+ * empty set).
+ */
+struct neighborhood_op_t {
+  __device__ __host__ __forceinline__ neighborhood_t
+  operator()(neighborhood_t const& a, neighborhood_t const& b) const {
+    neighborhood_t c;
+    c.count = a.count + b.count;
+    c.sum.latitude = a.sum.latitude + b.sum.latitude;
+    c.sum.longitude = a.sum.longitude + b.sum.longitude;
+    c.first = (a.count > 0) ? a.first : b.first;
+    c.second = (a.count > 1) ? a.second : (a.count == 1) ? b.first : b.second;
+    return c;
+  }
+};
+
+/**
+ * @brief Sums over the located neighbors of a vertex for one iteration of the
+ * spatial median, given the current estimate `y`: the number of neighbors
+ * (`length`) and of those at a nonzero distance of `y` (`nonzeros`), the sum
+ * of the inverse distances to `y` (`weights`) and the sum of the coordinates
+ * weighted by the inverse distances (`weighted`).
+ */
+struct weiszfeld_t {
+  int length;
+  int nonzeros;
+  float weights;
+  coordinates_t weighted;
+};
+
+struct weiszfeld_op_t {
+  __device__ __host__ __forceinline__ weiszfeld_t
+  operator()(weiszfeld_t const& a, weiszfeld_t const& b) const {
+    return {a.length + b.length,
+            a.nonzeros + b.nonzeros,
+            a.weights + b.weights,
+            {a.weighted.latitude + b.weighted.latitude,
+             a.weighted.longitude + b.weighted.longitude}};
+  }
+};
+
+/**
+ * @brief One (Weiszfeld) iteration of the spatial median of a set of > 2
+ * points, from the sums over the set at the current estimate `y`.
  *
  *        Spatial Median;
  *        That is, given a set X find the point m s.t.
@@ -133,106 +163,47 @@ __device__ __host__ float haversine(coordinates_t n,
  *
  *        is minimized. This is a robust estimator of
  *        the mode of the set.
+ *
+ * @return true if converged, `y` is then the spatial median, otherwise `y` is
+ * the next estimate.
  */
-template <typename graph_t, typename vertex_t = typename graph_t::vertex_type>
-__device__ __host__ void spatial_median(graph_t& G,
-                                        std::size_t length,
-                                        coordinates_t* coordinates,
-                                        vertex_t v,
-                                        float* Dinv,
-                                        int max_iter = 1000,
-                                        float eps = 1e-3) {
-  float r, rinv;
-  float Dinvs = 0;
-
-  std::size_t iter_ = 0;
-  std::size_t nonzeros = 0;
-  std::size_t num_zeros = 0;
-
-  // Can be done cleaner, but storing lat and long.
-  coordinates_t R, tmp, T;
-  coordinates_t y, y1;
-
-  auto start_edge = G.get_starting_edge(v);
-  auto num_neighbors = G.get_number_of_neighbors(v);
-
-  // Calculate mean of all <latitude, longitude>
-  // for all possible locations of v;
-  y = mean(G, coordinates, length, v);
-
-  // Calculate the spatial median;
-  while (true) {
-    iter_ += 1;
-    Dinvs = 0;
-    T.latitude = 0;
-    T.longitude = 0;  // T.lat = 0, T.lon = 0;
-    nonzeros = 0;
-
-    for (auto e = start_edge; e < start_edge + num_neighbors; e++) {
-      vertex_t u = G.get_destination_vertex(e);
-      if (gunrock::util::limits::is_valid(coordinates[u].latitude) &&
-          gunrock::util::limits::is_valid(coordinates[u].longitude)) {
-        // Get the haversine distance between the latitude and longitude of
-        // valid neighbor
-        auto Dist = haversine(coordinates[u], y);
-        Dinv[e] = Dist == 0 ? 0 : 1 / Dist;
-        nonzeros = Dist != 0 ? nonzeros + 1 : nonzeros;
-        Dinvs += Dinv[e];
-      }
-    }
-
-    std::size_t len = 0;
-    for (auto e = start_edge; e < start_edge + num_neighbors; e++) {
-      // W[] array, Dinv[e] / Dinvs
-      vertex_t u = G.get_destination_vertex(e);
-      if (gunrock::util::limits::is_valid(coordinates[u].latitude) &&
-          gunrock::util::limits::is_valid(coordinates[u].longitude)) {
-        T.latitude += (Dinv[e] / Dinvs) * coordinates[u].latitude;
-        T.longitude += (Dinv[e] / Dinvs) * coordinates[u].longitude;
-        len++;
-      }
-    }
-
-    num_zeros = len - nonzeros;
-    if (num_zeros == 0) {
-      y1.latitude = T.latitude;
-      y1.longitude = T.longitude;
-    }
-
-    else if (num_zeros == len) {
-      // Valid location found
-      coordinates[v].latitude = y.latitude;
-      coordinates[v].longitude = y.longitude;
-      return;
-    }
-
-    else {
-      R.latitude = (T.latitude - y.latitude) * Dinvs;
-      R.longitude = (T.longitude - y.longitude) * Dinvs;
-      r = sqrt(R.latitude * R.latitude + R.longitude * R.longitude);
-      rinv = r == 0 ?: num_zeros / r;
-
-      y1.latitude = max(0.0f, 1 - rinv) * T.latitude +
-                    min(1.0f, rinv) * y.latitude;  // latitude
-      y1.longitude = max(0.0f, 1 - rinv) * T.longitude +
-                     min(1.0f, rinv) * y.longitude;  // longitude
-    }
-
-    tmp.latitude = y.latitude - y1.latitude;
-    tmp.longitude = y.longitude - y1.longitude;
+__device__ __host__ __forceinline__ bool spatial_median_step(
+    weiszfeld_t const& s,
+    coordinates_t& y,
+    float eps = 1e-3) {
+  int num_zeros = s.length - s.nonzeros;
+
+  // Valid location found
+  if (num_zeros == s.length)
+    return true;
+
+  // W[] array, Dinv[e] / Dinvs
+  coordinates_t T, y1;
+  T.latitude = s.weighted.latitude / s.weights;
+  T.longitude = s.weighted.longitude / s.weights;
+
+  if (num_zeros == 0) {
+    y1 = T;
+  } else {
+    coordinates_t R;
+    R.latitude = (T.latitude - y.latitude) * s.weights;
+    R.longitude = (T.longitude - y.longitude) * s.weights;
+    float r = sqrt(R.latitude * R.latitude + R.longitude * R.longitude);
+    float rinv = (r == 0) ? 1 : num_zeros / r;
+
+    y1.latitude = max(0.0f, 1 - rinv) * T.latitude +
+                  min(1.0f, rinv) * y.latitude;  // latitude
+    y1.longitude = max(0.0f, 1 - rinv) * T.longitude +
+                   min(1.0f, rinv) * y.longitude;  // longitude
+  }
 
-    if ((sqrt(tmp.latitude * tmp.latitude + tmp.longitude * tmp.longitude)) <
-            eps ||
-        (iter_ > max_iter)) {
-      // Valid location found
-      coordinates[v].latitude = y1.latitude;
-      coordinates[v].longitude = y1.longitude;
-      return;
-    }
+  coordinates_t tmp;
+  tmp.latitude = y.latitude - y1.latitude;
+  tmp.longitude = y.longitude - y1.longitude;
 
-    y.latitude = y1.latitude;
-    y.longitude = y1.longitude;
-  }  // -> spatial_median while() loop
+  y = y1;
+  return sqrt(tmp.latitude * tmp.latitude + tmp.longitude * tmp.longitude) <
+         eps;
 }
 
 struct param_t {
@@ -257,7 +228,9 @@ struct problem_t : gunrock::problem_t<graph_t> {
   using edge_t = typename graph_t::edge_type;
   using weight_t = typename graph_t::weight_type;
 
-  thrust::device_vector<float> inv_haversine_distance;
+  thrust::device_vector<coordinates_t> centers;  // of the iteration.
+  thrust::device_vector<int> lengths;  // located neighbors, while iterating.
+  frontier_t<vertex_t> medians[2];     // vertices iterating a spatial median.
 
   problem_t(graph_t& G,
             param_type& _param,
@@ -269,12 +242,13 @@ struct problem_t : gunrock::problem_t<graph_t> {
 
   void init() override {
     auto g = this->get_graph();
-    auto n_edges = g.get_number_of_edges();
-    inv_haversine_distance.resize(n_edges);
+    auto n_vertices = g.get_number_of_vertices();
+    centers.resize(n_vertices);
+    lengths.resize(n_vertices);
   }
 
   void reset() override {
-    /// @todo reset the coordinates and inv_haversine_distance arrays.
+    /// @todo reset the coordinates array.
   }
 };
 
@@ -294,15 +268,14 @@ struct enactor_t : gunrock::enactor_t<problem_t> {
 
   void loop(cuda::multi_context_t& context) override {
     // Data slice
-    auto E = this->get_enactor();
     auto P = this->get_problem();
     auto G = P->get_graph();
-    auto f = this->get_input_frontier();
-    auto f_data = f->data();
+    auto context0 = context.get_context(0);
 
     auto coordinates = P->result.coordinates;
     auto spatial_iterations = P->param.spatial_iterations;
-    auto inv_haversine_distance = P->inv_haversine_distance.data().get();
+    auto centers = P->centers.data().get();
+    auto lengths = P->lengths.data().get();
 
     /**
      * @brief Compute "center" of a set of points.
@@ -311,78 +284,113 @@ struct enactor_t : gunrock::enactor_t<problem_t> {
      *        if points == 1; center = point;
      *        if points == 2; center = midpoint;
      *        if points > 2; center = spatial median;
+     *
+     * The centers of an iteration are computed from the locations of the
+     * previous one; the located neighbors of the vertices without a
+     * predicted location are reduced warp-cooperatively.
      */
-    auto spatial_center_op = [=] __device__(vertex_t const& v) -> void {
-      if (gunrock::util::limits::is_valid(coordinates[v].latitude) &&
-          gunrock::util::limits::is_valid(coordinates[v].longitude))
-        return;
-
-      // if no predicted location, and neighbor locations exists
-      // Custom spatial center median calculation for geolocation
-      // start median calculation -->
-      auto start_edge = G.get_starting_edge(v);
-      auto num_neighbors = G.get_number_of_neighbors(v);
-
-      auto valid_neighbors = 0;
-      coordinates_t neighbors[2];  // for length <=2 use registers
-
-      for (auto e = start_edge; e < start_edge + num_neighbors; e++) {
-        auto u = G.get_destination_vertex(e);
-        if (gunrock::util::limits::is_valid(coordinates[u].latitude) &&
-            gunrock::util::limits::is_valid(coordinates[u].longitude)) {
-          neighbors[valid_neighbors % 2].latitude =
-              coordinates[u].latitude;  // last valid latitude
-          neighbors[valid_neighbors % 2].longitude =
-              coordinates[u].longitude;  // last valid longitude
-          valid_neighbors++;
-        }
-      }
+    auto locate = [coordinates] __host__ __device__(
+                      vertex_t const& v, vertex_t const& u, edge_t const& e,
+                      weight_t const& w) -> neighborhood_t {
+      if (is_located(coordinates[v]) || !is_located(coordinates[u]))
+        return neighborhood_t{};
+      return {1, coordinates[u], coordinates[u], coordinates[u]};
+    };
 
-      // If one location found, point at that location
-      if (valid_neighbors == 1) {
-        coordinates_t only_neighbor;
-        if (gunrock::util::limits::is_valid(neighbors[0].latitude) &&
-            gunrock::util::limits::is_valid(neighbors[0].longitude)) {
-          only_neighbor.latitude = neighbors[0].latitude;
-          only_neighbor.longitude = neighbors[0].longitude;
-        } else {
-          only_neighbor.latitude = neighbors[1].latitude;
-          only_neighbor.longitude = neighbors[1].longitude;
+    auto center = [coordinates, centers, lengths] __host__ __device__(
+                      vertex_t const& v, neighborhood_t const& neighbors) {
+      auto invalid = gunrock::numeric_limits<float>::invalid();
+      coordinates_t c = {invalid, invalid};
+      int length = 0;
+      if (!is_located(coordinates[v])) {
+        // If one location found, point at that location
+        if (neighbors.count == 1)
+          c = neighbors.first;
+
+        // If two locations found, compute a midpoint
+        else if (neighbors.count == 2)
+          c = midpoint(neighbors.first, neighbors.second, v);
+
+        // if locations more than 2, compute the spatial median, starting from
+        // the mean of all <latitude, longitude>.
+        else if (neighbors.count > 2) {
+          c.latitude = neighbors.sum.latitude / neighbors.count;
+          c.longitude = neighbors.sum.longitude / neighbors.count;
+          length = neighbors.count;
         }
-        coordinates[v].latitude = only_neighbor.latitude;
-        coordinates[v].longitude = only_neighbor.longitude;
-        return;
-      }
 
-      // If two locations found, compute a midpoint
-      else if (valid_neighbors == 2) {
-        coordinates[v] = midpoint(neighbors[0], neighbors[1], v);
-        return;
+        // if no valid locations are found, the center stays invalid.
       }
+      centers[v] = c;
+      lengths[v] = length;
+    };
 
-      // if locations more than 2, compute spatial median.
-      else if (valid_neighbors > 2) {
-        spatial_median(G, valid_neighbors, coordinates, v,
-                       inv_haversine_distance, spatial_iterations);
-      }
+    operators::neighbors_reduce::execute<
+        operators::load_balance_t::warp_mapped,
+        operators::advance_io_type_t::graph>(
+        G, (frontier_t<vertex_t>*)nullptr, locate, neighborhood_op_t{},
+        neighborhood_t{}, center, context);
 
-      // if no valid locations are found
-      else {
-        coordinates[v].latitude = gunrock::numeric_limits<float>::invalid();
-        coordinates[v].longitude = gunrock::numeric_limits<float>::invalid();
-      }
+    // Spatial medians, one iteration of all the remaining vertices at a time.
+    auto iterating = [lengths] __host__ __device__(vertex_t const& v) -> bool {
+      return lengths[v] > 2;
+    };
 
-      // <-- end median calculation.
+    auto distances = [coordinates, centers] __host__ __device__(
+                         vertex_t const& v, vertex_t const& u,
+                         edge_t const& e, weight_t const& w) -> weiszfeld_t {
+      if (!is_located(coordinates[u]))
+        return weiszfeld_t{};
+
+      // Get the haversine distance between the latitude and longitude of
+      // valid neighbor and the estimate.
+      auto Dist = haversine(coordinates[u], centers[v]);
+      float Dinv = Dist == 0 ? 0 : 1 / Dist;
+      return {1,
+              Dist != 0,
+              Dinv,
+              {Dinv * coordinates[u].latitude,
+               Dinv * coordinates[u].longitude}};
+    };
+
+    auto active = &(P->medians[0]);
+    auto inactive = &(P->medians[1]);
+    inactive->sequence((vertex_t)0, G.get_number_of_vertices(),
+                       context0->stream());
+    operators::filter::execute<operators::filter_algorithm_t::compact>(
+        G, iterating, inactive, active, *context0, false);
+
+    for (unsigned int iteration = 1; !active->is_empty(); ++iteration) {
+      bool last = iteration > spatial_iterations;
+      auto iterate = [centers, lengths, last] __host__ __device__(
+                         vertex_t const& v, weiszfeld_t const& sums) {
+        coordinates_t y = centers[v];
+        bool converged = spatial_median_step(sums, y);
+        centers[v] = y;
+        if (converged || last)
+          lengths[v] = 0;  // Valid location found
+      };
+
+      operators::neighbors_reduce::execute<
+          operators::load_balance_t::warp_mapped>(
+          G, active, distances, weiszfeld_op_t{}, weiszfeld_t{}, iterate,
+          *context0);
+      operators::filter::execute<operators::filter_algorithm_t::compact>(
+          G, iterating, active, inactive, *context0, false);
+      std::swap(active, inactive);
+    }
+    context0->synchronize();
+
+    // Predicted locations of the iteration.
+    auto update = [coordinates, centers] __device__(vertex_t const& v) {
+      if (!is_located(coordinates[v]))
+        coordinates[v] = centers[v];
     };
 
-    /*!
-     * For each vertex, run the spatial center operation.
-     * @todo We can possibly do better with a filter operator instead.
-     */
     operators::parallel_for::execute<operators::parallel_for_each_t::vertex>(
-        G,                  // graph
-        spatial_center_op,  // lambda function
-        context             // context
+        G,       // graph
+        update,  // lambda function
+        context  // context
     );
   }
 
@@ -12,7 +12,16 @@
 #pragma once
 
 #include <gunrock/algorithms/algorithms.hxx>
-#include <thrust/logical.h>
+#include <thrust/copy.h>
+#include <thrust/functional.h>
+#include <thrust/transform_reduce.h>
+#include <thrust/for_each.h>
+#include <thrust/host_vector.h>
+
+#include <algorithm>
+#include <limits>
+#include <unordered_map>
+#include <vector>
 
 namespace gunrock {
 namespace kcore {
@@ -46,7 +55,12 @@ struct problem_t : gunrock::problem_t<graph_t> {
   // the user.
   thrust::device_vector<int> degrees;
   thrust::device_vector<bool> deleted;
-  thrust::device_vector<bool> to_be_deleted;
+
+  // Vertices not peeled yet (compacted after every level), and the level
+  // (minimum degree of those vertices) being peeled.
+  frontier_t<vertex_t> remaining[2];
+  int current;  // buffer of `remaining` holding the vertices.
+  int level;
 
   // `init` function, described above.  This should be called once, when `problem` gets instantiated.
   void init() {
@@ -56,10 +70,9 @@ struct problem_t : gunrock::problem_t<graph_t> {
     // Get number of vertices from the graph
     auto n_vertices = g.get_number_of_vertices();   
     
-    // Set the size of `degrees`, `deleted`, and `to_be_deleted` (`thrust` function)
+    // Set the size of `degrees` and `deleted` (`thrust` function)
     degrees.resize(n_vertices);
     deleted.resize(n_vertices);
-    to_be_deleted.resize(n_vertices);
   }
 
   // `reset` function, described above.  Should be called
@@ -71,7 +84,7 @@ struct problem_t : gunrock::problem_t<graph_t> {
     auto k_cores  = this->result.k_cores;
     auto n_vertices = g.get_number_of_vertices();
     
-    // set `k_cores`, `deleted`, and `to_be_deleted` to 0 for all vertices
+    // set `k_cores` and `deleted` to 0 for all vertices
     thrust::fill(
       thrust::device, 
       k_cores + 0, 
@@ -81,39 +94,41 @@ struct problem_t : gunrock::problem_t<graph_t> {
 
     thrust::fill(
       thrust::device, 
-      to_be_deleted.begin(), 
-      to_be_deleted.end(),
+      deleted.begin(), 
+      deleted.end(),
       0
     );
 
     //set initial `degrees` values to be vertices' actual degree
-    //will reduce these as vertices are removed from k-cores with increasing k value
+    //will reduce these as vertices are peeled, zero degree vertices are
+    //peeled by the first level (0)
     auto get_degree = [=] __device__(const int& i) -> int {
       return g.get_number_of_neighbors(i);
     };
 
-    thrust::transform(thrust::counting_iterator<vertex_t>(0),
-                      thrust::counting_iterator<vertex_t>(n_vertices),
-                      degrees.begin(), get_degree);
-
-    //mark zero degree vertices as deleted
-    auto degrees_data = degrees.data().get();
-    auto mark_zero_degrees = [=] __device__(const int& i) -> bool {
-      if ((degrees_data[i]) == 0) {
-        return true;
-      }
-      else {
-        return false;
-      }
-    };
-
     thrust::transform(thrust::device, thrust::counting_iterator<vertex_t>(0),
                       thrust::counting_iterator<vertex_t>(n_vertices),
-                      deleted.begin(), mark_zero_degrees);
+                      degrees.begin(), get_degree);
 
+    current = 0;
+    level = 0;
   }
 };
 
+/**
+ * @brief Bucketed peeling: every iteration peels one level `k`, the minimum
+ * degree of the remaining vertices (so the empty levels are skipped), until
+ * no vertex remains.
+ *
+ * @par Overview
+ * The bucket of level `k` (the input frontier) starts with the remaining
+ * vertices of degree <= `k`. Its vertices get the core number `k` and are
+ * deleted, an advance decrements the degrees of their remaining neighbors
+ * (warp-aggregated, see `math::atomic::aggregated_add`) and outputs exactly
+ * once those whose degree drops to `k`, the next bucket of the level; the
+ * level ends with an empty bucket. The remaining vertices are then compacted,
+ * the vertices are never all re-scanned.
+ */
 template <typename problem_t>
 struct enactor_t : gunrock::enactor_t<problem_t> {
   using gunrock::enactor_t<problem_t>::enactor_t;
@@ -123,133 +138,128 @@ struct enactor_t : gunrock::enactor_t<problem_t> {
   using weight_t = typename problem_t::weight_t;
 
   // How to initialize the frontier at the beginning of the application.
-  // In this case, we want all vertices in the initial frontier
+  // In this case, all vertices remain, the buckets are built per level.
   void prepare_frontier(frontier_t<vertex_t>* f, cuda::multi_context_t& context) override {
     // get pointer to the problem
     auto P = this->get_problem();   
     auto n_vertices = P->get_graph().get_number_of_vertices();
 
-    // Fill the frontier with a sequence of vertices from 0 -> n_vertices.
-    f->sequence((vertex_t)0, n_vertices, context.get_context(0)->stream());
+    // Fill the remaining vertices with a sequence from 0 -> n_vertices.
+    P->current = 0;
+    P->remaining[0].sequence((vertex_t)0, n_vertices,
+                             context.get_context(0)->stream());
+    f->set_number_of_elements(0);
   }
 
-  // One iteration of the application
+  // One level of the application
   void loop(cuda::multi_context_t& context) override {
 
     auto E = this->get_enactor();
     auto P = this->get_problem();
     auto G = P->get_graph();
+    auto context0 = context.get_context(0);
+    auto policy = context0->execution_policy();
 
     // Get parameters and data structures
     auto k_cores = P->result.k_cores;
     auto degrees = P->degrees.data().get();
     auto deleted = P->deleted.data().get();
-    auto to_be_deleted = P->to_be_deleted.data().get();
-    auto n_vertices = G.get_number_of_vertices();
-    auto f = this->get_input_frontier();
+    auto remaining = &(P->remaining[P->current]);
+    auto compacted = &(P->remaining[P->current ^ 1]);
+
+    // Current level, the minimum degree of the remaining vertices (at least
+    // one more than the previous level).
+    int k = thrust::transform_reduce(
+        policy, remaining->begin(), remaining->end(),
+        [degrees] __device__(vertex_t const& v) -> int { return degrees[v]; },
+        std::numeric_limits<int>::max(), thrust::minimum<int>());
+    P->level = k;
+
+    // First bucket, the remaining vertices of degree <= k.
+    auto in_bucket = [degrees, k] __host__ __device__(
+      vertex_t const& vertex
+    ) -> bool {
+      return degrees[vertex] <= k;
+    };
 
-    // Get current iteration of application
-    auto k = this->iteration + 1;
-    
-    // Mark vertices with degree <= k for deletion and output their neighbors
-    auto advance_op = [degrees, k_cores, k, deleted, to_be_deleted] __host__ __device__(
+    operators::filter::execute<operators::filter_algorithm_t::compact>(
+        G, in_bucket, remaining, E->get_input_frontier(), *context0, false);
+
+    // Reduce degrees of deleted vertices' neighbors, output the neighbors
+    // whose degree drops to k (exactly one decrement sees k + 1).
+    auto advance_op = [degrees, k, deleted] __host__ __device__(
       vertex_t const& source,    // source of edge
       vertex_t const& neighbor,  // destination of edge
       edge_t const& edge,        // id of edge
       weight_t const& weight     // weight of edge
     ) -> bool {
 
-      if (deleted[source] == true) {
+      if (deleted[neighbor] == true) {
         return false;
       }
 
-      if (degrees[source] > k) {
-        return false;
-      }
-
-      else{
-        k_cores[source] = k;
-        to_be_deleted[source] = true;
-        if (deleted[neighbor] == true) {
-            return false;
-        }
-        return true;
-      }
-
+      int old_degrees = math::atomic::aggregated_add(&degrees[neighbor], -1);
+      return old_degrees == (k + 1);
     };
 
-    // Reduce degrees of deleted vertices' neighbors
-    // Check updated degree against k
-    auto filter_op = [degrees, k_cores, k, deleted] __host__ __device__(
-      vertex_t const& vertex
-    ) -> bool {
-
-      if (deleted[vertex] == true) {
-        return false;
-      }
-
-      int old_degrees = math::atomic::add(&degrees[vertex], -1);
-
-      if (old_degrees != (k + 1)) {
-        return false;
-      }
-
-      else {
-        return true;
-      }
-
+    auto keep = [] __host__ __device__(vertex_t const& vertex) -> bool {
+      return true;  // invalid vertices are dropped by the filter.
     };
 
-    while(!f->is_empty()) {
+    auto f = this->get_input_frontier();
+    while (!f->is_empty()) {
+      //Peel the bucket, mark its vertices as deleted
+      thrust::for_each(policy, f->begin(), f->end(),
+                       [=] __device__(vertex_t const& v) {
+                         k_cores[v] = k;
+                         deleted[v] = true;
+                       });
 
       // Execute advance operator
-      //
-        operators::advance::execute<operators::load_balance_t::merge_path,
-                                    operators::advance_direction_t::forward,
-                                    operators::advance_io_type_t::vertices,
-                                    operators::advance_io_type_t::vertices>(
-		G, E, advance_op, context);
-
-      //Mark to-be-deleted vertices as deleted
-      auto mark_deleted = [=] __device__(const int& i) -> bool {
-        return deleted[i] | to_be_deleted[i];
-      };
+      operators::advance::execute<operators::load_balance_t::merge_path,
+                                  operators::advance_direction_t::forward,
+                                  operators::advance_io_type_t::vertices,
+                                  operators::advance_io_type_t::vertices>(
+          G, E, advance_op, context);
 
-      thrust::transform(thrust::device, thrust::counting_iterator<vertex_t>(0),
-                        thrust::counting_iterator<vertex_t>(n_vertices),
-                        P->deleted.begin(), mark_deleted);
-
-      // Execute filter operator
-      operators::filter::execute<operators::filter_algorithm_t::predicated>(
-          G, E, filter_op, context);
+      // Execute filter operator, the output has no duplicates.
+      operators::filter::execute<operators::filter_algorithm_t::compact>(
+          G, E, keep, context, false);
 
+      f = this->get_input_frontier();
     }
 
+    // Compact the remaining vertices.
+    auto is_remaining = [deleted] __host__ __device__(
+      vertex_t const& vertex
+    ) -> bool {
+      return !deleted[vertex];
+    };
+
+    operators::filter::execute<operators::filter_algorithm_t::compact>(
+        G, is_remaining, remaining, compacted, *context0, false);
+    P->current ^= 1;
   }
 
-  virtual bool is_converged(cuda::multi_context_t& context) {
+  virtual bool is_converged(cuda::multi_context_t& context) override {
     auto P = this->get_problem();
-    auto G = P->get_graph();
-    auto n_vertices = G.get_number_of_vertices();
-    auto f = this->get_input_frontier();
 
     //  Check if all vertices have been removed from graph
-    bool graph_empty = thrust::all_of(thrust::device, P->deleted.begin(), P->deleted.end(), thrust::identity<bool>());
+    bool graph_empty = P->remaining[P->current].is_empty();
 
     if (graph_empty) {
-      printf("degeneracy = %u\n", this->iteration);
+      printf("degeneracy = %d\n", P->level);
     }
 
-    // Fill the frontier with a sequence of vertices from 0 -> n_vertices.
-    f->sequence((vertex_t)0, n_vertices, context.get_context(0)->stream());
-
     return graph_empty;
   }
 };
 
 template <typename graph_t>
 float run(graph_t& G,
-          int* k_cores       // Output
+          int* k_cores,  // Output
+          std::shared_ptr<cuda::multi_context_t> multi_context =
+              nullptr  // Context (optional, default: GPU 0)
 ) {
   using vertex_t = typename graph_t::vertex_type;
   using weight_t = typename graph_t::weight_type;
@@ -261,8 +271,9 @@ float run(graph_t& G,
   result_type result(k_cores);
 
   // Context for application (eg, GPU + CUDA stream it will be executed on)
-  auto multi_context =
-      std::shared_ptr<cuda::multi_context_t>(new cuda::multi_context_t(0));
+  if (!multi_context)
+    multi_context =
+        std::shared_ptr<cuda::multi_context_t>(new cuda::multi_context_t(0));
 
   // instantiate `problem` and `enactor` templates.
   using problem_type = problem_t<graph_t, result_type>;
@@ -278,5 +289,340 @@ float run(graph_t& G,
   return enactor.enact();
 }
 
+/**
+ * @brief k-core decomposition of a dynamic (undirected) graph
+ * (`format::dynamic_csr_t`, both directions of every edge stored), kept
+ * up-to-date across batches of edge insertions and deletions; only the
+ * vertices whose core number may change are visited.
+ *
+ * @par Overview
+ * A batch holds every (undirected) edge once, `update()` adds or removes
+ * both of its directions:
+ * - Deletions only lower core numbers, the old ones are upper bounds. From
+ *   the endpoints of the deleted edges, a vertex lowers its core number to
+ *   the largest `h` (at most the old one) such that `h` of its neighbors have
+ *   a core number of at least `h`, and queues the neighbors it stopped
+ *   supporting. This converges to the new core numbers.
+ * - Insertions are split (on the host) into matchings, no two edges of a
+ *   matching share an endpoint, inserting a matching raises a core number by
+ *   at most one. The candidates are the vertices reached from the endpoint
+ *   with the smaller core number `K` of an inserted edge through vertices
+ *   of core number `K`. Candidates with at most `K` neighbors of a higher
+ *   core number or non-evicted candidates (of the same `K`) are evicted,
+ *   peeling the candidates; the remaining ones move to the `K + 1` core.
+ * Edge weights are ignored (inserted edges have a weight of 1).
+ */
+template <typename vertex_t, typename edge_t, typename weight_t>
+struct incremental_t {
+  using csr_type =
+      format::dynamic_csr_t<memory_space_t::device, vertex_t, edge_t, weight_t>;
+  using batch_type = format::edge_batch_t<vertex_t, weight_t>;
+  using frontier_type = frontier_t<vertex_t>;
+
+  /**
+   * @param _D dynamic (undirected) graph (device), updated by `update()`.
+   * @param _k_cores output (device), `n` core numbers.
+   * @param _multi_context context (optional, default: GPU 0).
+   */
+  incremental_t(csr_type& _D,
+                int* _k_cores,
+                std::shared_ptr<cuda::multi_context_t> _multi_context = nullptr)
+      : D(_D),
+        k_cores(_k_cores),
+        multi_context(_multi_context),
+        epoch(0),
+        previous(_D.number_of_rows),
+        degrees(_D.number_of_rows),
+        stamps(_D.number_of_rows, -1),
+        evicted(_D.number_of_rows, -1),
+        segments(_D.number_of_rows) {
+    if (!multi_context)
+      multi_context =
+          std::shared_ptr<cuda::multi_context_t>(new cuda::multi_context_t(0));
+    input = &frontiers[0];
+    output = &frontiers[1];
+  }
+
+  /**
+   * @brief k-core decomposition of the whole (current) graph.
+   * @return float elapsed time (ms).
+   */
+  float run() {
+    auto G = graph::build::from_dynamic_csr<memory_space_t::device>(D);
+    return kcore::run(G, k_cores, multi_context);
+  }
+
+  /**
+   * @brief Delete, then insert, batches of (undirected) edges and update the
+   * core numbers.
+   *
+   * @param inserts edges to insert (device), every edge once.
+   * @param deletes edges to delete (device), every edge once.
+   * @return float elapsed time (ms).
+   */
+  float update(batch_type const& inserts, batch_type const& deletes) {
+    auto context = multi_context->get_context(0);
+    auto& timer = context->timer();
+    timer.begin();
+
+    if (deletes.size > 0)
+      remove(deletes, *context);
+
+    if (inserts.size > 0) {
+      // Greedy matchings: an edge goes to the first matching after those of
+      // its endpoints' previous edges.
+      thrust::host_vector<vertex_t> sources(
+          thrust::device_pointer_cast(inserts.sources),
+          thrust::device_pointer_cast(inserts.sources) + inserts.size);
+      thrust::host_vector<vertex_t> destinations(
+          thrust::device_pointer_cast(inserts.destinations),
+          thrust::device_pointer_cast(inserts.destinations) + inserts.size);
+
+      std::unordered_map<vertex_t, std::size_t> next;
+      std::vector<thrust::host_vector<vertex_t>> matchings;
+      for (std::size_t i = 0; i < inserts.size; ++i) {
+        vertex_t u = sources[i];
+        vertex_t v = destinations[i];
+        std::size_t round = std::max(next[u], next[v]);
+        next[u] = next[v] = round + 1;
+        if (round == matchings.size())
+          matchings.emplace_back();
+        matchings[round].push_back(u);
+        matchings[round].push_back(v);
+      }
+
+      for (auto& matching : matchings)
+        insert(matching, *context);
+    }
+
+    return timer.end();
+  }
+
+  /**
+   * @brief Delete the edges of `deletes` (both directions) and lower the core
+   * numbers.
+   */
+  void remove(batch_type const& deletes, cuda::standard_context_t& context) {
+    auto policy = context.execution_policy();
+    std::size_t size = deletes.size;
+
+    // Both directions.
+    vector_t<vertex_t, memory_space_t::device> sources(2 * size);
+    vector_t<vertex_t, memory_space_t::device> destinations(2 * size);
+    thrust::copy_n(policy, deletes.sources, size, sources.begin());
+    thrust::copy_n(policy, deletes.destinations, size, sources.begin() + size);
+    thrust::copy_n(policy, deletes.destinations, size, destinations.begin());
+    thrust::copy_n(policy, deletes.sources, size,
+                   destinations.begin() + size);
+
+    batch_type batch;
+    batch.sources = sources.data().get();
+    batch.destinations = destinations.data().get();
+    batch.size = 2 * size;
+    D.delete_edges(batch);
+    auto G = graph::build::from_dynamic_csr<memory_space_t::device>(D);
+
+    // Endpoints of the deleted edges.
+    output->reserve(2 * size);
+    thrust::copy_n(policy, sources.begin(), 2 * size, output->data());
+    output->set_number_of_elements(2 * size);
+
+    auto keep = [] __device__(vertex_t const& v) -> bool { return true; };
+    operators::filter::execute<operators::filter_algorithm_t::compact>(
+        G, keep, output, input, context);
+
+    auto cores = k_cores;
+    auto bounds = previous.data().get();
+    auto marks = stamps.data().get();
+    while (!input->is_empty()) {
+      int round = ++epoch;
+      auto f = input->data();
+      thrust::for_each(
+          policy, thrust::make_counting_iterator<std::size_t>(0),
+          thrust::make_counting_iterator<std::size_t>(
+              input->get_number_of_elements()),
+          [=] __device__(std::size_t const& i) {
+            vertex_t v = f[i];
+            int k = cores[v];
+            int h = k;
+            edge_t begin = G.get_starting_edge(v);
+            edge_t end = begin + G.get_number_of_neighbors(v);
+            for (; h > 0; --h) {
+              int count = 0;
+              for (edge_t e = begin; e < end && count < h; ++e)
+                count += (cores[G.get_destination_vertex(e)] >= h);
+              if (count >= h)
+                break;
+            }
+            if (h < k) {
+              cores[v] = h;
+              bounds[v] = k;
+              marks[v] = round;
+            }
+          });
+
+      // Neighbors `v` stopped supporting.
+      auto unsupported = [=] __device__(vertex_t const& source,
+                                        vertex_t const& neighbor,
+                                        edge_t const& edge,
+                                        weight_t const& weight) -> bool {
+        int k = cores[neighbor];
+        return marks[source] == round && k > cores[source] &&
+               k <= bounds[source];
+      };
+      operators::advance_filter::step(G, unsupported, keep, input, output,
+                                      segments, context);
+    }
+  }
+
+  /**
+   * @brief Insert a matching (host, pairs of endpoints, both directions) and
+   * raise the core numbers.
+   */
+  void insert(thrust::host_vector<vertex_t> const& matching,
+              cuda::standard_context_t& context) {
+    auto policy = context.execution_policy();
+    std::size_t size = matching.size() / 2;
+
+    thrust::host_vector<vertex_t> h_sources(2 * size);
+    thrust::host_vector<vertex_t> h_destinations(2 * size);
+    for (std::size_t i = 0; i < size; ++i) {
+      h_sources[i] = h_destinations[size + i] = matching[2 * i];
+      h_destinations[i] = h_sources[size + i] = matching[2 * i + 1];
+    }
+    vector_t<vertex_t, memory_space_t::device> sources(h_sources);
+    vector_t<vertex_t, memory_space_t::device> destinations(h_destinations);
+
+    batch_type batch;
+    batch.sources = sources.data().get();
+    batch.destinations = destinations.data().get();
+    batch.size = 2 * size;
+    D.insert_edges(batch);
+    auto G = graph::build::from_dynamic_csr<memory_space_t::device>(D);
+
+    int round = ++epoch;
+    auto cores = k_cores;
+    auto marks = stamps.data().get();
+    auto gone = evicted.data().get();
+    auto counts = degrees.data().get();
+    auto src = batch.sources;
+    auto dst = batch.destinations;
+
+    // Roots, the endpoint(s) with the smaller core number.
+    output->reserve(2 * size);
+    auto roots = output->data();
+    thrust::for_each(policy, thrust::make_counting_iterator<std::size_t>(0),
+                     thrust::make_counting_iterator<std::size_t>(size),
+                     [=] __device__(std::size_t const& i) {
+                       vertex_t u = src[i];
+                       vertex_t v = dst[i];
+                       auto invalid =
+                           gunrock::numeric_limits<vertex_t>::invalid();
+                       roots[2 * i] = cores[u] <= cores[v] ? u : invalid;
+                       roots[2 * i + 1] = cores[v] <= cores[u] ? v : invalid;
+                     });
+    output->set_number_of_elements(2 * size);
+
+    auto keep = [] __device__(vertex_t const& v) -> bool { return true; };
+    operators::filter::execute<operators::filter_algorithm_t::compact>(
+        G, keep, output, input, context);
+
+    auto f = input->data();
+    thrust::for_each(policy, f, f + input->get_number_of_elements(),
+                     [=] __device__(vertex_t const& v) { marks[v] = round; });
+
+    // Candidates, reached through vertices of the same core number.
+    candidates.set_number_of_elements(0);
+    auto grow = [=] __device__(vertex_t const& source,
+                               vertex_t const& neighbor, edge_t const& edge,
+                               weight_t const& weight) -> bool {
+      if (cores[neighbor] != cores[source])
+        return false;
+      int old = marks[neighbor];
+      if (old == round)
+        return false;
+      return math::atomic::cas(&marks[neighbor], old, round) == old;
+    };
+    while (!input->is_empty()) {
+      append(candidates, *input);
+      operators::advance_filter::step(G, grow, keep, input, output, segments,
+                                      context);
+    }
+
+    // Peel the candidates that cannot be in the next core.
+    auto c = candidates.data();
+    std::size_t number_of_candidates = candidates.get_number_of_elements();
+    auto supports = [=] __device__(vertex_t const& v, vertex_t const& w,
+                                   edge_t const& edge,
+                                   weight_t const& weight) -> int {
+      int k = cores[v];
+      return (cores[w] > k || (cores[w] == k && marks[w] == round));
+    };
+    auto sum = [] __device__(int const& a, int const& b) { return a + b; };
+    auto peel = [=] __device__(vertex_t const& v, int const& count) {
+      counts[v] = count;
+      if (count <= cores[v])
+        gone[v] = round;
+    };
+    operators::neighbors_reduce::execute<
+        operators::load_balance_t::warp_mapped>(G, &candidates, supports, sum,
+                                                0, peel, context);
+
+    input->reserve(number_of_candidates);
+    auto last = thrust::copy_if(
+        policy, c, c + number_of_candidates, input->data(),
+        [=] __device__(vertex_t const& v) { return gone[v] == round; });
+    input->set_number_of_elements(last - input->data());
+
+    auto evict = [=] __device__(vertex_t const& source,
+                                vertex_t const& neighbor, edge_t const& edge,
+                                weight_t const& weight) -> bool {
+      int k = cores[neighbor];
+      if (marks[neighbor] != round || gone[neighbor] == round ||
+          k != cores[source])
+        return false;
+      if (math::atomic::add(&counts[neighbor], -1) != k + 1)
+        return false;
+      gone[neighbor] = round;
+      return true;
+    };
+    while (!input->is_empty())
+      operators::advance_filter::step(G, evict, keep, input, output, segments,
+                                      context);
+
+    thrust::for_each(policy, c, c + number_of_candidates,
+                     [=] __device__(vertex_t const& v) {
+                       if (gone[v] != round)
+                         cores[v] += 1;
+                     });
+  }
+
+  /**
+   * @brief Append the elements of `from` to `to`.
+   */
+  void append(frontier_type& to, frontier_type& from) {
+    std::size_t count = to.get_number_of_elements();
+    std::size_t size = from.get_number_of_elements();
+    to.reserve(count + size);
+    thrust::copy_n(thrust::device, from.data(), size, to.data() + count);
+    to.set_number_of_elements(count + size);
+  }
+
+  csr_type& D;
+  int* k_cores;
+  std::shared_ptr<cuda::multi_context_t> multi_context;
+
+  int epoch;  // current round.
+  vector_t<int, memory_space_t::device> previous;  // upper bounds.
+  vector_t<int, memory_space_t::device> degrees;   // of the candidates.
+  vector_t<int, memory_space_t::device> stamps;    // round of a candidate.
+  vector_t<int, memory_space_t::device> evicted;   // round of an eviction.
+  vector_t<edge_t, memory_space_t::device> segments;
+  frontier_type frontiers[2];
+  frontier_type candidates;
+  frontier_type* input;
+  frontier_type* output;
+};
+
 }  // namespace kcore
 }  // namespace gunrock
@@ -12,6 +12,8 @@
 
 #include <gunrock/algorithms/algorithms.hxx>
 
+#include <type_traits>
+
 namespace gunrock {
 namespace ppr {
 
@@ -24,8 +26,12 @@ struct param_t {
       : seed(_seed), alpha(_alpha), epsilon(_epsilon) {}
 };
 
-template <typename weight_t>
+/**
+ * @brief Output ranks (`weight_t`), the residuals are stored as `rank_t`.
+ */
+template <typename weight_t, typename rank_t = weight_t>
 struct result_t {
+  using rank_type = rank_t;
   weight_t* p;
   result_t(weight_t* _p) : p(_p) {}
 };
@@ -46,9 +52,10 @@ struct problem_t : gunrock::problem_t<graph_t> {
   using vertex_t = typename graph_t::vertex_type;
   using edge_t = typename graph_t::edge_type;
   using weight_t = typename graph_t::weight_type;
+  using rank_t = typename result_type::rank_type;
 
-  thrust::device_vector<weight_t> r;
-  thrust::device_vector<weight_t> r_prime;
+  thrust::device_vector<rank_t> r;          // residuals pushed this iteration
+  thrust::device_vector<weight_t> r_prime;  // accumulated (atomics)
 
   weight_t _2a1a;
   weight_t _1a1a;
@@ -77,10 +84,10 @@ struct problem_t : gunrock::problem_t<graph_t> {
     auto d_r_prime = thrust::device_pointer_cast(r_prime.data());
 
     thrust::fill(policy, d_p + 0, d_p + n_vertices, 0);
-    thrust::fill(policy, d_r + 0, d_r + n_vertices, 0);
+    thrust::fill(policy, d_r + 0, d_r + n_vertices, rank_t(weight_t(0)));
     thrust::fill(policy, d_r_prime + 0, d_r_prime + n_vertices, 0);
 
-    thrust::fill(policy, d_r + seed, d_r + seed + 1, 1);
+    thrust::fill(policy, d_r + seed, d_r + seed + 1, rank_t(weight_t(1)));
     thrust::fill(policy, d_r_prime + seed, d_r_prime + seed + 1, 1);
   }
 };
@@ -94,11 +101,13 @@ struct enactor_t : gunrock::enactor_t<problem_t> {
   using vertex_t = typename problem_t::vertex_t;
   using edge_t = typename problem_t::edge_t;
   using weight_t = typename problem_t::weight_t;
+  using rank_t = typename problem_t::rank_t;
 
   void prepare_frontier(frontier_t<vertex_t>* f,
                         cuda::multi_context_t& context) override {
     auto P = this->get_problem();
-    f->push_back(P->param.seed);
+    f->push_back(P->param.seed,
+                context.get_context(0)->stream());
   }
 
   void loop(cuda::multi_context_t& context) override {
@@ -108,7 +117,7 @@ struct enactor_t : gunrock::enactor_t<problem_t> {
     auto G = P->get_graph();
 
     weight_t* p = P->result.p;
-    weight_t* r = P->r.data().get();
+    rank_t* r = P->r.data().get();
     weight_t* r_prime = P->r_prime.data().get();
 
     auto n_vertices = G.get_number_of_vertices();
@@ -118,7 +127,7 @@ struct enactor_t : gunrock::enactor_t<problem_t> {
 
     auto filter_op = [p, r, r_prime, _2a1a] __host__ __device__(
                          vertex_t const& vertex) -> bool {
-      p[vertex] += _2a1a * r[vertex];
+      p[vertex] += _2a1a * weight_t(r[vertex]);
       r_prime[vertex] = 0;
       return true;
     };
@@ -129,7 +138,8 @@ struct enactor_t : gunrock::enactor_t<problem_t> {
     auto advance_op = [G, r, r_prime, _1a1a, epsilon] __host__ __device__(
                           vertex_t const& src, vertex_t const& dst,
                           edge_t const& edge, weight_t const& weight) -> bool {
-      auto update = _1a1a * r[src] / (weight_t)G.get_number_of_neighbors(src);
+      weight_t update =
+          _1a1a * weight_t(r[src]) / (weight_t)G.get_number_of_neighbors(src);
       auto oldval = math::atomic::add(r_prime + dst, update);
       auto newval = oldval + update;
       auto thresh = (weight_t)G.get_number_of_neighbors(dst) * epsilon;
@@ -141,31 +151,46 @@ struct enactor_t : gunrock::enactor_t<problem_t> {
         G, E, advance_op, context);
 
     auto policy = this->context->get_context(0)->execution_policy();
-    thrust::copy_n(policy, r_prime, n_vertices, r);
+    thrust::transform(policy, r_prime, r_prime + n_vertices, r,
+                      [] __device__(weight_t const& x) { return rank_t(x); });
   }
 
 };  // struct enactor_t
 
-template <typename graph_t>
+/**
+ * @brief Personalized PageRank of `seed` into `p`.
+ *
+ * @tparam rank_t storage type of the residuals read by the push, e.g.
+ * `__nv_bfloat16` (accumulated in `weight_t`); `__half` is not recommended,
+ * residuals around `epsilon` underflow its range.
+ */
+template <typename rank_t = void, typename graph_t>
 float run(graph_t& G,
           typename graph_t::vertex_type& seed,
           typename graph_t::weight_type* p,
           typename graph_t::weight_type& alpha,
-          typename graph_t::weight_type& epsilon) {
+          typename graph_t::weight_type& epsilon,
+          std::shared_ptr<cuda::multi_context_t> multi_context =
+              nullptr  // Context (optional, default: GPU 0)
+) {
   // <user-defined>
   using vertex_t = typename graph_t::vertex_type;
   using weight_t = typename graph_t::weight_type;
 
+  using storage_t =
+      std::conditional_t<std::is_void_v<rank_t>, weight_t, rank_t>;
+
   using param_type = param_t<vertex_t, weight_t>;
-  using result_type = result_t<weight_t>;
+  using result_type = result_t<weight_t, storage_t>;
 
   param_type param(seed, alpha, epsilon);
   result_type result(p);
   // </user-defined>
 
   // <boiler-plate>
-  auto multi_context =
-      std::shared_ptr<cuda::multi_context_t>(new cuda::multi_context_t(0));
+  if (!multi_context)
+    multi_context =
+        std::shared_ptr<cuda::multi_context_t>(new cuda::multi_context_t(0));
 
   using problem_type = problem_t<graph_t, param_type, result_type>;
   using enactor_type = enactor_t<problem_type>;
@@ -179,35 +204,110 @@ float run(graph_t& G,
   // </boiler-plate>
 }
 
-template <typename graph_t>
+/**
+ * @brief Personalized PageRank of seeds `0 ... n_seeds - 1`, the seeds are
+ * processed in batches of 32 or 64 (one bit per seed in a `mask_t`), and
+ * every push iteration of a batch scans the edges of its active vertices
+ * once for all the seeds they are active in. The ranks of seed `i` are
+ * written to `p + i * n`.
+ *
+ * @tparam mask_t `std::uint32_t` or `std::uint64_t` (default), width of a
+ * batch.
+ */
+template <typename mask_t = std::uint64_t, typename graph_t>
 float run_batch(graph_t& G,
                 typename graph_t::vertex_type& n_seeds,
                 typename graph_t::weight_type* p,
                 typename graph_t::weight_type& alpha,
                 typename graph_t::weight_type& epsilon) {
-  // <user-defined>
   using vertex_t = typename graph_t::vertex_type;
+  using edge_t = typename graph_t::edge_type;
   using weight_t = typename graph_t::weight_type;
+  namespace multi_source = operators::batch::multi_source;
 
-  auto n_vertices = G.get_number_of_vertices();
-
-  // ???: Is this a good way to time wall-clock time?
   auto multi_context =
       std::shared_ptr<cuda::multi_context_t>(new cuda::multi_context_t(0));
   auto context = multi_context->get_context(0);
-  auto timer = context->timer();
+  auto policy = context->execution_policy();
+
+  std::size_t n = G.get_number_of_vertices();
+
+  // Vertices rejoin the frontier whenever their residual crosses the
+  // threshold again.
+  multi_source::state_t<vertex_t, mask_t> state(n, false);
+
+  // Per-lane residuals, lane `l` at `l * n`.
+  vector_t<weight_t, memory_space_t::device> r(state.lanes * n);
+  vector_t<weight_t, memory_space_t::device> r_prime(state.lanes * n);
+  auto d_r = r.data().get();
+  auto d_r_prime = r_prime.data().get();
+
+  weight_t _2a1a = (2 * alpha) / (1 + alpha);
+  weight_t _1a1a = ((1 - alpha) / (1 + alpha));
+
+  auto& timer = context->timer();
   timer.begin();
 
-  auto f = [&](vertex_t seed) -> float {
-    return ppr::run(G, seed, p + (n_vertices * seed), alpha, epsilon);
-  };
+  thrust::host_vector<vertex_t> seeds(n_seeds);
+  thrust::sequence(seeds.begin(), seeds.end(), vertex_t(0));
+
+  for (std::size_t first = 0; first < seeds.size(); first += state.lanes) {
+    int count =
+        (int)std::min<std::size_t>(state.lanes, seeds.size() - first);
+    auto batch = p + first * n;
+
+    thrust::fill(policy, thrust::device_pointer_cast(batch),
+                 thrust::device_pointer_cast(batch) + count * n, weight_t(0));
+    thrust::fill(policy, r.begin(), r.end(), weight_t(0));
+    thrust::fill(policy, r_prime.begin(), r_prime.end(), weight_t(0));
+
+    state.reset(seeds.data() + first, count, *context);
+    multi_source::for_each_active(
+        state,
+        [=] __device__(vertex_t const& v, mask_t const& lanes) {
+          multi_source::for_each_lane(lanes, [&](int lane) {
+            d_r[lane * n + v] = 1;
+            d_r_prime[lane * n + v] = 1;
+          });
+        },
+        *context);
+
+    auto advance_op = [=] __device__(vertex_t const& src, vertex_t const& dst,
+                                     edge_t const& edge,
+                                     weight_t const& weight,
+                                     mask_t const& lanes) -> mask_t {
+      mask_t crossed = 0;
+      auto src_degree = (weight_t)G.get_number_of_neighbors(src);
+      auto thresh = (weight_t)G.get_number_of_neighbors(dst) * epsilon;
+      multi_source::for_each_lane(lanes, [&](int lane) {
+        auto update = _1a1a * d_r[lane * n + src] / src_degree;
+        auto oldval = math::atomic::add(d_r_prime + lane * n + dst, update);
+        auto newval = oldval + update;
+        if ((oldval < thresh) && (newval >= thresh))
+          crossed |= mask_t(1) << lane;
+      });
+      return crossed;
+    };
 
-  thrust::host_vector<float> total_elapsed(1);
-  operators::batch::execute(f, n_seeds, total_elapsed.data());
+    while (!state.is_empty()) {
+      multi_source::for_each_active(
+          state,
+          [=] __device__(vertex_t const& v, mask_t const& lanes) {
+            multi_source::for_each_lane(lanes, [&](int lane) {
+              batch[lane * n + v] += _2a1a * d_r[lane * n + v];
+              d_r_prime[lane * n + v] = 0;
+            });
+          },
+          *context);
+
+      multi_source::advance<operators::load_balance_t::block_mapped>(
+          G, state, advance_op, *context);
+      multi_source::commit(state, *context);
+      thrust::copy_n(policy, d_r_prime, count * n, d_r);
+    }
+  }
 
-  // return total_elapsed[0]; // This returns the total execution time, not the
-  // wall-clock time.  Weird.
-  return timer.end();  // Is this a better way to time?
+  return timer.end();
 }
 
 }  // namespace ppr
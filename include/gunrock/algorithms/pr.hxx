@@ -13,6 +13,15 @@
 #include <gunrock/algorithms/algorithms.hxx>
 #include <thrust/iterator/counting_iterator.h>
 #include <thrust/inner_product.h>
+#include <thrust/count.h>
+#include <thrust/pair.h>
+#include <thrust/copy.h>
+#include <thrust/for_each.h>
+
+#include <cuda_fp16.h>
+
+#include <limits>
+#include <type_traits>
 
 namespace gunrock {
 namespace pr {
@@ -25,12 +34,82 @@ struct param_t {
   param_t(weight_t _alpha, weight_t _tol) : alpha(_alpha), tol(_tol) {}
 };
 
-template <typename weight_t>
+/**
+ * @brief Output ranks (`weight_t`), stored as `rank_t` during the iterations.
+ */
+template <typename weight_t, typename rank_t = weight_t>
 struct result_t {
+  using rank_type = rank_t;
   weight_t* p;
   result_t(weight_t* _p) : p(_p) {}
 };
 
+/**
+ * @brief Storage of the ranks as `rank_t` (e.g., `__half` or
+ * `__nv_bfloat16`), the arithmetic stays in `weight_t`. Narrow ranks are
+ * stored scaled by the number of vertices (around 1 on average instead of
+ * 1 / n), within the normal range of `__half`; with `rank_t == weight_t`
+ * they are stored as is.
+ *
+ * @par Range
+ * A rank is at most 1 (the ranks sum to 1), so the scale is capped at the
+ * largest finite `rank_t` (65504 for `__half`): no stored rank overflows,
+ * whatever the skew of the graph, and stores saturate to that largest value
+ * (rounding). Past 65504 vertices, a `__half` scale no longer brings the
+ * average rank to 1, and the smallest ranks, about (1 - alpha) / n, fall
+ * below its normal range (6.1e-5 once scaled) at about 1.6e8 vertices
+ * (alpha = 0.85) and lose precision: use `__nv_bfloat16` (the range of
+ * `float`) for such graphs.
+ */
+template <typename weight_t, typename rank_t>
+struct ranks_t {
+  static constexpr bool narrow = !std::is_same_v<weight_t, rank_t>;
+
+  /**
+   * @brief Largest finite `rank_t`, `__nv_bfloat16` has the range of
+   * `float`.
+   */
+  static constexpr weight_t get_largest() {
+    if constexpr (std::is_same_v<rank_t, __half>)
+      return weight_t(65504);
+    else if constexpr (std::is_arithmetic_v<rank_t>)
+      return weight_t(std::numeric_limits<rank_t>::max());
+    else
+      return weight_t(std::numeric_limits<float>::max());
+  }
+
+  static constexpr weight_t largest = get_largest();
+
+  weight_t scale;
+
+  /**
+   * @brief Ranks of a graph of `n` vertices, the scale is `n` capped at
+   * `largest` (see Range).
+   */
+  __host__ __device__ static ranks_t for_vertices(weight_t n) {
+    if constexpr (narrow)
+      return {n < largest ? n : largest};
+    else
+      return {weight_t(1)};
+  }
+
+  __host__ __device__ __forceinline__ rank_t store(weight_t r) const {
+    if constexpr (narrow) {
+      weight_t scaled = r * scale;
+      return rank_t(scaled < largest ? scaled : largest);
+    } else {
+      return r;
+    }
+  }
+
+  __host__ __device__ __forceinline__ weight_t load(rank_t r) const {
+    if constexpr (narrow)
+      return static_cast<weight_t>(r) / scale;
+    else
+      return r;
+  }
+};
+
 template <typename graph_t, typename param_type, typename result_type>
 struct problem_t : gunrock::problem_t<graph_t> {
   param_type param;
@@ -47,18 +126,66 @@ struct problem_t : gunrock::problem_t<graph_t> {
   using vertex_t = typename graph_t::vertex_type;
   using edge_t = typename graph_t::edge_type;
   using weight_t = typename graph_t::weight_type;
+  using rank_t = typename result_type::rank_type;
+  using ranks_type = ranks_t<weight_t, rank_t>;
 
-  thrust::device_vector<weight_t>
-      plast;  // pagerank values from previous iteration
-  thrust::device_vector<weight_t>
+  vertex_array_t<rank_t> plast;  // pagerank values from previous iteration
+  thrust::device_vector<rank_t>
+      pnext;  // (pull, narrow ranks) stands in for `p` during the iterations
+  vertex_array_t<weight_t>
       iweights;  // alpha * 1 / (sum of outgoing weights) -- used to determine
                  // out of mass spread from src to dst
 
+  /*!
+   * With both CSR and CSC views, PageRank pulls the rank of the in-neighbors
+   * of every vertex (CSC) through a merge-path SpMV, no atomics are used and
+   * the results are deterministic. Otherwise, rank is pushed along the
+   * outgoing edges (CSR) with atomics.
+   */
+  static constexpr bool pull =
+      graph_t::template contains_representation<
+          typename graph_t::graph_csr_view_t>() &&
+      graph_t::template contains_representation<
+          typename graph_t::graph_csc_view_t>();
+
+  /*!
+   * Ranks the enactor works on: `result.p`, or when pushing on multiple GPUs
+   * the striped `staged_p`, copied to `result.p` once converged
+   * (`finalize()`). The pull SpMV runs on the first GPU.
+   */
+  weight_t* p = nullptr;
+  vertex_array_t<weight_t> staged_p;
+
+  weight_t dangling;  // (pull) alpha * sum of the dangling vertices' ranks.
+  weight_t error;     // (pull) max |p - plast| of the last iteration.
+
+  ranks_type ranks() {
+    return ranks_type::for_vertices(
+        (weight_t)this->get_graph().get_number_of_vertices());
+  }
+
+  /**
+   * @brief (pull) Ranks buffer `i` of the two the iterations alternate
+   * between, the first is `p` itself unless the ranks are narrow.
+   */
+  rank_t* buffer(int i) {
+    if (i == 1)
+      return plast.data();
+    if constexpr (ranks_type::narrow)
+      return pnext.data().get();
+    else
+      return p;
+  }
+
   void init() override {
     auto g = this->get_graph();
     auto n_vertices = g.get_number_of_vertices();
-    plast.resize(n_vertices);
-    iweights.resize(n_vertices);
+    plast.allocate(n_vertices, *(this->context));
+    if constexpr (pull && ranks_type::narrow)
+      pnext.resize(n_vertices);
+    iweights.allocate(n_vertices, *(this->context));
+    if (!pull && this->context->size() > 1)
+      staged_p.allocate(n_vertices, *(this->context));
   }
 
   void reset() override {
@@ -70,17 +197,30 @@ struct problem_t : gunrock::problem_t<graph_t> {
     auto n_vertices = g.get_number_of_vertices();
     auto alpha = this->param.alpha;
 
-    thrust::fill_n(policy, this->result.p, n_vertices, 1.0 / n_vertices);
+    p = staged_p.is_striped() ? staged_p.data() : this->result.p;
+    thrust::fill_n(policy, p, n_vertices, 1.0 / n_vertices);
+    if constexpr (pull && ranks_type::narrow)
+      thrust::fill_n(policy, pnext.begin(), n_vertices,
+                     ranks().store((weight_t)1.0 / n_vertices));
 
-    thrust::fill_n(policy, plast.begin(), n_vertices, 0);
+    thrust::fill_n(policy, plast.data(), n_vertices, ranks().store(0));
 
+    using csr_view_t = typename graph_t::graph_csr_view_t;
     auto get_weight = [=] __device__(const int& i) -> weight_t {
       weight_t val = 0;
 
-      edge_t start = g.get_starting_edge(i);
-      edge_t end = start + g.get_number_of_neighbors(i);
-      for (edge_t offset = start; offset < end; offset++) {
-        val += g.get_edge_weight(offset);
+      if constexpr (pull) {
+        // Outgoing weights, not the default view's.
+        edge_t start = g.template get_starting_edge<csr_view_t>(i);
+        edge_t end = start + g.template get_number_of_neighbors<csr_view_t>(i);
+        for (edge_t offset = start; offset < end; offset++)
+          val += g.template get_edge_weight<csr_view_t>(offset);
+      } else {
+        edge_t start = g.get_starting_edge(i);
+        edge_t end = start + g.get_number_of_neighbors(i);
+        for (edge_t offset = start; offset < end; offset++) {
+          val += g.get_edge_weight(offset);
+        }
       }
 
       return val != 0 ? alpha / val : 0;
@@ -88,7 +228,21 @@ struct problem_t : gunrock::problem_t<graph_t> {
 
     thrust::transform(policy, thrust::counting_iterator<vertex_t>(0),
                       thrust::counting_iterator<vertex_t>(n_vertices),
-                      iweights.begin(), get_weight);
+                      iweights.data(), get_weight);
+
+    // The initial ranks are uniform, every dangling vertex holds 1 / n.
+    auto dangling_vertices = thrust::count(
+        policy, iweights.data(), iweights.data() + n_vertices, weight_t(0));
+    dangling = alpha * (weight_t)dangling_vertices / (weight_t)n_vertices;
+    error = 0;
+  }
+
+  void finalize() override {
+    if (!staged_p.is_striped())
+      return;
+    auto policy = this->get_single_context()->execution_policy();
+    thrust::copy(policy, p, p + staged_p.size(), this->result.p);
+    this->get_single_context()->synchronize();
   }
 };
 
@@ -101,25 +255,93 @@ struct enactor_t : gunrock::enactor_t<problem_t> {
   using vertex_t = typename problem_t::vertex_t;
   using edge_t = typename problem_t::edge_t;
   using weight_t = typename problem_t::weight_t;
+  using rank_t = typename problem_t::rank_t;
 
   void prepare_frontier(frontier_t<vertex_t>* f,
                         cuda::multi_context_t& context) override {}
 
   void loop(cuda::multi_context_t& context) override {
+    if constexpr (problem_t::pull)
+      pull(context);
+    else
+      push(context);
+  }
+
+  /**
+   * @brief One pull iteration, a single SpMV over the CSC view computes the
+   * new ranks, the error and the dangling mass of the next iteration. The
+   * ranks alternate between two buffers (see `problem_t::buffer()`) instead
+   * of being copied; narrow ranks halve the bytes of the gather.
+   */
+  void pull(cuda::multi_context_t& context) {
+    auto P = this->get_problem();
+    auto G = P->get_graph();
+    using csc_view_t = typename decltype(G)::graph_csc_view_t;
+
+    auto n_vertices = G.get_number_of_vertices();
+    auto alpha = P->param.alpha;
+    auto iweights = P->iweights.data();
+    auto R = P->ranks();
+
+    bool even = (this->iteration % 2 == 0);
+    rank_t* current = P->buffer(even ? 0 : 1);
+    rank_t* next = P->buffer(even ? 1 : 0);
+
+    auto offsets = G.csc_view_t::get_column_offsets();
+    auto sources = G.csc_view_t::get_row_indices();
+    auto weights = G.csc_view_t::get_nonzero_values();
+
+    auto contribution = [=] __device__(edge_t const& e) -> weight_t {
+      vertex_t u = sources[e];
+      return R.load(current[u]) * iweights[u] * weights[e];
+    };
+
+    using pair_t = thrust::pair<weight_t, weight_t>;  // (error, dangling)
+    weight_t base = (1 - alpha + P->dangling) / n_vertices;
+    auto update = [=] __device__(edge_t const& v, weight_t const& sum) {
+      weight_t rank = base + sum;
+      rank_t stored = R.store(rank);
+      next[v] = stored;
+      // The error of the stored ranks, which reach a fixed point.
+      return pair_t(abs(R.load(stored) - R.load(current[v])),
+                    iweights[v] == 0 ? alpha * rank : weight_t(0));
+    };
+
+    auto combine = [] __device__(pair_t const& a, pair_t const& b) {
+      return pair_t(a.first > b.first ? a.first : b.first,
+                    a.second + b.second);
+    };
+
+    auto result = operators::spmv::execute(
+        offsets, (edge_t)n_vertices, G.get_number_of_edges(), contribution,
+        update, pair_t(0, 0), combine, *(context.get_context(0)));
+
+    P->error = result.first;
+    P->dangling = result.second;
+  }
+
+  /**
+   * @brief One push iteration, rank is scattered along the outgoing edges
+   * with atomics. The ranks are accumulated in `p` (`weight_t`), `plast`
+   * holds the previous ones as `rank_t`.
+   */
+  void push(cuda::multi_context_t& context) {
     // Data slice
     auto E = this->get_enactor();
     auto P = this->get_problem();
     auto G = P->get_graph();
 
     auto n_vertices = G.get_number_of_vertices();
-    auto p = P->result.p;
-    auto plast = P->plast.data().get();
-    auto iweights = P->iweights.data().get();
+    auto p = P->p;
+    auto plast = P->plast.data();
+    auto iweights = P->iweights.data();
     auto alpha = P->param.alpha;
+    auto R = P->ranks();
 
     auto policy = this->context->get_context(0)->execution_policy();
 
-    thrust::copy_n(policy, p, n_vertices, plast);
+    thrust::transform(policy, p, p + n_vertices, plast,
+                      [=] __device__(weight_t const& r) { return R.store(r); });
 
     // >> handle "dangling nodes" (nodes w/ zero outdegree)
     // could skip this if no nodes have sero outdegree
@@ -139,10 +361,10 @@ struct enactor_t : gunrock::enactor_t<problem_t> {
     //   p, n_vertices, (1 - alpha) / n_vertices);
     // <<
 
-    auto spread_op = [p, plast, iweights] __host__ __device__(
+    auto spread_op = [p, plast, iweights, R] __host__ __device__(
                          vertex_t const& src, vertex_t const& dst,
                          edge_t const& edge, weight_t const& weight) -> bool {
-      weight_t update = plast[src] * iweights[src] * weight;
+      weight_t update = R.load(plast[src]) * iweights[src] * weight;
       math::atomic::add(p + dst, update);
       return false;
     };
@@ -159,15 +381,20 @@ struct enactor_t : gunrock::enactor_t<problem_t> {
       return false;
 
     auto P = this->get_problem();
+    if constexpr (problem_t::pull)
+      return P->error < P->param.tol;
+
     auto G = P->get_graph();
     auto tol = P->param.tol;
 
     auto n_vertices = G.get_number_of_vertices();
-    auto p = P->result.p;
-    auto plast = P->plast.data().get();
+    auto p = P->p;
+    auto plast = P->plast.data();
+    auto R = P->ranks();
 
+    // Compared as stored, narrow ranks differ from `p` by their precision.
     auto abs_diff = [=] __device__(const int& i) -> weight_t {
-      return abs(p[i] - plast[i]);
+      return abs(R.load(R.store(p[i])) - R.load(plast[i]));
     };
 
     auto policy = this->context->get_context(0)->execution_policy();
@@ -179,28 +406,59 @@ struct enactor_t : gunrock::enactor_t<problem_t> {
     return err < tol;
   }
 
+  void finalize(cuda::multi_context_t& context) override {
+    // Pull: the last ranks were written to `plast` after an odd number of
+    // iterations, narrow ranks are always in one of the buffers.
+    if constexpr (problem_t::pull) {
+      auto P = this->get_problem();
+      auto n_vertices = P->get_graph().get_number_of_vertices();
+      auto policy = context.get_context(0)->execution_policy();
+      rank_t* last = P->buffer(this->iteration % 2);
+      if constexpr (problem_t::ranks_type::narrow) {
+        auto R = P->ranks();
+        thrust::transform(
+            policy, last, last + n_vertices, P->result.p,
+            [=] __device__(rank_t const& r) { return R.load(r); });
+      } else if (this->iteration % 2 == 1) {
+        thrust::copy_n(policy, last, n_vertices, P->result.p);
+      }
+    }
+  }
+
 };  // struct enactor_t
 
-template <typename graph_t>
+/**
+ * @brief PageRank of `G` into `p`.
+ *
+ * @tparam rank_t storage type of the ranks during the iterations, e.g.
+ * `__half` or `__nv_bfloat16` (accumulated in `weight_t`); `tol` should not
+ * be finer than its precision.
+ */
+template <typename rank_t = void, typename graph_t>
 float run(graph_t& G,
           typename graph_t::weight_type alpha,
           typename graph_t::weight_type tol,
-          typename graph_t::weight_type* p  // Output
+          typename graph_t::weight_type* p,  // Output
+          std::shared_ptr<cuda::multi_context_t> multi_context =
+              nullptr  // Context (optional, default: GPU 0)
 ) {
   // <user-defined>
   using vertex_t = typename graph_t::vertex_type;
   using weight_t = typename graph_t::weight_type;
+  using storage_t =
+      std::conditional_t<std::is_void_v<rank_t>, weight_t, rank_t>;
 
   using param_type = param_t<weight_t>;
-  using result_type = result_t<weight_t>;
+  using result_type = result_t<weight_t, storage_t>;
 
   param_type param(alpha, tol);
   result_type result(p);
   // </user-defined>
 
   // <boiler-plate>
-  auto multi_context =
-      std::shared_ptr<cuda::multi_context_t>(new cuda::multi_context_t(0));
+  if (!multi_context)
+    multi_context =
+        std::shared_ptr<cuda::multi_context_t>(new cuda::multi_context_t(0));
 
   using problem_type = problem_t<graph_t, param_type, result_type>;
   using enactor_type = enactor_t<problem_type>;
@@ -218,5 +476,288 @@ float run(graph_t& G,
   // </boiler-plate>
 }
 
+/**
+ * @brief PageRank over a dynamic graph (`format::dynamic_csr_t`), kept
+ * up-to-date across batches of edge insertions and deletions by pushing the
+ * residual of the ranks, from the previous ranks, instead of iterating over
+ * the whole graph again.
+ *
+ * @par Overview
+ * The ranks `p` are the fixed point of `p = (1 - alpha) / n + A p`, where
+ * `A` spreads `alpha` of the rank of a vertex along its outgoing edges (in
+ * proportion to their weights) or, for a dangling vertex, uniformly over all
+ * the vertices. The residual `r = (1 - alpha) / n + A p - p` is computed once
+ * by `run()`; a batch only changes the columns of `A` of its sources, whose
+ * old contributions to `r` are retracted and new ones added (along their old
+ * and new edges). Every vertex with `|r| > tol` then pushes its residual:
+ * it is added to its rank and spread along its edges. The uniform residual
+ * of the dangling vertices is accumulated in one scalar, applied to all the
+ * vertices only once it exceeds `tol` (a full pass, seldom).
+ */
+template <typename vertex_t, typename edge_t, typename weight_t>
+struct incremental_t {
+  using csr_type =
+      format::dynamic_csr_t<memory_space_t::device, vertex_t, edge_t, weight_t>;
+  using batch_type = format::edge_batch_t<vertex_t, weight_t>;
+  using frontier_type = frontier_t<vertex_t>;
+
+  /**
+   * @param _D dynamic graph (device), updated by `update()`.
+   * @param _alpha damping factor.
+   * @param _tol tolerance, on the residual of every vertex.
+   * @param _p output (device), `n` ranks.
+   * @param _multi_context context (optional, default: GPU 0).
+   */
+  incremental_t(csr_type& _D,
+                weight_t _alpha,
+                weight_t _tol,
+                weight_t* _p,
+                std::shared_ptr<cuda::multi_context_t> _multi_context = nullptr)
+      : D(_D),
+        alpha(_alpha),
+        tol(_tol),
+        p(_p),
+        multi_context(_multi_context),
+        residuals(_D.number_of_rows),
+        iweights(_D.number_of_rows),
+        deltas(_D.number_of_rows),
+        uniform(1),
+        segments(_D.number_of_rows) {
+    if (!multi_context)
+      multi_context =
+          std::shared_ptr<cuda::multi_context_t>(new cuda::multi_context_t(0));
+    input = &frontiers[0];
+    output = &frontiers[1];
+  }
+
+  /**
+   * @brief PageRank of the whole (current) graph, and its residual.
+   * @return float elapsed time (ms).
+   */
+  float run() {
+    auto G = graph::build::from_dynamic_csr<memory_space_t::device>(D);
+    float elapsed = pr::run(G, alpha, tol, p, multi_context);
+
+    auto context = multi_context->get_context(0);
+    auto policy = context->execution_policy();
+    auto& timer = context->timer();
+    timer.begin();
+
+    auto n = (weight_t)G.get_number_of_vertices();
+    auto a = alpha;
+    auto ranks = p;
+    auto r = residuals.data().get();
+    auto iw = iweights.data().get();
+
+    thrust::for_each(policy, thrust::make_counting_iterator<vertex_t>(0),
+                     thrust::make_counting_iterator<vertex_t>(
+                         G.get_number_of_vertices()),
+                     [=] __device__(vertex_t const& v) {
+                       iw[v] = get_iweight(G, v, a);
+                       r[v] = (1 - a) / n - ranks[v];
+                     });
+
+    auto dangling = [=] __device__(vertex_t const& v) -> weight_t {
+      return iw[v] == 0 ? a * ranks[v] / n : 0;
+    };
+    uniform[0] = thrust::transform_reduce(
+        policy, thrust::make_counting_iterator<vertex_t>(0),
+        thrust::make_counting_iterator<vertex_t>(G.get_number_of_vertices()),
+        dangling, weight_t(0), thrust::plus<weight_t>());
+
+    auto spread = [=] __device__(vertex_t const& source,
+                                 vertex_t const& neighbor, edge_t const& edge,
+                                 weight_t const& weight) -> bool {
+      math::atomic::add(r + neighbor, ranks[source] * iw[source] * weight);
+      return false;
+    };
+    operators::advance::execute<operators::load_balance_t::block_mapped,
+                                operators::advance_direction_t::forward,
+                                operators::advance_io_type_t::graph,
+                                operators::advance_io_type_t::none>(
+        G, spread, input, output, segments, *context);
+
+    return elapsed + timer.end();
+  }
+
+  /**
+   * @brief Delete, then insert, batches of edges and update the ranks.
+   *
+   * @param inserts edges to insert (device).
+   * @param deletes edges to delete (device).
+   * @return float elapsed time (ms).
+   */
+  float update(batch_type const& inserts, batch_type const& deletes) {
+    auto context = multi_context->get_context(0);
+    auto policy = context->execution_policy();
+    auto& timer = context->timer();
+    timer.begin();
+
+    auto n = (weight_t)D.number_of_rows;
+    auto a = alpha;
+    auto epsilon = tol;
+    auto ranks = p;
+    auto r = residuals.data().get();
+    auto iw = iweights.data().get();
+    auto rho = uniform.data().get();
+
+    auto keep = [] __device__(vertex_t const& v) -> bool { return true; };
+    auto pending = [=] __device__(vertex_t const& v) -> bool {
+      return abs(r[v]) > epsilon;
+    };
+
+    // Sources of the batches, their columns of `A` change.
+    output->set_number_of_elements(0);
+    output->reserve(inserts.size + deletes.size);
+    thrust::copy_n(policy, inserts.sources, inserts.size, output->data());
+    thrust::copy_n(policy, deletes.sources, deletes.size,
+                   output->data() + inserts.size);
+    output->set_number_of_elements(inserts.size + deletes.size);
+
+    // Retract their old contributions.
+    {
+      auto G = graph::build::from_dynamic_csr<memory_space_t::device>(D);
+      operators::filter::execute<operators::filter_algorithm_t::compact>(
+          G, keep, output, &touched, *context);
+
+      auto retract = [=] __device__(vertex_t const& source,
+                                    vertex_t const& neighbor,
+                                    edge_t const& edge,
+                                    weight_t const& weight) -> bool {
+        math::atomic::add(r + neighbor, -ranks[source] * iw[source] * weight);
+        return false;
+      };
+      operators::advance::execute<operators::load_balance_t::block_mapped,
+                                  operators::advance_direction_t::forward,
+                                  operators::advance_io_type_t::vertices,
+                                  operators::advance_io_type_t::none>(
+          G, retract, &touched, output, segments, *context);
+    }
+
+    D.delete_edges(deletes);
+    D.insert_edges(inserts);
+    auto G = graph::build::from_dynamic_csr<memory_space_t::device>(D);
+
+    // Add the new ones, along the new edges.
+    auto t = touched.data();
+    thrust::for_each(
+        policy, thrust::make_counting_iterator<std::size_t>(0),
+        thrust::make_counting_iterator<std::size_t>(
+            touched.get_number_of_elements()),
+        [=] __device__(std::size_t const& i) {
+          vertex_t v = t[i];
+          weight_t weight = get_iweight(G, v, a);
+          weight_t change = (weight == 0 ? a * ranks[v] / n : 0) -
+                            (iw[v] == 0 ? a * ranks[v] / n : 0);
+          if (change != 0)
+            math::atomic::add(rho, change);
+          iw[v] = weight;
+        });
+
+    auto contribute = [=] __device__(vertex_t const& source,
+                                     vertex_t const& neighbor,
+                                     edge_t const& edge,
+                                     weight_t const& weight) -> bool {
+      math::atomic::add(r + neighbor, ranks[source] * iw[source] * weight);
+      return true;
+    };
+    operators::advance::execute<operators::load_balance_t::block_mapped,
+                                operators::advance_direction_t::forward,
+                                operators::advance_io_type_t::vertices,
+                                operators::advance_io_type_t::vertices>(
+        G, contribute, &touched, output, segments, *context);
+
+    // The old neighbors that are not neighbors anymore.
+    if (deletes.size > 0) {
+      std::size_t count = output->get_number_of_elements();
+      output->reserve(count + deletes.size);
+      thrust::copy_n(policy, deletes.destinations, deletes.size,
+                     output->data() + count);
+      output->set_number_of_elements(count + deletes.size);
+    }
+    operators::filter::execute<operators::filter_algorithm_t::compact>(
+        G, pending, output, input, *context);
+
+    // Push the residuals.
+    auto d = deltas.data().get();
+    auto push = [=] __device__(vertex_t const& source,
+                               vertex_t const& neighbor, edge_t const& edge,
+                               weight_t const& weight) -> bool {
+      math::atomic::add(r + neighbor, d[source] * iw[source] * weight);
+      return true;
+    };
+
+    while (true) {
+      while (!input->is_empty()) {
+        auto f = input->data();
+        thrust::for_each(
+            policy, thrust::make_counting_iterator<std::size_t>(0),
+            thrust::make_counting_iterator<std::size_t>(
+                input->get_number_of_elements()),
+            [=] __device__(std::size_t const& i) {
+              vertex_t v = f[i];
+              weight_t delta = r[v];
+              r[v] = 0;
+              ranks[v] += delta;
+              d[v] = delta;
+              if (iw[v] == 0)
+                math::atomic::add(rho, a * delta / n);
+            });
+        operators::advance_filter::step(G, push, pending, input, output,
+                                        segments, *context);
+      }
+
+      weight_t spread = uniform[0];
+      if (abs(spread) <= epsilon)
+        break;
+
+      // Apply the uniform residual (full pass).
+      uniform[0] = 0;
+      input->reserve(D.number_of_rows);
+      auto last = thrust::copy_if(
+          policy, thrust::make_counting_iterator<vertex_t>(0),
+          thrust::make_counting_iterator<vertex_t>(D.number_of_rows),
+          input->data(), [=] __device__(vertex_t const& v) {
+            r[v] += spread;
+            return abs(r[v]) > epsilon;
+          });
+      input->set_number_of_elements(last - input->data());
+    }
+
+    return timer.end();
+  }
+
+  /**
+   * @brief alpha / (sum of the outgoing weights of `v`), 0 if dangling.
+   */
+  template <typename graph_type>
+  __host__ __device__ static weight_t get_iweight(graph_type const& G,
+                                                  vertex_t const& v,
+                                                  weight_t const& alpha) {
+    weight_t sum = 0;
+    edge_t e = G.get_starting_edge(v);
+    edge_t end = e + G.get_number_of_neighbors(v);
+    for (; e < end; ++e)
+      sum += G.get_edge_weight(e);
+    return sum != 0 ? alpha / sum : 0;
+  }
+
+  csr_type& D;
+  weight_t alpha;
+  weight_t tol;
+  weight_t* p;
+  std::shared_ptr<cuda::multi_context_t> multi_context;
+
+  vector_t<weight_t, memory_space_t::device> residuals;
+  vector_t<weight_t, memory_space_t::device> iweights;  // see `problem_t`.
+  vector_t<weight_t, memory_space_t::device> deltas;    // pushed residuals.
+  vector_t<weight_t, memory_space_t::device> uniform;   // dangling residual.
+  vector_t<edge_t, memory_space_t::device> segments;
+  frontier_type frontiers[2];
+  frontier_type touched;  // sources of the last batches.
+  frontier_type* input;
+  frontier_type* output;
+};
+
 }  // namespace pr
 }  // namespace gunrock
\ No newline at end of file
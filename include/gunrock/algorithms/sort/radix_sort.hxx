@@ -50,6 +50,27 @@ void sort_keys(type_t* keys,
                  thrust::greater<type_t>());
 }
 
+// key-value pairs
+// Sorts (stably) the values along with their keys into ascending or
+// descending order of the keys. The values can be any random-access iterator
+// (e.g. a zip iterator to carry several arrays along).
+
+template <typename key_t, typename values_t>
+void sort_pairs(key_t* keys,
+                values_t values,
+                std::size_t num_items,
+                order_t order = order_t::ascending,
+                cuda::stream_t stream = 0) {
+  if (order == order_t::ascending)
+    thrust::stable_sort_by_key(thrust::cuda::par.on(stream), keys,
+                               keys + num_items, values,
+                               thrust::less<key_t>());
+  else
+    thrust::stable_sort_by_key(thrust::cuda::par.on(stream), keys,
+                               keys + num_items, values,
+                               thrust::greater<key_t>());
+}
+
 }  // namespace radix
 
 }  // namespace sort
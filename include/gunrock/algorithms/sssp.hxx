@@ -15,10 +15,12 @@
 namespace gunrock {
 namespace sssp {
 
-template <typename vertex_t>
+template <typename vertex_t, typename weight_t = float>
 struct param_t {
   vertex_t single_source;
-  param_t(vertex_t _single_source) : single_source(_single_source) {}
+  weight_t delta;  // bucket width, <= 0 selects one from the graph.
+  param_t(vertex_t _single_source, weight_t _delta = 0)
+      : single_source(_single_source), delta(_delta) {}
 };
 
 template <typename vertex_t, typename weight_t>
@@ -46,16 +48,61 @@ struct problem_t : gunrock::problem_t<graph_t> {
   using edge_t = typename graph_t::edge_type;
   using weight_t = typename graph_t::weight_type;
 
-  thrust::device_vector<vertex_t> visited;
+  /*!
+   * Distances the enactor works on: `result.distances`, or on multiple GPUs
+   * the striped `staged_distances`, copied to `result.distances` once
+   * converged (`finalize()`).
+   */
+  weight_t* distances = nullptr;
+  vertex_array_t<weight_t> staged_distances;
+
+  vertex_array_t<vertex_t> visited;
+
+  /*!
+   * Near-far piles of the delta-stepping scheduler, the near pile is the
+   * enactor's input frontier.
+   */
+  operators::advance::bucketing::near_far_t<vertex_t, weight_t> piles;
+
+  /*!
+   * Number of edges relaxed (advance operator calls) during the last run,
+   * counted on the device (`relaxed_counter`) and fetched once converged.
+   */
+  std::size_t edges_relaxed;
+  vector_t<std::size_t, memory_space_t::device> relaxed_counter;
 
   void init() override {
     auto g = this->get_graph();
     auto n_vertices = g.get_number_of_vertices();
-    visited.resize(n_vertices);
+    visited.allocate(n_vertices, *(this->context));
+    if (this->context->size() > 1)
+      staged_distances.allocate(n_vertices, *(this->context));
 
     // Execution policy for a given context (using single-gpu).
     auto policy = this->context->get_context(0)->execution_policy();
-    thrust::fill(policy, visited.begin(), visited.end(), -1);
+    thrust::fill(policy, visited.data(), visited.data() + n_vertices, -1);
+
+    // Bucket width heuristic: average edge weight scaled by warp size over
+    // the average degree, such that a bucket holds about a warp of edges per
+    // vertex.
+    if (this->param.delta <= 0) {
+      auto n_edges = g.get_number_of_edges();
+      weight_t total_weight = thrust::transform_reduce(
+          policy, thrust::make_counting_iterator<edge_t>(0),
+          thrust::make_counting_iterator<edge_t>(n_edges),
+          [g] __device__(edge_t const& e) -> weight_t {
+            return g.get_edge_weight(e);
+          },
+          (weight_t)0, thrust::plus<weight_t>());
+
+      weight_t average_weight = (n_edges > 0) ? total_weight / n_edges : 1;
+      weight_t average_degree =
+          (n_vertices > 0) ? (weight_t)n_edges / n_vertices : 1;
+      this->param.delta =
+          average_weight * 32 / std::max(average_degree, (weight_t)1);
+      if (this->param.delta <= 0)
+        this->param.delta = 1;
+    }
   }
 
   void reset() override {
@@ -65,15 +112,31 @@ struct problem_t : gunrock::problem_t<graph_t> {
     auto context = this->get_single_context();
     auto policy = context->execution_policy();
 
-    auto d_distances = thrust::device_pointer_cast(this->result.distances);
+    distances = staged_distances.is_striped() ? staged_distances.data()
+                                              : this->result.distances;
+    auto d_distances = thrust::device_pointer_cast(distances);
     thrust::fill(policy, d_distances + 0, d_distances + n_vertices,
                  std::numeric_limits<weight_t>::max());
 
     thrust::fill(policy, d_distances + this->param.single_source,
                  d_distances + this->param.single_source + 1, 0);
 
-    thrust::fill(policy, visited.begin(), visited.end(),
+    thrust::fill(policy, visited.data(), visited.data() + n_vertices,
                  -1);  // This does need to be reset in between runs though
+
+    piles.reset(n_vertices, this->param.delta, *context);
+    edges_relaxed = 0;
+    relaxed_counter.resize(1);
+    thrust::fill(policy, relaxed_counter.begin(), relaxed_counter.end(), 0);
+  }
+
+  void finalize() override {
+    if (!staged_distances.is_striped())
+      return;
+    auto policy = this->get_single_context()->execution_policy();
+    thrust::copy(policy, distances, distances + staged_distances.size(),
+                 this->result.distances);
+    this->get_single_context()->synchronize();
   }
 };
 
@@ -87,10 +150,70 @@ struct enactor_t : gunrock::enactor_t<problem_t> {
   using edge_t = typename problem_t::edge_t;
   using weight_t = typename problem_t::weight_t;
 
+  /*!
+   * Device-sized queues of the persistent traversal.
+   */
+  operators::advance::captured::queues_t<vertex_t> queues;
+
   void prepare_frontier(frontier_t<vertex_t>* f,
                         cuda::multi_context_t& context) override {
     auto P = this->get_problem();
-    f->push_back(P->param.single_source);
+    f->push_back(P->param.single_source,
+                context.get_context(0)->stream());
+    if (this->properties.persistent_iterations) {
+      // A vertex is queued at most once per iteration (see
+      // `loop_persistent()`), the queues do not grow.
+      auto n_vertices = P->get_graph().get_number_of_vertices();
+      this->frontiers[0].reserve(n_vertices);
+      this->frontiers[1].reserve(n_vertices);
+      queues.bind(this->frontiers[0], this->frontiers[1],
+                  *(context.get_context(0)));
+    }
+  }
+
+  bool is_persistent() override { return true; }
+
+  /**
+   * @brief Bellman-Ford in one persistent kernel, the vertices whose
+   * distance improved form the next frontier (the near-far piles are not
+   * used, `delta` is ignored). A vertex is claimed once per iteration
+   * through `visited`, which holds the last iteration that queued it.
+   */
+  void loop_persistent(cuda::standard_context_t& context) override {
+    auto P = this->get_problem();
+    auto G = P->get_graph();
+
+    auto distances = P->distances;
+    auto visited = P->visited.data();
+    auto iteration = queues.get_iteration();
+
+    auto shortest_path = [distances] __device__(
+                             vertex_t const& source,    // ... source
+                             vertex_t const& neighbor,  // neighbor
+                             edge_t const& edge,        // edge
+                             weight_t const& weight     // weight (tuple).
+                             ) -> bool {
+      weight_t distance_to_neighbor = distances[source] + weight;
+      weight_t recover_distance =
+          math::atomic::min(&(distances[neighbor]), distance_to_neighbor);
+      return (distance_to_neighbor < recover_distance);
+    };
+
+    auto claim = [G, visited, iteration] __device__(
+                     vertex_t const& vertex) -> bool {
+      if (G.get_number_of_neighbors(vertex) == 0)
+        return false;
+      vertex_t now = (vertex_t)(*iteration);
+      return math::atomic::max(&visited[vertex], now) < now;
+    };
+
+    operators::advance::persistent::execute(
+        G, shortest_path, claim, queues, context,
+        reinterpret_cast<operators::advance::persistent::size_type*>(
+            P->relaxed_counter.data().get()));
+
+    // The last iteration is the one with an empty output.
+    this->iteration = queues.get_number_of_iterations(context) + 1;
   }
 
   void loop(cuda::multi_context_t& context) override {
@@ -100,8 +223,8 @@ struct enactor_t : gunrock::enactor_t<problem_t> {
     auto G = P->get_graph();
 
     auto single_source = P->param.single_source;
-    auto distances = P->result.distances;
-    auto visited = P->visited.data().get();
+    auto distances = P->distances;
+    auto visited = P->visited.data();
 
     auto iteration = this->iteration;
 
@@ -121,22 +244,52 @@ struct enactor_t : gunrock::enactor_t<problem_t> {
       return (distance_to_neighbor < recover_distance);
     };
 
-    auto remove_completed_paths = [G, visited, iteration] __host__ __device__(
-                                      vertex_t const& vertex) -> bool {
-      if (visited[vertex] == iteration)
+    // Near-far piles, vertices beyond the current split are deferred to the
+    // far pile instead of being relaxed right away.
+    auto split = P->piles.split;
+    auto bucket = P->piles.bucket;
+    auto far_pile = P->piles.far_pile.data().get();
+    auto far_size = P->piles.far_size.data().get();
+    auto far_marker = P->piles.far_marker.data().get();
+
+    auto remove_completed_paths =
+        [G, distances, visited, iteration, split, bucket, far_pile, far_size,
+         far_marker] __device__(vertex_t const& vertex) -> bool {
+      if (G.get_number_of_neighbors(vertex) == 0)
         return false;
 
-      visited[vertex] = iteration;
-      return G.get_number_of_neighbors(vertex) > 0;
+      if (distances[vertex] >= split) {
+        operators::advance::bucketing::push_far(far_pile, far_size, far_marker,
+                                                bucket, vertex);
+        return false;
+      }
+
+      // Claim the vertex once per iteration, as in `loop_persistent()`: the
+      // iterations only grow, so only the first claim raises `visited`.
+      vertex_t now = (vertex_t)iteration;
+      return math::atomic::max(&visited[vertex], now) < now;
     };
 
-    // Execute advance operator on the provided lambda
-    operators::advance::execute<operators::load_balance_t::block_mapped>(
-        G, E, shortest_path, context);
+    // Execute the fused advance and filter operator on the provided lambdas,
+    // no intermediate (edge-sized) frontier is written.
+    operators::advance_filter::execute<
+        operators::load_balance_t::block_mapped>(
+        G, E, shortest_path, remove_completed_paths, context, true,
+        P->relaxed_counter.data().get());
+
+    // Near pile exhausted, move on to the next (non-empty) bucket.
+    auto priority = [distances] __device__(vertex_t const& v) -> weight_t {
+      return distances[v];
+    };
+    operators::advance::bucketing::refill(P->piles, E->get_input_frontier(),
+                                          priority,
+                                          *(context.get_context(0)));
+  }
 
-    // Execute filter operator on the provided lambda
-    operators::filter::execute<operators::filter_algorithm_t::predicated>(
-        G, E, remove_completed_paths, context);
+  void finalize(cuda::multi_context_t& context) override {
+    auto P = this->get_problem();
+    thrust::host_vector<std::size_t> relaxed = P->relaxed_counter;
+    P->edges_relaxed = relaxed[0];
   }
 
 };  // struct enactor_t
@@ -145,22 +298,29 @@ template <typename graph_t>
 float run(graph_t& G,
           typename graph_t::vertex_type& single_source,  // Parameter
           typename graph_t::weight_type* distances,      // Output
-          typename graph_t::vertex_type* predecessors    // Output
+          typename graph_t::vertex_type* predecessors,   // Output
+          std::size_t* edges_relaxed = nullptr,          // Output (optional)
+          typename graph_t::weight_type delta = 0,       // Parameter (optional)
+          std::shared_ptr<cuda::multi_context_t> multi_context =
+              nullptr,  // Context (optional, default: GPU 0)
+          enactor_properties_t properties =
+              enactor_properties_t()  // Properties (optional)
 ) {
   // <user-defined>
   using vertex_t = typename graph_t::vertex_type;
   using weight_t = typename graph_t::weight_type;
 
-  using param_type = param_t<vertex_t>;
+  using param_type = param_t<vertex_t, weight_t>;
   using result_type = result_t<vertex_t, weight_t>;
 
-  param_type param(single_source);
+  param_type param(single_source, delta);
   result_type result(distances, predecessors);
   // </user-defined>
 
   // <boiler-plate>
-  auto multi_context =
-      std::shared_ptr<cuda::multi_context_t>(new cuda::multi_context_t(0));
+  if (!multi_context)
+    multi_context =
+        std::shared_ptr<cuda::multi_context_t>(new cuda::multi_context_t(0));
 
   using problem_type = problem_t<graph_t, param_type, result_type>;
   using enactor_type = enactor_t<problem_type>;
@@ -169,9 +329,160 @@ float run(graph_t& G,
   problem.init();
   problem.reset();
 
-  enactor_type enactor(&problem, multi_context);
-  return enactor.enact();
+  enactor_type enactor(&problem, multi_context, properties);
+  float elapsed = enactor.enact();
   // </boiler-plate>
+
+  if (edges_relaxed)
+    *edges_relaxed = problem.edges_relaxed;
+  return elapsed;
+}
+
+/**
+ * @brief Shortest paths bound to a graph for repeated queries: the problem
+ * (bucket width, visited flags and near-far piles), the enactor and the
+ * context are built once, every `run()` only resets them.
+ *
+ * @par Example
+ * \code
+ * sssp::session_t<decltype(G)> session(G);
+ * for (auto source : sources)
+ *   session.run(source, distances, predecessors);
+ * \endcode
+ */
+template <typename graph_t>
+struct session_t {
+  using vertex_t = typename graph_t::vertex_type;
+  using weight_t = typename graph_t::weight_type;
+  using param_type = param_t<vertex_t, weight_t>;
+  using result_type = result_t<vertex_t, weight_t>;
+  using problem_type = problem_t<graph_t, param_type, result_type>;
+  using enactor_type = enactor_t<problem_type>;
+
+  /**
+   * @param G graph.
+   * @param delta bucket width (`<= 0` selects one from the graph, once).
+   * @param multi_context context (optional, default: GPU 0).
+   */
+  session_t(graph_t& G,
+            weight_t delta = 0,
+            std::shared_ptr<cuda::multi_context_t> multi_context = nullptr)
+      : session(multi_context,
+                enactor_properties_t(),
+                G,
+                param_type(0, delta),
+                result_type(nullptr, nullptr)) {}
+
+  /**
+   * @brief Shortest paths from `single_source`.
+   *
+   * @param single_source source vertex.
+   * @param distances output (device), `n` entries.
+   * @param predecessors output (device), `n` entries.
+   * @param edges_relaxed output (optional), number of edges relaxed.
+   * @return float elapsed time (ms).
+   */
+  float run(vertex_t const& single_source,
+            weight_t* distances,
+            vertex_t* predecessors,
+            std::size_t* edges_relaxed = nullptr) {
+    auto& problem = session.get_problem();
+    problem.param.single_source = single_source;
+    problem.result = result_type(distances, predecessors);
+    float elapsed = session.enact();
+    if (edges_relaxed)
+      *edges_relaxed = problem.edges_relaxed;
+    return elapsed;
+  }
+
+  gunrock::session_t<problem_type, enactor_type> session;
+};
+
+/**
+ * @brief Shortest paths from multiple sources at once (Bellman-Ford), the
+ * sources are processed in batches of 32 or 64 (one bit per source in a
+ * `mask_t`), and every batch relaxes the edges of its active vertices once
+ * per iteration for all the sources they are active in.
+ *
+ * @tparam mask_t `std::uint32_t` or `std::uint64_t` (default), width of a
+ * batch.
+ * @param G graph.
+ * @param sources sources (host).
+ * @param number_of_sources number of sources.
+ * @param distances output (device), `number_of_sources * n` entries, the
+ * distances from source `i` are at `distances + i * n`.
+ * @param multi_context context (optional, default: GPU 0).
+ * @return float elapsed time (ms).
+ */
+template <typename mask_t = std::uint64_t, typename graph_t>
+float run_multi_source(graph_t& G,
+                       typename graph_t::vertex_type const* sources,
+                       std::size_t number_of_sources,
+                       typename graph_t::weight_type* distances,
+                       std::shared_ptr<cuda::multi_context_t> multi_context =
+                           nullptr) {
+  using vertex_t = typename graph_t::vertex_type;
+  using edge_t = typename graph_t::edge_type;
+  using weight_t = typename graph_t::weight_type;
+  namespace multi_source = operators::batch::multi_source;
+
+  if (!multi_context)
+    multi_context =
+        std::shared_ptr<cuda::multi_context_t>(new cuda::multi_context_t(0));
+  auto context = multi_context->get_context(0);
+
+  std::size_t n = G.get_number_of_vertices();
+
+  // Vertices are revisited whenever their distance improves.
+  multi_source::state_t<vertex_t, mask_t> state(n, false);
+
+  auto& timer = context->timer();
+  timer.begin();
+
+  auto d_distances = thrust::device_pointer_cast(distances);
+  thrust::fill(context->execution_policy(), d_distances,
+               d_distances + number_of_sources * n,
+               std::numeric_limits<weight_t>::max());
+
+  for (std::size_t first = 0; first < number_of_sources;
+       first += state.lanes) {
+    int count = (int)std::min<std::size_t>(state.lanes,
+                                           number_of_sources - first);
+    auto batch = distances + first * n;
+
+    state.reset(sources + first, count, *context);
+    multi_source::for_each_active(
+        state,
+        [=] __device__(vertex_t const& v, mask_t const& lanes) {
+          multi_source::for_each_lane(
+              lanes, [&](int lane) { batch[lane * n + v] = 0; });
+        },
+        *context);
+
+    auto shortest_path = [=] __device__(vertex_t const& source,
+                                        vertex_t const& neighbor,
+                                        edge_t const& edge,
+                                        weight_t const& weight,
+                                        mask_t const& lanes) -> mask_t {
+      mask_t improved = 0;
+      multi_source::for_each_lane(lanes, [&](int lane) {
+        weight_t* lane_distances = batch + lane * n;
+        weight_t distance_to_neighbor = lane_distances[source] + weight;
+        weight_t recover_distance = math::atomic::min(
+            &(lane_distances[neighbor]), distance_to_neighbor);
+        if (distance_to_neighbor < recover_distance)
+          improved |= mask_t(1) << lane;
+      });
+      return improved;
+    };
+
+    while (!state.is_empty()) {
+      multi_source::advance(G, state, shortest_path, *context);
+      multi_source::commit(state, *context);
+    }
+  }
+
+  return timer.end();
 }
 
 }  // namespace sssp
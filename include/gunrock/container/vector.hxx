@@ -14,6 +14,7 @@
 #pragma once
 
 #include <gunrock/memory.hxx>
+#include <gunrock/memory_pool.hxx>
 #include <gunrock/util/type_traits.hxx>
 
 // includes: thrust
@@ -24,16 +25,28 @@ namespace gunrock {
 
 using namespace memory;
 
+/**
+ * @brief Host, device or managed vector. Device vectors draw from the
+ * stream-ordered memory pool of the current device's context (see
+ * `memory::pool_t`), or `cudaMalloc` if no context exists yet. Managed
+ * vectors are device vectors in unified memory (`cudaMallocManaged`).
+ */
 template <typename type_t, memory_space_t space>
-using vector_t =
-    std::conditional_t<space == memory_space_t::host,  // condition
-                       thrust::host_vector<type_t>,    // host_type
-                       thrust::device_vector<type_t>   // device_type
-                       >;
+using vector_t = std::conditional_t<
+    space == memory_space_t::host,                                 // condition
+    thrust::host_vector<type_t>,                                   // host_type
+    std::conditional_t<
+        space == memory_space_t::managed,                          // condition
+        thrust::device_vector<type_t, memory::managed_allocator_t<type_t>>,
+        thrust::device_vector<type_t, memory::pool_allocator_t<type_t>>>>;
 
 template <typename type_t>
 using host_vector_t = thrust::host_vector<type_t>;
 template <typename type_t>
-using device_vector_t = thrust::device_vector<type_t>;
+using device_vector_t =
+    thrust::device_vector<type_t, memory::pool_allocator_t<type_t>>;
+template <typename type_t>
+using managed_vector_t =
+    thrust::device_vector<type_t, memory::managed_allocator_t<type_t>>;
 
 }  // namespace gunrock
\ No newline at end of file
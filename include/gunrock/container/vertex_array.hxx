@@ -0,0 +1,91 @@
+/**
+ * @file vertex_array.hxx
+ * @author Muhammad Osama (mosama@ucdavis.edu)
+ * @brief Vertex-indexed arrays of a problem, striped over the GPUs of a
+ * multi-GPU context.
+ * @version 0.1
+ * @date 2021-06-28
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include <gunrock/cuda/context.hxx>
+#include <gunrock/container/vector.hxx>
+#include <gunrock/virtual_memory.hxx>
+
+namespace gunrock {
+
+/**
+ * @brief Vertex-indexed array (e.g., distances, ranks) accessible by all the
+ * GPUs of a context: a device vector on a single GPU, a
+ * `memory::striped_array_t` on more, with one stripe per GPU of
+ * `get_vertices_per_partition()` vertices. The multi-GPU operators partition
+ * the vertices the same way (see `gunrock::problem_t` and
+ * `operators::multi_gpu::state_t::vertices_per_partition`), so the entries
+ * a GPU updates the most, the ones of the vertices it owns, are in its own
+ * memory.
+ *
+ * @tparam type_t element type.
+ */
+template <typename type_t>
+class vertex_array_t {
+ public:
+  vertex_array_t() = default;
+
+  /**
+   * @brief Vertices per stripe of the vertex arrays over the GPUs of
+   * `context` (independent of the element type), `0` on a single GPU.
+   */
+  static std::size_t get_vertices_per_partition(
+      std::size_t number_of_vertices,
+      cuda::multi_context_t& context) {
+    if (context.size() < 2)
+      return 0;
+    return memory::striped_vertices_per_partition(number_of_vertices,
+                                                  get_devices(context));
+  }
+
+  /**
+   * @brief Allocate `number_of_vertices` entries for `context`.
+   */
+  void allocate(std::size_t number_of_vertices,
+                cuda::multi_context_t& context) {
+    n = number_of_vertices;
+    if (context.size() < 2) {
+      local.resize(n);
+      return;
+    }
+
+    auto devices = get_devices(context);
+    striped = std::make_shared<memory::striped_array_t<type_t>>(
+        n, devices, memory::striped_vertices_per_partition(n, devices));
+  }
+
+  type_t* data() {
+    return striped ? striped->data() : local.data().get();
+  }
+
+  std::size_t size() const { return n; }
+
+  bool is_striped() const { return (bool)striped; }
+
+ private:
+  static std::vector<int> get_devices(cuda::multi_context_t& context) {
+    std::vector<int> devices;
+    for (std::size_t d = 0; d < context.size(); ++d)
+      devices.push_back(context.get_context(d)->ordinal());
+    return devices;
+  }
+
+  std::size_t n = 0;
+  vector_t<type_t, memory_space_t::device> local;
+  std::shared_ptr<memory::striped_array_t<type_t>> striped;
+};  // class vertex_array_t
+
+}  // namespace gunrock
@@ -9,11 +9,119 @@
  *
  */
 #pragma once
+
+#include <type_traits>
+
+#include <cuda_fp16.h>
+#include <cuda_bf16.h>
+
 namespace gunrock {
 namespace cuda {
 
+namespace detail {
+
+__device__ __forceinline__ unsigned short int as_bits(__half value) {
+  return __half_as_ushort(value);
+}
+
+__device__ __forceinline__ unsigned short int as_bits(__nv_bfloat16 value) {
+  return __bfloat16_as_ushort(value);
+}
+
+template <typename type_t>
+__device__ __forceinline__ type_t from_bits(unsigned short int bits) {
+  if constexpr (std::is_same_v<type_t, __half>)
+    return __ushort_as_half(bits);
+  else
+    return __ushort_as_bfloat16(bits);
+}
+
+/**
+ * @brief Atomically replace the 16-bit floating point value (half or
+ * bfloat16) at `address` by `op(value)` (computed in float), with a CAS loop
+ * on the 16-bit word (sm_70 and up).
+ *
+ * @return type_t the old value.
+ */
+template <typename type_t, typename operator_t>
+__device__ __forceinline__ type_t atomic_update(type_t* address,
+                                                operator_t op) {
+  unsigned short int* addr_as_ushort =
+      reinterpret_cast<unsigned short int*>(address);
+  unsigned short int old = *addr_as_ushort;
+  unsigned short int expected;
+  do {
+    expected = old;
+    float current = static_cast<float>(from_bits<type_t>(expected));
+    old = ::atomicCAS(addr_as_ushort, expected,
+                      as_bits(static_cast<type_t>(op(current))));
+  } while (expected != old);
+  return from_bits<type_t>(old);
+}
+
+}  // namespace detail
+
+/**
+ * @brief Wrapper around CUDA's natively supported atomicAdd types. The 64-bit
+ * integers (e.g. `std::int64_t`, `long`, which CUDA only supports as
+ * `unsigned long long`) are added as unsigned 64-bit integers (two's
+ * complement).
+ *
+ * @tparam type_t
+ * @param address
+ * @param value
+ * @return type_t
+ */
+template <typename type_t>
+__device__ static type_t atomicAdd(type_t* address, type_t value) {
+  if constexpr (std::is_integral_v<type_t> && sizeof(type_t) == 8)
+    return (type_t)::atomicAdd(
+        reinterpret_cast<unsigned long long int*>(address),
+        (unsigned long long int)value);
+  else
+    return ::atomicAdd(address, value);
+}
+
 /**
- * @brief Wrapper around CUDA's natively supported atomicMin types.
+ * @brief atomicAdd on bfloat16, natively supported from sm_80 on, a CAS loop
+ * (in float) before.
+ */
+__device__ static __nv_bfloat16 atomicAdd(__nv_bfloat16* address,
+                                          __nv_bfloat16 value) {
+#if __CUDA_ARCH__ >= 800
+  return ::atomicAdd(address, value);
+#else
+  float addend = static_cast<float>(value);
+  return detail::atomic_update(
+      address, [addend](float current) { return current + addend; });
+#endif
+}
+
+/**
+ * @brief Wrapper around CUDA's natively supported atomicCAS types, including
+ * the 64-bit integers (as `unsigned long long`).
+ *
+ * @tparam type_t
+ * @param address
+ * @param compare
+ * @param value
+ * @return type_t
+ */
+template <typename type_t>
+__device__ static type_t atomicCAS(type_t* address,
+                                   type_t compare,
+                                   type_t value) {
+  if constexpr (std::is_integral_v<type_t> && sizeof(type_t) == 8)
+    return (type_t)::atomicCAS(
+        reinterpret_cast<unsigned long long int*>(address),
+        (unsigned long long int)compare, (unsigned long long int)value);
+  else
+    return ::atomicCAS(address, compare, value);
+}
+
+/**
+ * @brief Wrapper around CUDA's natively supported atomicMin types, including
+ * the 64-bit integers (as `long long` or `unsigned long long`).
  *
  * @tparam type_t
  * @param address
@@ -22,7 +130,35 @@ namespace cuda {
  */
 template <typename type_t>
 __device__ static type_t atomicMin(type_t* address, type_t value) {
-  return ::atomicMin(address, value);
+  if constexpr (std::is_integral_v<type_t> && sizeof(type_t) == 8 &&
+                std::is_signed_v<type_t>)
+    return (type_t)::atomicMin(reinterpret_cast<long long int*>(address),
+                               (long long int)value);
+  else if constexpr (std::is_integral_v<type_t> && sizeof(type_t) == 8)
+    return (type_t)::atomicMin(
+        reinterpret_cast<unsigned long long int*>(address),
+        (unsigned long long int)value);
+  else
+    return ::atomicMin(address, value);
+}
+
+/**
+ * @brief atomicMin on half, a CAS loop (in float).
+ */
+__device__ static __half atomicMin(__half* address, __half value) {
+  float other = static_cast<float>(value);
+  return detail::atomic_update(
+      address, [other](float current) { return ::fminf(current, other); });
+}
+
+/**
+ * @brief atomicMin on bfloat16, a CAS loop (in float).
+ */
+__device__ static __nv_bfloat16 atomicMin(__nv_bfloat16* address,
+                                          __nv_bfloat16 value) {
+  float other = static_cast<float>(value);
+  return detail::atomic_update(
+      address, [other](float current) { return ::fminf(current, other); });
 }
 
 /**
@@ -68,7 +204,8 @@ __device__ static double atomicMin(double* address, double value) {
 }
 
 /**
- * @brief Wrapper around CUDA's natively supported atomicMax types.
+ * @brief Wrapper around CUDA's natively supported atomicMax types, including
+ * the 64-bit integers (as `long long` or `unsigned long long`).
  *
  * @tparam type_t
  * @param address
@@ -77,7 +214,35 @@ __device__ static double atomicMin(double* address, double value) {
  */
 template <typename type_t>
 __device__ static type_t atomicMax(type_t* address, type_t value) {
-  return ::atomicMax(address, value);
+  if constexpr (std::is_integral_v<type_t> && sizeof(type_t) == 8 &&
+                std::is_signed_v<type_t>)
+    return (type_t)::atomicMax(reinterpret_cast<long long int*>(address),
+                               (long long int)value);
+  else if constexpr (std::is_integral_v<type_t> && sizeof(type_t) == 8)
+    return (type_t)::atomicMax(
+        reinterpret_cast<unsigned long long int*>(address),
+        (unsigned long long int)value);
+  else
+    return ::atomicMax(address, value);
+}
+
+/**
+ * @brief atomicMax on half, a CAS loop (in float).
+ */
+__device__ static __half atomicMax(__half* address, __half value) {
+  float other = static_cast<float>(value);
+  return detail::atomic_update(
+      address, [other](float current) { return ::fmaxf(current, other); });
+}
+
+/**
+ * @brief atomicMax on bfloat16, a CAS loop (in float).
+ */
+__device__ static __nv_bfloat16 atomicMax(__nv_bfloat16* address,
+                                          __nv_bfloat16 value) {
+  float other = static_cast<float>(value);
+  return detail::atomic_update(
+      address, [other](float current) { return ::fmaxf(current, other); });
 }
 
 /**
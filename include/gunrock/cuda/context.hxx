@@ -11,6 +11,7 @@
 #pragma once
 
 #include <gunrock/error.hxx>
+#include <gunrock/memory_pool.hxx>
 #include <gunrock/cuda/cuda.hxx>
 #include <gunrock/util/timer.hxx>
 
@@ -19,12 +20,47 @@
 
 #include <moderngpu/context.hxx>
 
+#include <unordered_map>
+
 namespace gunrock {
 namespace cuda {
 
 template <int dummy_arg>
 __global__ void dummy_k() {}
 
+/**
+ * @brief moderngpu context whose device allocations (e.g. the temporary
+ * storage of `mgpu::transform_compact`) are drawn from a `memory::pool_t`.
+ */
+class pooled_mgpu_context_t : public mgpu::standard_context_t {
+ public:
+  pooled_mgpu_context_t(std::shared_ptr<memory::pool_t> _pool,
+                        cudaStream_t _stream)
+      : mgpu::standard_context_t(false, _stream), pool(_pool) {}
+
+  virtual void* alloc(size_t size, mgpu::memory_space_t space) override {
+    if (space != mgpu::memory_space_device)
+      return mgpu::standard_context_t::alloc(size, space);
+    void* pointer = pool->allocate(size);
+    sizes[pointer] = size;
+    return pointer;
+  }
+
+  virtual void free(void* pointer, mgpu::memory_space_t space) override {
+    if (space != mgpu::memory_space_device)
+      return mgpu::standard_context_t::free(pointer, space);
+    auto it = sizes.find(pointer);
+    if (it == sizes.end())
+      return;
+    pool->deallocate(pointer, it->second);
+    sizes.erase(it);
+  }
+
+ private:
+  std::shared_ptr<memory::pool_t> pool;
+  std::unordered_map<void*, std::size_t> sizes;
+};  // class pooled_mgpu_context_t
+
 struct context_t {
   context_t() = default;
 
@@ -54,13 +90,24 @@ class standard_context_t : public context_t {
   cuda::stream_t _stream;
   cuda::event_t _event;
 
-  /**
-   * @todo Find out how to use a shared_ptr<> without printing the GPU debug
-   * information. Currently, we are not releasing this pointer, which causes a
-   * memory leak. Fix this later.
+  /*!
+   * moderngpu context on this context's stream and pool, released with the
+   * context.
    */
   mgpu::standard_context_t* _mgpu_context;
 
+  /**
+   * @brief Stream-ordered memory pool of this context (device and stream,
+   * the pool creates and owns the context's stream),
+   * attached to the device (see `memory::pool_t::get_default()`): it is the
+   * default pool of the device if it is the first context alive on it, or
+   * after `make_default()`. Device `vector_t`s and frontiers draw from the
+   * default pool; thrust's temporary storage (through `execution_policy()`)
+   * and moderngpu's allocations draw from this one.
+   */
+  std::shared_ptr<memory::pool_t> _pool;
+  memory::temporary_allocator_t _temporary_allocator;
+
   util::timer_t _timer;
 
   // Making this a template argument means we won't generate an instance
@@ -73,20 +120,39 @@ class standard_context_t : public context_t {
     _ptx_version = cuda::make_compute_capability(attr.ptxVersion);
 
     cudaSetDevice(_ordinal);
-    cudaStreamCreateWithFlags(&_stream, cudaStreamNonBlocking);
+    _pool = std::make_shared<memory::pool_t>(_ordinal);
+    _stream = _pool->get_stream();
     cudaEventCreateWithFlags(&_event, cudaEventDisableTiming);
     cudaGetDeviceProperties(&_props, _ordinal);
+    _timer.set_stream(_stream);
+
+    memory::pool_t::attach(_pool);
+    _temporary_allocator = memory::temporary_allocator_t(_pool);
 
-    _mgpu_context = new mgpu::standard_context_t(false, _stream);
+    _mgpu_context = new pooled_mgpu_context_t(_pool, _stream);
   }
 
  public:
   standard_context_t(cuda::device_id_t device = 0)
-      : context_t(), _ordinal(device), _mgpu_context(nullptr) {
+      : context_t(),
+        _ordinal(device),
+        _mgpu_context(nullptr),
+        _pool(nullptr),
+        _temporary_allocator(nullptr) {
     init();
   }
 
-  ~standard_context_t() { cudaEventDestroy(_event); }
+  ~standard_context_t() {
+    cudaSetDevice(_ordinal);
+    cudaStreamSynchronize(_stream);
+    delete _mgpu_context;
+    cudaEventDestroy(_event);
+
+    // The pool owns the stream: containers still drawing from the pool keep
+    // both alive, the last one released destroys them.
+    _temporary_allocator = memory::temporary_allocator_t(nullptr);
+    _pool.reset();
+  }
 
   virtual const cuda::device_properties_t& props() const override {
     return _props;
@@ -116,7 +182,22 @@ class standard_context_t : public context_t {
 
   virtual cuda::device_id_t ordinal() { return _ordinal; }
 
-  auto execution_policy() { return thrust::cuda::par.on(this->stream()); }
+  std::shared_ptr<memory::pool_t> pool() { return _pool; }
+
+  /**
+   * @brief Make this context's pool the default pool of the device, for all
+   * the threads (see `memory::pool_t::set_default()`); otherwise, the first
+   * context alive on the device provides it.
+   */
+  void make_default() { memory::pool_t::set_default(_pool); }
+
+  /**
+   * @brief thrust execution policy of this context, runs on the context's
+   * stream and allocates temporary storage from the context's memory pool.
+   */
+  auto execution_policy() {
+    return thrust::cuda::par(_temporary_allocator).on(this->stream());
+  }
 
 };  // class standard_context_t
 
@@ -143,7 +224,13 @@ class multi_context_t {
     }
   }
 
-  ~multi_context_t() {}
+  ~multi_context_t() {
+    for (auto& context : contexts)
+      delete context;
+  }
+
+  multi_context_t(const multi_context_t& rhs) = delete;
+  multi_context_t& operator=(const multi_context_t& rhs) = delete;
 
   auto get_context(cuda::device_id_t device) {
     auto contexts_ptr = contexts.data();
@@ -152,6 +239,12 @@ class multi_context_t {
 
   auto size() { return contexts.size(); }
 
+  /**
+   * @brief Enable peer access between all the devices of the context (where
+   * supported), and let every device access the memory pools of the others
+   * (see `memory::pool_t::grant_peer_access()`): peer access alone does not
+   * cover the pools' allocations.
+   */
   void enable_peer_access() {
     int num_gpus = size();
     for (int i = 0; i < num_gpus; i++) {
@@ -163,7 +256,19 @@ class multi_context_t {
           continue;
 
         auto ctx_peer = get_context(j);
-        cudaDeviceEnablePeerAccess(ctx_peer->ordinal(), 0);
+        int can_access = 0;
+        cudaDeviceCanAccessPeer(&can_access, ctx->ordinal(),
+                                ctx_peer->ordinal());
+        if (!can_access)
+          continue;
+        cudaError_t status = cudaDeviceEnablePeerAccess(ctx_peer->ordinal(), 0);
+        if (status == cudaErrorPeerAccessAlreadyEnabled)
+          cudaGetLastError();
+        else
+          error::throw_if_exception(status);
+
+        // Device i accesses the pools of device j.
+        memory::pool_t::grant_peer_access(ctx_peer->ordinal(), ctx->ordinal());
       }
     }
 
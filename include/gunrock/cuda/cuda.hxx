@@ -19,5 +19,6 @@ namespace cuda {}  // namespace cuda
 #include <gunrock/cuda/function.hxx>
 #include <gunrock/cuda/stream_management.hxx>
 #include <gunrock/cuda/event_management.hxx>
+#include <gunrock/cuda/graph_management.hxx>
 #include <gunrock/cuda/device_properties.hxx>
 #include <gunrock/cuda/context.hxx>
\ No newline at end of file
@@ -0,0 +1,87 @@
+/**
+ * @file graph_management.hxx
+ * @author Muhammad Osama (mosama@ucdavis.edu)
+ * @brief CUDA Graphs captured from a stream and replayed as a single launch.
+ * @version 0.1
+ * @date 2021-06-11
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#pragma once
+
+#include <gunrock/error.hxx>
+#include <gunrock/cuda/stream_management.hxx>
+
+namespace gunrock {
+namespace cuda {
+
+/**
+ * @brief Executable CUDA Graph of the work enqueued on a stream during
+ * `capture()`. The captured work must not synchronize, allocate or read
+ * device data back on the host (the kernels' arguments and launch
+ * configurations are frozen at capture time).
+ */
+class captured_graph_t {
+ public:
+  captured_graph_t() : graph(nullptr), instance(nullptr) {}
+
+  ~captured_graph_t() { release(); }
+
+  captured_graph_t(const captured_graph_t& rhs) = delete;
+  captured_graph_t& operator=(const captured_graph_t& rhs) = delete;
+
+  /**
+   * @brief Capture the work `f()` enqueues on `stream`, and instantiate it.
+   *
+   * @param stream stream to capture (must not be the legacy default stream).
+   * @param f function enqueueing the work.
+   */
+  template <typename function_t>
+  void capture(stream_t stream, function_t f) {
+    release();
+    error::throw_if_exception(
+        cudaStreamBeginCapture(stream, cudaStreamCaptureModeThreadLocal),
+        "Failed to begin the stream capture.");
+    try {
+      f();
+    } catch (...) {
+      cudaStreamEndCapture(stream, &graph);
+      release();
+      throw;
+    }
+    error::throw_if_exception(
+        cudaStreamEndCapture(stream, &graph),
+        "Stream capture failed, the captured work must not synchronize.");
+    error::throw_if_exception(
+        cudaGraphInstantiate(&instance, graph, nullptr, nullptr, 0),
+        "Failed to instantiate the captured graph.");
+  }
+
+  /**
+   * @brief Replay the captured work on `stream`.
+   */
+  void launch(stream_t stream) {
+    error::throw_if_exception(cudaGraphLaunch(instance, stream),
+                              "Captured graph launch failed.");
+  }
+
+  bool is_empty() const { return instance == nullptr; }
+
+ private:
+  void release() {
+    if (instance)
+      cudaGraphExecDestroy(instance);
+    if (graph)
+      cudaGraphDestroy(graph);
+    instance = nullptr;
+    graph = nullptr;
+  }
+
+  cudaGraph_t graph;
+  cudaGraphExec_t instance;
+};  // class captured_graph_t
+
+}  // namespace cuda
+}  // namespace gunrock
@@ -52,7 +52,10 @@ enum sm_flag_t : unsigned {
   sm_72 = 1 << 10,
   sm_75 = 1 << 11,
   sm_80 = 1 << 12,
-  sm_86 = 1 << 13
+  sm_86 = 1 << 13,
+  sm_89 = 1 << 14,
+  sm_90 = 1 << 15,
+  sm_0 = fallback  // no SM_TARGET, only the fallbacks match.
 };
 
 // Macro for the flag of the current device's SM version
@@ -89,18 +92,41 @@ constexpr sm_flag_t operator&(sm_flag_t lhs, sm_flag_t rhs) {
  * @tparam block_dimensions_ Block dimensions to launch with
  * @tparam grid_dimensions_ Grid dimensions to launch with
  * @tparam shared_memory_bytes_ Amount of shared memory to allocate
+ * @tparam items_per_thread_ Work items processed by every thread (tiles of
+ * `block_size * items_per_thread` items per block)
  */
 template <sm_flag_t sm_flags_,
           typename block_dimensions_,
           typename grid_dimensions_,
-          size_t shared_memory_bytes_ = 0>
+          size_t shared_memory_bytes_ = 0,
+          unsigned items_per_thread_ = 1>
 struct launch_params_t {
   typedef block_dimensions_ block_dimensions;
   typedef grid_dimensions_ grid_dimensions;
   enum : size_t { shared_memory_bytes = shared_memory_bytes_ };
   enum : unsigned { sm_flags = sm_flags_ };
+  enum : unsigned {
+    block_size = block_dimensions_::size,
+    items_per_thread = items_per_thread_,
+    tile_size = block_dimensions_::size * items_per_thread_
+  };
 };
 
+/**
+ * @brief 1D launch parameters (the grid is sized at launch from the work)
+ * @tparam sm_flags_ Bitwise flags indicating SM versions (sm_flag_t enum)
+ * @tparam block_size_ Threads per block
+ * @tparam items_per_thread_ Work items processed by every thread
+ */
+template <sm_flag_t sm_flags_,
+          unsigned block_size_,
+          unsigned items_per_thread_ = 1>
+using launch_params_1d_t = launch_params_t<sm_flags_,
+                                           dim3_t<block_size_>,
+                                           dim3_t<1>,
+                                           0,
+                                           items_per_thread_>;
+
 template <typename... lp_v>
 struct device_launch_params_t;
 
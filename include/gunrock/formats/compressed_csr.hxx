@@ -0,0 +1,188 @@
+/**
+ * @file compressed_csr.hxx
+ * @author Muhammad Osama (mosama@ucdavis.edu)
+ * @brief Compressed Sparse Row format with bit-packed column indices, and
+ * optional values.
+ * @version 0.1
+ * @date 2021-06-18
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#pragma once
+
+#include <gunrock/memory.hxx>
+#include <gunrock/container/vector.hxx>
+#include <gunrock/formats/formats.hxx>
+
+#include <thrust/copy.h>
+#include <thrust/fill.h>
+#include <thrust/for_each.h>
+#include <thrust/functional.h>
+#include <thrust/scan.h>
+#include <thrust/iterator/counting_iterator.h>
+
+#include <cstdint>
+#include <type_traits>
+
+namespace gunrock {
+namespace format {
+
+using namespace memory;
+
+/**
+ * @brief Compressed Sparse Row (CSR) format whose column indices are
+ * bit-packed in blocks of `block_size` consecutive nonzeros: every block
+ * stores its smallest column index (`block_bases`), and each of its column
+ * indices as the difference to it, in the fewest bits that fit the block's
+ * largest difference (`block_widths`). The blocks are word-aligned
+ * (`block_words`, offset of each block in `words`).
+ *
+ * @par Overview
+ * Any column index is decoded in O(1) (one or two words), such that the
+ * graph view (`graph::graph_compressed_csr_t`) keeps the random access the
+ * operators expect. Sorted neighbor lists, and all the more a locality
+ * preserving vertex order (see `format::reorder`), make the differences
+ * small. The values are optional: without them (pattern matrices, unweighted
+ * graphs), no memory is allocated for the values and every edge weighs 1.
+ *
+ * @tparam index_t
+ * @tparam offset_t
+ * @tparam value_t
+ */
+template <memory_space_t space,
+          typename index_t,
+          typename offset_t,
+          typename value_t>
+struct compressed_csr_t {
+  using word_t = std::uint32_t;
+  static constexpr offset_t block_size = 32;
+
+  index_t number_of_rows;
+  index_t number_of_columns;
+  offset_t number_of_nonzeros;
+
+  vector_t<offset_t, space> row_offsets;          // Ap
+  vector_t<index_t, space> block_bases;           // smallest column of a block
+  vector_t<unsigned char, space> block_widths;    // bits per column of a block
+  vector_t<offset_t, space> block_words;          // first word of a block
+  vector_t<word_t, space> words;                  // packed columns (padded)
+  vector_t<value_t, space> nonzero_values;        // Ax (optional)
+
+  compressed_csr_t()
+      : number_of_rows(0), number_of_columns(0), number_of_nonzeros(0) {}
+
+  /**
+   * @brief Compress a CSR, in the CSR's memory space.
+   *
+   * @param csr CSR (column indices sorted within rows compress better).
+   * @param keep_values copy the values; without them every edge weighs 1.
+   * @return compressed_csr_t&
+   */
+  compressed_csr_t& from_csr(csr_t<space, index_t, offset_t, value_t>& csr,
+                             bool keep_values = true) {
+    using execution_policy_t =
+        std::conditional_t<is_device_accessible(space),
+                           decltype(thrust::device), decltype(thrust::host)>;
+    execution_policy_t exec;
+
+    number_of_rows = csr.number_of_rows;
+    number_of_columns = csr.number_of_columns;
+    number_of_nonzeros = csr.number_of_nonzeros;
+
+    row_offsets = csr.row_offsets;
+    if (keep_values)
+      nonzero_values = csr.nonzero_values;
+    else
+      nonzero_values.clear();
+
+    offset_t nnz = number_of_nonzeros;
+    offset_t number_of_blocks = (nnz + block_size - 1) / block_size;
+    block_bases.resize(number_of_blocks);
+    block_widths.resize(number_of_blocks);
+    block_words.resize(number_of_blocks + 1);
+
+    auto J = raw_pointer_cast(csr.column_indices.data());
+    auto bases = raw_pointer_cast(block_bases.data());
+    auto widths = raw_pointer_cast(block_widths.data());
+
+    // Base and width of every block.
+    thrust::for_each(exec, thrust::make_counting_iterator<offset_t>(0),
+                     thrust::make_counting_iterator<offset_t>(number_of_blocks),
+                     [=] __host__ __device__(offset_t const& b) {
+                       offset_t begin = b * block_size;
+                       offset_t end = (begin + block_size < nnz)
+                                          ? begin + block_size
+                                          : nnz;
+                       index_t lo = J[begin], hi = J[begin];
+                       for (offset_t e = begin + 1; e < end; ++e) {
+                         lo = (J[e] < lo) ? J[e] : lo;
+                         hi = (J[e] > hi) ? J[e] : hi;
+                       }
+                       std::uint64_t range = (std::uint64_t)(hi - lo);
+                       unsigned char width = 0;
+                       while (width < 32 && (range >> width) != 0)
+                         ++width;
+                       bases[b] = lo;
+                       widths[b] = width;
+                     });
+
+    // A block of `block_size` (32) columns of `w` bits spans `w` words.
+    thrust::transform_exclusive_scan(
+        exec, thrust::make_counting_iterator<offset_t>(0),
+        thrust::make_counting_iterator<offset_t>(number_of_blocks + 1),
+        block_words.begin(),
+        [=] __host__ __device__(offset_t const& b) -> offset_t {
+          return (b == number_of_blocks) ? 0 : widths[b];
+        },
+        (offset_t)0, thrust::plus<offset_t>());
+
+    offset_t number_of_words = block_words[number_of_blocks];
+    words.resize(number_of_words + 1);  // decoding reads a word ahead.
+    thrust::fill(exec, words.begin(), words.end(), 0);
+
+    auto offsets = raw_pointer_cast(block_words.data());
+    auto packed = raw_pointer_cast(words.data());
+
+    // Pack, every block writes its own words only.
+    thrust::for_each(
+        exec, thrust::make_counting_iterator<offset_t>(0),
+        thrust::make_counting_iterator<offset_t>(number_of_blocks),
+        [=] __host__ __device__(offset_t const& b) {
+          unsigned int width = widths[b];
+          if (width == 0)
+            return;
+          offset_t begin = b * block_size;
+          offset_t end =
+              (begin + block_size < nnz) ? begin + block_size : nnz;
+          for (offset_t e = begin; e < end; ++e) {
+            std::uint64_t bit = (std::uint64_t)(e - begin) * width;
+            offset_t word = offsets[b] + (offset_t)(bit >> 5);
+            unsigned int shift = bit & 31;
+            word_t delta = (word_t)(J[e] - bases[b]);
+            packed[word] |= delta << shift;
+            if (shift + width > 32)
+              packed[word + 1] |= delta >> (32 - shift);
+          }
+        });
+
+    return *this;
+  }
+
+  /**
+   * @brief Bytes used by the compressed format.
+   */
+  std::size_t get_size_in_bytes() const {
+    return row_offsets.size() * sizeof(offset_t) +
+           block_bases.size() * sizeof(index_t) +
+           block_widths.size() * sizeof(unsigned char) +
+           block_words.size() * sizeof(offset_t) +
+           words.size() * sizeof(word_t) +
+           nonzero_values.size() * sizeof(value_t);
+  }
+
+};  // struct compressed_csr_t
+
+}  // namespace format
+}  // namespace gunrock
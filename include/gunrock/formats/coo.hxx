@@ -2,6 +2,17 @@
 
 #include <gunrock/memory.hxx>
 #include <gunrock/container/vector.hxx>
+#include <gunrock/algorithms/sort/radix_sort.hxx>
+
+#include <thrust/sort.h>
+#include <thrust/tuple.h>
+#include <thrust/remove.h>
+#include <thrust/unique.h>
+#include <thrust/transform.h>
+#include <thrust/iterator/zip_iterator.h>
+
+#include <cstdint>
+#include <type_traits>
 
 namespace gunrock {
 namespace format {
@@ -46,6 +57,101 @@ struct coo_t {
 
   ~coo_t() {}
 
+  /**
+   * @brief Sort the nonzeros by (row, column), on the coordinate format's
+   * memory space, and optionally remove the self-loops (diagonal) and the
+   * duplicate entries (the first of the duplicates is kept). The sorted
+   * coordinate format is the shared edge list from which the CSR, CSC and COO
+   * views are built (see `graph::build::from_coo()`).
+   *
+   * @par Overview
+   * With indices of (at most) 32-bits, (row, column) pairs are packed into a
+   * single 64-bit key and sorted with one radix sort pass. With wider indices
+   * two stable radix sort passes are used, on the column and then on the row.
+   *
+   * @param remove_self_loops remove (i, i) entries.
+   * @param remove_duplicates keep only one of the (i, j) entries.
+   */
+  void sort(bool remove_self_loops = false, bool remove_duplicates = false) {
+    using execution_policy_t =
+        std::conditional_t<is_device_accessible(space),
+                           decltype(thrust::device), decltype(thrust::host)>;
+    execution_policy_t exec;
+
+    auto I = raw_pointer_cast(row_indices.data());
+    auto J = raw_pointer_cast(column_indices.data());
+    auto V = raw_pointer_cast(nonzero_values.data());
+    std::size_t nnz = number_of_nonzeros;
+
+    auto entries = thrust::make_zip_iterator(thrust::make_tuple(I, J, V));
+    using entry_t = thrust::tuple<index_t, index_t, value_t>;
+
+    if (remove_self_loops) {
+      auto end = thrust::remove_if(
+          exec, entries, entries + nnz,
+          [] __host__ __device__(entry_t const& t) {
+            return thrust::get<0>(t) == thrust::get<1>(t);
+          });
+      nnz = thrust::distance(entries, end);
+    }
+
+    if constexpr (sizeof(index_t) <= sizeof(std::uint32_t)) {
+      // (row, column) -> row << 32 | column.
+      vector_t<std::uint64_t, space> keys(nnz);
+      auto K = raw_pointer_cast(keys.data());
+      auto pairs = thrust::make_zip_iterator(thrust::make_tuple(I, J));
+      thrust::transform(
+          exec, pairs, pairs + nnz, K,
+          [] __host__ __device__(thrust::tuple<index_t, index_t> const& t) {
+            return ((std::uint64_t)(std::uint32_t)thrust::get<0>(t) << 32) |
+                   (std::uint64_t)(std::uint32_t)thrust::get<1>(t);
+          });
+
+      if constexpr (is_device_accessible(space))
+        gunrock::sort::radix::sort_pairs(K, V, nnz);
+      else
+        thrust::stable_sort_by_key(exec, K, K + nnz, V);
+
+      if (remove_duplicates) {
+        auto end = thrust::unique_by_key(exec, K, K + nnz, V);
+        nnz = thrust::distance(K, end.first);
+      }
+
+      thrust::transform(exec, K, K + nnz, pairs,
+                        [] __host__ __device__(std::uint64_t const& k) {
+                          return thrust::make_tuple(
+                              (index_t)(k >> 32), (index_t)(std::uint32_t)k);
+                        });
+    } else {
+      // Least-significant key first, the second pass is stable.
+      auto rows_values = thrust::make_zip_iterator(thrust::make_tuple(I, V));
+      auto columns_values =
+          thrust::make_zip_iterator(thrust::make_tuple(J, V));
+      if constexpr (is_device_accessible(space)) {
+        gunrock::sort::radix::sort_pairs(J, rows_values, nnz);
+        gunrock::sort::radix::sort_pairs(I, columns_values, nnz);
+      } else {
+        thrust::stable_sort_by_key(exec, J, J + nnz, rows_values);
+        thrust::stable_sort_by_key(exec, I, I + nnz, columns_values);
+      }
+
+      if (remove_duplicates) {
+        auto end = thrust::unique(
+            exec, entries, entries + nnz,
+            [] __host__ __device__(entry_t const& a, entry_t const& b) {
+              return thrust::get<0>(a) == thrust::get<0>(b) &&
+                     thrust::get<1>(a) == thrust::get<1>(b);
+            });
+        nnz = thrust::distance(entries, end);
+      }
+    }
+
+    number_of_nonzeros = nnz;
+    row_indices.resize(nnz);
+    column_indices.resize(nnz);
+    nonzero_values.resize(nnz);
+  }
+
 };  // struct coo_t
 
 }  // namespace format
@@ -2,6 +2,9 @@
 
 #include <gunrock/container/vector.hxx>
 #include <gunrock/memory.hxx>
+#include <gunrock/io/binary.hxx>
+
+#include <thrust/host_vector.h>
 
 namespace gunrock {
 namespace format {
@@ -46,6 +49,57 @@ struct csc_t {
 
   ~csc_t() {}
 
+  /**
+   * @brief Load a binary CSC file (see `io::binary` and
+   * `csr_t::read_binary()`).
+   *
+   * @param filename binary CSC file.
+   * @param stream stream for the host to device copies.
+   */
+  void read_binary(std::string filename, cudaStream_t stream = 0) {
+    io::mapped_file_t file(filename);
+    auto header = io::binary::read_header<index_t, offset_t, value_t>(
+        file, io::binary::layout_t::csc);
+
+    number_of_rows = header.number_of_rows;
+    number_of_columns = header.number_of_columns;
+    number_of_nonzeros = header.number_of_nonzeros;
+
+    column_offsets.resize(number_of_columns + 1);
+    row_indices.resize(number_of_nonzeros);
+    nonzero_values.resize(number_of_nonzeros);
+
+    io::binary::read(file, header, raw_pointer_cast(column_offsets.data()),
+                     raw_pointer_cast(row_indices.data()),
+                     raw_pointer_cast(nonzero_values.data()),
+                     is_device_accessible(space), stream);
+  }
+
+  /**
+   * @brief Write this CSC to a (versioned) binary file, see `io::binary`.
+   *
+   * @param filename output file.
+   */
+  void write_binary(std::string filename) {
+    auto header = io::binary::make_header<index_t, offset_t, value_t>(
+        io::binary::layout_t::csc, number_of_rows, number_of_columns,
+        number_of_nonzeros);
+
+    if (is_device_accessible(space)) {
+      thrust::host_vector<offset_t> h_column_offsets(column_offsets);
+      thrust::host_vector<index_t> h_row_indices(row_indices);
+      thrust::host_vector<value_t> h_nonzero_values(nonzero_values);
+
+      io::binary::write(filename, header, h_column_offsets.data(),
+                        h_row_indices.data(), h_nonzero_values.data());
+    } else {
+      io::binary::write(filename, header,
+                        raw_pointer_cast(column_offsets.data()),
+                        raw_pointer_cast(row_indices.data()),
+                        raw_pointer_cast(nonzero_values.data()));
+    }
+  }
+
 };  // struct csc_t
 
 }  // namespace format
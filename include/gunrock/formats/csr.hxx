@@ -3,8 +3,13 @@
 #include <gunrock/memory.hxx>
 #include <gunrock/container/vector.hxx>
 #include <gunrock/formats/formats.hxx>
+#include <gunrock/io/binary.hxx>
 
 #include <thrust/transform.h>
+#include <thrust/binary_search.h>
+#include <thrust/iterator/counting_iterator.h>
+
+#include <type_traits>
 
 namespace gunrock {
 namespace format {
@@ -51,166 +56,107 @@ struct csr_t {
 
   /**
    * @brief Convert a Coordinate Sparse Format into Compressed Sparse Row
-   * Format.
+   * Format. The coordinate format is uploaded once to the CSR's memory space
+   * and the whole conversion runs there: the nonzeros are sorted by (row,
+   * column) (see `coo_t::sort()`), and the row offsets are derived from the
+   * sorted row indices with a vectorized binary search.
    *
    * @tparam index_t
    * @tparam offset_t
    * @tparam value_t
    * @param coo
+   * @param remove_self_loops remove (i, i) entries.
+   * @param remove_duplicates keep only one of the (i, j) entries.
    * @return csr_t<space, index_t, offset_t, value_t>&
    */
   csr_t<space, index_t, offset_t, value_t> from_coo(
-      const coo_t<memory_space_t::host, index_t, offset_t, value_t>& coo) {
-    number_of_rows = coo.number_of_rows;
-    number_of_columns = coo.number_of_columns;
-    number_of_nonzeros = coo.number_of_nonzeros;
-
-    // Allocate space for vectors
-    vector_t<offset_t, memory_space_t::host> _Ap;
-    vector_t<index_t, memory_space_t::host> _Aj;
-    vector_t<value_t, memory_space_t::host> _Ax;
-
-    offset_t* Ap;
-    index_t* Aj;
-    value_t* Ax;
-
-    if (space == memory_space_t::device) {
-      assert(space == memory_space_t::device);
-      // If returning csr_t on device, allocate temporary host vectors, build on
-      // host and move to device.
-      _Ap.resize(number_of_rows + 1);
-      _Aj.resize(number_of_nonzeros);
-      _Ax.resize(number_of_nonzeros);
-
-      Ap = _Ap.data();
-      Aj = _Aj.data();
-      Ax = _Ax.data();
-
-    } else {
-      assert(space == memory_space_t::host);
-      // If returning csr_t on host, use it's internal memory to build from COO.
-      row_offsets.resize(number_of_rows + 1);
-      column_indices.resize(number_of_nonzeros);
-      nonzero_values.resize(number_of_nonzeros);
-
-      Ap = raw_pointer_cast(row_offsets.data());
-      Aj = raw_pointer_cast(column_indices.data());
-      Ax = raw_pointer_cast(nonzero_values.data());
-    }
-
-    // compute number of non-zero entries per row of A.
-    for (offset_t n = 0; n < number_of_nonzeros; ++n) {
-      ++Ap[coo.row_indices[n]];
-    }
-
-    // cumulative sum the nnz per row to get row_offsets[].
-    for (index_t i = 0, sum = 0; i < number_of_rows; ++i) {
-      index_t temp = Ap[i];
-      Ap[i] = sum;
-      sum += temp;
-    }
-    Ap[number_of_rows] = number_of_nonzeros;
-
-    // write coordinate column indices and nonzero values into CSR's
-    // column indices and nonzero values.
-    for (offset_t n = 0; n < number_of_nonzeros; ++n) {
-      index_t row = coo.row_indices[n];
-      index_t dest = Ap[row];
-
-      Aj[dest] = coo.column_indices[n];
-      Ax[dest] = coo.nonzero_values[n];
-
-      ++Ap[row];
-    }
-
-    for (index_t i = 0, last = 0; i <= number_of_rows; ++i) {
-      index_t temp = Ap[i];
-      Ap[i] = last;
-      last = temp;
-    }
-
-    // If returning a device csr_t, move coverted data to device.
-    if (space == memory_space_t::device) {
-      row_offsets = _Ap;
-      column_indices = _Aj;
-      nonzero_values = _Ax;
-    }
+      const coo_t<memory_space_t::host, index_t, offset_t, value_t>& coo,
+      bool remove_self_loops = false,
+      bool remove_duplicates = false) {
+    using execution_policy_t =
+        std::conditional_t<is_device_accessible(space),
+                           decltype(thrust::device), decltype(thrust::host)>;
+    execution_policy_t exec;
+
+    coo_t<space, index_t, offset_t, value_t> sorted;
+    sorted.number_of_rows = coo.number_of_rows;
+    sorted.number_of_columns = coo.number_of_columns;
+    sorted.number_of_nonzeros = coo.number_of_nonzeros;
+    sorted.row_indices = coo.row_indices;
+    sorted.column_indices = coo.column_indices;
+    sorted.nonzero_values = coo.nonzero_values;
+    sorted.sort(remove_self_loops, remove_duplicates);
+
+    number_of_rows = sorted.number_of_rows;
+    number_of_columns = sorted.number_of_columns;
+    number_of_nonzeros = sorted.number_of_nonzeros;
+
+    // row_offsets[i] = first nonzero of row i, within the sorted row indices.
+    row_offsets.resize(number_of_rows + 1);
+    auto I = raw_pointer_cast(sorted.row_indices.data());
+    thrust::lower_bound(exec, I, I + number_of_nonzeros,
+                        thrust::counting_iterator<index_t>(0),
+                        thrust::counting_iterator<index_t>(number_of_rows + 1),
+                        row_offsets.begin());
 
-    // XXX: Clean-up?
-    Ap = nullptr;
-    Ax = nullptr;
-    Aj = nullptr;
+    column_indices.swap(sorted.column_indices);
+    nonzero_values.swap(sorted.nonzero_values);
 
-    return *this;  // CSR representation (with possible duplicates)
+    return *this;  // CSR representation
   }
 
-  void read_binary(std::string filename) {
-    FILE* file = fopen(filename.c_str(), "rb");
+  /**
+   * @brief Load a binary CSR file (see `io::binary`). The file is mapped and
+   * its arrays are copied straight into this container, through pinned
+   * staging buffers when on the device. The type widths recorded in the file
+   * must match `index_t`, `offset_t` and `value_t`.
+   *
+   * @param filename binary CSR file.
+   * @param stream stream for the host to device copies.
+   */
+  void read_binary(std::string filename, cudaStream_t stream = 0) {
+    io::mapped_file_t file(filename);
+    auto header = io::binary::read_header<index_t, offset_t, value_t>(
+        file, io::binary::layout_t::csr);
 
-    // Read metadata
-    fread(&number_of_rows,     sizeof(index_t),  1, file);
-    fread(&number_of_columns,  sizeof(index_t),  1, file);
-    fread(&number_of_nonzeros, sizeof(offset_t), 1, file);
+    number_of_rows = header.number_of_rows;
+    number_of_columns = header.number_of_columns;
+    number_of_nonzeros = header.number_of_nonzeros;
 
     row_offsets.resize(number_of_rows + 1);
     column_indices.resize(number_of_nonzeros);
     nonzero_values.resize(number_of_nonzeros);
 
-    if(space == memory_space_t::device) {
-      assert(space == memory_space_t::device);
-
-      thrust::host_vector<offset_t> h_row_offsets(number_of_rows + 1);
-      thrust::host_vector<index_t> h_column_indices(number_of_nonzeros);
-      thrust::host_vector<value_t> h_nonzero_values(number_of_nonzeros);
-
-      fread(memory::raw_pointer_cast(h_row_offsets.data()),     sizeof(offset_t), number_of_rows + 1, file);
-      fread(memory::raw_pointer_cast(h_column_indices.data()),  sizeof(index_t),  number_of_nonzeros, file);
-      fread(memory::raw_pointer_cast(h_nonzero_values.data()),  sizeof(value_t),  number_of_nonzeros, file);
-
-      // Copy data from host to device
-      row_offsets    = h_row_offsets;
-      column_indices = h_column_indices;
-      nonzero_values = h_nonzero_values;
-
-    } else {
-      assert(space == memory_space_t::host);
-
-      fread(memory::raw_pointer_cast(row_offsets.data()),     sizeof(offset_t), number_of_rows + 1, file);
-      fread(memory::raw_pointer_cast(column_indices.data()),  sizeof(index_t),  number_of_nonzeros, file);
-      fread(memory::raw_pointer_cast(nonzero_values.data()),  sizeof(value_t),  number_of_nonzeros, file);      
-    }
+    io::binary::read(file, header, raw_pointer_cast(row_offsets.data()),
+                     raw_pointer_cast(column_indices.data()),
+                     raw_pointer_cast(nonzero_values.data()),
+                     is_device_accessible(space), stream);
   }
-  
-  void write_binary(std::string filename) {
-    FILE* file = fopen(filename.c_str(), "wb");
-
-    // Write metadata
-    fwrite(&number_of_rows,      sizeof(index_t),  1, file);
-    fwrite(&number_of_columns,   sizeof(index_t),  1, file);
-    fwrite(&number_of_nonzeros,  sizeof(offset_t), 1, file);
 
-    // Write data
-    if(space == memory_space_t::device) {
-      assert(space == memory_space_t::device);
+  /**
+   * @brief Write this CSR to a (versioned) binary file, see `io::binary`.
+   *
+   * @param filename output file.
+   */
+  void write_binary(std::string filename) {
+    auto header = io::binary::make_header<index_t, offset_t, value_t>(
+        io::binary::layout_t::csr, number_of_rows, number_of_columns,
+        number_of_nonzeros);
 
+    if (is_device_accessible(space)) {
       thrust::host_vector<offset_t> h_row_offsets(row_offsets);
       thrust::host_vector<index_t> h_column_indices(column_indices);
       thrust::host_vector<value_t> h_nonzero_values(nonzero_values);
 
-      fwrite(memory::raw_pointer_cast(h_row_offsets.data()),    sizeof(offset_t), number_of_rows + 1, file);
-      fwrite(memory::raw_pointer_cast(h_column_indices.data()), sizeof(index_t),  number_of_nonzeros, file);
-      fwrite(memory::raw_pointer_cast(h_nonzero_values.data()), sizeof(value_t),  number_of_nonzeros, file);
+      io::binary::write(filename, header, h_row_offsets.data(),
+                        h_column_indices.data(), h_nonzero_values.data());
     } else {
-      assert(space == memory_space_t::host);
-
-      fwrite(memory::raw_pointer_cast(row_offsets.data()),    sizeof(offset_t), number_of_rows + 1, file);
-      fwrite(memory::raw_pointer_cast(column_indices.data()), sizeof(index_t),  number_of_nonzeros, file);
-      fwrite(memory::raw_pointer_cast(nonzero_values.data()), sizeof(value_t),  number_of_nonzeros, file);
+      io::binary::write(filename, header, raw_pointer_cast(row_offsets.data()),
+                        raw_pointer_cast(column_indices.data()),
+                        raw_pointer_cast(nonzero_values.data()));
     }
-
-    fclose(file);
   }
-  
+
 };  // struct csr_t
 
 }  // namespace format
@@ -0,0 +1,433 @@
+/**
+ * @file dynamic_csr.hxx
+ * @author Muhammad Osama (mosama@ucdavis.edu)
+ * @brief Gap-buffered Compressed Sparse Row format, supporting batched edge
+ * insertions and deletions.
+ * @version 0.1
+ * @date 2021-06-20
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#pragma once
+
+#include <gunrock/memory.hxx>
+#include <gunrock/util/math.hxx>
+#include <gunrock/util/type_limits.hxx>
+#include <gunrock/container/vector.hxx>
+#include <gunrock/formats/formats.hxx>
+
+#include <thrust/binary_search.h>
+#include <thrust/copy.h>
+#include <thrust/count.h>
+#include <thrust/fill.h>
+#include <thrust/for_each.h>
+#include <thrust/functional.h>
+#include <thrust/logical.h>
+#include <thrust/reduce.h>
+#include <thrust/remove.h>
+#include <thrust/scan.h>
+#include <thrust/scatter.h>
+#include <thrust/sort.h>
+#include <thrust/transform.h>
+#include <thrust/unique.h>
+#include <thrust/iterator/constant_iterator.h>
+#include <thrust/iterator/counting_iterator.h>
+#include <thrust/iterator/zip_iterator.h>
+
+namespace gunrock {
+namespace format {
+
+using namespace memory;
+
+/**
+ * @brief A batch of edges (in device-accessible memory), inserted into or
+ * deleted from a `dynamic_csr_t`.
+ *
+ * @tparam index_t
+ * @tparam value_t
+ */
+template <typename index_t, typename value_t>
+struct edge_batch_t {
+  index_t const* sources = nullptr;
+  index_t const* destinations = nullptr;
+  value_t const* values = nullptr;  // insertions only, nullptr: weight 1.
+  std::size_t size = 0;
+};
+
+/**
+ * @brief Compressed Sparse Row (CSR) format with a gap after every row, such
+ * that edge batches are inserted in place: every row owns the slots
+ * `[row_offsets[v], row_offsets[v + 1])`, the first `row_sizes[v]` of which
+ * hold its edges, the rest are invalid. Edge ids are slots.
+ *
+ * @par Overview
+ * An insertion sorts the batch by (row, column), drops the duplicates and
+ * the edges that already exist (whose values are updated instead), and
+ * appends every row's new edges after its existing ones. Only if a row runs
+ * out of gap, all the rows are laid out again, with a gap of `slack` times
+ * their size (at least `min_slack` slots). A deletion invalidates the
+ * deleted slots, and compacts the rows it touched. Neither keeps the column
+ * indices of a row sorted. The number of rows (vertices) is fixed.
+ *
+ * @tparam space device-accessible memory space.
+ * @tparam index_t
+ * @tparam offset_t
+ * @tparam value_t
+ */
+template <memory_space_t space,
+          typename index_t,
+          typename offset_t,
+          typename value_t>
+struct dynamic_csr_t {
+  static_assert(memory::is_device_accessible(space),
+                "Dynamic CSR is only supported in device-accessible memory.");
+
+  index_t number_of_rows;
+  index_t number_of_columns;
+  offset_t number_of_nonzeros;  // live edges.
+
+  /*!
+   * Gap of a row, relative to its size, and its minimum (slots).
+   */
+  float slack = 0.25f;
+  offset_t min_slack = 4;
+
+  vector_t<offset_t, space> row_offsets;   // first slot of every row
+  vector_t<offset_t, space> row_sizes;     // edges of every row
+  vector_t<index_t, space> column_indices;  // slots
+  vector_t<value_t, space> nonzero_values;  // slots
+
+  dynamic_csr_t()
+      : number_of_rows(0), number_of_columns(0), number_of_nonzeros(0) {}
+
+  using execution_policy_t = decltype(thrust::device);
+
+  __host__ __device__ static constexpr index_t invalid() {
+    return gunrock::numeric_limits<index_t>::invalid();
+  }
+
+  /**
+   * @brief Lay out a CSR with a gap after every row.
+   *
+   * @param csr CSR.
+   * @return dynamic_csr_t&
+   */
+  dynamic_csr_t& from_csr(csr_t<space, index_t, offset_t, value_t> const& csr) {
+    execution_policy_t exec;
+
+    number_of_rows = csr.number_of_rows;
+    number_of_columns = csr.number_of_columns;
+    number_of_nonzeros = csr.number_of_nonzeros;
+
+    row_offsets = csr.row_offsets;
+    column_indices = csr.column_indices;
+    nonzero_values = csr.nonzero_values;
+
+    row_sizes.resize(number_of_rows);
+    auto offsets = raw_pointer_cast(row_offsets.data());
+    thrust::transform(exec, thrust::make_counting_iterator<index_t>(0),
+                      thrust::make_counting_iterator<index_t>(number_of_rows),
+                      row_sizes.begin(),
+                      [=] __host__ __device__(index_t const& v) -> offset_t {
+                        return offsets[v + 1] - offsets[v];
+                      });
+
+    relayout(nullptr);
+    return *this;
+  }
+
+  /**
+   * @brief Compacted (gap-less) CSR of the live edges, rows not sorted.
+   *
+   * @return csr_t<space, index_t, offset_t, value_t>
+   */
+  csr_t<space, index_t, offset_t, value_t> to_csr() {
+    csr_t<space, index_t, offset_t, value_t> csr;
+    csr.number_of_rows = number_of_rows;
+    csr.number_of_columns = number_of_columns;
+    csr.number_of_nonzeros = number_of_nonzeros;
+    layout(csr.row_offsets, csr.column_indices, csr.nonzero_values, nullptr,
+           0.0f, 0);
+    return csr;
+  }
+
+  std::size_t get_number_of_slots() const { return column_indices.size(); }
+
+  /**
+   * @brief Insert a batch of edges. Edges already present (and duplicates
+   * within the batch, the first of which is kept) are not inserted again,
+   * the value of an existing edge is updated.
+   *
+   * @param batch edges, with every source and destination within the rows
+   * and columns of the format.
+   * @return std::size_t number of edges inserted.
+   */
+  std::size_t insert_edges(edge_batch_t<index_t, value_t> const& batch) {
+    execution_policy_t exec;
+    std::size_t size = batch.size;
+    if (size == 0)
+      return 0;
+
+    vector_t<index_t, space> sources(size), destinations(size);
+    vector_t<value_t, space> values(size, (value_t)1);
+    thrust::copy(exec, batch.sources, batch.sources + size, sources.begin());
+    thrust::copy(exec, batch.destinations, batch.destinations + size,
+                 destinations.begin());
+    if (batch.values)
+      thrust::copy(exec, batch.values, batch.values + size, values.begin());
+
+    auto S = raw_pointer_cast(sources.data());
+    auto D = raw_pointer_cast(destinations.data());
+    auto W = raw_pointer_cast(values.data());
+
+    // Sort by (source, destination), least-significant key first.
+    thrust::stable_sort_by_key(
+        exec, D, D + size, thrust::make_zip_iterator(thrust::make_tuple(S, W)));
+    thrust::stable_sort_by_key(
+        exec, S, S + size, thrust::make_zip_iterator(thrust::make_tuple(D, W)));
+    auto pairs = thrust::make_zip_iterator(thrust::make_tuple(S, D));
+    size = thrust::distance(
+        pairs, thrust::unique_by_key(exec, pairs, pairs + size, W).first);
+
+    // Update the existing edges, and drop them from the batch.
+    auto offsets = raw_pointer_cast(row_offsets.data());
+    auto sizes = raw_pointer_cast(row_sizes.data());
+    auto columns = raw_pointer_cast(column_indices.data());
+    auto weights = raw_pointer_cast(nonzero_values.data());
+
+    vector_t<char, space> existing(size);
+    auto exists = raw_pointer_cast(existing.data());
+    thrust::for_each(exec, thrust::make_counting_iterator<std::size_t>(0),
+                     thrust::make_counting_iterator<std::size_t>(size),
+                     [=] __host__ __device__(std::size_t const& i) {
+                       offset_t begin = offsets[S[i]];
+                       offset_t end = begin + sizes[S[i]];
+                       exists[i] = 0;
+                       for (offset_t e = begin; e < end; ++e) {
+                         if (columns[e] == D[i]) {
+                           weights[e] = W[i];
+                           exists[i] = 1;
+                           break;
+                         }
+                       }
+                     });
+
+    auto entries = thrust::make_zip_iterator(thrust::make_tuple(S, D, W));
+    size = thrust::distance(
+        entries, thrust::remove_if(exec, entries, entries + size, exists,
+                                   thrust::identity<char>()));
+    if (size == 0)
+      return 0;
+
+    // New edges of every row.
+    vector_t<index_t, space> rows(size);
+    vector_t<offset_t, space> counts(size);
+    std::size_t number_of_groups = thrust::distance(
+        rows.begin(),
+        thrust::reduce_by_key(exec, S, S + size,
+                              thrust::make_constant_iterator<offset_t>(1),
+                              rows.begin(), counts.begin())
+            .first);
+
+    auto R = raw_pointer_cast(rows.data());
+    auto C = raw_pointer_cast(counts.data());
+    bool overflow = thrust::any_of(
+        exec, thrust::make_counting_iterator<std::size_t>(0),
+        thrust::make_counting_iterator<std::size_t>(number_of_groups),
+        [=] __host__ __device__(std::size_t const& g) {
+          return sizes[R[g]] + C[g] > offsets[R[g] + 1] - offsets[R[g]];
+        });
+
+    if (overflow) {
+      vector_t<offset_t, space> extra(number_of_rows, 0);
+      thrust::scatter(exec, counts.begin(), counts.begin() + number_of_groups,
+                      rows.begin(), extra.begin());
+      relayout(raw_pointer_cast(extra.data()));
+
+      offsets = raw_pointer_cast(row_offsets.data());
+      sizes = raw_pointer_cast(row_sizes.data());
+      columns = raw_pointer_cast(column_indices.data());
+      weights = raw_pointer_cast(nonzero_values.data());
+    }
+
+    // Append after the existing edges, in the order of the batch.
+    vector_t<std::size_t, space> firsts(size);
+    thrust::lower_bound(exec, S, S + size, S, S + size, firsts.begin());
+    auto F = raw_pointer_cast(firsts.data());
+    thrust::for_each(exec, thrust::make_counting_iterator<std::size_t>(0),
+                     thrust::make_counting_iterator<std::size_t>(size),
+                     [=] __host__ __device__(std::size_t const& i) {
+                       offset_t slot =
+                           offsets[S[i]] + sizes[S[i]] + (offset_t)(i - F[i]);
+                       columns[slot] = D[i];
+                       weights[slot] = W[i];
+                     });
+    thrust::for_each(
+        exec, thrust::make_counting_iterator<std::size_t>(0),
+        thrust::make_counting_iterator<std::size_t>(number_of_groups),
+        [=] __host__ __device__(std::size_t const& g) { sizes[R[g]] += C[g]; });
+
+    number_of_nonzeros += (offset_t)size;
+    return size;
+  }
+
+  /**
+   * @brief Delete a batch of edges, an edge of the batch that is not present
+   * is ignored (one instance of a repeated edge is deleted per occurrence).
+   *
+   * @param batch edges (values ignored).
+   * @return std::size_t number of edges deleted.
+   */
+  std::size_t delete_edges(edge_batch_t<index_t, value_t> const& batch) {
+    execution_policy_t exec;
+    std::size_t size = batch.size;
+    if (size == 0)
+      return 0;
+
+    auto offsets = raw_pointer_cast(row_offsets.data());
+    auto sizes = raw_pointer_cast(row_sizes.data());
+    auto columns = raw_pointer_cast(column_indices.data());
+    auto weights = raw_pointer_cast(nonzero_values.data());
+    auto S = batch.sources;
+    auto D = batch.destinations;
+
+    // Invalidate the slots, each by one deletion only.
+    vector_t<char, space> deleted(size);
+    auto removed = raw_pointer_cast(deleted.data());
+    thrust::for_each(
+        exec, thrust::make_counting_iterator<std::size_t>(0),
+        thrust::make_counting_iterator<std::size_t>(size),
+        [=] __host__ __device__(std::size_t const& i) {
+          offset_t begin = offsets[S[i]];
+          offset_t end = begin + sizes[S[i]];
+          removed[i] = 0;
+          for (offset_t e = begin; e < end; ++e) {
+            if (columns[e] == D[i] &&
+                math::atomic::cas(columns + e, D[i], invalid()) == D[i]) {
+              removed[i] = 1;
+              break;
+            }
+          }
+        });
+
+    std::size_t number_of_deleted =
+        thrust::count(exec, deleted.begin(), deleted.end(), 1);
+    if (number_of_deleted == 0)
+      return 0;
+
+    // Compact the rows touched.
+    vector_t<index_t, space> rows(number_of_deleted);
+    thrust::copy_if(exec, S, S + size, deleted.begin(), rows.begin(),
+                    thrust::identity<char>());
+    thrust::sort(exec, rows.begin(), rows.end());
+    std::size_t number_of_rows_touched = thrust::distance(
+        rows.begin(), thrust::unique(exec, rows.begin(), rows.end()));
+
+    auto R = raw_pointer_cast(rows.data());
+    thrust::for_each(
+        exec, thrust::make_counting_iterator<std::size_t>(0),
+        thrust::make_counting_iterator<std::size_t>(number_of_rows_touched),
+        [=] __host__ __device__(std::size_t const& g) {
+          index_t v = R[g];
+          offset_t begin = offsets[v];
+          offset_t end = begin + sizes[v];
+          offset_t kept = begin;
+          for (offset_t e = begin; e < end; ++e) {
+            if (columns[e] != invalid()) {
+              columns[kept] = columns[e];
+              weights[kept] = weights[e];
+              ++kept;
+            }
+          }
+          for (offset_t e = kept; e < end; ++e)
+            columns[e] = invalid();
+          sizes[v] = kept - begin;
+        });
+
+    number_of_nonzeros -= (offset_t)number_of_deleted;
+    return number_of_deleted;
+  }
+
+  // Layout helpers, public: device lambdas cannot be defined within private
+  // member functions.
+
+  /**
+   * @brief Lay out the live edges again, every row with room for `extra`
+   * more edges (`nullptr`: none) and the gap (see `slack`).
+   */
+  void relayout(offset_t const* extra) {
+    vector_t<offset_t, space> offsets;
+    vector_t<index_t, space> columns;
+    vector_t<value_t, space> values;
+    layout(offsets, columns, values, extra, slack, min_slack);
+    row_offsets.swap(offsets);
+    column_indices.swap(columns);
+    nonzero_values.swap(values);
+  }
+
+  /**
+   * @brief Copy the live edges into a new layout, whose row `v` has
+   * `size + extra[v]` slots plus a gap of `gap` times that (at least
+   * `min_gap` slots).
+   */
+  void layout(vector_t<offset_t, space>& new_offsets,
+              vector_t<index_t, space>& new_columns,
+              vector_t<value_t, space>& new_values,
+              offset_t const* extra,
+              float gap,
+              offset_t min_gap) {
+    execution_policy_t exec;
+    index_t n = number_of_rows;
+    auto sizes = raw_pointer_cast(row_sizes.data());
+
+    new_offsets.resize(n + 1);
+    thrust::transform_exclusive_scan(
+        exec, thrust::make_counting_iterator<index_t>(0),
+        thrust::make_counting_iterator<index_t>(n + 1), new_offsets.begin(),
+        [=] __host__ __device__(index_t const& v) -> offset_t {
+          if (v == n)
+            return 0;
+          offset_t needed = sizes[v] + (extra ? extra[v] : 0);
+          offset_t padding = (offset_t)(needed * gap);
+          return needed + (padding > min_gap ? padding : min_gap);
+        },
+        (offset_t)0, thrust::plus<offset_t>());
+
+    std::size_t slots = new_offsets[n];
+    new_columns.resize(slots);
+    new_values.resize(slots);
+    thrust::fill(exec, new_columns.begin(), new_columns.end(), invalid());
+
+    // Row of every old slot, then move the live ones.
+    std::size_t old_slots = column_indices.size();
+    vector_t<index_t, space> slot_rows(old_slots);
+    auto old_offsets = raw_pointer_cast(row_offsets.data());
+    thrust::upper_bound(exec, old_offsets, old_offsets + n + 1,
+                        thrust::make_counting_iterator<offset_t>(0),
+                        thrust::make_counting_iterator<offset_t>(old_slots),
+                        slot_rows.begin());
+
+    auto rows = raw_pointer_cast(slot_rows.data());
+    auto columns = raw_pointer_cast(column_indices.data());
+    auto values = raw_pointer_cast(nonzero_values.data());
+    auto to_offsets = raw_pointer_cast(new_offsets.data());
+    auto to_columns = raw_pointer_cast(new_columns.data());
+    auto to_values = raw_pointer_cast(new_values.data());
+    thrust::for_each(exec, thrust::make_counting_iterator<offset_t>(0),
+                     thrust::make_counting_iterator<offset_t>(old_slots),
+                     [=] __host__ __device__(offset_t const& e) {
+                       index_t v = rows[e] - 1;
+                       offset_t k = e - old_offsets[v];
+                       if (k < sizes[v]) {
+                         to_columns[to_offsets[v] + k] = columns[e];
+                         to_values[to_offsets[v] + k] = values[e];
+                       }
+                     });
+  }
+
+};  // struct dynamic_csr_t
+
+}  // namespace format
+}  // namespace gunrock
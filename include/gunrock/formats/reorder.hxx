@@ -0,0 +1,421 @@
+/**
+ * @file reorder.hxx
+ * @author Muhammad Osama (mosama@ucdavis.edu)
+ * @brief Vertex reordering (relabeling) of a CSR graph for locality: degree
+ * sort, breadth-first order and Reverse Cuthill-McKee, computed on the GPU,
+ * with the permutation to map results back to the original ids.
+ * @version 0.1
+ * @date 2021-06-17
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#pragma once
+
+#include <gunrock/error.hxx>
+#include <gunrock/memory.hxx>
+#include <gunrock/container/vector.hxx>
+#include <gunrock/util/math.hxx>
+#include <gunrock/util/type_limits.hxx>
+
+#include <thrust/copy.h>
+#include <thrust/count.h>
+#include <thrust/fill.h>
+#include <thrust/find.h>
+#include <thrust/for_each.h>
+#include <thrust/functional.h>
+#include <thrust/gather.h>
+#include <thrust/reverse.h>
+#include <thrust/scan.h>
+#include <thrust/scatter.h>
+#include <thrust/sequence.h>
+#include <thrust/sort.h>
+#include <thrust/transform.h>
+#include <thrust/iterator/counting_iterator.h>
+#include <thrust/iterator/zip_iterator.h>
+
+#include <limits>
+
+namespace gunrock {
+namespace format {
+namespace reorder {
+
+using namespace memory;
+
+/**
+ * @brief Vertex orders.
+ *
+ * @par Overview
+ *  - `degree`: decreasing degree, the high-degree vertices (touched by most
+ *    advances) share cache lines.
+ *  - `bfs`: breadth-first order from a source, the vertices of a level are
+ *    grouped by their first parent.
+ *  - `rcm`: Reverse Cuthill-McKee, breadth-first from a low-degree vertex
+ *    with the vertices of a level sorted by (parent, degree), reversed; keeps
+ *    the neighbors of a vertex close to it (low bandwidth).
+ */
+enum algorithm_t {
+  degree,  /// Decreasing degree.
+  bfs,     /// Breadth-first order.
+  rcm      /// Reverse Cuthill-McKee.
+};         // enum: algorithm_t
+
+/**
+ * @brief Permutation between the original and the reordered vertex ids.
+ *
+ * @tparam index_t vertex type.
+ */
+template <typename index_t>
+struct permutation_t {
+  /*!
+   * `labels[original] = reordered`.
+   */
+  vector_t<index_t, memory_space_t::device> labels;
+
+  /*!
+   * `order[reordered] = original`.
+   */
+  vector_t<index_t, memory_space_t::device> order;
+
+  std::size_t size() const { return labels.size(); }
+
+  /**
+   * @brief Reordered id of an original vertex (e.g. a source), synchronous.
+   */
+  index_t get_reordered_id(index_t const& original) const {
+    return labels[original];
+  }
+
+  /**
+   * @brief Original id of a reordered vertex, synchronous.
+   */
+  index_t get_original_id(index_t const& reordered) const {
+    return order[reordered];
+  }
+
+  /**
+   * @brief Per-vertex values (e.g. distances) computed on the reordered
+   * graph, in the original vertex order: `original[v] = reordered[labels[v]]`.
+   *
+   * @param reordered input (device), indexed by reordered ids.
+   * @param original output (device), indexed by original ids.
+   * @param stream stream.
+   */
+  template <typename type_t>
+  void to_original(type_t const* reordered,
+                   type_t* original,
+                   cudaStream_t stream = 0) const {
+    thrust::gather(thrust::cuda::par.on(stream), labels.begin(), labels.end(),
+                   reordered, original);
+  }
+
+  /**
+   * @brief Per-vertex values in the original order (e.g. initial values), in
+   * the reordered vertex order.
+   */
+  template <typename type_t>
+  void to_reordered(type_t const* original,
+                    type_t* reordered,
+                    cudaStream_t stream = 0) const {
+    thrust::gather(thrust::cuda::par.on(stream), order.begin(), order.end(),
+                   original, reordered);
+  }
+
+  /**
+   * @brief Vertex ids computed on the reordered graph (e.g. predecessors), as
+   * original ids, in place. Invalid ids are kept.
+   *
+   * @param ids vertex ids (device).
+   * @param size number of ids.
+   * @param stream stream.
+   */
+  void ids_to_original(index_t* ids,
+                       std::size_t size,
+                       cudaStream_t stream = 0) const {
+    auto original = order.data().get();
+    thrust::transform(thrust::cuda::par.on(stream), ids, ids + size, ids,
+                      [=] __device__(index_t const& v) {
+                        return gunrock::util::limits::is_valid(v) ? original[v]
+                                                                  : v;
+                      });
+  }
+};
+
+namespace detail {
+
+/**
+ * @brief Breadth-first (Cuthill-McKee) labeling. Every connected component
+ * is traversed from a seed, level by level: the unlabeled neighbors of a
+ * level are claimed by their lowest-labeled parent, then labeled in (parent,
+ * degree, id) order (`by_degree`) or (parent, id) order. Vertices without any
+ * edge are labeled last.
+ *
+ * @note Components after the first are seeded with their lowest-degree
+ * (`by_degree`) or lowest-id unlabeled vertex, one traversal per component;
+ * the candidates are sorted once and scanned with a cursor.
+ * The sort key packs the parent label and the degree (clamped) in 64 bits.
+ */
+template <typename index_t, typename offset_t>
+void traversal_order(index_t n,
+                     offset_t const* offsets,
+                     index_t const* columns,
+                     offset_t nnz,
+                     index_t source,
+                     bool by_degree,
+                     index_t* labels,
+                     index_t* order) {
+  using key_t = unsigned long long;
+  constexpr index_t unlabeled = std::numeric_limits<index_t>::max();
+  constexpr key_t unclaimed = std::numeric_limits<key_t>::max();
+  constexpr key_t max_degree = 0xffffffffull;
+  auto policy = thrust::device;
+
+  vector_t<char, memory_space_t::device> has_edges(n, 0);
+  vector_t<key_t, memory_space_t::device> claims(n, unclaimed);
+  vector_t<key_t, memory_space_t::device> sort_keys(n);
+  vector_t<index_t, memory_space_t::device> candidates(n);
+  vector_t<index_t, memory_space_t::device> counter(1);
+
+  auto edges = has_edges.data().get();
+  auto claimed = claims.data().get();
+  auto keys = sort_keys.data().get();
+  auto queue = candidates.data().get();
+  auto count = counter.data().get();
+
+  thrust::fill(policy, labels, labels + n, unlabeled);
+  thrust::for_each(policy, thrust::make_counting_iterator<index_t>(0),
+                   thrust::make_counting_iterator<index_t>(n),
+                   [=] __device__(index_t const& v) {
+                     if (offsets[v + 1] > offsets[v])
+                       edges[v] = 1;
+                   });
+  thrust::for_each(policy, thrust::make_counting_iterator<offset_t>(0),
+                   thrust::make_counting_iterator<offset_t>(nnz),
+                   [=] __device__(offset_t const& e) {
+                     edges[columns[e]] = 1;
+                   });
+
+  index_t reachable = thrust::count(policy, edges, edges + n, 1);
+
+  // Seeds of the components, the vertices with an edge in (degree, id) or
+  // id order. A cursor moves past the labeled ones, so seeding all the
+  // components scans the seeds once.
+  vector_t<index_t, memory_space_t::device> seed_candidates(reachable);
+  auto seeds = seed_candidates.data().get();
+  thrust::copy_if(policy, thrust::make_counting_iterator<index_t>(0),
+                  thrust::make_counting_iterator<index_t>(n), seeds,
+                  [=] __device__(index_t const& v) { return edges[v] != 0; });
+  if (by_degree) {
+    thrust::transform(policy, seeds, seeds + reachable, keys,
+                      [=] __device__(index_t const& v) -> key_t {
+                        return offsets[v + 1] - offsets[v];
+                      });
+    thrust::stable_sort_by_key(policy, keys, keys + reachable, seeds);
+  }
+  auto is_unlabeled = [=] __device__(index_t const& v) {
+    return labels[v] == unlabeled;
+  };
+
+  index_t next = 0;
+  index_t cursor = 0;
+  bool first = true;
+  while (next < reachable) {
+    index_t seed = source;
+    if (!first || source < 0 || source >= n || has_edges[source] == 0) {
+      cursor = thrust::find_if(policy, seeds + cursor, seeds + reachable,
+                               is_unlabeled) -
+               seeds;
+      seed = seed_candidates[cursor];
+    }
+    first = false;
+
+    thrust::fill(policy, labels + seed, labels + seed + 1, next);
+    thrust::fill(policy, order + next, order + next + 1, seed);
+    index_t level_begin = next++;
+
+    while (level_begin < next) {
+      index_t level_end = next;
+      thrust::fill(policy, count, count + 1, 0);
+
+      // Claim the unlabeled neighbors of the level by their lowest parent.
+      thrust::for_each(
+          policy, thrust::make_counting_iterator<index_t>(level_begin),
+          thrust::make_counting_iterator<index_t>(level_end),
+          [=] __device__(index_t const& i) {
+            index_t u = order[i];
+            for (offset_t e = offsets[u]; e < offsets[u + 1]; ++e) {
+              index_t w = columns[e];
+              if (labels[w] != unlabeled)
+                continue;
+              key_t previous = math::atomic::min(claimed + w, (key_t)i);
+              if (previous == unclaimed)
+                queue[math::atomic::add(count, (index_t)1)] = w;
+            }
+          });
+
+      index_t size = counter[0];
+      if (size == 0)
+        break;
+
+      // Label the claimed vertices in (parent, degree, id) order.
+      thrust::sort(policy, queue, queue + size);
+      thrust::transform(policy, queue, queue + size, keys,
+                        [=] __device__(index_t const& w) {
+                          key_t degree = 0;
+                          if (by_degree) {
+                            degree = offsets[w + 1] - offsets[w];
+                            degree = (degree < max_degree) ? degree
+                                                           : max_degree;
+                          }
+                          return (claimed[w] << 32) | degree;
+                        });
+      thrust::stable_sort_by_key(policy, keys, keys + size, queue);
+
+      index_t base = next;
+      thrust::for_each(policy, thrust::make_counting_iterator<index_t>(0),
+                       thrust::make_counting_iterator<index_t>(size),
+                       [=] __device__(index_t const& j) {
+                         labels[queue[j]] = base + j;
+                         order[base + j] = queue[j];
+                       });
+
+      next += size;
+      level_begin = level_end;
+    }
+  }
+
+  // Vertices without any edge, last.
+  thrust::copy_if(policy, thrust::make_counting_iterator<index_t>(0),
+                  thrust::make_counting_iterator<index_t>(n), order + reachable,
+                  [=] __device__(index_t const& v) { return edges[v] == 0; });
+  thrust::for_each(policy, thrust::make_counting_iterator<index_t>(reachable),
+                   thrust::make_counting_iterator<index_t>(n),
+                   [=] __device__(index_t const& j) { labels[order[j]] = j; });
+}
+
+}  // namespace detail
+
+/**
+ * @brief Relabel the vertices of a (square, device) CSR in place, for
+ * locality of the per-vertex gathers of the operators. The neighbors of
+ * every row are kept sorted; values follow their edges.
+ *
+ * @par Example
+ * \code
+ * csr.from_coo(mm.load(filename));
+ * auto permutation = format::reorder::execute(csr, format::reorder::rcm);
+ * // ... build the graph from csr, run an algorithm from
+ * // permutation.get_reordered_id(source), then
+ * permutation.to_original(distances_reordered, distances);
+ * \endcode
+ *
+ * @param csr CSR matrix (device), relabeled in place.
+ * @param algorithm `degree`, `bfs` or `rcm`.
+ * @param source seed of the first traversal (`bfs`, `rcm`); an invalid or
+ * isolated source selects one.
+ * @return permutation_t<index_t> between original and reordered ids.
+ */
+template <typename index_t, typename offset_t, typename value_t>
+permutation_t<index_t> execute(
+    csr_t<memory_space_t::device, index_t, offset_t, value_t>& csr,
+    algorithm_t algorithm,
+    index_t source = gunrock::numeric_limits<index_t>::invalid()) {
+  if (csr.number_of_rows != csr.number_of_columns)
+    error::throw_if_exception(cudaErrorInvalidValue,
+                              "Reordering requires a square matrix.");
+
+  auto policy = thrust::device;
+  index_t n = csr.number_of_rows;
+  offset_t nnz = csr.number_of_nonzeros;
+  auto offsets = csr.row_offsets.data().get();
+  auto columns = csr.column_indices.data().get();
+  auto values = csr.nonzero_values.data().get();
+
+  permutation_t<index_t> permutation;
+  permutation.labels.resize(n);
+  permutation.order.resize(n);
+  auto labels = permutation.labels.data().get();
+  auto order = permutation.order.data().get();
+
+  // --
+  // Order
+
+  if (algorithm == algorithm_t::degree) {
+    vector_t<offset_t, memory_space_t::device> degrees(n);
+    thrust::transform(policy, thrust::make_counting_iterator<index_t>(0),
+                      thrust::make_counting_iterator<index_t>(n),
+                      degrees.begin(), [=] __device__(index_t const& v) {
+                        return offsets[v + 1] - offsets[v];
+                      });
+    thrust::sequence(policy, order, order + n);
+    thrust::stable_sort_by_key(policy, degrees.begin(), degrees.end(), order,
+                               thrust::greater<offset_t>());
+    thrust::scatter(policy, thrust::make_counting_iterator<index_t>(0),
+                    thrust::make_counting_iterator<index_t>(n), order, labels);
+  } else {
+    detail::traversal_order(n, offsets, columns, nnz, source,
+                            algorithm == algorithm_t::rcm, labels, order);
+    if (algorithm == algorithm_t::rcm) {
+      thrust::reverse(policy, order, order + n);
+      thrust::transform(policy, labels, labels + n, labels,
+                        [=] __device__(index_t const& l) { return n - 1 - l; });
+    }
+  }
+
+  // --
+  // Relabel the rows (in the new order) and their neighbors.
+
+  vector_t<offset_t, memory_space_t::device> new_offsets(n + 1);
+  vector_t<index_t, memory_space_t::device> new_columns(nnz);
+  vector_t<value_t, memory_space_t::device> new_values(nnz);
+  vector_t<index_t, memory_space_t::device> new_rows(nnz);
+
+  thrust::transform_exclusive_scan(
+      policy, thrust::make_counting_iterator<index_t>(0),
+      thrust::make_counting_iterator<index_t>(n + 1), new_offsets.begin(),
+      [=] __device__(index_t const& i) -> offset_t {
+        if (i == n)
+          return 0;
+        index_t v = order[i];
+        return offsets[v + 1] - offsets[v];
+      },
+      (offset_t)0, thrust::plus<offset_t>());
+
+  auto row_starts = new_offsets.data().get();
+  auto relabeled_columns = new_columns.data().get();
+  auto relabeled_values = new_values.data().get();
+  auto relabeled_rows = new_rows.data().get();
+  thrust::for_each(policy, thrust::make_counting_iterator<index_t>(0),
+                   thrust::make_counting_iterator<index_t>(n),
+                   [=] __device__(index_t const& i) {
+                     index_t v = order[i];
+                     offset_t to = row_starts[i];
+                     for (offset_t e = offsets[v]; e < offsets[v + 1];
+                          ++e, ++to) {
+                       relabeled_rows[to] = i;
+                       relabeled_columns[to] = labels[columns[e]];
+                       relabeled_values[to] = values[e];
+                     }
+                   });
+
+  // Sort the neighbors of every row (two stable passes, by column then row).
+  thrust::stable_sort_by_key(
+      policy, new_columns.begin(), new_columns.end(),
+      thrust::make_zip_iterator(
+          thrust::make_tuple(new_rows.begin(), new_values.begin())));
+  thrust::stable_sort_by_key(
+      policy, new_rows.begin(), new_rows.end(),
+      thrust::make_zip_iterator(
+          thrust::make_tuple(new_columns.begin(), new_values.begin())));
+
+  csr.row_offsets.swap(new_offsets);
+  csr.column_indices.swap(new_columns);
+  csr.nonzero_values.swap(new_values);
+
+  return permutation;
+}
+
+}  // namespace reorder
+}  // namespace format
+}  // namespace gunrock
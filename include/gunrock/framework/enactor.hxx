@@ -10,11 +10,15 @@
  */
 
 #include <vector>
+#include <algorithm>
 
 #include <gunrock/cuda/cuda.hxx>
 
 #include <gunrock/framework/frontier/frontier.hxx>
 #include <gunrock/framework/problem.hxx>
+#include <gunrock/framework/profiler.hxx>
+#include <gunrock/framework/operators/advance/push_pull.hxx>
+#include <gunrock/framework/operators/multi_gpu/state.hxx>
 
 #pragma once
 
@@ -30,11 +34,30 @@ namespace gunrock {
  */
 struct enactor_properties_t {
   /*!
-   * Resizes the frontier by this factor * the size required.
-   * @code frontier.resize(frontier_sizing_factor * new_size);
+   * Growth factor of the frontiers: a frontier too small for an operator's
+   * output (e.g. the `compute_output_length()` of an advance) grows to at
+   * least this factor * its current capacity.
    */
   float frontier_sizing_factor{2};
 
+  /*!
+   * Initial capacity (number of elements) of each frontier buffer, `0` for
+   * the number of vertices. The buffers grow on demand from there.
+   * @note The fused advance-filter grows its output buffer to the number of
+   * edges the first time it runs (within `frontier_memory_budget`), such
+   * that its iterations do not synchronize; the trade-off is an edge-sized
+   * buffer for the algorithms that use it (e.g., BFS, SSSP).
+   */
+  std::size_t initial_frontier_capacity{0};
+
+  /*!
+   * Hard budget (bytes) for the frontier buffers and the scratch output of
+   * the chunked advance (one more buffer), `0` for unlimited. An advance
+   * whose output would not fit in a buffer is processed in several passes
+   * (see `operators::advance::chunked`).
+   */
+  std::size_t frontier_memory_budget{0};
+
   /*!
    * Number of frontier buffers to manage.
    * @note Not used in the implementation yet.
@@ -47,6 +70,43 @@ struct enactor_properties_t {
    */
   bool self_manage_frontiers{false};
 
+  /*!
+   * When enabled, and the algorithm provides a capture-safe iteration
+   * (`is_capturable()`), one iteration is captured as a CUDA Graph and
+   * replayed until convergence instead of running `loop()`.
+   */
+  bool capture_iterations{false};
+
+  /*!
+   * Number of replays of the captured iteration between two (asynchronous)
+   * reads of the convergence flag.
+   */
+  int convergence_check_interval{16};
+
+  /*!
+   * When enabled, and the algorithm provides a persistent traversal
+   * (`is_persistent()`), one cooperative kernel runs all the iterations
+   * (`loop_persistent()`) instead of `loop()`. Takes precedence over
+   * `capture_iterations`.
+   */
+  bool persistent_iterations{false};
+
+  /*!
+   * Frontier density (active vertices / vertices) from which the algorithms
+   * that support it (e.g., BFS) switch to a dense (bitmap) frontier, back to
+   * the sparse one below half of it; `0` disables the switch. See
+   * `frontier::get_density()`.
+   */
+  float dense_frontier_threshold{0};
+
+  /*!
+   * Instrumentation hook (e.g. `profiler::profiler_t`), active on the
+   * enacting thread during `enact()`; `nullptr` disables the instrumentation.
+   * @note A captured iteration (`capture_iterations`) or a persistent
+   * traversal (`persistent_iterations`) is not instrumented.
+   */
+  std::shared_ptr<profiler::hook_t> profiler;
+
   /**
    * @brief Construct a new enactor properties t object with default values.
    */
@@ -80,6 +140,7 @@ template <typename algorithm_problem_t,
 struct enactor_t {
   using vertex_t = typename algorithm_problem_t::vertex_t;
   using edge_t = typename algorithm_problem_t::edge_t;
+  using graph_type = typename algorithm_problem_t::graph_type;
 
   using frontier_type = frontier_t<
       std::conditional_t<frontier_kind == frontier_kind_t::vertex_frontier,
@@ -114,7 +175,28 @@ struct enactor_t {
    * actually needs it is being run. Otherwise, it maybe a waste of memory space
    * to allocate this.
    */
-  thrust::device_vector<vertex_t> scanned_work_domain;
+  vector_t<edge_t, memory_space_t::device> scanned_work_domain;
+
+  /*!
+   * Bookkeeping for the direction-optimized (push-pull) advance, such as the
+   * visited vertices and the direction of the previous iteration. The switching
+   * thresholds (alpha, beta) can be tuned through this member as well.
+   * @note Only allocated when a direction-optimized advance is executed.
+   */
+  operators::advance::push_pull::state_t<vertex_t, edge_t> push_pull_state;
+
+  /*!
+   * Partitioned graph and per-device frontiers used by the operators when the
+   * context holds more than one GPU.
+   * @note Only allocated when an operator runs on a multi-GPU context.
+   */
+  operators::multi_gpu::state_t<graph_type, frontier_type> multi_gpu_state;
+
+  /*!
+   * Convergence flag of the captured iteration, cleared before and set by
+   * `loop_captured()` whenever work remains for the next iteration.
+   */
+  vector_t<int, memory_space_t::device> work_remains;
 
   /*!
    * Active frontier buffer, this pointer can be obtained by
@@ -170,23 +252,34 @@ struct enactor_t {
         buffer_selector(0),
         iteration(0),
         scanned_work_domain(problem->get_graph().get_number_of_vertices()) {
+    // Partitions of the multi-GPU operators aligned to the vertex arrays.
+    multi_gpu_state.vertices_per_partition =
+        problem->get_vertices_per_partition();
+
     /*!
      * If the self manage frontiers property is false, the enactor interface
-     * will resize the frontier buffers ahead of time to avoid the first
-     * allocation during the algorithm execution face.
-     * @note We also use a resizing factor to allocate more than what we
-     * actually may need.
+     * will reserve the frontier buffers ahead of time, to a vertex-sized
+     * capacity (not edge-sized, the buffers grow geometrically if an operator
+     * needs more), within the memory budget if one is given.
      *
      */
     if (!(properties.self_manage_frontiers)) {
       auto g = problem->get_graph();
-      std::size_t initial_size =
-          (g.get_number_of_edges() > g.get_number_of_vertices())
-              ? g.get_number_of_edges()
-              : g.get_number_of_vertices();
+      std::size_t initial_size = properties.initial_frontier_capacity
+                                     ? properties.initial_frontier_capacity
+                                     : g.get_number_of_vertices();
+
+      std::size_t limit = 0;
+      if (properties.frontier_memory_budget) {
+        limit = properties.frontier_memory_budget /
+                ((frontiers.size() + 1) *
+                 sizeof(typename frontier_type::type_t));
+        initial_size = std::min(initial_size, limit);
+      }
 
       for (auto& buffer : frontiers) {
         buffer.set_resizing_factor(properties.frontier_sizing_factor);
+        buffer.set_capacity_limit(limit);
         buffer.reserve((std::size_t)(initial_size));
       }
     }
@@ -220,6 +313,23 @@ struct enactor_t {
     inactive_frontier = &frontiers[buffer_selector ^ 1];
   }
 
+  /**
+   * @brief Prepare the enactor for another `enact()` on the same problem
+   * (after `problem->reset()`), keeping its allocations: the frontiers are
+   * emptied but not released, the buffer selection and the iteration count
+   * start over, and the direction-optimized advance forgets its visited
+   * vertices. Algorithms with state of their own extend it.
+   */
+  virtual void reset() {
+    for (auto& buffer : frontiers)
+      buffer.set_number_of_elements(0);
+    buffer_selector = 0;
+    active_frontier = &frontiers[0];
+    inactive_frontier = &frontiers[1];
+    iteration = 0;
+    push_pull_state.reset();
+  }
+
   /**
    * @brief Get the pointer to the enactor object.
    * @return enactor_t*
@@ -234,15 +344,91 @@ struct enactor_t {
    */
   float enact() {
     auto single_context = context->get_context(0);
+    auto hook = properties.profiler.get();
+    profiler::scoped_hook_t scope(hook);
+
     prepare_frontier(get_input_frontier(), *context);
-    auto timer = single_context->timer();
+    auto& timer = single_context->timer();
     timer.begin();
-    while (!is_converged(*context)) {
-      loop(*context);
-      ++iteration;
+    if (properties.persistent_iterations && context->size() == 1 &&
+        is_persistent()) {
+      loop_persistent(*single_context);
+      single_context->synchronize();
+    } else if (properties.capture_iterations && context->size() == 1 &&
+               is_capturable()) {
+      enact_captured(*single_context);
+    } else {
+      while (!is_converged(*context)) {
+        if (hook)
+          hook->begin_iteration(iteration,
+                                get_input_frontier()->get_number_of_elements(),
+                                *single_context);
+        loop(*context);
+        if (hook)
+          hook->end_iteration(iteration,
+                              get_input_frontier()->get_number_of_elements(),
+                              *single_context);
+        ++iteration;
+      }
     }
     finalize(*context);
-    return timer.end();
+    problem->finalize();
+    float elapsed = timer.end();
+    if (hook)
+      hook->finish(*single_context);
+    return elapsed;
+  }
+
+  /**
+   * @brief Capture one iteration (`loop_captured()`) as a CUDA Graph and
+   * replay it, in chunks of `convergence_check_interval` replays, until the
+   * `work_remains` flag of a chunk's last replay reads back as zero. The
+   * flag of a chunk is read while the next chunk is already running, so the
+   * host never stalls the replays; the extra replays past convergence are
+   * no-ops.
+   *
+   * @note `iteration` counts the replays, which is at most two chunks more
+   * than the number of iterations the algorithm needed.
+   */
+  void enact_captured(cuda::standard_context_t& context) {
+    auto stream = context.stream();
+    if (work_remains.size() == 0)
+      work_remains.resize(1);
+    auto flag = work_remains.data().get();
+
+    cuda::captured_graph_t graph;
+    graph.capture(stream, [&]() {
+      cudaMemsetAsync(flag, 0, sizeof(int), stream);
+      loop_captured(context);
+    });
+
+    int* h_flag = nullptr;
+    cuda::event_t read;
+    error::throw_if_exception(cudaMallocHost(&h_flag, sizeof(int)));
+    cudaEventCreateWithFlags(&read, cudaEventDisableTiming);
+
+    int interval = std::max(1, properties.convergence_check_interval);
+    bool pending = false;
+    while (true) {
+      for (int i = 0; i < interval; ++i, ++iteration)
+        graph.launch(stream);
+
+      // Flag of the previous chunk, its replays are done by now or soon.
+      if (pending) {
+        cudaEventSynchronize(read);
+        if (*h_flag == 0)
+          break;
+      }
+
+      cudaMemcpyAsync(h_flag, flag, sizeof(int), cudaMemcpyDeviceToHost,
+                      stream);
+      cudaEventRecord(read, stream);
+      pending = true;
+    }
+
+    context.synchronize();
+    cudaEventDestroy(read);
+    cudaFreeHost(h_flag);
   }
 
   /**
@@ -261,6 +447,39 @@ struct enactor_t {
    */
   virtual void loop(cuda::multi_context_t& context) = 0;
 
+  /**
+   * @brief Capture-safe variant of `loop()`, run by `enact_captured()`. Only
+   * enqueue work on the context's stream with launch configurations that do
+   * not depend on the data (no host reads of frontier sizes, no
+   * synchronization and no allocation), and set `work_remains[0]` to
+   * non-zero on the device if another iteration is needed. Once converged,
+   * an iteration must leave the results unchanged.
+   *
+   * @param context `gunrock::cuda::standard_context_t` being captured.
+   */
+  virtual void loop_captured(cuda::standard_context_t& context) {}
+
+  /**
+   * @brief True if the algorithm implements `loop_captured()`.
+   */
+  virtual bool is_capturable() { return false; }
+
+  /**
+   * @brief Persistent variant of the whole `enact()` loop, run instead when
+   * `persistent_iterations` is enabled: enqueue one (cooperative) kernel on
+   * the context's stream that iterates until convergence (e.g.,
+   * `operators::advance::persistent::execute()`), and set `iteration` to
+   * the number of iterations. `finalize()` runs after it.
+   *
+   * @param context `gunrock::cuda::standard_context_t`.
+   */
+  virtual void loop_persistent(cuda::standard_context_t& context) {}
+
+  /**
+   * @brief True if the algorithm implements `loop_persistent()`.
+   */
+  virtual bool is_persistent() { return false; }
+
   /**
    * @brief Prepare the initial frontier.
    *
@@ -14,5 +14,6 @@
 #include <gunrock/framework/frontier/frontier.hxx>
 #include <gunrock/framework/problem.hxx>
 #include <gunrock/framework/enactor.hxx>
+#include <gunrock/framework/session.hxx>
 
 #include <gunrock/framework/operators/operators.hxx>
\ No newline at end of file
@@ -0,0 +1,244 @@
+/**
+ * @file bitmap_frontier.hxx
+ * @author Muhammad Osama (mosama@ucdavis.edu)
+ * @brief Bitmap-based frontier implementation.
+ * @version 0.1
+ * @date 2021-06-03
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#pragma once
+
+#include <gunrock/error.hxx>
+#include <gunrock/util/type_limits.hxx>
+#include <gunrock/container/vector.hxx>
+#include <gunrock/algorithms/sort/radix_sort.hxx>
+
+#include <thrust/copy.h>
+#include <thrust/fill.h>
+#include <thrust/for_each.h>
+#include <thrust/host_vector.h>
+#include <thrust/transform_reduce.h>
+#include <thrust/iterator/counting_iterator.h>
+
+namespace gunrock {
+namespace frontier {
+using namespace memory;
+
+/**
+ * @brief Dense frontier that stores one bit per element (vertex or edge id).
+ *
+ * @par Overview
+ * A bitmap frontier is duplicate-free by construction and requires O(n/32)
+ * words of storage, independent of how many times an element is inserted.
+ * The "capacity" of a bitmap frontier is the number of ids it can represent,
+ * and the number of elements is the number of set bits (computed with a
+ * device-wide population count, and cached until the bitmap changes).
+ * Insertion on the device uses `atomicOr` on the underlying 32-bit words; see
+ * `insert()` and `contains()`.
+ *
+ * @tparam type_t type of the ids (vertex or edge) stored in the frontier.
+ */
+template <typename type_t>
+class bitmap_frontier_t {
+ public:
+  using word_t = unsigned int;
+  using pointer_t = word_t*;
+
+  static constexpr std::size_t bits_per_word = sizeof(word_t) * 8;
+
+  bitmap_frontier_t() : storage(), num_bits(0) {}
+  bitmap_frontier_t(std::size_t size)
+      : storage(number_of_words(size), 0), num_bits(size) {}
+
+  /**
+   * @brief Number of words needed to represent `size` ids.
+   */
+  __host__ __device__ static constexpr std::size_t number_of_words(
+      std::size_t const& size) {
+    return (size + bits_per_word - 1) / bits_per_word;
+  }
+
+  /**
+   * @brief Set the bit of `id` in `words` (device-side, atomic).
+   */
+  __device__ static void insert(word_t* words, type_t const& id) {
+    atomicOr(words + (id / bits_per_word), word_t(1) << (id % bits_per_word));
+  }
+
+  /**
+   * @brief Test the bit of `id` in `words`.
+   */
+  __host__ __device__ static bool contains(word_t const* words,
+                                           type_t const& id) {
+    return (words[id / bits_per_word] >> (id % bits_per_word)) & word_t(1);
+  }
+
+  /**
+   * @brief Get the number of elements (set bits) within the frontier.
+   * @note Device-wide reduction (the result is copied back to the host) the
+   * first time after a modification, cached afterwards. Kernels that write
+   * the bits through `data()` must `invalidate_number_of_elements()` (see
+   * `frontier_t::touch()`).
+   * @return std::size_t
+   */
+  std::size_t get_number_of_elements(cuda::stream_t stream = 0) const {
+    if (count_valid)
+      return count;
+
+    auto words = storage.data().get();
+    count = thrust::transform_reduce(
+        thrust::cuda::par.on(stream),
+        thrust::make_counting_iterator<std::size_t>(0),
+        thrust::make_counting_iterator<std::size_t>(storage.size()),
+        [=] __device__(std::size_t const& i) -> std::size_t {
+          return __popc(words[i]);
+        },
+        (std::size_t)0, thrust::plus<std::size_t>());
+    count_valid = true;
+    return count;
+  }
+
+  /**
+   * @brief Forget the cached number of elements, the bits were modified.
+   */
+  void invalidate_number_of_elements() { count_valid = false; }
+
+  /**
+   * @brief Get the capacity (number of ids the bitmap can represent).
+   * @return std::size_t
+   */
+  std::size_t get_capacity() const { return num_bits; }
+
+  /**
+   * @brief Size of the underlying storage in bytes.
+   * @return std::size_t
+   */
+  std::size_t get_size_in_bytes() const {
+    return storage.size() * sizeof(word_t);
+  }
+
+  pointer_t data() { return raw_pointer_cast(storage.data()); }
+  pointer_t begin() { return this->data(); }
+  pointer_t end() { return this->begin() + storage.size(); }
+  bool is_empty() const { return (this->get_number_of_elements() == 0); }
+
+  /**
+   * @brief Number of underlying words of the bitmap.
+   * @return std::size_t
+   */
+  std::size_t get_number_of_words() const { return storage.size(); }
+
+  /**
+   * @brief (vertex-like) push back a value to the frontier, sets the bit of
+   * `value` (the bitmap grows if `value` is out of range).
+   *
+   * @param value
+   * @param stream stream of the context consuming the frontier.
+   */
+  void push_back(type_t const& value, cuda::stream_t stream = 0) {
+    if (static_cast<std::size_t>(value) >= num_bits)
+      this->reserve(static_cast<std::size_t>(value) + 1);
+
+    auto words = this->data();
+    thrust::for_each(thrust::cuda::par.on(stream),
+                     thrust::make_counting_iterator<type_t>(value),
+                     thrust::make_counting_iterator<type_t>(value + 1),
+                     [=] __device__(type_t const& v) { insert(words, v); });
+    error::throw_if_exception(cudaStreamSynchronize(stream));
+    count_valid = false;
+  }
+
+  /**
+   * @brief Clear all bits, the frontier becomes empty.
+   *
+   * @param stream
+   */
+  void clear(cuda::stream_t stream = 0) {
+    thrust::fill(thrust::cuda::par.on(stream), storage.begin(), storage.end(),
+                 word_t(0));
+    count = 0;
+    count_valid = true;
+  }
+
+  /**
+   * @brief Copy the bits (and the cached number of elements) of `other`.
+   *
+   * @param other bitmap.
+   * @param stream
+   */
+  void assign(bitmap_frontier_t const& other, cuda::stream_t stream = 0) {
+    this->resize(other.num_bits);
+    thrust::copy(thrust::cuda::par.on(stream), other.storage.begin(),
+                 other.storage.end(), storage.begin());
+    count = other.count;
+    count_valid = other.count_valid;
+  }
+
+  /**
+   * @brief `sequence` sets the bits of [initial_value, initial_value + size).
+   *
+   * @param initial_value The first value of the sequence.
+   * @param size Number of elements in the sequence.
+   * @param stream @see `cuda::stream_t`.
+   */
+  void sequence(type_t const initial_value,
+                std::size_t const& size,
+                cuda::stream_t stream = 0) {
+    auto words = this->data();
+    thrust::for_each(
+        thrust::cuda::par.on(stream),
+        thrust::make_counting_iterator<type_t>(initial_value),
+        thrust::make_counting_iterator<type_t>(initial_value + size),
+        [=] __device__(type_t const& v) { insert(words, v); });
+    count_valid = false;
+  }
+
+  /**
+   * @brief Resize the bitmap to represent exactly `size` ids. Newly added
+   * words are cleared.
+   *
+   * @param size number of ids (bits, not words or bytes).
+   */
+  void resize(std::size_t const& size) {
+    storage.resize(number_of_words(size), word_t(0));
+    num_bits = size;
+    count_valid = false;  // shrinking drops bits.
+  }
+
+  /**
+   * @brief Grow the bitmap to represent at least `size` ids, never shrinks.
+   *
+   * @param size number of ids (bits, not words or bytes).
+   */
+  void reserve(std::size_t const& size) {
+    if (size > num_bits)
+      this->resize(size);
+  }
+
+  /**
+   * @brief A bitmap is always sorted (ascending), this is a no-op.
+   */
+  void sort(sort::order_t order = sort::order_t::ascending,
+            cuda::stream_t stream = 0) {}
+
+  void print() {
+    thrust::host_vector<word_t> h_storage = storage;
+    std::cout << "Frontier = ";
+    for (std::size_t i = 0; i < num_bits; ++i)
+      if (contains(h_storage.data(), (type_t)i))
+        std::cout << i << " ";
+    std::cout << std::endl;
+  }
+
+ private:
+  vector_t<word_t, memory_space_t::device> storage;
+  std::size_t num_bits;  // number of ids the bitmap can represent.
+  mutable std::size_t count = 0;  // number of set bits, if `count_valid`.
+  mutable bool count_valid = false;
+};
+
+}  // namespace frontier
+}  // namespace gunrock
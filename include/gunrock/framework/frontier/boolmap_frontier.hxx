@@ -0,0 +1,207 @@
+/**
+ * @file boolmap_frontier.hxx
+ * @author Muhammad Osama (mosama@ucdavis.edu)
+ * @brief Boolmap-based frontier implementation.
+ * @version 0.1
+ * @date 2021-06-03
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#pragma once
+
+#include <gunrock/error.hxx>
+#include <gunrock/util/type_limits.hxx>
+#include <gunrock/container/vector.hxx>
+#include <gunrock/algorithms/sort/radix_sort.hxx>
+
+#include <thrust/copy.h>
+#include <thrust/fill.h>
+#include <thrust/count.h>
+#include <thrust/host_vector.h>
+
+namespace gunrock {
+namespace frontier {
+using namespace memory;
+
+/**
+ * @brief Dense frontier that stores one flag (byte) per element (vertex or
+ * edge id).
+ *
+ * @par Overview
+ * Same semantics as `bitmap_frontier_t`, but every id owns a full byte, so
+ * insertion from the device is a plain (non-atomic) store, at the cost of 8x
+ * the storage of a bitmap. Useful for operators that write every slot anyway
+ * (e.g. a pull-based advance).
+ *
+ * @tparam type_t type of the ids (vertex or edge) stored in the frontier.
+ */
+template <typename type_t>
+class boolmap_frontier_t {
+ public:
+  using flag_t = bool;
+  using pointer_t = flag_t*;
+
+  boolmap_frontier_t() : storage(), num_flags(0) {}
+  boolmap_frontier_t(std::size_t size)
+      : storage(size, false), num_flags(size) {}
+
+  /**
+   * @brief Set the flag of `id` in `flags` (device-side).
+   */
+  __device__ static void insert(flag_t* flags, type_t const& id) {
+    flags[id] = true;
+  }
+
+  /**
+   * @brief Test the flag of `id` in `flags`.
+   */
+  __host__ __device__ static bool contains(flag_t const* flags,
+                                           type_t const& id) {
+    return flags[id];
+  }
+
+  /**
+   * @brief Get the number of elements (set flags) within the frontier.
+   * @note Device-wide reduction (the result is copied back to the host) the
+   * first time after a modification, cached afterwards, see
+   * `bitmap_frontier_t::get_number_of_elements()`.
+   * @return std::size_t
+   */
+  std::size_t get_number_of_elements(cuda::stream_t stream = 0) const {
+    if (!count_valid) {
+      count = thrust::count(thrust::cuda::par.on(stream), storage.begin(),
+                            storage.end(), true);
+      count_valid = true;
+    }
+    return count;
+  }
+
+  /**
+   * @brief Forget the cached number of elements, the flags were modified.
+   */
+  void invalidate_number_of_elements() { count_valid = false; }
+
+  /**
+   * @brief Get the capacity (number of ids the boolmap can represent).
+   * @return std::size_t
+   */
+  std::size_t get_capacity() const { return num_flags; }
+
+  /**
+   * @brief Size of the underlying storage in bytes.
+   * @return std::size_t
+   */
+  std::size_t get_size_in_bytes() const {
+    return storage.size() * sizeof(flag_t);
+  }
+
+  pointer_t data() { return raw_pointer_cast(storage.data()); }
+  pointer_t begin() { return this->data(); }
+  pointer_t end() { return this->begin() + storage.size(); }
+  bool is_empty() const { return (this->get_number_of_elements() == 0); }
+
+  /**
+   * @brief (vertex-like) push back a value to the frontier, sets the flag of
+   * `value` (the boolmap grows if `value` is out of range).
+   *
+   * @param value
+   * @param stream stream of the context consuming the frontier.
+   */
+  void push_back(type_t const& value, cuda::stream_t stream = 0) {
+    if (static_cast<std::size_t>(value) >= num_flags)
+      this->reserve(static_cast<std::size_t>(value) + 1);
+    thrust::fill_n(thrust::cuda::par.on(stream), storage.begin() + value, 1,
+                   true);
+    error::throw_if_exception(cudaStreamSynchronize(stream));
+    count_valid = false;
+  }
+
+  /**
+   * @brief Clear all flags, the frontier becomes empty.
+   *
+   * @param stream
+   */
+  void clear(cuda::stream_t stream = 0) {
+    thrust::fill(thrust::cuda::par.on(stream), storage.begin(), storage.end(),
+                 false);
+    count = 0;
+    count_valid = true;
+  }
+
+  /**
+   * @brief Copy the flags (and the cached number of elements) of `other`.
+   *
+   * @param other boolmap.
+   * @param stream
+   */
+  void assign(boolmap_frontier_t const& other, cuda::stream_t stream = 0) {
+    this->resize(other.num_flags);
+    thrust::copy(thrust::cuda::par.on(stream), other.storage.begin(),
+                 other.storage.end(), storage.begin());
+    count = other.count;
+    count_valid = other.count_valid;
+  }
+
+  /**
+   * @brief `sequence` sets the flags of [initial_value, initial_value + size).
+   *
+   * @param initial_value The first value of the sequence.
+   * @param size Number of elements in the sequence.
+   * @param stream @see `cuda::stream_t`.
+   */
+  void sequence(type_t const initial_value,
+                std::size_t const& size,
+                cuda::stream_t stream = 0) {
+    thrust::fill(thrust::cuda::par.on(stream), storage.begin() + initial_value,
+                 storage.begin() + initial_value + size, true);
+    count_valid = false;
+  }
+
+  /**
+   * @brief Resize the boolmap to represent exactly `size` ids. Newly added
+   * flags are cleared.
+   *
+   * @param size number of ids.
+   */
+  void resize(std::size_t const& size) {
+    storage.resize(size, false);
+    num_flags = size;
+    count_valid = false;
+  }
+
+  /**
+   * @brief Grow the boolmap to represent at least `size` ids, never shrinks.
+   *
+   * @param size number of ids.
+   */
+  void reserve(std::size_t const& size) {
+    if (size > num_flags)
+      this->resize(size);
+  }
+
+  /**
+   * @brief A boolmap is always sorted (ascending), this is a no-op.
+   */
+  void sort(sort::order_t order = sort::order_t::ascending,
+            cuda::stream_t stream = 0) {}
+
+  void print() {
+    thrust::host_vector<flag_t> h_storage = storage;
+    std::cout << "Frontier = ";
+    for (std::size_t i = 0; i < num_flags; ++i)
+      if (h_storage[i])
+        std::cout << i << " ";
+    std::cout << std::endl;
+  }
+
+ private:
+  vector_t<flag_t, memory_space_t::device> storage;
+  std::size_t num_flags;  // number of ids the boolmap can represent.
+  mutable std::size_t count = 0;  // number of set flags, if `count_valid`.
+  mutable bool count_valid = false;
+};
+
+}  // namespace frontier
+}  // namespace gunrock
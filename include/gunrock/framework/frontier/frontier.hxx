@@ -18,18 +18,25 @@
 #pragma once
 
 #include <gunrock/framework/frontier/vector_frontier.hxx>
+#include <gunrock/framework/frontier/bitmap_frontier.hxx>
+#include <gunrock/framework/frontier/boolmap_frontier.hxx>
 #include <gunrock/util/type_limits.hxx>
+#include <gunrock/error.hxx>
 
 #include <gunrock/graph/graph.hxx>
 #include <gunrock/cuda/context.hxx>
 
+#include <algorithm>
+#include <type_traits>
+
+#include <thrust/copy.h>
+#include <thrust/for_each.h>
+#include <thrust/iterator/counting_iterator.h>
+
 namespace gunrock {
 
 using namespace memory;
 
-// Maybe we use for frontier related function
-namespace frontier {}  // namespace frontier
-
 /**
  * @brief Underlying frontier data structure.
  */
@@ -45,26 +52,57 @@ enum frontier_kind_t {
   vertex_edge_frontier  /// (wip)
 };                      // enum: frontier_kind_t
 
+namespace frontier {
+namespace detail {
+template <typename type_t, frontier_storage_t underlying_st>
+using underlying_frontier_t = std::conditional_t<
+    underlying_st == frontier_storage_t::bitmap,
+    bitmap_frontier_t<type_t>,
+    std::conditional_t<underlying_st == frontier_storage_t::boolmap,
+                       boolmap_frontier_t<type_t>,
+                       vector_frontier_t<type_t>>>;
+}  // namespace detail
+}  // namespace frontier
+
+/**
+ * @brief Frontier with a selectable underlying storage. `vector` (sparse)
+ * frontiers store a list of active ids, `bitmap` and `boolmap` (dense)
+ * frontiers store a membership map over all ids and are duplicate-free.
+ *
+ * @note The forward vertex advance and the filter accept both (see
+ * `operators::advance::dense` and `operators::filter::dense`), the other
+ * operators the sparse one; use `frontier::to_dense()` and
+ * `frontier::to_sparse()` to switch between the two, e.g. when
+ * `frontier::get_density()` crosses a threshold (see `bfs::enactor_t`).
+ */
 template <typename t,
           frontier_storage_t underlying_st = frontier_storage_t::vector>
-class frontier_t : public frontier::vector_frontier_t<t> {
+class frontier_t
+    : public frontier::detail::underlying_frontier_t<t, underlying_st> {
  public:
   using type_t = t;
-  using pointer_t = type_t*;
-  using frontier_type_t = frontier_t<type_t>;
+  using frontier_type_t = frontier_t<type_t, underlying_st>;
+  using underlying_frontier_t =
+      frontier::detail::underlying_frontier_t<type_t, underlying_st>;
+  using pointer_t = typename underlying_frontier_t::pointer_t;
 
-  // We can use std::conditional to figure out what type to use.
-  using underlying_frontier_t = frontier::vector_frontier_t<type_t>;
+  static constexpr frontier_storage_t underlying_storage = underlying_st;
+  static constexpr bool is_dense =
+      (underlying_st != frontier_storage_t::vector);
 
   // <todo> revisit frontier constructors/destructor
   frontier_t()
       : underlying_frontier_t(),
         kind(frontier_kind_t::vertex_frontier),
-        resizing_factor(1) {}
+        resizing_factor(1),
+        capacity_limit(0),
+        version(0) {}
   frontier_t(std::size_t size, float frontier_resizing_factor = 1.0)
       : underlying_frontier_t(size),
         kind(frontier_kind_t::vertex_frontier),
-        resizing_factor(frontier_resizing_factor) {}
+        resizing_factor(frontier_resizing_factor),
+        capacity_limit(0),
+        version(0) {}
 
   ~frontier_t() {}
   // </todo>
@@ -77,7 +115,10 @@ class frontier_t : public frontier::vector_frontier_t<t> {
   frontier_kind_t get_frontier_kind() const { return kind; }
 
   std::size_t get_size_in_bytes() const {
-    return this->get_number_of_elements() * sizeof(type_t);
+    if constexpr (is_dense)
+      return underlying_frontier_t::get_size_in_bytes();
+    else
+      return this->get_number_of_elements() * sizeof(type_t);
   }
 
   /**
@@ -103,6 +144,46 @@ class frontier_t : public frontier::vector_frontier_t<t> {
     return underlying_frontier_t::get_capacity();
   }
 
+  /**
+   * @brief Get the largest capacity the frontier may grow to (number of
+   * elements), `0` if unlimited.
+   * @return std::size_t
+   */
+  std::size_t get_capacity_limit() const { return capacity_limit; }
+
+  /**
+   * @brief Version of the frontier's contents, incremented by every member
+   * that modifies them (and by `touch()`). Consumers that cache a view of the
+   * frontier (e.g., the multi-GPU mirrors, see
+   * `operators::multi_gpu::state_t`) compare versions to detect changes.
+   * @return std::size_t
+   */
+  std::size_t get_version() const { return version; }
+
+  /**
+   * @brief Record a modification of the contents that did not go through a
+   * member of the frontier (e.g., a kernel writing in place through
+   * `data()`), see `get_version()`.
+   */
+  void touch() {
+    ++version;
+    if constexpr (is_dense)
+      underlying_frontier_t::invalidate_number_of_elements();
+  }
+
+  /**
+   * @brief Copy the contents of the dense frontier `other` (bitmap and
+   * boolmap only).
+   *
+   * @param other frontier of the same storage.
+   * @param stream
+   */
+  void assign(frontier_t const& other, cuda::stream_t stream = 0) {
+    static_assert(is_dense, "Only dense frontiers are assigned.");
+    underlying_frontier_t::assign(other, stream);
+    ++version;
+  }
+
   /**
    * @brief Set the frontier kind: edge or vertex frontier.
    *
@@ -111,14 +192,24 @@ class frontier_t : public frontier::vector_frontier_t<t> {
   void set_frontier_kind(frontier_kind_t _kind) { kind = _kind; }
 
   /**
-   * @brief Set the resizing factor for the frontier. This float is used to
-   * multiply the `reserve` size to scale it a bit higher every time to avoid
-   * reallocations.
+   * @brief Set the resizing factor for the frontier. A sparse frontier that
+   * has to grow grows to at least this factor times its current capacity, so
+   * the number of reallocations is logarithmic in the final size.
    *
    * @param factor
    */
   void set_resizing_factor(float factor) { resizing_factor = factor; }
 
+  /**
+   * @brief Set the largest capacity a sparse frontier may grow to (number of
+   * elements, `0` for unlimited). Growing beyond it throws; the advance
+   * operator instead splits an input whose output would not fit, see
+   * `operators::advance::chunked`.
+   *
+   * @param limit
+   */
+  void set_capacity_limit(std::size_t limit) { capacity_limit = limit; }
+
   /**
    * @brief Set how many number of elements the frontier contains. Note, this is
    * manually managed right now, we can look for better and cleaner options
@@ -129,6 +220,25 @@ class frontier_t : public frontier::vector_frontier_t<t> {
    */
   void set_number_of_elements(std::size_t const& elements) {
     underlying_frontier_t::set_number_of_elements(elements);
+    touch();
+  }
+
+  /**
+   * @brief Device-resident number of elements (sparse frontiers only).
+   * @see `frontier::vector_frontier_t::get_device_number_of_elements()`.
+   */
+  auto get_device_number_of_elements(cuda::stream_t stream = 0) {
+    return underlying_frontier_t::get_device_number_of_elements(stream);
+  }
+
+  /**
+   * @brief The device counter holds the number of elements (sparse frontiers
+   * only).
+   * @see `frontier::vector_frontier_t::set_number_of_elements_on_device()`.
+   */
+  void set_number_of_elements_on_device(cuda::stream_t stream = 0) {
+    underlying_frontier_t::set_number_of_elements_on_device(stream);
+    touch();
   }
 
   pointer_t data() { return underlying_frontier_t::data(); }
@@ -140,9 +250,11 @@ class frontier_t : public frontier::vector_frontier_t<t> {
    * @brief (vertex-like) push back a value to the frontier.
    *
    * @param value
+   * @param stream stream of the context consuming the frontier.
    */
-  void push_back(type_t const& value) {
-    underlying_frontier_t::push_back(value);
+  void push_back(type_t const& value, cuda::stream_t stream = 0) {
+    underlying_frontier_t::push_back(value, stream);
+    touch();
   }
 
   /**
@@ -153,6 +265,7 @@ class frontier_t : public frontier::vector_frontier_t<t> {
    */
   void fill(type_t const value, cuda::stream_t stream = 0) {
     underlying_frontier_t::fill(value, stream);
+    touch();
   }
 
   /**
@@ -169,15 +282,22 @@ class frontier_t : public frontier::vector_frontier_t<t> {
   void sequence(type_t const initial_value,
                 std::size_t const& size,
                 cuda::stream_t stream = 0) {
-    // Resize if needed.
-    if (this->get_capacity() < size)
-      this->reserve(size);
-
-    // Set the new number of elements.
-    this->set_number_of_elements(size);
+    if constexpr (is_dense) {
+      // Dense frontiers must be able to represent the largest id.
+      if (this->get_capacity() < initial_value + size)
+        this->reserve(initial_value + size);
+    } else {
+      // Resize if needed.
+      if (this->get_capacity() < size)
+        this->reserve(size);
+
+      // Set the new number of elements.
+      this->set_number_of_elements(size);
+    }
 
     // Fill in the sequence.
     underlying_frontier_t::sequence(initial_value, size, stream);
+    touch();
   }
 
   /**
@@ -205,7 +325,25 @@ class frontier_t : public frontier::vector_frontier_t<t> {
    * @param size size to reserve (size is in count not bytes).
    */
   void reserve(std::size_t const& size) {
-    underlying_frontier_t::reserve(size * resizing_factor);
+    if constexpr (is_dense) {
+      underlying_frontier_t::reserve(size * resizing_factor);
+      touch();
+    } else {
+      std::size_t capacity = this->get_capacity();
+      if (size <= capacity)
+        return;
+      if (capacity_limit && size > capacity_limit)
+        error::throw_if_exception(cudaErrorMemoryAllocation,
+                                  "Frontier exceeds its capacity limit.");
+
+      // Geometric growth, clamped to the limit.
+      std::size_t grown =
+          std::max(size, (std::size_t)(capacity * resizing_factor));
+      if (capacity_limit)
+        grown = std::min(grown, capacity_limit);
+      underlying_frontier_t::reserve(grown);
+      touch();
+    }
   }
 
   /**
@@ -217,6 +355,7 @@ class frontier_t : public frontier::vector_frontier_t<t> {
   void sort(sort::order_t order = sort::order_t::ascending,
             cuda::stream_t stream = 0) {
     underlying_frontier_t::sort(order, stream);
+    touch();
   }
 
   /**
@@ -226,7 +365,97 @@ class frontier_t : public frontier::vector_frontier_t<t> {
 
  private:
   frontier_kind_t kind;   // vertex or edge frontier.
-  float resizing_factor;  // reserve size * factor.
-};                        // struct frontier_t
+  float resizing_factor;       // growth factor.
+  std::size_t capacity_limit;  // largest capacity (elements), 0 if unlimited.
+  std::size_t version;         // incremented on modification.
+};                             // struct frontier_t
 
+namespace frontier {
+
+/**
+ * @brief Fraction of the `size` ids (usually number of vertices) that are
+ * active in the frontier, used to decide between a sparse and a dense
+ * representation.
+ *
+ * @param f frontier.
+ * @param size number of ids the frontier is drawn from.
+ * @return float density in [0, 1] (may exceed 1 for sparse frontiers with
+ * duplicates).
+ */
+template <typename frontier_type>
+float get_density(frontier_type* f, std::size_t const& size) {
+  return (size == 0) ? 0.0f : (float)f->get_number_of_elements() / (float)size;
+}
+
+/**
+ * @brief Convert a sparse (vector) frontier to a dense (bitmap or boolmap)
+ * frontier. Duplicates and invalid ids are dropped. O(|sparse| + size).
+ *
+ * @param sparse input vector frontier.
+ * @param dense output bitmap/boolmap frontier (cleared first).
+ * @param size number of ids the frontier is drawn from.
+ * @param context `cuda::standard_context_t`.
+ */
+template <typename sparse_frontier_type, typename dense_frontier_type>
+void to_dense(sparse_frontier_type* sparse,
+              dense_frontier_type* dense,
+              std::size_t const& size,
+              cuda::standard_context_t& context) {
+  static_assert(
+      !sparse_frontier_type::is_dense && dense_frontier_type::is_dense,
+      "to_dense converts a vector frontier to a dense frontier.");
+  using type_t = typename sparse_frontier_type::type_t;
+
+  if (dense->get_capacity() < size)
+    dense->reserve(size);
+  dense->clear(context.stream());
+
+  auto sparse_data = sparse->data();
+  auto dense_data = dense->data();
+  thrust::for_each(context.execution_policy(),
+                   thrust::make_counting_iterator<std::size_t>(0),
+                   thrust::make_counting_iterator<std::size_t>(
+                       sparse->get_number_of_elements()),
+                   [=] __device__(std::size_t const& i) {
+                     type_t v = sparse_data[i];
+                     if (gunrock::util::limits::is_valid(v))
+                       dense_frontier_type::insert(dense_data, v);
+                   });
+  dense->touch();
+}
+
+/**
+ * @brief Convert a dense (bitmap or boolmap) frontier to a sparse (vector)
+ * frontier. The output is sorted and duplicate-free. O(size).
+ *
+ * @param dense input bitmap/boolmap frontier.
+ * @param sparse output vector frontier.
+ * @param context `cuda::standard_context_t`.
+ */
+template <typename dense_frontier_type, typename sparse_frontier_type>
+void to_sparse(dense_frontier_type* dense,
+               sparse_frontier_type* sparse,
+               cuda::standard_context_t& context) {
+  static_assert(
+      dense_frontier_type::is_dense && !sparse_frontier_type::is_dense,
+      "to_sparse converts a dense frontier to a vector frontier.");
+  using type_t = typename sparse_frontier_type::type_t;
+
+  std::size_t size = dense->get_capacity();
+  std::size_t elements = dense->get_number_of_elements();
+
+  if (sparse->get_capacity() < elements)
+    sparse->reserve(elements);
+  sparse->set_number_of_elements(elements);
+
+  auto dense_data = dense->data();
+  thrust::copy_if(context.execution_policy(),
+                  thrust::make_counting_iterator<type_t>(0),
+                  thrust::make_counting_iterator<type_t>(size), sparse->begin(),
+                  [=] __device__(type_t const& v) {
+                    return dense_frontier_type::contains(dense_data, v);
+                  });
+}
+
+}  // namespace frontier
 }  // namespace gunrock
\ No newline at end of file
@@ -11,28 +11,109 @@
 
 #pragma once
 
+#include <gunrock/error.hxx>
 #include <gunrock/util/type_limits.hxx>
 #include <gunrock/container/vector.hxx>
 #include <gunrock/algorithms/sort/radix_sort.hxx>
+#include <thrust/copy.h>
 #include <thrust/sequence.h>
 
 namespace gunrock {
 namespace frontier {
 using namespace memory;
 
+namespace detail {
+template <typename type_t>
+__global__ void set_value(type_t* address, type_t value) {
+  *address = value;
+}
+}  // namespace detail
+
+/**
+ * @brief Sparse frontier, a list of active ids.
+ *
+ * @par Overview
+ * The number of elements is kept both on the host and in a device counter.
+ * Operators that produce a frontier on the device (such as the fused
+ * advance-filter) write the count to the device counter only, see
+ * `set_number_of_elements_on_device()`, and the host copy of the count is
+ * fetched lazily, the first time it is asked for. Chains of such operators
+ * therefore never wait on the host for a frontier size.
+ */
 template <typename type_t>
 class vector_frontier_t {
  public:
   using pointer_t = type_t*;
+  using counter_t = unsigned long long;
 
-  vector_frontier_t() : storage(), num_elements(0) {}
-  vector_frontier_t(std::size_t size) : storage(size), num_elements(size) {}
+  vector_frontier_t()
+      : storage(),
+        num_elements(0),
+        host_valid(true),
+        device_valid(false),
+        counter_stream(0) {}
+  vector_frontier_t(std::size_t size)
+      : storage(size),
+        num_elements(size),
+        host_valid(true),
+        device_valid(false),
+        counter_stream(0) {}
 
   /**
-   * @brief Get the number of elements within the frontier.
+   * @brief Get the number of elements within the frontier. Synchronizes with
+   * the device if the count was last written on the device.
    * @return std::size_t
    */
-  std::size_t get_number_of_elements() const { return num_elements; }
+  std::size_t get_number_of_elements() const {
+    if (!host_valid) {
+      counter_t count = 0;
+      cudaMemcpyAsync(&count, counter.data().get(), sizeof(counter_t),
+                      cudaMemcpyDeviceToHost, counter_stream);
+      cudaStreamSynchronize(counter_stream);
+      num_elements = count;
+      host_valid = true;
+    }
+    return num_elements;
+  }
+
+  /**
+   * @brief Device pointer to the number of elements, up-to-date in `stream`
+   * order (uploaded from the host if the host copy is newer). Operators may
+   * read it to size their work, or overwrite it and then call
+   * `set_number_of_elements_on_device()`.
+   *
+   * @param stream stream of the operator using the counter.
+   * @return counter_t*
+   */
+  counter_t* get_device_number_of_elements(cuda::stream_t stream = 0) {
+    if (counter.size() == 0)
+      counter.resize(1);
+    if (!device_valid) {
+      detail::set_value<<<1, 1, 0, stream>>>(counter.data().get(),
+                                             (counter_t)num_elements);
+      device_valid = true;
+    }
+    return counter.data().get();
+  }
+
+  /**
+   * @brief Declare that the device counter (see
+   * `get_device_number_of_elements()`) holds the number of elements, written
+   * by work enqueued on `stream`.
+   *
+   * @param stream stream the count was written on.
+   */
+  void set_number_of_elements_on_device(cuda::stream_t stream = 0) {
+    counter_stream = stream;
+    device_valid = true;
+    host_valid = false;
+  }
+
+  /**
+   * @brief True if the number of elements is known on the host, i.e.
+   * `get_number_of_elements()` does not synchronize.
+   */
+  bool is_size_on_host() const { return host_valid; }
 
   /**
    * @brief Get the capacity (number of elements possible).
@@ -50,6 +131,8 @@ class vector_frontier_t {
    */
   void set_number_of_elements(std::size_t const& elements) {
     num_elements = elements;
+    host_valid = true;
+    device_valid = false;
   }
 
   pointer_t data() { return raw_pointer_cast(storage.data()) /* .get() */; }
@@ -58,13 +141,24 @@ class vector_frontier_t {
   bool is_empty() const { return (this->get_number_of_elements() == 0); }
 
   /**
-   * @brief (vertex-like) push back a value to the frontier.
+   * @brief (vertex-like) push back a value to the frontier. The value is
+   * staged in the launch parameters of a single-thread kernel on `stream`
+   * (no pageable copy), and `stream` is synchronized, such that operators on
+   * other streams see it too.
    *
    * @param value
+   * @param stream stream of the context consuming the frontier.
    */
-  void push_back(type_t const& value) {
-    storage.push_back(value);
-    num_elements++;
+  void push_back(type_t const& value, cuda::stream_t stream = 0) {
+    // The operators write within the capacity, not through the storage's own
+    // size, the value goes right after the current elements.
+    std::size_t size = get_number_of_elements();
+    if (size >= get_capacity())
+      reserve(2 * size + 1);
+    detail::set_value<<<1, 1, 0, stream>>>(data() + size, value);
+    error::throw_if_exception(cudaPeekAtLastError());
+    error::throw_if_exception(cudaStreamSynchronize(stream));
+    set_number_of_elements(size + 1);
   }
 
   /**
@@ -116,8 +210,23 @@ class vector_frontier_t {
    * report the actual size, not reserved size. See std::vector for more detail.
    *
    * @param size size to reserve (size is in count not bytes).
+   *
+   * @note Growing keeps the current elements (the first
+   * `get_number_of_elements()`), even those the operators wrote beyond the
+   * storage's own size.
    */
-  void reserve(std::size_t const& size) { storage.reserve(size); }
+  void reserve(std::size_t const& size) {
+    if (size <= get_capacity())
+      return;
+
+    std::size_t elements = get_number_of_elements();
+    vector_t<type_t, memory_space_t::device> grown;
+    grown.reserve(size);
+    grown.resize(elements);
+    thrust::copy(thrust::device, storage.data(), storage.data() + elements,
+                 grown.begin());
+    storage.swap(grown);
+  }
 
   /**
    * @brief Parallel sort the frontier.
@@ -141,7 +250,13 @@ class vector_frontier_t {
 
  private:
   vector_t<type_t, memory_space_t::device> storage;
-  std::size_t num_elements;  // number of elements in the frontier.
+  mutable std::size_t num_elements;  // number of elements in the frontier.
+
+  // Device copy of the number of elements, and which copies are current.
+  vector_t<counter_t, memory_space_t::device> counter;
+  mutable bool host_valid;
+  bool device_valid;
+  cuda::stream_t counter_stream;
 };
 
 }  // namespace frontier
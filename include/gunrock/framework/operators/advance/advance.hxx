@@ -15,12 +15,23 @@
 #include <gunrock/error.hxx>
 #include <gunrock/util/type_limits.hxx>
 
+#include <gunrock/framework/profiler.hxx>
 #include <gunrock/framework/operators/configs.hxx>
 
 #include <gunrock/framework/operators/advance/helpers.hxx>
 #include <gunrock/framework/operators/advance/merge_path.hxx>
 #include <gunrock/framework/operators/advance/thread_mapped.hxx>
 #include <gunrock/framework/operators/advance/block_mapped.hxx>
+#include <gunrock/framework/operators/advance/warp_mapped.hxx>
+#include <gunrock/framework/operators/advance/work_stealing.hxx>
+#include <gunrock/framework/operators/advance/push_pull.hxx>
+#include <gunrock/framework/operators/advance/bucketing.hxx>
+#include <gunrock/framework/operators/advance/captured.hxx>
+#include <gunrock/framework/operators/advance/persistent.hxx>
+#include <gunrock/framework/operators/advance/chunked.hxx>
+#include <gunrock/framework/operators/advance/prefetch.hxx>
+#include <gunrock/framework/operators/advance/streamed.hxx>
+#include <gunrock/framework/operators/advance/dense.hxx>
 
 namespace gunrock {
 namespace operators {
@@ -64,7 +75,8 @@ namespace advance {
  *  \endcode
  *
  * @tparam lb `gunrock::operators::load_balance_t` enum, determines which
- * load-balancing algorithm to use when running advance.
+ * load-balancing algorithm to use when running advance. `automatic` selects
+ * one per call, see `select_load_balance()`.
  * @tparam direction `gunrock::operators::advance_direction_t` enum.
  * Determines the direction when advancing the input frontier (foward, backward,
  * both).
@@ -80,8 +92,8 @@ namespace advance {
  * @param input input frontier being passed in.
  * @param output resultant output frontier containing the neighbors.
  * @param segments storaged space for scanned items (segment offsets).
- * @param context a `cuda::multi_context_t` that contains GPU contexts for the
- * available CUDA devices. Used to launch the advance kernels.
+ * @param context a `cuda::standard_context_t` of the GPU used to launch the
+ * advance kernels.
  */
 template <load_balance_t lb,
           advance_direction_t direction,
@@ -96,33 +108,239 @@ void execute(graph_t& G,
              frontier_t* input,
              frontier_t* output,
              work_tiles_t& segments,
-             cuda::multi_context_t& context) {
-  if (context.size() == 1) {
-    auto context0 = context.get_context(0);
+             cuda::standard_context_t& context) {
+  // Dense frontiers: the active vertices are a bitmap (boolmap), expanded
+  // without segments (see `dense::execute()`).
+  if constexpr (frontier_t::is_dense) {
+    static_assert(direction == advance_direction_t::forward &&
+                      input_type == advance_io_type_t::vertices &&
+                      output_type == advance_io_type_t::vertices,
+                  "Dense frontiers support forward vertex-to-vertex "
+                  "advances.");
+    profiler::operator_scope_t scope("advance", input, context);
+    dense::execute(G, op, input, output, context);
+    scope.set_output(output);
+  } else {
+    profiler::operator_scope_t scope("advance", input, context);
+    if (scope.is_active())
+      scope.set_edges((input_type == advance_io_type_t::graph)
+                          ? G.get_number_of_edges()
+                          : profiler::count_edges(G, input, context));
 
-    // std::cout << "[ADV] Input:: ";
-    // input->print();
+    // Output frontier under a capacity limit: an oversized advance runs in
+    // chunks (each chunk is a single-pass advance, see below).
+    if constexpr (input_type != advance_io_type_t::graph &&
+                  output_type != advance_io_type_t::none &&
+                  direction != advance_direction_t::optimized) {
+      if (output->get_capacity_limit() &&
+          chunked::execute(G, input, output, segments, context,
+                           [&](frontier_t* chunk_input,
+                               frontier_t* chunk_output,
+                               work_tiles_t& chunk_segments) {
+                             execute<lb, direction, input_type, output_type>(
+                                 G, op, chunk_input, chunk_output,
+                                 chunk_segments, context);
+                           })) {
+        scope.set_output(output);
+        return;
+      }
+    }
+
+    // Graph in unified memory: migrate the neighbor lists of the input on a
+    // side stream, alongside the advance, instead of faulting them in.
+    if constexpr (input_type != advance_io_type_t::graph &&
+                  direction == advance_direction_t::forward) {
+      if (G.memory_space() == memory_space_t::managed)
+        prefetch::execute(G, input, context);
+    }
 
-    if (lb == load_balance_t::merge_path) {
+    if constexpr (direction == advance_direction_t::optimized) {
+      error::throw_if_exception(
+          cudaErrorUnknown,
+          "Direction-optimized advance requires a `push_pull::state_t`.");
+    } else if (lb == load_balance_t::merge_path) {
       merge_path::execute<direction, input_type, output_type>(
-          G, op, input, output, segments, *context0);
+          G, op, input, output, segments, context);
     } else if (lb == load_balance_t::thread_mapped) {
       thread_mapped::execute<direction, input_type, output_type>(
-          G, op, input, output, segments, *context0);
+          G, op, input, output, segments, context);
     } else if (lb == load_balance_t::block_mapped) {
       block_mapped::execute<direction, input_type, output_type>(
-          G, op, input, output, segments, *context0);
+          G, op, input, output, segments, context);
+    } else if (lb == load_balance_t::warp_mapped) {
+      warp_mapped::execute<direction, input_type, output_type>(
+          G, op, input, output, segments, context);
+    } else if (lb == load_balance_t::work_stealing) {
+      work_stealing::execute<direction, input_type, output_type>(
+          G, op, input, output, segments, context);
+    } else if constexpr (lb == load_balance_t::automatic) {
+      auto selected = select_load_balance(
+          G, input, context, input_type == advance_io_type_t::graph);
+      if (selected == load_balance_t::thread_mapped)
+        execute<load_balance_t::thread_mapped, direction, input_type,
+                output_type>(G, op, input, output, segments, context);
+      else if (selected == load_balance_t::warp_mapped)
+        execute<load_balance_t::warp_mapped, direction, input_type,
+                output_type>(G, op, input, output, segments, context);
+      else if (selected == load_balance_t::work_stealing)
+        execute<load_balance_t::work_stealing, direction, input_type,
+                output_type>(G, op, input, output, segments, context);
+      else
+        execute<load_balance_t::merge_path, direction, input_type, output_type>(
+            G, op, input, output, segments, context);
     } else {
       error::throw_if_exception(cudaErrorUnknown,
                                 "Advance type not supported.");
     }
+    scope.set_output(output);
+  }
+}
 
-    // std::cout << "[ADV] Output:: ";
-    // output->print();
-
+/**
+ * @brief Advance on a `cuda::multi_context_t`, with explicit frontiers. Only
+ * single-GPU contexts are supported by this overload, the enactor overload
+ * below supports multiple GPUs (it holds the partitioned graph and the
+ * per-device frontiers).
+ * @see execute() above for the parameters.
+ */
+template <load_balance_t lb,
+          advance_direction_t direction,
+          advance_io_type_t input_type,
+          advance_io_type_t output_type,
+          typename graph_t,
+          typename operator_t,
+          typename frontier_t,
+          typename work_tiles_t>
+void execute(graph_t& G,
+             operator_t op,
+             frontier_t* input,
+             frontier_t* output,
+             work_tiles_t& segments,
+             cuda::multi_context_t& context) {
+  if (context.size() == 1) {
+    execute<lb, direction, input_type, output_type>(
+        G, op, input, output, segments, *(context.get_context(0)));
   } else {
     error::throw_if_exception(cudaErrorUnknown,
-                              "`context.size() != 1` not supported");
+                              "`context.size() != 1` requires the enactor "
+                              "interface, see `multi_gpu::state_t`.");
+  }
+}
+
+/**
+ * @brief Direction-optimized (push-pull) advance. Each call decides, based on
+ * the frontier size and the number of unvisited edges, whether to push from
+ * the input frontier (using the `lb` load-balanced advance over the CSR view)
+ * or to pull into the unvisited vertices (over the CSC view).
+ *
+ * @par Overview
+ * The graph must contain both CSR and CSC views (see
+ * `graph::build::from_csr<space, view_t::csr | view_t::csc>`). The push step
+ * outputs an edge-sized frontier, the pull step a vertex-sized frontier, both
+ * with invalid slots; follow the advance with a filter to compact them.
+ *
+ * @tparam lb `gunrock::operators::load_balance_t` enum, load-balancing
+ * algorithm used for the push step.
+ * @tparam direction must be
+ * `gunrock::operators::advance_direction_t::optimized` to use push-pull, other
+ * directions ignore the `state`.
+ * @param state `push_pull::state_t`, persists the visited vertices and the
+ * last direction across iterations (also holds the alpha/beta thresholds).
+ * @see execute() for the rest of the parameters.
+ */
+template <load_balance_t lb,
+          advance_direction_t direction,
+          advance_io_type_t input_type,
+          advance_io_type_t output_type,
+          typename graph_t,
+          typename operator_t,
+          typename frontier_t,
+          typename work_tiles_t,
+          typename state_type>
+void execute(graph_t& G,
+             operator_t op,
+             frontier_t* input,
+             frontier_t* output,
+             work_tiles_t& segments,
+             state_type& state,
+             cuda::multi_context_t& context) {
+  if constexpr (direction != advance_direction_t::optimized) {
+    execute<lb, direction, input_type, output_type>(G, op, input, output,
+                                                    segments, context);
+  } else {
+    // Direction-Optimized advance is supported using CSR and CSC graph
+    // views/representations. If they are not both present within the
+    // \type(graph_t), fail at compile time.
+    static_assert(graph_t::template contains_representation<
+                          typename graph_t::graph_csr_view_t>() &&
+                      graph_t::template contains_representation<
+                          typename graph_t::graph_csc_view_t>(),
+                  "CSR and CSC sparse-matrix representations required for "
+                  "direction-optimized advance.");
+
+    if (context.size() != 1)
+      error::throw_if_exception(cudaErrorUnknown,
+                                "Direction-optimized advance is single-GPU.");
+
+    auto context0 = context.get_context(0);
+    auto selected = push_pull::select_direction(G, input, state, *context0);
+
+    if (selected == advance_direction_t::backward) {
+      // The pull scans the in-edges of the unvisited vertices, its edges are
+      // not counted.
+      profiler::operator_scope_t scope("advance", input, *context0);
+      push_pull::execute<input_type, output_type>(G, op, input, output, state,
+                                                  *context0);
+      scope.set_output(output);
+    } else
+      execute<lb, advance_direction_t::forward, input_type, output_type>(
+          G, op, input, output, segments, context);
+  }
+}
+
+/**
+ * @brief Multi-GPU advance using the enactor's `multi_gpu::state_t`: every
+ * GPU advances the portion of the input frontier it owns over its local
+ * subgraph, then the outputs are exchanged between the GPUs (by owner) and
+ * gathered into the enactor's output frontier.
+ *
+ * @note Direction-optimized advance falls back to a forward (push) advance,
+ * the pull step needs the whole in-neighborhood of a vertex.
+ * @see execute() below for the parameters.
+ */
+template <load_balance_t lb,
+          advance_direction_t direction,
+          advance_io_type_t input_type,
+          advance_io_type_t output_type,
+          typename graph_t,
+          typename enactor_type,
+          typename operator_type>
+void multi_gpu_execute(graph_t& G,
+                       enactor_type* E,
+                       operator_type op,
+                       cuda::multi_context_t& context) {
+  constexpr advance_direction_t local_direction =
+      (direction == advance_direction_t::optimized)
+          ? advance_direction_t::forward
+          : direction;
+
+  auto& state = E->multi_gpu_state;
+  state.init(G, context);
+
+  int in = 0;
+  if constexpr (input_type != advance_io_type_t::graph)
+    in = state.acquire(E->get_input_frontier(), context);
+  int out = in ^ 1;
+
+  state.for_each_device(context, [&](int d, auto& slice, auto& local_context) {
+    execute<lb, local_direction, input_type, output_type>(
+        slice.graph, op, &(slice.frontiers[in]), &(slice.scratch),
+        slice.segments, local_context);
+  });
+
+  if constexpr (output_type != advance_io_type_t::none) {
+    state.exchange(out, context);
+    state.gather(out, E->get_output_frontier(), context);
   }
 }
 
@@ -196,14 +414,29 @@ void execute(graph_t& G,
              operator_type op,
              cuda::multi_context_t& context,
              bool swap_buffers = true) {
-  execute<lb, direction, input_type, output_type>(
-      G,                         // graph
-      op,                        // advance operator
-      E->get_input_frontier(),   // input frontier
-      E->get_output_frontier(),  // output frontier
-      E->scanned_work_domain,    // work segments
-      context                    // gpu context
-  );
+  if (context.size() > 1) {
+    multi_gpu_execute<lb, direction, input_type, output_type>(G, E, op,
+                                                            context);
+  } else if constexpr (direction == advance_direction_t::optimized) {
+    execute<lb, direction, input_type, output_type>(
+        G,                         // graph
+        op,                        // advance operator
+        E->get_input_frontier(),   // input frontier
+        E->get_output_frontier(),  // output frontier
+        E->scanned_work_domain,    // work segments
+        E->push_pull_state,        // push-pull bookkeeping
+        context                    // gpu context
+    );
+  } else {
+    execute<lb, direction, input_type, output_type>(
+        G,                         // graph
+        op,                        // advance operator
+        E->get_input_frontier(),   // input frontier
+        E->get_output_frontier(),  // output frontier
+        E->scanned_work_domain,    // work segments
+        context                    // gpu context
+    );
+  }
 
   /*!
    * @note if the Enactor interface is used, we, the library writers assume
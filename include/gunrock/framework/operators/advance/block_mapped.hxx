@@ -17,6 +17,7 @@
 #include <gunrock/cuda/global.hxx>
 
 #include <gunrock/framework/operators/configs.hxx>
+#include <gunrock/framework/operators/launch.hxx>
 
 #include <thrust/transform_scan.h>
 #include <thrust/iterator/discard_iterator.h>
@@ -51,69 +52,67 @@ void __global__ block_mapped_kernel(graph_t const G,
 
   // Specialize Block Scan for 1D block of THREADS_PER_BLOCK.
   using block_scan_t = cub::BlockScan<edge_t, THREADS_PER_BLOCK>;
-  // using block_load_t =
-  //     cub::BlockLoad<edge_t, THREADS_PER_BLOCK, ITEMS_PER_THREAD>;
 
-  auto global_idx = cuda::thread::global::id::x();
+  // Every block works on a tile of THREADS_PER_BLOCK * ITEMS_PER_THREAD input
+  // items, every thread on ITEMS_PER_THREAD consecutive ones (blocked).
+  constexpr int tile_size = THREADS_PER_BLOCK * ITEMS_PER_THREAD;
+  std::size_t tile_begin = (std::size_t)cuda::block::id::x() * tile_size;
   auto local_idx = cuda::thread::local::id::x();
 
   thrust::counting_iterator<type_t> all_vertices(0);
 
-  __shared__ union TempStorage {
-    typename block_scan_t::TempStorage scan;
-    // typename block_load_t::TempStorage load;
-  } storage;
+  __shared__ typename block_scan_t::TempStorage storage;
 
   // Prepare data to process (to shmem/registers).
-  __shared__ vertex_t offset[1];
-  __shared__ vertex_t vertices[THREADS_PER_BLOCK];
-  __shared__ edge_t degrees[THREADS_PER_BLOCK];
-  __shared__ edge_t sedges[THREADS_PER_BLOCK];
+  __shared__ work_tiles_t offset[1];
+  __shared__ vertex_t vertices[tile_size];
+  __shared__ edge_t degrees[tile_size];
+  __shared__ edge_t sedges[tile_size];
   edge_t th_deg[ITEMS_PER_THREAD];
 
-  if (global_idx < input_size) {
-    vertex_t v = (input_type == advance_io_type_t::graph)
-                     ? all_vertices[global_idx]
-                     : input[global_idx];
-    vertices[local_idx] = v;
-    if (gunrock::util::limits::is_valid(v)) {
-      sedges[local_idx] = G.get_starting_edge(v);
-      th_deg[0] = G.get_number_of_neighbors(v);
+#pragma unroll
+  for (int j = 0; j < ITEMS_PER_THREAD; ++j) {
+    int item = local_idx * ITEMS_PER_THREAD + j;
+    std::size_t idx = tile_begin + item;
+    th_deg[j] = 0;
+    if (idx < input_size) {
+      vertex_t v = (input_type == advance_io_type_t::graph) ? all_vertices[idx]
+                                                            : input[idx];
+      vertices[item] = v;
+      if (gunrock::util::limits::is_valid(v)) {
+        sedges[item] = G.get_starting_edge(v);
+        th_deg[j] = G.get_number_of_neighbors(v);
+      }
     } else {
-      th_deg[0] = 0;
+      vertices[item] = gunrock::numeric_limits<vertex_t>::invalid();
     }
-  } else {
-    vertices[local_idx] = gunrock::numeric_limits<vertex_t>::invalid();
-    th_deg[0] = 0;
   }
   __syncthreads();
 
   // Exclusive sum of degrees.
-  vertex_t aggregate_degree_per_block;
-  block_scan_t(storage.scan)
-      .ExclusiveSum(th_deg, th_deg, aggregate_degree_per_block);
+  edge_t aggregate_degree_per_block;
+  block_scan_t(storage).ExclusiveSum(th_deg, th_deg,
+                                     aggregate_degree_per_block);
   __syncthreads();
 
   // Store back to shared memory.
-  degrees[local_idx] = th_deg[0];
+#pragma unroll
+  for (int j = 0; j < ITEMS_PER_THREAD; ++j)
+    degrees[local_idx * ITEMS_PER_THREAD + j] = th_deg[j];
 
   if (output_type != advance_io_type_t::none) {
     // Accumulate the output size to global memory, only done once per block.
     if (local_idx == 0)
-      if ((cuda::block::id::x() * cuda::block::size::x()) < input_size)
-        offset[0] = offsets[cuda::block::id::x() * cuda::block::size::x()];
+      if (tile_begin < input_size)
+        offset[0] = offsets[tile_begin];
   }
 
   __syncthreads();
 
-  // To search for which vertex id we are computing on.
-  auto length = global_idx - local_idx + cuda::block::size::x();
-
-  // Bound check.
-  if (input_size < length)
-    length = input_size;
-
-  length -= global_idx - local_idx;
+  // Number of items of the tile.
+  int length = (tile_begin + tile_size < input_size)
+                   ? tile_size
+                   : (int)(input_size - tile_begin);
 
   for (int i = local_idx;               // threadIdx.x
        i < aggregate_degree_per_block;  // total degree to process
@@ -181,12 +180,17 @@ void execute(graph_t& G,
                               ? G.get_number_of_vertices()
                               : input->get_number_of_elements();
 
-  // TODO: Use launch_box_t instead.
-  constexpr int block_size = 128;
-  int grid_size = (work_size + block_size - 1) / block_size;
+  using launch_box_t =
+      launch::launch_box_for_t<launch::kernel_t::advance_block_mapped>;
+  constexpr int block_size = launch_box_t::block_size;
+  constexpr int items_per_thread = launch_box_t::items_per_thread;
+  constexpr int tile_size = launch_box_t::tile_size;
+  int grid_size = (work_size + tile_size - 1) / tile_size;
+  if (grid_size == 0)
+    return;
 
   // Launch blocked-mapped advance kernel.
-  block_mapped_kernel<block_size, 1, input_type, output_type>
+  block_mapped_kernel<block_size, items_per_thread, input_type, output_type>
       <<<grid_size, block_size, 0, context.stream()>>>(
           G, op, input->data(), output->data(), work_size,
           segments.data().get());
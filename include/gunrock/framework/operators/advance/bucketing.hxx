@@ -0,0 +1,219 @@
+/**
+ * @file bucketing.hxx
+ * @author Muhammad Osama (mosama@ucdavis.edu)
+ * @brief Near-far pile bucketing (delta-stepping) for priority-ordered
+ * traversals, see Davidson et al., "Work-Efficient Parallel GPU Methods for
+ * Single-Source Shortest Paths" (IPDPS'14).
+ * @version 0.1
+ * @date 2021-06-06
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#pragma once
+
+#include <gunrock/util/math.hxx>
+#include <gunrock/cuda/context.hxx>
+
+#include <thrust/copy.h>
+#include <thrust/fill.h>
+#include <thrust/remove.h>
+#include <thrust/for_each.h>
+#include <thrust/host_vector.h>
+#include <thrust/transform_reduce.h>
+
+#include <limits>
+
+namespace gunrock {
+namespace operators {
+namespace advance {
+namespace bucketing {
+
+/**
+ * @brief Near-far piles of a bucketed traversal. The near pile is the
+ * enactor's active frontier (priorities below `split`), the far pile holds the
+ * vertices deferred to a later bucket (priorities at or above `split`).
+ *
+ * @par Overview
+ * Once the near pile is exhausted, `refill()` advances `split` by `delta` and
+ * moves the far vertices whose priority now lies below the split into the near
+ * pile. Far vertices whose priority dropped below the previous split were
+ * already re-inserted into a near pile and are dropped (stale). Every vertex
+ * is inserted into the far pile at most once per bucket, so the far pile never
+ * holds more than `n` vertices.
+ *
+ * @tparam vertex_t vertex type.
+ * @tparam priority_t priority type (e.g. distance/weight type).
+ */
+template <typename vertex_t, typename priority_t>
+struct near_far_t {
+  using size_type = unsigned long long int;  // atomicAdd-able.
+
+  /*!
+   * Width of a bucket.
+   */
+  priority_t delta;
+
+  /*!
+   * Upper bound (exclusive) of the priorities in the near pile.
+   */
+  priority_t split;
+
+  /*!
+   * Current bucket, used to deduplicate insertions into the far pile.
+   */
+  int bucket;
+
+  /*!
+   * Far pile storage, its size (device-side, see `push_far()`) and per-vertex
+   * marker of the last bucket the vertex was inserted in.
+   */
+  thrust::device_vector<vertex_t> far_pile;
+  thrust::device_vector<size_type> far_size;
+  thrust::device_vector<int> far_marker;
+
+  near_far_t() : delta(1), split(1), bucket(0) {}
+
+  /**
+   * @brief Allocate (if needed) and reset the piles, the first bucket is
+   * [0, delta).
+   *
+   * @param n_vertices number of vertices of the graph.
+   * @param _delta width of a bucket.
+   * @param context `cuda::standard_context_t`.
+   */
+  void reset(std::size_t n_vertices,
+             priority_t _delta,
+             cuda::standard_context_t& context) {
+    auto policy = context.execution_policy();
+
+    delta = _delta;
+    split = _delta;
+    bucket = 0;
+
+    far_pile.resize(n_vertices);
+    far_marker.resize(n_vertices);
+    far_size.resize(1);
+    thrust::fill(policy, far_marker.begin(), far_marker.end(), -1);
+    thrust::fill(policy, far_size.begin(), far_size.end(), 0);
+  }
+
+  /**
+   * @brief Number of vertices in the far pile (copied to the host).
+   * @return std::size_t
+   */
+  std::size_t get_far_size() {
+    thrust::host_vector<size_type> h_far_size = far_size;
+    return h_far_size[0];
+  }
+};
+
+/**
+ * @brief Insert `v` into the far pile (device-side), unless it was already
+ * inserted during the current `bucket`.
+ *
+ * @param far_pile `near_far_t::far_pile` data.
+ * @param far_size `near_far_t::far_size` data.
+ * @param far_marker `near_far_t::far_marker` data.
+ * @param bucket `near_far_t::bucket`.
+ * @param v vertex to defer.
+ */
+template <typename vertex_t, typename size_type>
+__device__ __forceinline__ void push_far(vertex_t* far_pile,
+                                         size_type* far_size,
+                                         int* far_marker,
+                                         int const& bucket,
+                                         vertex_t const& v) {
+  if (far_marker[v] == bucket)
+    return;
+  if (math::atomic::max(far_marker + v, bucket) == bucket)
+    return;  // someone else inserted it in this bucket.
+
+  auto idx = math::atomic::add(far_size, (size_type)1);
+  far_pile[idx] = v;
+}
+
+/**
+ * @brief Refill an empty near pile from the far pile, advancing the split by
+ * `delta` until the near pile is non-empty or the far pile is exhausted.
+ *
+ * @param piles `near_far_t`.
+ * @param near near pile (an empty vertex frontier).
+ * @param priority device lambda, `(vertex_t) -> priority_t`, current priority
+ * of a vertex.
+ * @param context `cuda::standard_context_t`.
+ */
+template <typename piles_t, typename frontier_t, typename priority_op_t>
+void refill(piles_t& piles,
+            frontier_t* near,
+            priority_op_t priority,
+            cuda::standard_context_t& context) {
+  using vertex_t = typename frontier_t::type_t;
+  auto policy = context.execution_policy();
+
+  while (near->is_empty()) {
+    std::size_t far_size = piles.get_far_size();
+    if (far_size == 0)
+      return;
+
+    auto far_begin = piles.far_pile.begin();
+    auto far_end = piles.far_pile.begin() + far_size;
+
+    // Skip the empty buckets, the next bucket starts at the smallest priority
+    // (not stale) within the far pile.
+    auto lower = piles.split;
+    auto none = std::numeric_limits<decltype(lower)>::max();
+    auto smallest = thrust::transform_reduce(
+        policy, far_begin, far_end,
+        [=] __device__(vertex_t const& v) {
+          auto p = priority(v);
+          return (p < lower) ? none : p;
+        },
+        none, thrust::minimum<decltype(lower)>());
+
+    // Only stale vertices left, the far pile is exhausted.
+    if (smallest == none) {
+      thrust::fill(policy, piles.far_size.begin(), piles.far_size.end(), 0);
+      return;
+    }
+
+    auto upper = ((smallest > lower) ? smallest : lower) + piles.delta;
+    piles.split = upper;
+    piles.bucket++;
+
+    // Vertices of the next bucket, [lower, upper), move to the near pile.
+    // Priorities are only ever lowered (relaxed), and those that dropped below
+    // `lower` were already re-inserted into a near pile.
+    if (near->get_capacity() < far_size)
+      near->reserve(far_size);
+    auto near_end = thrust::copy_if(policy, far_begin, far_end, near->begin(),
+                                    [=] __device__(vertex_t const& v) {
+                                      auto p = priority(v);
+                                      return (p >= lower) && (p < upper);
+                                    });
+    near->set_number_of_elements(thrust::distance(near->begin(), near_end));
+
+    // Keep the rest, [upper, inf), in the far pile and drop the stale ones.
+    auto new_far_end = thrust::remove_if(
+        policy, far_begin, far_end,
+        [=] __device__(vertex_t const& v) { return priority(v) < upper; });
+    far_size = thrust::distance(far_begin, new_far_end);
+
+    // Remaining far vertices belong to the new bucket, so they are not
+    // inserted again.
+    auto far_marker = piles.far_marker.data().get();
+    auto bucket = piles.bucket;
+    thrust::for_each(policy, far_begin, new_far_end,
+                     [=] __device__(vertex_t const& v) {
+                       far_marker[v] = bucket;
+                     });
+    thrust::fill(policy, piles.far_size.begin(), piles.far_size.end(),
+                 (typename piles_t::size_type)far_size);
+  }
+}
+
+}  // namespace bucketing
+}  // namespace advance
+}  // namespace operators
+}  // namespace gunrock
@@ -0,0 +1,195 @@
+/**
+ * @file captured.hxx
+ * @author Muhammad Osama (mosama@ucdavis.edu)
+ * @brief Capture-safe advance over ping-pong vertex queues whose sizes live
+ * on the device, such that an iteration can be recorded once as a CUDA Graph
+ * and replayed (see `enactor_t::enact_captured()`).
+ * @version 0.1
+ * @date 2021-06-11
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#pragma once
+
+#include <gunrock/error.hxx>
+#include <gunrock/cuda/context.hxx>
+#include <gunrock/container/vector.hxx>
+#include <gunrock/util/type_limits.hxx>
+#include <gunrock/framework/operators/launch.hxx>
+
+#include <algorithm>
+
+namespace gunrock {
+namespace operators {
+namespace advance {
+namespace captured {
+
+using size_type = unsigned long long;
+
+/**
+ * @brief Two vertex queues (typically the enactor's two frontier buffers)
+ * and their device-resident bookkeeping: the size of each queue, which queue
+ * is the input of the next iteration, and the number of iterations that
+ * produced a non-empty queue.
+ *
+ * @tparam vertex_t vertex type.
+ */
+template <typename vertex_t>
+struct queues_t {
+  vertex_t* buffers[2];
+  size_type capacity;
+
+  /*!
+   * `{size of queue 0, size of queue 1, input queue, iteration}`.
+   */
+  vector_t<size_type, memory_space_t::device> state;
+
+  queues_t() : buffers{nullptr, nullptr}, capacity(0), state(4) {}
+
+  /**
+   * @brief Use the storage of `input` and `output` as the queues, the
+   * elements of `input` are the first input queue. Not capture-safe, call it
+   * before the capture (e.g., in `prepare_frontier()`).
+   */
+  template <typename frontier_t>
+  void bind(frontier_t& input,
+            frontier_t& output,
+            cuda::standard_context_t& context) {
+    buffers[0] = input.data();
+    buffers[1] = output.data();
+    capacity = std::min(input.get_capacity(), output.get_capacity());
+
+    // The input was likely filled on the default stream.
+    context.pool()->order(0, context.stream());
+    size_type h_state[4] = {input.get_number_of_elements(), 0, 0, 0};
+    cudaMemcpyAsync(state.data().get(), h_state, sizeof(h_state),
+                    cudaMemcpyHostToDevice, context.stream());
+    context.synchronize();
+  }
+
+  /**
+   * @brief Device pointer to the iteration counter, for operators that
+   * depend on the iteration (kernel arguments are frozen by the capture).
+   */
+  size_type const* get_iteration() { return state.data().get() + 3; }
+
+  /**
+   * @brief Size of the current input queue (synchronous, not capture-safe).
+   */
+  size_type get_number_of_elements(cuda::standard_context_t& context) {
+    size_type h_state[4];
+    cudaMemcpyAsync(h_state, state.data().get(), sizeof(h_state),
+                    cudaMemcpyDeviceToHost, context.stream());
+    context.synchronize();
+    return h_state[h_state[2]];
+  }
+
+  /**
+   * @brief Number of iterations that produced a non-empty queue
+   * (synchronous, not capture-safe).
+   */
+  size_type get_number_of_iterations(cuda::standard_context_t& context) {
+    size_type h_iteration;
+    cudaMemcpyAsync(&h_iteration, get_iteration(), sizeof(size_type),
+                    cudaMemcpyDeviceToHost, context.stream());
+    context.synchronize();
+    return h_iteration;
+  }
+};
+
+/**
+ * @brief Expand the input queue (thread-mapped, grid-stride over the
+ * device-resident size), pushing the accepted neighbors to the output queue.
+ */
+template <typename graph_t, typename operator_t, typename vertex_t>
+__global__ void expand(graph_t G,
+                       operator_t op,
+                       vertex_t* queue_0,
+                       vertex_t* queue_1,
+                       size_type capacity,
+                       size_type* state,
+                       int* work_remains) {
+  size_type selector = state[2];
+  vertex_t const* input = selector ? queue_1 : queue_0;
+  vertex_t* output = selector ? queue_0 : queue_1;
+  size_type* output_size = state + (selector ^ 1);
+  size_type size = (state[selector] < capacity) ? state[selector] : capacity;
+
+  for (size_type i = blockIdx.x * blockDim.x + threadIdx.x; i < size;
+       i += gridDim.x * blockDim.x) {
+    auto v = input[i];
+    if (!gunrock::util::limits::is_valid(v))
+      continue;
+
+    auto starting_edge = G.get_starting_edge(v);
+    auto total_edges = G.get_number_of_neighbors(v);
+    for (auto k = 0; k < total_edges; ++k) {
+      auto e = k + starting_edge;
+      auto n = G.get_destination_vertex(e);
+      auto w = G.get_edge_weight(e);
+      if (!op(v, n, e, w))
+        continue;
+
+      size_type position = atomicAdd(output_size, size_type(1));
+      if (position < capacity)
+        output[position] = n;
+      *work_remains = 1;
+    }
+  }
+}
+
+/**
+ * @brief Empty the consumed input queue, and make the output queue the next
+ * input if it is non-empty (an empty output leaves the bookkeeping as is, so
+ * the replays past convergence are no-ops).
+ */
+template <typename state_t>
+__global__ void swap(state_t* state) {
+  state_t selector = state[2];
+  state[selector] = 0;
+  if (state[selector ^ 1] > 0) {
+    state[2] = selector ^ 1;
+    state[3] += 1;
+  }
+}
+
+/**
+ * @brief Capture-safe advance, `op(source, neighbor, edge, weight) -> bool`
+ * is applied to the outgoing edges of the input queue and the accepted
+ * neighbors form the next input queue. The launch configuration only depends
+ * on the device, and sets `work_remains[0]` to 1 if any neighbor is accepted.
+ *
+ * @note The operator should accept a vertex at most once (e.g., by claiming
+ * it atomically), the accepted neighbors beyond the queues' capacity are
+ * dropped.
+ *
+ * @param G graph (its default view is traversed).
+ * @param op advance operator.
+ * @param queues `queues_t`, bound to the frontier buffers.
+ * @param work_remains device flag.
+ * @param context `cuda::standard_context_t`, its stream is the one captured.
+ */
+template <typename graph_t, typename operator_t, typename vertex_t>
+void execute(graph_t& G,
+             operator_t op,
+             queues_t<vertex_t>& queues,
+             int* work_remains,
+             cuda::standard_context_t& context) {
+  using launch_box_t =
+      launch::launch_box_for_t<launch::kernel_t::advance_captured>;
+  constexpr int threads = launch_box_t::block_size;
+  int blocks = context.props().multiProcessorCount * 8;
+  auto state = queues.state.data().get();
+
+  expand<<<blocks, threads, 0, context.stream()>>>(
+      G, op, queues.buffers[0], queues.buffers[1], queues.capacity, state,
+      work_remains);
+  swap<<<1, 1, 0, context.stream()>>>(state);
+}
+
+}  // namespace captured
+}  // namespace advance
+}  // namespace operators
+}  // namespace gunrock
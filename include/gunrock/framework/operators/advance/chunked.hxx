@@ -0,0 +1,139 @@
+/**
+ * @file chunked.hxx
+ * @author Muhammad Osama (mosama@ucdavis.edu)
+ * @brief Advance in several passes, for outputs larger than the output
+ * frontier's capacity limit.
+ * @version 0.1
+ * @date 2021-06-16
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#pragma once
+
+#include <gunrock/error.hxx>
+#include <gunrock/cuda/context.hxx>
+#include <gunrock/util/type_limits.hxx>
+#include <gunrock/framework/operators/advance/helpers.hxx>
+
+#include <thrust/binary_search.h>
+#include <thrust/copy.h>
+#include <thrust/count.h>
+
+namespace gunrock {
+namespace operators {
+namespace advance {
+namespace chunked {
+
+/**
+ * @brief Predicate of the items kept from a chunk's output (a functor, the
+ * enclosing function is instantiated on the host `advance_t` closure).
+ */
+template <typename type_t>
+struct is_valid_t {
+  __device__ bool operator()(type_t const& v) const {
+    return gunrock::util::limits::is_valid(v);
+  }
+};
+
+/**
+ * @brief If the output of the advance would exceed the capacity limit of the
+ * output frontier (`frontier_t::set_capacity_limit()`), advance the input in
+ * chunks instead: every chunk of the input whose neighbors fit within the
+ * limit is advanced into a scratch frontier, whose valid items are then
+ * appended to the output.
+ *
+ * @par Overview
+ * The chunk boundaries come from the scan of the input degrees (the same
+ * scan `compute_output_length()` needs to size the output), one binary
+ * search per chunk. Unlike a single-pass advance, the output of a chunked
+ * advance has no invalid slots; it must fit within the limit once compacted.
+ *
+ * @param G graph.
+ * @param input input frontier (sparse).
+ * @param output output frontier, with a capacity limit.
+ * @param segments storage for the scan of the input degrees.
+ * @param context `cuda::standard_context_t`.
+ * @param advance `advance(chunk_input, chunk_output, chunk_segments)`, the
+ * single-pass advance of a chunk.
+ * @return bool `true` if the advance was processed in chunks, `false` if the
+ * output fits (or has no limit) and a single-pass advance should be used.
+ */
+template <typename graph_t,
+          typename frontier_t,
+          typename work_tiles_t,
+          typename advance_t>
+bool execute(graph_t& G,
+             frontier_t* input,
+             frontier_t* output,
+             work_tiles_t& segments,
+             cuda::standard_context_t& context,
+             advance_t advance) {
+  using type_t = typename frontier_t::type_t;
+  using offset_t = typename work_tiles_t::value_type;
+
+  if constexpr (frontier_t::is_dense) {
+    return false;
+  } else {
+    std::size_t limit = output->get_capacity_limit();
+    if (limit == 0)
+      return false;
+
+    std::size_t size_of_output =
+        compute_output_length(G, input, segments, context);
+    if (size_of_output <= limit)
+      return false;
+
+    auto policy = context.execution_policy();
+    std::size_t size = input->get_number_of_elements();
+    offset_t const* offsets = segments.data().get();
+
+    frontier_t chunk_input, chunk_output;
+    work_tiles_t chunk_segments;
+    chunk_output.reserve(limit);
+
+    std::size_t produced = 0;
+    output->set_number_of_elements(0);
+    for (std::size_t begin = 0; begin < size;) {
+      // Last input item such that the chunk's neighbors fit within the limit.
+      offset_t base = segments[begin];
+      std::size_t end =
+          thrust::distance(
+              offsets, thrust::upper_bound(policy, offsets + begin + 1,
+                                           offsets + size + 1,
+                                           (offset_t)(base + limit))) -
+          1;
+      if (end == begin)
+        error::throw_if_exception(
+            cudaErrorMemoryAllocation,
+            "Neighbors of a vertex exceed the frontier's capacity limit.");
+
+      chunk_input.set_number_of_elements(0);
+      chunk_input.reserve(end - begin);
+      chunk_input.set_number_of_elements(end - begin);
+      thrust::copy(policy, input->begin() + begin, input->begin() + end,
+                   chunk_input.begin());
+
+      advance(&chunk_input, &chunk_output, chunk_segments);
+
+      // Append the valid items of the chunk to the output.
+      is_valid_t<type_t> valid;
+      std::size_t kept = thrust::count_if(policy, chunk_output.begin(),
+                                          chunk_output.end(), valid);
+      output->reserve(produced + kept);
+      thrust::copy_if(policy, chunk_output.begin(), chunk_output.end(),
+                      output->begin() + produced, valid);
+      produced += kept;
+      output->set_number_of_elements(produced);
+
+      begin = end;
+    }
+    return true;
+  }
+}
+
+}  // namespace chunked
+}  // namespace advance
+}  // namespace operators
+}  // namespace gunrock
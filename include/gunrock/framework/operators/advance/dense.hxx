@@ -0,0 +1,105 @@
+/**
+ * @file dense.hxx
+ * @author Muhammad Osama (mosama@ucdavis.edu)
+ * @brief Advance over dense (bitmap or boolmap) frontiers.
+ * @version 0.1
+ * @date 2021-06-28
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#pragma once
+
+#include <gunrock/cuda/context.hxx>
+#include <gunrock/framework/frontier/frontier.hxx>
+#include <gunrock/framework/operators/configs.hxx>
+
+#include <algorithm>
+
+#include <thrust/for_each.h>
+#include <thrust/iterator/counting_iterator.h>
+
+namespace gunrock {
+namespace operators {
+namespace advance {
+namespace dense {
+
+/**
+ * @brief Forward advance from a dense input frontier into a dense output
+ * frontier: every active vertex of `input` expands its outgoing edges, the
+ * neighbors accepted by `op` are set in `output` (cleared first, and sized
+ * to the vertices of `G`). A bitmap is scanned a word per thread, the set
+ * bits are turned into vertex ids with `__ffs`; a boolmap is scanned a
+ * vertex per thread. No segments (scan of the work) are needed, and the
+ * output is duplicate-free by construction.
+ *
+ * @note Thread-mapped over the active vertices, meant for the dense
+ * iterations of a traversal, where most vertices are active.
+ *
+ * @param G graph.
+ * @param op advance operator, `op(source, neighbor, edge, weight) -> bool`.
+ * @param input dense input frontier.
+ * @param output dense output frontier.
+ * @param context `cuda::standard_context_t`.
+ */
+template <typename graph_t, typename operator_t, typename frontier_t>
+void execute(graph_t& G,
+             operator_t op,
+             frontier_t* input,
+             frontier_t* output,
+             cuda::standard_context_t& context) {
+  static_assert(frontier_t::is_dense,
+                "Dense advance requires bitmap or boolmap frontiers.");
+  using type_t = typename frontier_t::type_t;
+
+  std::size_t n = G.get_number_of_vertices();
+  if (output->get_capacity() < n)
+    output->reserve(n);
+  output->clear(context.stream());
+
+  auto in = input->data();
+  auto out = output->data();
+  auto expand = [=] __device__(type_t const& v) {
+    auto starting_edge = G.get_starting_edge(v);
+    auto total_edges = G.get_number_of_neighbors(v);
+    for (decltype(total_edges) i = 0; i < total_edges; ++i) {
+      auto e = i + starting_edge;
+      auto neighbor = G.get_destination_vertex(e);
+      auto weight = G.get_edge_weight(e);
+      if (op(v, neighbor, e, weight))
+        frontier_t::insert(out, neighbor);
+    }
+  };
+
+  auto policy = context.execution_policy();
+  if constexpr (frontier_t::underlying_storage == frontier_storage_t::bitmap) {
+    constexpr std::size_t bits = frontier_t::bits_per_word;
+    std::size_t words = frontier_t::number_of_words(
+        std::min<std::size_t>(n, input->get_capacity()));
+    thrust::for_each(policy, thrust::make_counting_iterator<std::size_t>(0),
+                     thrust::make_counting_iterator<std::size_t>(words),
+                     [=] __device__(std::size_t const& w) {
+                       auto word = in[w];
+                       while (word) {
+                         int b = __ffs(word) - 1;
+                         word &= word - 1;
+                         expand((type_t)(w * bits + b));
+                       }
+                     });
+  } else {
+    std::size_t size = std::min<std::size_t>(n, input->get_capacity());
+    thrust::for_each(policy, thrust::make_counting_iterator<type_t>(0),
+                     thrust::make_counting_iterator<type_t>(size),
+                     [=] __device__(type_t const& v) {
+                       if (frontier_t::contains(in, v))
+                         expand(v);
+                     });
+  }
+  output->touch();
+}
+
+}  // namespace dense
+}  // namespace advance
+}  // namespace operators
+}  // namespace gunrock
@@ -12,7 +12,13 @@
 #pragma once
 
 #include <gunrock/cuda/context.hxx>
+#include <gunrock/cuda/device_properties.hxx>
+#include <gunrock/framework/operators/configs.hxx>
+
+#include <thrust/tuple.h>
+#include <thrust/extrema.h>
 #include <thrust/transform_scan.h>
+#include <thrust/transform_reduce.h>
 
 namespace gunrock {
 namespace operators {
@@ -25,6 +31,8 @@ std::size_t compute_output_length(graph_t& G,
                                   cuda::standard_context_t& context,
                                   bool graph_as_frontier = false) {
   using vertex_t = typename graph_t::vertex_type;
+  // Offsets into the output (edge-sized, e.g. 64-bit with 32-bit vertices).
+  using offset_t = typename work_tiles_t::value_type;
 
   auto input_data = input->data();
   auto total_elems = graph_as_frontier ? G.get_number_of_vertices()
@@ -34,7 +42,8 @@ std::size_t compute_output_length(graph_t& G,
   if (segments.size() < total_elems + 1)
     segments.resize(total_elems + 1);
 
-  auto segment_sizes = [=] __host__ __device__(std::size_t const& i) {
+  auto segment_sizes =
+      [=] __host__ __device__(std::size_t const& i) -> offset_t {
     if (i == total_elems)  // XXX: this is a weird exc. scan.
       return 0;
 
@@ -53,8 +62,8 @@ std::size_t compute_output_length(graph_t& G,
                                                   1),  // input iterator: last
       segments.begin(),                                // output iterator
       segment_sizes,                                   // unary operation
-      (vertex_t)0,                                     // initial value
-      thrust::plus<vertex_t>()                         // binary operation
+      (offset_t)0,                                     // initial value
+      thrust::plus<offset_t>()                         // binary operation
   );
 
   // The last item contains the total scanned items, so in a simple
@@ -70,7 +79,7 @@ std::size_t compute_output_length(graph_t& G,
   // If the active buffer is greater than number of vertices,
   // we should TODO: resize the scanned work domain, this happens
   // when we allow duplicates to be in the active buffer.
-  thrust::host_vector<vertex_t> size_of_output(
+  thrust::host_vector<offset_t> size_of_output(
       segments.data() + location_of_total_scanned_items,
       segments.data() + location_of_total_scanned_items + 1);
 
@@ -85,6 +94,75 @@ std::size_t compute_output_length(graph_t& G,
   return size_of_output[0];
 }
 
+/**
+ * @brief Select a load-balancing strategy for the advance, used by
+ * `load_balance_t::automatic`. One read-only pass over the input frontier
+ * gathers the number of valid vertices, their total and maximum degree.
+ *
+ * @par Overview
+ *  - Small degrees everywhere (max <= warp size), `thread_mapped`: no imbalance
+ *    to fix, cheapest kernel.
+ *  - Heavy skew (a few hubs much larger than the average), `work_stealing`:
+ *    hubs are split across all warps of the GPU.
+ *  - Large average degree, `warp_mapped`: most vertices fill a warp.
+ *  - Otherwise, `merge_path`.
+ *
+ * @return load_balance_t the selected strategy (never `automatic`).
+ */
+template <typename graph_t, typename frontier_t>
+load_balance_t select_load_balance(graph_t& G,
+                                   frontier_t* input,
+                                   cuda::standard_context_t& context,
+                                   bool graph_as_frontier = false) {
+  using vertex_t = typename graph_t::vertex_type;
+  using stats_t = thrust::tuple<std::size_t, std::size_t, std::size_t>;
+
+  constexpr std::size_t warp_size = cuda::properties::warp_max_threads();
+  constexpr std::size_t thread_mapped_max_average = 8;
+  constexpr std::size_t work_stealing_min_degree = 4096;
+  constexpr std::size_t work_stealing_min_skew = 64;
+
+  auto input_data = input->data();
+  auto total_elems = graph_as_frontier ? G.get_number_of_vertices()
+                                       : input->get_number_of_elements();
+
+  // (valid vertices, total degree, maximum degree)
+  auto degree_stats = [=] __device__(std::size_t const& i) -> stats_t {
+    auto v = graph_as_frontier ? vertex_t(i) : input_data[i];
+    if (!gunrock::util::limits::is_valid(v))
+      return stats_t(0, 0, 0);
+    std::size_t degree = G.get_number_of_neighbors(v);
+    return stats_t(1, degree, degree);
+  };
+
+  auto combine = [] __device__(stats_t const& a, stats_t const& b) -> stats_t {
+    return stats_t(thrust::get<0>(a) + thrust::get<0>(b),
+                   thrust::get<1>(a) + thrust::get<1>(b),
+                   thrust::max(thrust::get<2>(a), thrust::get<2>(b)));
+  };
+
+  stats_t stats = thrust::transform_reduce(
+      context.execution_policy(),
+      thrust::make_counting_iterator<std::size_t>(0),
+      thrust::make_counting_iterator<std::size_t>(total_elems), degree_stats,
+      stats_t(0, 0, 0), combine);
+
+  std::size_t valid = thrust::get<0>(stats);
+  std::size_t max_degree = thrust::get<2>(stats);
+  std::size_t average_degree =
+      (valid == 0) ? 0 : thrust::get<1>(stats) / valid;
+
+  if (max_degree <= warp_size && average_degree < thread_mapped_max_average)
+    return load_balance_t::thread_mapped;
+  if (max_degree >= work_stealing_min_degree &&
+      max_degree >= work_stealing_min_skew * std::max<std::size_t>(
+                                                   average_degree, 1))
+    return load_balance_t::work_stealing;
+  if (average_degree >= warp_size)
+    return load_balance_t::warp_mapped;
+  return load_balance_t::merge_path;
+}
+
 }  // namespace advance
 }  // namespace operators
 }  // namespace gunrock
\ No newline at end of file
@@ -11,16 +11,20 @@
 
 #pragma once
 
+#include <gunrock/error.hxx>
 #include <gunrock/util/math.hxx>
 #include <gunrock/cuda/context.hxx>
 
 #include <gunrock/framework/operators/configs.hxx>
+#include <gunrock/framework/operators/launch.hxx>
 
 // XXX: Replace these later
 #include <moderngpu/transform.hxx>
 #include <moderngpu/kernel_scan.hxx>
 #include <moderngpu/kernel_load_balance.hxx>
 
+#include <limits>
+
 namespace gunrock {
 namespace operators {
 namespace advance {
@@ -38,22 +42,8 @@ void execute(graph_t& G,
              frontier_t* output,
              work_tiles_t& segments,
              cuda::standard_context_t& context) {
-  if constexpr (direction == advance_direction_t::optimized) {
-    error::throw_if_exception(cudaErrorUnknown,
-                              "Direction-optimized not yet implemented.");
-
-    // Direction-Optimized advance is supported using CSR and CSC graph
-    // views/representations. If they are not both present within the
-    // \type(graph_t), throw an exception.
-    using find_csr_t = typename graph_t::graph_csr_view_t;
-    using find_csc_t = typename graph_t::graph_csc_view_t;
-    if (!(G.template contains_representation<find_csr_t>() &&
-          G.template contains_representation<find_csc_t>())) {
-      error::throw_if_exception(cudaErrorUnknown,
-                                "CSR and CSC sparse-matrix representations "
-                                "required for direction-optimized advance.");
-    }
-  }
+  static_assert(direction != advance_direction_t::optimized,
+                "Use push_pull for the direction-optimized advance.");
 
   using type_t = typename frontier_t::type_t;
   using view_t = std::conditional_t<direction == advance_direction_t::forward,
@@ -64,6 +54,12 @@ void execute(graph_t& G,
       G, input, segments, context,
       (input_type == advance_io_type_t::graph) ? true : false);
 
+  // moderngpu counts the work items (and segments) with `int`.
+  if (size_of_output > std::numeric_limits<int>::max())
+    error::throw_if_exception(cudaErrorUnknown,
+                              "Merge-path advance of more than 2^31 - 1 "
+                              "edges is not supported, use block_mapped.");
+
   if constexpr (output_type != advance_io_type_t::none) {
     // If output frontier is empty, resize and return.
     if (size_of_output <= 0) {
@@ -108,9 +104,13 @@ void execute(graph_t& G,
   int end = (input_type == advance_io_type_t::graph)
                 ? G.get_number_of_vertices()
                 : input->get_number_of_elements();
-  mgpu::transform_lbs(neighbors_expand, size_of_output,
-                      thrust::raw_pointer_cast(segments.data()), end,
-                      *(context.mgpu()));
+  using launch_box_t =
+      launch::launch_box_for_t<launch::kernel_t::advance_merge_path>;
+  using launch_params_t = mgpu::launch_params_t<launch_box_t::block_size,
+                                                launch_box_t::items_per_thread>;
+  mgpu::transform_lbs<launch_params_t>(
+      neighbors_expand, size_of_output,
+      thrust::raw_pointer_cast(segments.data()), end, *(context.mgpu()));
 }
 }  // namespace merge_path
 }  // namespace advance
@@ -0,0 +1,191 @@
+/**
+ * @file persistent.hxx
+ * @author Muhammad Osama (mosama@ucdavis.edu)
+ * @brief Persistent advance, one cooperative kernel runs all the iterations
+ * of a traversal over the device-resident queues of `captured::queues_t`
+ * (see `enactor_properties_t::persistent_iterations`).
+ * @version 0.1
+ * @date 2021-06-23
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#pragma once
+
+#include <gunrock/error.hxx>
+#include <gunrock/cuda/context.hxx>
+#include <gunrock/util/type_limits.hxx>
+#include <gunrock/framework/operators/launch.hxx>
+#include <gunrock/framework/operators/advance/captured.hxx>
+
+#include <cooperative_groups.h>
+
+#include <algorithm>
+
+namespace gunrock {
+namespace operators {
+namespace advance {
+namespace persistent {
+
+namespace cg = cooperative_groups;
+
+using size_type = captured::size_type;
+
+/**
+ * @brief Iterate until the input queue is empty: every iteration expands
+ * the input queue (thread-mapped, grid-stride), pushes the neighbors
+ * accepted by both `advance_op` and `filter_op` to the output queue, and
+ * after a grid-wide sync, swaps the queues (as `captured::swap`).
+ */
+template <typename graph_t,
+          typename advance_op_t,
+          typename filter_op_t,
+          typename vertex_t>
+__global__ void persistent_kernel(graph_t G,
+                                  advance_op_t advance_op,
+                                  filter_op_t filter_op,
+                                  vertex_t* queue_0,
+                                  vertex_t* queue_1,
+                                  size_type capacity,
+                                  size_type* state,
+                                  size_type* edges_visited) {
+  cg::grid_group grid = cg::this_grid();
+  size_type visited = 0;
+
+  while (true) {
+    // Same bookkeeping on every thread, it only changes between the syncs.
+    size_type selector = state[2];
+    size_type size = (state[selector] < capacity) ? state[selector] : capacity;
+    if (size == 0)
+      break;
+
+    vertex_t const* input = selector ? queue_1 : queue_0;
+    vertex_t* output = selector ? queue_0 : queue_1;
+    size_type* output_size = state + (selector ^ 1);
+
+    for (size_type i = grid.thread_rank(); i < size; i += grid.size()) {
+      auto v = input[i];
+      if (!gunrock::util::limits::is_valid(v))
+        continue;
+
+      auto starting_edge = G.get_starting_edge(v);
+      auto total_edges = G.get_number_of_neighbors(v);
+      visited += total_edges;
+      for (decltype(total_edges) k = 0; k < total_edges; ++k) {
+        auto e = k + starting_edge;
+        auto n = G.get_destination_vertex(e);
+        auto w = G.get_edge_weight(e);
+        if (!advance_op(v, n, e, w) || !filter_op(n))
+          continue;
+
+        // One atomic per (coalesced) group of accepting threads.
+        auto active = cg::coalesced_threads();
+        size_type base = 0;
+        if (active.thread_rank() == 0)
+          base = atomicAdd(output_size, (size_type)active.size());
+        base = active.shfl(base, 0);
+        size_type position = base + active.thread_rank();
+        if (position < capacity)
+          output[position] = n;
+      }
+    }
+
+    grid.sync();
+    if (grid.thread_rank() == 0) {
+      state[selector] = 0;
+      if (state[selector ^ 1] > 0) {
+        state[2] = selector ^ 1;
+        state[3] += 1;
+      }
+    }
+    grid.sync();
+  }
+
+  if (edges_visited && visited)
+    atomicAdd(edges_visited, visited);
+}
+
+/**
+ * @brief Persistent traversal, `advance_op(source, neighbor, edge, weight)
+ * -> bool` and `filter_op(neighbor) -> bool` are applied to the outgoing
+ * edges of the input queue, the neighbors accepted by both form the next
+ * input queue, until it is empty. One cooperative kernel (one full wave of
+ * blocks) runs all the iterations, with grid-wide syncs between them, and
+ * returns to the host once converged: no per-iteration launches, host loop
+ * or host reads of the frontier size, which dominate the iterations of
+ * small-frontier, high-diameter traversals (e.g., road networks).
+ *
+ * @note The operators are the ones of an advance and a filter, operators
+ * that depend on the iteration read it from `queues.get_iteration()`. They
+ * should accept a vertex at most once per iteration (e.g., by claiming it
+ * atomically), the accepted neighbors beyond the queues' capacity are
+ * dropped.
+ *
+ * @param G graph (its default view is traversed).
+ * @param advance_op advance operator.
+ * @param filter_op filter operator, applied to the accepted neighbors.
+ * @param queues `captured::queues_t`, bound to the frontier buffers; on
+ * return, its iteration counter is the number of non-empty iterations.
+ * @param context `cuda::standard_context_t`.
+ * @param edges_visited device counter (optional), incremented by the number
+ * of edges the traversal visited.
+ */
+template <typename graph_t,
+          typename advance_op_t,
+          typename filter_op_t,
+          typename vertex_t>
+void execute(graph_t& G,
+             advance_op_t advance_op,
+             filter_op_t filter_op,
+             captured::queues_t<vertex_t>& queues,
+             cuda::standard_context_t& context,
+             size_type* edges_visited = nullptr) {
+  if (!context.props().cooperativeLaunch)
+    error::throw_if_exception(cudaErrorNotSupported,
+                              "Persistent advance requires cooperative "
+                              "launches.");
+
+  using launch_box_t =
+      launch::launch_box_for_t<launch::kernel_t::advance_persistent>;
+  constexpr int threads = launch_box_t::block_size;
+  auto kernel =
+      persistent_kernel<graph_t, advance_op_t, filter_op_t, vertex_t>;
+
+  // All the blocks must be resident for the grid-wide syncs.
+  int blocks_per_sm = 0;
+  error::throw_if_exception(cudaOccupancyMaxActiveBlocksPerMultiprocessor(
+      &blocks_per_sm, kernel, threads, 0));
+  int blocks = context.props().multiProcessorCount * blocks_per_sm;
+  if (blocks == 0)
+    error::throw_if_exception(cudaErrorCooperativeLaunchTooLarge);
+
+  auto state = queues.state.data().get();
+  void* arguments[] = {&G,
+                       &advance_op,
+                       &filter_op,
+                       &queues.buffers[0],
+                       &queues.buffers[1],
+                       &queues.capacity,
+                       &state,
+                       &edges_visited};
+  error::throw_if_exception(cudaLaunchCooperativeKernel(
+      (void*)kernel, blocks, threads, arguments, 0, context.stream()));
+}
+
+/**
+ * @brief Persistent traversal without a filter, see above.
+ */
+template <typename graph_t, typename advance_op_t, typename vertex_t>
+void execute(graph_t& G,
+             advance_op_t advance_op,
+             captured::queues_t<vertex_t>& queues,
+             cuda::standard_context_t& context) {
+  auto keep = [] __device__(vertex_t const& v) -> bool { return true; };
+  execute(G, advance_op, keep, queues, context);
+}
+
+}  // namespace persistent
+}  // namespace advance
+}  // namespace operators
+}  // namespace gunrock
@@ -0,0 +1,225 @@
+/**
+ * @file prefetch.hxx
+ * @author Muhammad Osama (mosama@ucdavis.edu)
+ * @brief Prefetch the neighbor lists of a frontier of a graph in unified
+ * (managed) memory, ahead of the advance.
+ * @version 0.1
+ * @date 2021-06-19
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#pragma once
+
+#include <gunrock/memory.hxx>
+#include <gunrock/cuda/context.hxx>
+#include <gunrock/container/vector.hxx>
+#include <gunrock/util/math.hxx>
+#include <gunrock/util/type_limits.hxx>
+#include <gunrock/graph/csr.hxx>
+
+#include <thrust/for_each.h>
+#include <thrust/iterator/counting_iterator.h>
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+
+namespace gunrock {
+namespace operators {
+namespace advance {
+namespace prefetch {
+
+/// Granularity of the touched ranges, one read per 64KB (the unit the driver
+/// migrates on a fault, at least).
+constexpr std::size_t default_page_size = std::size_t(64) << 10;
+
+/**
+ * @brief Persistent state of the prefetches issued from a context's stream:
+ * the page marks (the epoch of the last advance that touched a page, such
+ * that they are never cleared), the list of pages marked by the last
+ * advance and its device counter, and the side stream the pages are touched
+ * on, with the event it records once done.
+ */
+struct state_t {
+  int device;
+  cudaStream_t stream;
+  cudaEvent_t done;
+  unsigned int epoch = 0;
+  std::size_t capacity = 0;
+  unsigned int* marks = nullptr;
+  std::size_t* pages = nullptr;  // `capacity` pages, then the counter.
+
+  state_t(int _device) : device(_device) {
+    cudaSetDevice(device);
+    error::throw_if_exception(
+        cudaStreamCreateWithFlags(&stream, cudaStreamNonBlocking));
+    error::throw_if_exception(
+        cudaEventCreateWithFlags(&done, cudaEventDisableTiming));
+  }
+
+  ~state_t() {
+    // May outlive the CUDA runtime (static), the errors are ignored.
+    cudaSetDevice(device);
+    cudaStreamSynchronize(stream);
+    cudaFree(marks);
+    cudaFree(pages);
+    cudaEventDestroy(done);
+    cudaStreamDestroy(stream);
+  }
+
+  /**
+   * @brief Grow the marks and the page list to `size` pages (zeroed) on
+   * `on`, and start a new epoch.
+   */
+  void prepare(std::size_t size, cudaStream_t on) {
+    if (size > capacity) {
+      error::throw_if_exception(cudaStreamSynchronize(stream));
+      cudaFree(marks);
+      cudaFree(pages);
+      error::throw_if_exception(
+          cudaMalloc(&marks, size * sizeof(unsigned int)));
+      error::throw_if_exception(
+          cudaMalloc(&pages, (size + 1) * sizeof(std::size_t)));
+      error::throw_if_exception(
+          cudaMemsetAsync(marks, 0, size * sizeof(unsigned int), on));
+      capacity = size;
+      epoch = 0;
+    }
+    if (++epoch == 0) {
+      error::throw_if_exception(
+          cudaMemsetAsync(marks, 0, capacity * sizeof(unsigned int), on));
+      epoch = 1;
+    }
+    error::throw_if_exception(
+        cudaMemsetAsync(pages + capacity, 0, sizeof(std::size_t), on));
+  }
+
+  /**
+   * @brief State of the prefetches from `stream` (of `device`), created on
+   * first use.
+   */
+  static state_t& get(int device, cudaStream_t stream) {
+    static std::map<cudaStream_t, std::unique_ptr<state_t>> states;
+    static std::mutex states_mutex;
+    std::lock_guard<std::mutex> guard(states_mutex);
+    auto& state = states[stream];
+    if (!state || state->device != device)
+      state = std::make_unique<state_t>(device);
+    return *state;
+  }
+};
+
+/**
+ * @brief Migrate the pages of the column indices (and values) of a CSR graph
+ * in managed memory that the neighbors of the (sparse) input frontier span,
+ * to the context's device, while the advance runs, instead of faulting them
+ * in one by one on the advance's critical path.
+ *
+ * @par Overview
+ * Every input vertex marks the pages its neighbor list spans (on the
+ * context's stream, in the persistent `state_t` of the stream), the first
+ * vertex to mark a page in this advance appends it to a page list. A side
+ * stream then reads one element of every listed page, migrating it to the
+ * device, concurrently with the advance; the host never waits for, nor
+ * copies, the marks. The next prefetch from the stream waits (on the device)
+ * for the previous one before reusing the page list. The row offsets are not
+ * prefetched: built as managed, the topology is read mostly (see
+ * `memory::advise_read_mostly()`), the offsets are replicated on first
+ * access. Dense frontiers and graphs without a (plain or weightless) CSR
+ * view are not prefetched.
+ *
+ * @param G graph, in managed memory.
+ * @param input input frontier.
+ * @param context `cuda::standard_context_t`.
+ * @param page_size granularity of the touched ranges, in bytes.
+ */
+template <typename graph_t, typename frontier_t>
+void execute(graph_t& G,
+             frontier_t* input,
+             cuda::standard_context_t& context,
+             std::size_t page_size = default_page_size) {
+  using vertex_t = typename graph_t::vertex_type;
+  using edge_t = typename graph_t::edge_type;
+  using weight_t = typename graph_t::weight_type;
+  using csr_view_t = typename graph_t::graph_csr_view_t;
+
+  constexpr bool has_column_indices =
+      graph_t::template contains_representation<csr_view_t>() &&
+      std::is_base_of_v<graph::graph_csr_t<vertex_t, edge_t, weight_t>,
+                        csr_view_t>;
+
+  if constexpr (frontier_t::is_dense || !has_column_indices) {
+    return;
+  } else {
+    std::size_t size = input->get_number_of_elements();
+    std::size_t nnz = G.get_number_of_edges();
+    if (size == 0 || nnz == 0)
+      return;
+
+    auto offsets = G.csr_view_t::get_row_offsets();
+    auto indices = G.csr_view_t::get_column_indices();
+    auto values = G.csr_view_t::get_nonzero_values();
+
+    std::size_t edges_per_page =
+        std::max(page_size / sizeof(vertex_t), std::size_t(1));
+    std::size_t number_of_pages = (nnz + edges_per_page - 1) / edges_per_page;
+
+    auto& state = state_t::get(context.ordinal(), context.stream());
+
+    // The previous touches must be done with the page list.
+    error::throw_if_exception(
+        cudaStreamWaitEvent(context.stream(), state.done, 0));
+    state.prepare(number_of_pages, context.stream());
+
+    auto marks = state.marks;
+    auto pages = state.pages;
+    auto counter = state.pages + state.capacity;
+    auto epoch = state.epoch;
+    auto data = input->data();
+    thrust::for_each(context.execution_policy(),
+                     thrust::make_counting_iterator<std::size_t>(0),
+                     thrust::make_counting_iterator<std::size_t>(size),
+                     [=] __device__(std::size_t const& i) {
+                       vertex_t v = data[i];
+                       if (!gunrock::util::limits::is_valid(v))
+                         return;
+                       std::size_t begin = offsets[v];
+                       std::size_t end = offsets[v + 1];
+                       if (begin == end)
+                         return;
+                       for (std::size_t p = begin / edges_per_page;
+                            p <= (end - 1) / edges_per_page; ++p)
+                         if (math::atomic::max(marks + p, epoch) < epoch)
+                           pages[math::atomic::add(
+                               counter, std::size_t(1))] = p;
+                     });
+
+    // Touch the listed pages on the side stream, after the marks.
+    error::throw_if_exception(
+        cudaEventRecord(context.event(), context.stream()));
+    error::throw_if_exception(
+        cudaStreamWaitEvent(state.stream, context.event(), 0));
+    thrust::for_each(thrust::cuda::par.on(state.stream),
+                     thrust::make_counting_iterator<std::size_t>(0),
+                     thrust::make_counting_iterator<std::size_t>(
+                         number_of_pages),
+                     [=] __device__(std::size_t const& i) {
+                       if (i >= *counter)
+                         return;
+                       std::size_t first = pages[i] * edges_per_page;
+                       (void)*(volatile vertex_t const*)(indices + first);
+                       if (values)
+                         (void)*(volatile weight_t const*)(values + first);
+                     });
+    error::throw_if_exception(cudaEventRecord(state.done, state.stream));
+  }
+}
+
+}  // namespace prefetch
+}  // namespace advance
+}  // namespace operators
+}  // namespace gunrock
@@ -0,0 +1,245 @@
+/**
+ * @file push_pull.hxx
+ * @author Muhammad Osama (mosama@ucdavis.edu)
+ * @brief Direction-optimized (push-pull) advance, see Beamer et al.,
+ * "Direction-Optimizing Breadth-First Search" (SC'12).
+ * @version 0.1
+ * @date 2021-06-01
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#pragma once
+
+#include <gunrock/util/math.hxx>
+#include <gunrock/util/type_limits.hxx>
+#include <gunrock/cuda/context.hxx>
+
+#include <gunrock/framework/operators/configs.hxx>
+
+#include <thrust/for_each.h>
+#include <thrust/transform.h>
+#include <thrust/transform_reduce.h>
+#include <thrust/iterator/counting_iterator.h>
+#include <thrust/iterator/discard_iterator.h>
+
+namespace gunrock {
+namespace operators {
+namespace advance {
+namespace push_pull {
+
+/**
+ * @brief Bookkeeping for the direction-optimized advance that has to persist
+ * across iterations: the set of vertices already visited (ever been in an
+ * input frontier), the number of edges still reachable from unvisited vertices
+ * and the direction chosen in the previous iteration.
+ *
+ * @par Overview
+ * The direction is switched using the heuristic of Beamer et al.:
+ *  - push -> pull, if `frontier_edges > unvisited_edges / alpha`,
+ *  - pull -> push, if `frontier_vertices < number_of_vertices / beta`.
+ *
+ * @tparam vertex_t vertex type of the graph.
+ * @tparam edge_t edge type of the graph.
+ */
+template <typename vertex_t, typename edge_t>
+struct state_t {
+  /*!
+   * Switch from push to pull when the edges to check from the frontier exceed
+   * the unvisited edges divided by alpha.
+   */
+  float alpha{15};
+
+  /*!
+   * Switch from pull back to push when the frontier shrinks below the number
+   * of vertices divided by beta.
+   */
+  float beta{18};
+
+  /*!
+   * Direction used by the last call to the advance.
+   */
+  advance_direction_t direction{advance_direction_t::forward};
+
+  /*!
+   * Edges not yet explored, i.e. out-edges of the unvisited vertices.
+   */
+  edge_t unvisited_edges{0};
+
+  /*!
+   * Device-side maps (one int per vertex). `visited` is 1 if the vertex has
+   * been in an input frontier, `active` is 1 if the vertex is in the current
+   * input frontier (only built for the pull step).
+   */
+  thrust::device_vector<int> visited;
+  thrust::device_vector<int> active;
+
+  bool initialized{false};
+
+  state_t() = default;
+
+  /**
+   * @brief Forget all visited vertices and start with a push again. Call this
+   * in between runs, if the same state is reused for a different traversal.
+   */
+  void reset() {
+    initialized = false;
+    direction = advance_direction_t::forward;
+  }
+};
+
+/**
+ * @brief Mark the vertices of the input frontier as visited and select the
+ * direction for the upcoming advance.
+ *
+ * @tparam graph_t `gunrock::graph_t` struct.
+ * @tparam frontier_t `gunrock::frontier_t`.
+ * @tparam state_type `push_pull::state_t`.
+ * @param G input graph.
+ * @param input input (vertex) frontier.
+ * @param state push-pull bookkeeping state, updated in-place.
+ * @param context `cuda::standard_context_t`.
+ * @return advance_direction_t `forward` to push or `backward` to pull.
+ */
+template <typename graph_t, typename frontier_t, typename state_type>
+advance_direction_t select_direction(graph_t& G,
+                                     frontier_t* input,
+                                     state_type& state,
+                                     cuda::standard_context_t& context) {
+  using vertex_t = typename graph_t::vertex_type;
+  using edge_t = typename graph_t::edge_type;
+
+  auto policy = context.execution_policy();
+  auto n_vertices = G.get_number_of_vertices();
+
+  if (!state.initialized) {
+    state.visited.resize(n_vertices);
+    state.active.resize(n_vertices);
+    thrust::fill(policy, state.visited.begin(), state.visited.end(), 0);
+    state.unvisited_edges = G.get_number_of_edges();
+    state.direction = advance_direction_t::forward;
+    state.initialized = true;
+  }
+
+  auto input_data = input->data();
+  auto visited = state.visited.data().get();
+
+  // Claim the frontier vertices as visited, and count the out-edges of the
+  // newly visited ones (duplicates within the frontier are counted only once).
+  auto claim = [=] __device__(std::size_t const& i) -> edge_t {
+    vertex_t v = input_data[i];
+    if (!gunrock::util::limits::is_valid(v))
+      return 0;
+    if (math::atomic::cas(visited + v, 0, 1) != 0)
+      return 0;
+    return G.get_number_of_neighbors(v);
+  };
+
+  edge_t frontier_edges = thrust::transform_reduce(
+      policy, thrust::make_counting_iterator<std::size_t>(0),
+      thrust::make_counting_iterator<std::size_t>(
+          input->get_number_of_elements()),
+      claim, (edge_t)0, thrust::plus<edge_t>());
+
+  state.unvisited_edges -= frontier_edges;
+
+  std::size_t frontier_vertices = input->get_number_of_elements();
+  if (state.direction == advance_direction_t::forward) {
+    if ((float)frontier_edges > ((float)state.unvisited_edges / state.alpha))
+      state.direction = advance_direction_t::backward;
+  } else {
+    if ((float)frontier_vertices < ((float)n_vertices / state.beta))
+      state.direction = advance_direction_t::forward;
+  }
+
+  return state.direction;
+}
+
+/**
+ * @brief Bottom-up (pull) step of the direction-optimized advance. Every
+ * unvisited vertex scans its in-neighbors (using the CSC view) and stops as
+ * soon as one of them is in the input frontier and the user-defined operator
+ * accepts the edge.
+ *
+ * @par Overview
+ * The operator is called exactly like in the push step, `op(source, neighbor,
+ * edge, weight)`, where `source` is the in-frontier vertex, `neighbor` is the
+ * unvisited vertex and `edge`/`weight` are looked up in the CSC view. The
+ * output frontier is vertex-indexed; vertices that were discovered hold their
+ * own id, all other slots are invalid.
+ */
+template <advance_io_type_t input_type,
+          advance_io_type_t output_type,
+          typename graph_t,
+          typename operator_t,
+          typename frontier_t,
+          typename state_type>
+void execute(graph_t& G,
+             operator_t op,
+             frontier_t* input,
+             frontier_t* output,
+             state_type& state,
+             cuda::standard_context_t& context) {
+  static_assert(input_type == advance_io_type_t::vertices,
+                "Pull-based advance requires a vertex input frontier.");
+
+  using type_t = typename frontier_t::type_t;
+  using edge_t = typename graph_t::edge_type;
+  using view_t = typename graph_t::graph_csc_view_t;
+
+  auto policy = context.execution_policy();
+  auto n_vertices = G.get_number_of_vertices();
+
+  // Build the frontier membership map.
+  auto active = state.active.data().get();
+  auto visited = state.visited.data().get();
+  auto input_data = input->data();
+  thrust::fill(policy, state.active.begin(), state.active.end(), 0);
+  thrust::for_each(policy, thrust::make_counting_iterator<std::size_t>(0),
+                   thrust::make_counting_iterator<std::size_t>(
+                       input->get_number_of_elements()),
+                   [=] __device__(std::size_t const& i) {
+                     type_t v = input_data[i];
+                     if (gunrock::util::limits::is_valid(v))
+                       active[v] = 1;
+                   });
+
+  auto pull = [=] __device__(type_t const& v) -> type_t {
+    if (visited[v])
+      return gunrock::numeric_limits<type_t>::invalid();
+
+    edge_t start_edge = G.template get_starting_edge<view_t>(v);
+    edge_t num_neighbors = G.template get_number_of_neighbors<view_t>(v);
+
+    for (edge_t e = start_edge; e < start_edge + num_neighbors; ++e) {
+      type_t u = G.template get_source_vertex<view_t>(e);
+      if (!active[u])
+        continue;
+
+      auto w = G.template get_edge_weight<view_t>(e);
+      if (op(u, v, e, w))
+        return v;  // found a parent, stop looking (early exit).
+    }
+    return gunrock::numeric_limits<type_t>::invalid();
+  };
+
+  if constexpr (output_type != advance_io_type_t::none) {
+    if (output->get_capacity() < n_vertices)
+      output->reserve(n_vertices);
+    output->set_number_of_elements(n_vertices);
+
+    thrust::transform(policy, thrust::make_counting_iterator<type_t>(0),
+                      thrust::make_counting_iterator<type_t>(n_vertices),
+                      output->begin(), pull);
+  } else {
+    thrust::transform(policy, thrust::make_counting_iterator<type_t>(0),
+                      thrust::make_counting_iterator<type_t>(n_vertices),
+                      thrust::make_discard_iterator(), pull);
+  }
+}
+
+}  // namespace push_pull
+}  // namespace advance
+}  // namespace operators
+}  // namespace gunrock
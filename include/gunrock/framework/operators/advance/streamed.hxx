@@ -0,0 +1,386 @@
+/**
+ * @file streamed.hxx
+ * @author Muhammad Osama (mosama@ucdavis.edu)
+ * @brief Out-of-core advance over a host-resident CSR, whose edges are
+ * streamed to the device in partitions, overlapping copies and compute.
+ * @version 0.1
+ * @date 2021-06-19
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#pragma once
+
+#include <gunrock/error.hxx>
+#include <gunrock/memory.hxx>
+#include <gunrock/cuda/context.hxx>
+#include <gunrock/container/vector.hxx>
+#include <gunrock/formats/formats.hxx>
+#include <gunrock/util/type_limits.hxx>
+#include <gunrock/framework/operators/launch.hxx>
+
+#include <thrust/fill.h>
+#include <thrust/for_each.h>
+#include <thrust/functional.h>
+#include <thrust/gather.h>
+#include <thrust/scan.h>
+#include <thrust/transform_reduce.h>
+#include <thrust/host_vector.h>
+#include <thrust/iterator/counting_iterator.h>
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace gunrock {
+namespace operators {
+namespace advance {
+namespace streamed {
+
+using size_type = unsigned long long;
+
+/// Edges per partition (a partition of 32-bit indices and weights is 64MB).
+constexpr std::size_t default_partition_size = std::size_t(8) << 20;
+
+namespace detail {
+
+/**
+ * @brief Advance the edges `[e_begin, e_begin + size)` of the partition
+ * staged in `columns` and `values` (one thread per edge), whose sources are
+ * within `[v_begin, v_end)`. Edges of inactive sources are skipped.
+ */
+template <typename vertex_t,
+          typename edge_t,
+          typename weight_t,
+          typename operator_t>
+__global__ void expand(operator_t op,
+                       edge_t const* offsets,
+                       char const* active,
+                       vertex_t v_begin,
+                       vertex_t v_end,
+                       edge_t e_begin,
+                       edge_t size,
+                       vertex_t const* columns,
+                       weight_t const* values,
+                       vertex_t* output,
+                       size_type* counter) {
+  for (edge_t i = blockIdx.x * blockDim.x + threadIdx.x; i < size;
+       i += gridDim.x * blockDim.x) {
+    edge_t e = e_begin + i;
+
+    // Source: last vertex whose first edge is at or before `e`.
+    vertex_t lo = v_begin, hi = v_end;
+    while (hi - lo > 1) {
+      vertex_t mid = lo + (hi - lo) / 2;
+      if (offsets[mid] <= e)
+        lo = mid;
+      else
+        hi = mid;
+    }
+
+    if (!active[lo])
+      continue;
+
+    vertex_t neighbor = columns[i];
+    weight_t weight = values ? values[i] : (weight_t)1;
+    if (op(lo, neighbor, e, weight) && output)
+      output[atomicAdd(counter, (size_type)1)] = neighbor;
+  }
+}
+
+}  // namespace detail
+
+/**
+ * @brief Edges of a host-resident CSR (larger than the device memory),
+ * streamed to the device one partition (of consecutive edges) at a time. Only
+ * the row offsets, per-vertex flags and two partitions live on the device.
+ *
+ * @par Overview
+ * A partition is copied to a pinned staging buffer by the host, then to the
+ * device on a copy stream, and advanced on the context's stream. The two
+ * staging (and device) buffers are used in turns, such that the staging and
+ * copy of the next partition overlap the advance of the current one.
+ * Partitions without an active source are not streamed.
+ *
+ * @par Example
+ * \code
+ * format::csr_t<memory_space_t::host, vertex_t, edge_t, weight_t> csr;
+ * csr.from_coo(mm.load(filename));
+ * operators::advance::streamed::stream_t<vertex_t, edge_t, weight_t> S(
+ *     csr, *context);
+ * // ... within an enactor's loop:
+ * operators::advance::streamed::execute(S, op, E->get_input_frontier(),
+ *                                       E->get_output_frontier(), *context);
+ * \endcode
+ *
+ * @tparam vertex_t vertex type.
+ * @tparam edge_t edge type.
+ * @tparam weight_t weight type.
+ */
+template <typename vertex_t, typename edge_t, typename weight_t>
+class stream_t {
+ public:
+  using vertex_type = vertex_t;
+  using edge_type = edge_t;
+  using weight_type = weight_t;
+
+  /**
+   * @brief Partition the edges of `csr`, which must outlive the stream.
+   *
+   * @param csr host CSR (values are optional, without them every edge weighs
+   * 1).
+   * @param context `cuda::standard_context_t`.
+   * @param partition_size edges per partition.
+   */
+  stream_t(format::csr_t<memory_space_t::host, vertex_t, edge_t, weight_t>&
+               csr,
+           cuda::standard_context_t& context,
+           std::size_t partition_size = default_partition_size)
+      : number_of_vertices(csr.number_of_rows),
+        number_of_edges(csr.number_of_nonzeros),
+        partition_size(std::max(partition_size, std::size_t(1))),
+        h_offsets(csr.row_offsets.data()),
+        h_columns(csr.column_indices.data()),
+        h_values(csr.nonzero_values.size() ? csr.nonzero_values.data()
+                                           : nullptr),
+        offsets(csr.row_offsets),
+        active(csr.number_of_rows, 0),
+        active_scan(csr.number_of_rows + 1),
+        counter(1) {
+    // Partition boundaries, and the sources they span.
+    std::size_t edges = number_of_edges;
+    std::vector<vertex_t> bounds;
+    for (std::size_t e = 0; e < edges; e += this->partition_size) {
+      std::size_t last = std::min(e + this->partition_size, edges) - 1;
+      vertex_t first_source =
+          std::upper_bound(h_offsets, h_offsets + number_of_vertices + 1,
+                           (edge_t)e) -
+          h_offsets - 1;
+      vertex_t last_source =
+          std::upper_bound(h_offsets, h_offsets + number_of_vertices + 1,
+                           (edge_t)last) -
+          h_offsets - 1;
+      partitions.push_back({(edge_t)e, (edge_t)(last + 1 - e), first_source,
+                            (vertex_t)(last_source + 1)});
+      bounds.push_back(first_source);
+      bounds.push_back(last_source + 1);
+    }
+    partition_bounds = bounds;
+    active_counts.resize(bounds.size());
+
+    std::size_t staged = std::min(this->partition_size, edges);
+    for (int b = 0; b < 2; ++b) {
+      staging_columns[b] = memory::allocate<vertex_t>(
+          staged * sizeof(vertex_t), memory_space_t::host);
+      staging_values[b] =
+          h_values ? memory::allocate<weight_t>(staged * sizeof(weight_t),
+                                                memory_space_t::host)
+                   : nullptr;
+      columns[b].resize(staged);
+      if (h_values)
+        values[b].resize(staged);
+      error::throw_if_exception(
+          cudaEventCreateWithFlags(&copied[b], cudaEventDisableTiming));
+      error::throw_if_exception(
+          cudaEventCreateWithFlags(&consumed[b], cudaEventDisableTiming));
+    }
+    error::throw_if_exception(
+        cudaStreamCreateWithFlags(&copy_stream, cudaStreamNonBlocking));
+    context.synchronize();
+  }
+
+  stream_t(stream_t const&) = delete;
+  stream_t& operator=(stream_t const&) = delete;
+
+  ~stream_t() {
+    for (int b = 0; b < 2; ++b) {
+      cudaEventSynchronize(consumed[b]);
+      memory::free(staging_columns[b], memory_space_t::host);
+      memory::free(staging_values[b], memory_space_t::host);
+      cudaEventDestroy(copied[b]);
+      cudaEventDestroy(consumed[b]);
+    }
+    cudaStreamDestroy(copy_stream);
+  }
+
+  vertex_t get_number_of_vertices() const { return number_of_vertices; }
+  edge_t get_number_of_edges() const { return number_of_edges; }
+  std::size_t get_number_of_partitions() const { return partitions.size(); }
+
+  /**
+   * @brief Advance the (sparse) input frontier over the streamed edges.
+   *
+   * @param op `op(source, neighbor, edge, weight)`, a neighbor is appended to
+   * the output if it returns `true`.
+   * @param input input frontier.
+   * @param output output frontier (`nullptr`: no output), the neighbors are
+   * in no particular order, with no invalid items.
+   * @param context `cuda::standard_context_t`.
+   */
+  template <typename operator_t, typename frontier_t>
+  void advance(operator_t op,
+               frontier_t* input,
+               frontier_t* output,
+               cuda::standard_context_t& context) {
+    auto policy = context.execution_policy();
+    std::size_t size = input->get_number_of_elements();
+
+    if (output)
+      output->set_number_of_elements(0);
+    if (size == 0 || partitions.empty())
+      return;
+
+    // Flag the active sources.
+    auto flags = active.data().get();
+    auto data = input->data();
+    auto d_offsets = offsets.data().get();
+    vertex_t n = number_of_vertices;
+    thrust::fill(policy, active.begin(), active.end(), 0);
+    thrust::for_each(policy, thrust::make_counting_iterator<std::size_t>(0),
+                     thrust::make_counting_iterator<std::size_t>(size),
+                     [=] __device__(std::size_t const& i) {
+                       vertex_t v = data[i];
+                       if (gunrock::util::limits::is_valid(v) && v < n)
+                         flags[v] = 1;
+                     });
+
+    // Active sources per partition, only those partitions are streamed.
+    thrust::transform_exclusive_scan(
+        policy, thrust::make_counting_iterator<vertex_t>(0),
+        thrust::make_counting_iterator<vertex_t>(n + 1), active_scan.begin(),
+        [=] __device__(vertex_t const& v) -> vertex_t {
+          return (v == n) ? 0 : flags[v];
+        },
+        (vertex_t)0, thrust::plus<vertex_t>());
+    thrust::gather(policy, partition_bounds.begin(), partition_bounds.end(),
+                   active_scan.begin(), active_counts.begin());
+
+    // The output is at most the neighbors of the input.
+    std::size_t bound = 0;
+    if (output) {
+      bound = thrust::transform_reduce(
+          policy, thrust::make_counting_iterator<vertex_t>(0),
+          thrust::make_counting_iterator<vertex_t>(n),
+          [=] __device__(vertex_t const& v) -> std::size_t {
+            return flags[v] ? d_offsets[v + 1] - d_offsets[v] : 0;
+          },
+          std::size_t(0), thrust::plus<std::size_t>());
+      output->reserve(bound);
+    }
+    vertex_t* output_data = (output && bound) ? output->data() : nullptr;
+
+    thrust::fill(policy, counter.begin(), counter.end(), 0);
+    thrust::host_vector<vertex_t> counts(active_counts);
+
+    using launch_box_t =
+        launch::launch_box_for_t<launch::kernel_t::advance_streamed>;
+    constexpr int block_size = launch_box_t::block_size;
+    int turn = 0;
+    for (std::size_t k = 0; k < partitions.size(); ++k) {
+      if (counts[2 * k + 1] == counts[2 * k])
+        continue;
+
+      auto const& partition = partitions[k];
+      int b = turn++ % 2;
+
+      // The advance that last read this buffer is done (and so is its copy).
+      error::throw_if_exception(cudaEventSynchronize(consumed[b]));
+
+      std::memcpy(staging_columns[b], h_columns + partition.first_edge,
+                  partition.size * sizeof(vertex_t));
+      error::throw_if_exception(cudaMemcpyAsync(
+          columns[b].data().get(), staging_columns[b],
+          partition.size * sizeof(vertex_t), cudaMemcpyHostToDevice,
+          copy_stream));
+      if (h_values) {
+        std::memcpy(staging_values[b], h_values + partition.first_edge,
+                    partition.size * sizeof(weight_t));
+        error::throw_if_exception(cudaMemcpyAsync(
+            values[b].data().get(), staging_values[b],
+            partition.size * sizeof(weight_t), cudaMemcpyHostToDevice,
+            copy_stream));
+      }
+      error::throw_if_exception(cudaEventRecord(copied[b], copy_stream));
+      error::throw_if_exception(
+          cudaStreamWaitEvent(context.stream(), copied[b], 0));
+
+      std::size_t blocks = std::min<std::size_t>(
+          (partition.size + block_size - 1) / block_size,
+          context.props().multiProcessorCount * 32);
+      detail::expand<<<blocks, block_size, 0, context.stream()>>>(
+          op, d_offsets, flags, partition.first_source, partition.end_source,
+          partition.first_edge, partition.size, columns[b].data().get(),
+          h_values ? values[b].data().get() : (weight_t*)nullptr,
+          output_data, counter.data().get());
+      error::throw_if_exception(cudaPeekAtLastError());
+      error::throw_if_exception(cudaEventRecord(consumed[b], context.stream()));
+    }
+
+    if (output) {
+      context.synchronize();
+      size_type produced = counter[0];
+      output->set_number_of_elements(produced);
+    }
+  }
+
+ private:
+  struct partition_t {
+    edge_t first_edge;
+    edge_t size;
+    vertex_t first_source;
+    vertex_t end_source;  // one past the last source.
+  };
+
+  vertex_t number_of_vertices;
+  edge_t number_of_edges;
+  std::size_t partition_size;
+
+  edge_t const* h_offsets;
+  vertex_t const* h_columns;
+  weight_t const* h_values;
+
+  std::vector<partition_t> partitions;
+
+  vector_t<edge_t, memory_space_t::device> offsets;
+  vector_t<char, memory_space_t::device> active;
+  vector_t<vertex_t, memory_space_t::device> active_scan;
+  vector_t<vertex_t, memory_space_t::device> partition_bounds;
+  vector_t<vertex_t, memory_space_t::device> active_counts;
+  vector_t<size_type, memory_space_t::device> counter;
+
+  /*!
+   * Pinned staging buffers and their device copies, two of each.
+   */
+  vertex_t* staging_columns[2];
+  weight_t* staging_values[2];
+  vector_t<vertex_t, memory_space_t::device> columns[2];
+  vector_t<weight_t, memory_space_t::device> values[2];
+
+  cudaEvent_t copied[2];
+  cudaEvent_t consumed[2];
+  cudaStream_t copy_stream;
+};  // class stream_t
+
+/**
+ * @brief Advance over a streamed (out-of-core) graph, see `stream_t`.
+ *
+ * @param S streamed graph.
+ * @param op `op(source, neighbor, edge, weight)`.
+ * @param input input frontier.
+ * @param output output frontier.
+ * @param context `cuda::standard_context_t`.
+ */
+template <typename stream_type, typename operator_t, typename frontier_t>
+void execute(stream_type& S,
+             operator_t op,
+             frontier_t* input,
+             frontier_t* output,
+             cuda::standard_context_t& context) {
+  S.advance(op, input, output, context);
+}
+
+}  // namespace streamed
+}  // namespace advance
+}  // namespace operators
+}  // namespace gunrock
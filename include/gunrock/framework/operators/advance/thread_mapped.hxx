@@ -73,12 +73,12 @@ void execute(graph_t& G,
     auto starting_edge = G.get_starting_edge(v);
     auto total_edges = G.get_number_of_neighbors(v);
 
-    type_t offset = type_t(0);
+    std::size_t offset = 0;
     /// @todo if constexpr ()
     if (output_type != advance_io_type_t::none)
       offset = segments_data[idx];
 
-    for (auto i = 0; i < total_edges; ++i) {
+    for (decltype(total_edges) i = 0; i < total_edges; ++i) {
       auto e = i + starting_edge;            // edge id
       auto n = G.get_destination_vertex(e);  // neighbor id
       auto w = G.get_edge_weight(e);         // weight
@@ -0,0 +1,150 @@
+/**
+ * @file warp_mapped.hxx
+ * @author Muhammad Osama (mosama@ucdavis.edu)
+ * @brief
+ * @version 0.1
+ * @date 2021-06-05
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#pragma once
+
+#include <gunrock/error.hxx>
+#include <gunrock/util/math.hxx>
+#include <gunrock/cuda/context.hxx>
+#include <gunrock/cuda/global.hxx>
+#include <gunrock/cuda/device_properties.hxx>
+
+#include <gunrock/framework/operators/configs.hxx>
+#include <gunrock/framework/operators/launch.hxx>
+
+#include <algorithm>
+
+namespace gunrock {
+namespace operators {
+namespace advance {
+namespace warp_mapped {
+
+/**
+ * @brief Warp-mapped advance kernel, one warp per input vertex (the warps
+ * stride over the input frontier). The lanes of a warp process consecutive
+ * neighbors, so the reads of the neighbor list and the writes to the output
+ * frontier are coalesced, and a high-degree vertex is shared by 32 threads
+ * instead of being serialized on one (thread_mapped).
+ */
+template <int THREADS_PER_BLOCK,
+          advance_io_type_t input_type,
+          advance_io_type_t output_type,
+          typename graph_t,
+          typename type_t,
+          typename work_tiles_t,
+          typename operator_t>
+void __global__ warp_mapped_kernel(graph_t const G,
+                                   operator_t op,
+                                   type_t* input,
+                                   type_t* output,
+                                   std::size_t input_size,
+                                   work_tiles_t* offsets) {
+  constexpr int warp_size = cuda::properties::warp_max_threads();
+
+  // 64-bit, one warp per vertex exceeds `int` threads on large graphs.
+  std::size_t global_idx =
+      (std::size_t)blockIdx.x * blockDim.x + threadIdx.x;
+  int lane = threadIdx.x % warp_size;
+  std::size_t warp_id = global_idx / warp_size;
+  std::size_t num_warps = ((std::size_t)gridDim.x * blockDim.x) / warp_size;
+
+  for (std::size_t idx = warp_id; idx < input_size; idx += num_warps) {
+    type_t v = (input_type == advance_io_type_t::graph) ? type_t(idx)
+                                                        : input[idx];
+    if (!gunrock::util::limits::is_valid(v))
+      continue;
+
+    auto starting_edge = G.get_starting_edge(v);
+    auto total_edges = G.get_number_of_neighbors(v);
+
+    std::size_t offset = 0;  // edge-sized, not a vertex.
+    if constexpr (output_type != advance_io_type_t::none)
+      offset = offsets[idx];
+
+    for (auto i = lane; i < total_edges; i += warp_size) {
+      auto e = i + starting_edge;            // edge id
+      auto n = G.get_destination_vertex(e);  // neighbor id
+      auto w = G.get_edge_weight(e);         // weight
+      bool cond = op(v, n, e, w);
+
+      if constexpr (output_type != advance_io_type_t::none)
+        output[offset + i] =
+            (cond && n != v) ? n : gunrock::numeric_limits<type_t>::invalid();
+    }
+  }
+}
+
+template <advance_direction_t direction,
+          advance_io_type_t input_type,
+          advance_io_type_t output_type,
+          typename graph_t,
+          typename operator_t,
+          typename frontier_t,
+          typename work_tiles_t>
+void execute(graph_t& G,
+             operator_t op,
+             frontier_t* input,
+             frontier_t* output,
+             work_tiles_t& segments,
+             cuda::standard_context_t& context) {
+  constexpr bool graph_as_frontier = (input_type == advance_io_type_t::graph);
+
+  if constexpr (output_type != advance_io_type_t::none) {
+    auto size_of_output = compute_output_length(G, input, segments, context,
+                                                graph_as_frontier);
+
+    // If output frontier is empty, resize and return.
+    if (size_of_output <= 0) {
+      output->set_number_of_elements(0);
+      return;
+    }
+
+    /// Resize the output (inactive) buffer to the new size.
+    /// @todo Can be hidden within the frontier struct.
+    if (output->get_capacity() < size_of_output)
+      output->reserve(size_of_output);
+    output->set_number_of_elements(size_of_output);
+  }
+
+  std::size_t work_size = graph_as_frontier ? G.get_number_of_vertices()
+                                            : input->get_number_of_elements();
+  if (work_size == 0)
+    return;
+
+  using launch_box_t =
+      launch::launch_box_for_t<launch::kernel_t::advance_warp_mapped>;
+  constexpr int block_size = launch_box_t::block_size;
+  constexpr int warps_per_block =
+      block_size / cuda::properties::warp_max_threads();
+  using type_t = typename frontier_t::type_t;
+  using offset_t = typename work_tiles_t::value_type;
+  auto kernel = warp_mapped_kernel<block_size, input_type, output_type,
+                                   graph_t, type_t, offset_t, operator_t>;
+
+  // A few waves of resident blocks, the warps stride over the rest.
+  int blocks_per_sm = 0;
+  error::throw_if_exception(cudaOccupancyMaxActiveBlocksPerMultiprocessor(
+      &blocks_per_sm, kernel, block_size, 0));
+  std::size_t max_grid_size =
+      4 * (std::size_t)context.props().multiProcessorCount *
+      std::max(blocks_per_sm, 1);
+  std::size_t grid_size = std::min(
+      (work_size + warps_per_block - 1) / warps_per_block, max_grid_size);
+
+  // Launch warp-mapped advance kernel.
+  kernel<<<grid_size, block_size, 0, context.stream()>>>(
+      G, op, input->data(), output->data(), work_size, segments.data().get());
+}
+
+}  // namespace warp_mapped
+}  // namespace advance
+}  // namespace operators
+}  // namespace gunrock
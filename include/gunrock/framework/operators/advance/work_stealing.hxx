@@ -0,0 +1,174 @@
+/**
+ * @file work_stealing.hxx
+ * @author Muhammad Osama (mosama@ucdavis.edu)
+ * @brief
+ * @version 0.1
+ * @date 2021-06-05
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#pragma once
+
+#include <gunrock/error.hxx>
+#include <gunrock/util/math.hxx>
+#include <gunrock/cuda/context.hxx>
+#include <gunrock/cuda/global.hxx>
+#include <gunrock/cuda/device_properties.hxx>
+
+#include <gunrock/framework/operators/configs.hxx>
+#include <gunrock/framework/operators/launch.hxx>
+#include <gunrock/algorithms/search/binary_search.hxx>
+
+#include <thrust/fill.h>
+
+namespace gunrock {
+namespace operators {
+namespace advance {
+namespace work_stealing {
+
+/**
+ * @brief Persistent work-stealing advance kernel. The work (all the edges of
+ * the input frontier, in the order given by the scanned segment offsets) is
+ * split into chunks of CHUNK_SIZE edges. Every warp of the persistent grid
+ * repeatedly steals the next chunk through an atomic counter, and its lanes
+ * map the chunk's edges back to their source vertices using a binary search
+ * over the segment offsets. The edges of a hub with millions of neighbors are
+ * thus spread over all the warps of the GPU.
+ */
+template <int THREADS_PER_BLOCK,
+          int CHUNK_SIZE,
+          advance_io_type_t input_type,
+          advance_io_type_t output_type,
+          typename graph_t,
+          typename type_t,
+          typename offset_t,
+          typename operator_t>
+void __global__ work_stealing_kernel(graph_t const G,
+                                     operator_t op,
+                                     type_t* input,
+                                     type_t* output,
+                                     std::size_t input_size,
+                                     offset_t* offsets,
+                                     offset_t total_work,
+                                     offset_t* counter) {
+  constexpr int warp_size = cuda::properties::warp_max_threads();
+  auto lane = cuda::thread::local::id::x() % warp_size;
+
+  while (true) {
+    // Steal the next chunk (lane 0 steals on behalf of the warp).
+    offset_t chunk = 0;
+    if (lane == 0)
+      chunk = math::atomic::add(counter, (offset_t)CHUNK_SIZE);
+    chunk = __shfl_sync(0xffffffff, chunk, 0);
+
+    // No more work left, retire the warp.
+    if (chunk >= total_work)
+      return;
+
+    offset_t chunk_end = (chunk + (offset_t)CHUNK_SIZE < total_work)
+                             ? chunk + (offset_t)CHUNK_SIZE
+                             : total_work;
+    for (offset_t i = chunk + lane; i < chunk_end; i += warp_size) {
+      // Find the input vertex this edge belongs to.
+      auto id = search::binary::rightmost(offsets, i, (offset_t)input_size);
+      type_t v = (input_type == advance_io_type_t::graph) ? type_t(id)
+                                                          : input[id];
+
+      auto e = G.get_starting_edge(v) + i - offsets[id];  // edge id
+      auto n = G.get_destination_vertex(e);               // neighbor id
+      auto w = G.get_edge_weight(e);                      // weight
+      bool cond = op(v, n, e, w);
+
+      if constexpr (output_type != advance_io_type_t::none)
+        output[i] =
+            (cond && n != v) ? n : gunrock::numeric_limits<type_t>::invalid();
+    }
+  }
+}
+
+template <advance_direction_t direction,
+          advance_io_type_t input_type,
+          advance_io_type_t output_type,
+          typename graph_t,
+          typename operator_t,
+          typename frontier_t,
+          typename work_tiles_t>
+void execute(graph_t& G,
+             operator_t op,
+             frontier_t* input,
+             frontier_t* output,
+             work_tiles_t& segments,
+             cuda::standard_context_t& context) {
+  using offset_t = typename work_tiles_t::value_type;
+  using type_t = typename frontier_t::type_t;
+  constexpr bool graph_as_frontier = (input_type == advance_io_type_t::graph);
+
+  std::size_t work_size = graph_as_frontier ? G.get_number_of_vertices()
+                                            : input->get_number_of_elements();
+
+  // The segment offsets are required to map the stolen edges back to their
+  // source vertices, even if there is no output.
+  auto total_work =
+      compute_output_length(G, input, segments, context, graph_as_frontier);
+
+  if constexpr (output_type != advance_io_type_t::none) {
+    // If output frontier is empty, resize and return.
+    if (total_work <= 0) {
+      output->set_number_of_elements(0);
+      return;
+    }
+
+    /// Resize the output (inactive) buffer to the new size.
+    /// @todo Can be hidden within the frontier struct.
+    if (output->get_capacity() < total_work)
+      output->reserve(total_work);
+    output->set_number_of_elements(total_work);
+  }
+
+  if (total_work <= 0)
+    return;
+
+  // The element after the total (segments[work_size + 1]) is the steal
+  // counter.
+  if (segments.size() < work_size + 2)
+    segments.resize(work_size + 2);
+  thrust::fill(context.execution_policy(), segments.begin() + work_size + 1,
+               segments.begin() + work_size + 2, (offset_t)0);
+
+  // Persistent grid, one full wave of blocks over all SMs (as many as the
+  // occupancy of the kernel allows).
+  using launch_box_t =
+      launch::launch_box_for_t<launch::kernel_t::advance_work_stealing>;
+  constexpr int block_size = launch_box_t::block_size;
+  constexpr int chunk_size =
+      launch_box_t::items_per_thread * cuda::properties::warp_max_threads();
+  auto kernel = work_stealing_kernel<block_size, chunk_size, input_type,
+                                     output_type, graph_t, type_t, offset_t,
+                                     operator_t>;
+  int blocks_per_sm = 0;
+  error::throw_if_exception(cudaOccupancyMaxActiveBlocksPerMultiprocessor(
+      &blocks_per_sm, kernel, block_size, 0));
+  int grid_size =
+      context.props().multiProcessorCount * std::max(blocks_per_sm, 1);
+
+  // Do not launch more warps than there are chunks.
+  constexpr int warps_per_block =
+      block_size / cuda::properties::warp_max_threads();
+  int needed_blocks =
+      ((total_work + chunk_size - 1) / chunk_size + warps_per_block - 1) /
+      warps_per_block;
+  grid_size = std::min(grid_size, needed_blocks);
+
+  // Launch work-stealing advance kernel.
+  auto segments_data = segments.data().get();
+  kernel<<<grid_size, block_size, 0, context.stream()>>>(
+          G, op, input->data(), output->data(), work_size, segments_data,
+          (offset_t)total_work, segments_data + work_size + 1);
+}
+
+}  // namespace work_stealing
+}  // namespace advance
+}  // namespace operators
+}  // namespace gunrock
@@ -0,0 +1,493 @@
+/**
+ * @file advance_filter.hxx
+ * @author Muhammad Osama (mosama@ucdavis.edu)
+ * @brief Fused advance and filter operator, only the compacted output
+ * frontier is ever written.
+ * @version 0.1
+ * @date 2021-06-04
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#pragma once
+
+#include <vector>
+#include <algorithm>
+
+#include <gunrock/util/math.hxx>
+#include <gunrock/util/type_limits.hxx>
+#include <gunrock/error.hxx>
+#include <gunrock/cuda/context.hxx>
+#include <gunrock/cuda/global.hxx>
+
+#include <gunrock/framework/profiler.hxx>
+#include <gunrock/framework/operators/configs.hxx>
+#include <gunrock/framework/operators/launch.hxx>
+#include <gunrock/algorithms/search/binary_search.hxx>
+
+#include <thrust/fill.h>
+#include <thrust/host_vector.h>
+#include <thrust/transform_reduce.h>
+#include <thrust/iterator/counting_iterator.h>
+
+#include <cub/block/block_scan.cuh>
+
+namespace gunrock {
+namespace operators {
+namespace advance_filter {
+namespace block_mapped {
+
+/**
+ * @brief Block-mapped advance (see `advance::block_mapped`) that applies the
+ * filter predicate to every neighbor it generates. Survivors are ranked within
+ * the block using a block-wide scan, and a single atomic per block (per tile
+ * of THREADS_PER_BLOCK edges) reserves their slots in the output frontier.
+ *
+ * Blocks loop over chunks of THREADS_PER_BLOCK input items up to the input
+ * size, which is read on the device from `input_size` (unless it is
+ * `nullptr`, then `known_input_size` is used), so the grid can be sized
+ * without knowing the input size on the host.
+ */
+template <int THREADS_PER_BLOCK,
+          advance_io_type_t input_type,
+          advance_io_type_t output_type,
+          typename graph_t,
+          typename type_t,
+          typename counter_t,
+          typename advance_operator_t,
+          typename filter_operator_t>
+void __global__ block_mapped_kernel(graph_t const G,
+                                    advance_operator_t advance_op,
+                                    filter_operator_t filter_op,
+                                    type_t* input,
+                                    type_t* output,
+                                    counter_t known_input_size,
+                                    counter_t const* input_size,
+                                    counter_t* output_counter,
+                                    counter_t* edges_visited) {
+  using vertex_t = typename graph_t::vertex_type;
+  using edge_t = typename graph_t::edge_type;
+
+  using degree_scan_t = cub::BlockScan<edge_t, THREADS_PER_BLOCK>;
+  using output_scan_t = cub::BlockScan<int, THREADS_PER_BLOCK>;
+
+  auto local_idx = cuda::thread::local::id::x();
+
+  thrust::counting_iterator<type_t> all_vertices(0);
+
+  __shared__ union TempStorage {
+    typename degree_scan_t::TempStorage degrees;
+    typename output_scan_t::TempStorage output;
+  } storage;
+
+  __shared__ counter_t block_offset;
+  __shared__ vertex_t vertices[THREADS_PER_BLOCK];
+  __shared__ edge_t degrees[THREADS_PER_BLOCK];
+  __shared__ edge_t sedges[THREADS_PER_BLOCK];
+
+  counter_t size = input_size ? *input_size : known_input_size;
+  for (counter_t base = (counter_t)blockIdx.x * THREADS_PER_BLOCK; base < size;
+       base += (counter_t)gridDim.x * THREADS_PER_BLOCK) {
+    counter_t idx = base + local_idx;
+    edge_t th_deg = 0;
+
+    if (idx < size) {
+      vertex_t v = (input_type == advance_io_type_t::graph) ? all_vertices[idx]
+                                                            : input[idx];
+      vertices[local_idx] = v;
+      if (gunrock::util::limits::is_valid(v)) {
+        sedges[local_idx] = G.get_starting_edge(v);
+        th_deg = G.get_number_of_neighbors(v);
+      }
+    } else {
+      vertices[local_idx] = gunrock::numeric_limits<vertex_t>::invalid();
+    }
+    __syncthreads();
+
+    // Exclusive sum of degrees.
+    edge_t aggregate_degree_per_block;
+    degree_scan_t(storage.degrees)
+        .ExclusiveSum(th_deg, th_deg, aggregate_degree_per_block);
+    degrees[local_idx] = th_deg;
+    if (edges_visited && local_idx == 0 && aggregate_degree_per_block > 0)
+      math::atomic::add(edges_visited, (counter_t)aggregate_degree_per_block);
+    __syncthreads();
+
+    // To search for which vertex id we are computing on.
+    int length = (size - base < THREADS_PER_BLOCK) ? (int)(size - base)
+                                                   : THREADS_PER_BLOCK;
+
+    // Every thread of the block iterates the same number of times, such that
+    // the block-wide scan (below) can be used to rank the survivors.
+    for (edge_t tile = 0; tile < aggregate_degree_per_block;
+         tile += cuda::block::size::x()) {
+      edge_t i = tile + local_idx;
+      type_t item = gunrock::numeric_limits<type_t>::invalid();
+      int keep = 0;
+
+      if (i < aggregate_degree_per_block) {
+        // Binary search to find which vertex id to work on.
+        int id = search::binary::rightmost(degrees, i, length);
+        vertex_t v = (id < length)
+                         ? vertices[id]
+                         : gunrock::numeric_limits<vertex_t>::invalid();
+
+        if (gunrock::util::limits::is_valid(v)) {
+          // If the vertex is valid, get its edge, neighbor and edge weight.
+          auto e = sedges[id] + i - degrees[id];
+          auto n = G.get_destination_vertex(e);
+          auto w = G.get_edge_weight(e);
+
+          // User-defined advance condition, followed by the filter predicate.
+          if (advance_op(v, n, e, w) && n != v) {
+            item = (output_type == advance_io_type_t::edges) ? e : n;
+            if constexpr (output_type != advance_io_type_t::none)
+              keep = filter_op(item) ? 1 : 0;
+          }
+        }
+      }
+
+      if constexpr (output_type != advance_io_type_t::none) {
+        // Rank the survivors within the block and reserve their output slots.
+        int rank, survivors_per_tile;
+        output_scan_t(storage.output)
+            .ExclusiveSum(keep, rank, survivors_per_tile);
+
+        if (local_idx == 0)
+          block_offset =
+              (survivors_per_tile > 0)
+                  ? math::atomic::add(output_counter,
+                                      (counter_t)survivors_per_tile)
+                  : 0;
+        __syncthreads();
+
+        if (keep)
+          output[block_offset + rank] = item;
+
+        // Shared block_offset and scan storage are reused in the next tile.
+        __syncthreads();
+      }
+    }
+
+    // Shared vertices, degrees and edges are reused by the next chunk.
+    __syncthreads();
+  }
+}
+
+template <advance_io_type_t input_type,
+          advance_io_type_t output_type,
+          typename graph_t,
+          typename advance_operator_t,
+          typename filter_operator_t,
+          typename frontier_t,
+          typename work_tiles_t>
+void execute(graph_t& G,
+             advance_operator_t advance_op,
+             filter_operator_t filter_op,
+             frontier_t* input,
+             frontier_t* output,
+             work_tiles_t& segments,
+             cuda::standard_context_t& context,
+             std::size_t* edges_visited = nullptr) {
+  using type_t = typename frontier_t::type_t;
+  using counter_t = typename frontier_t::underlying_frontier_t::counter_t;
+  static_assert(sizeof(std::size_t) == sizeof(counter_t),
+                "Edge counter must be 64-bit.");
+
+  using launch_box_t =
+      launch::launch_box_for_t<launch::kernel_t::advance_filter>;
+  constexpr int block_size = launch_box_t::block_size;
+  auto stream = context.stream();
+
+  // The number of survivors is bounded by the number of edges to visit, and
+  // the output frontier is only reserved, never written beyond the survivors.
+  // If it can hold all the edges of the graph, nothing has to be computed
+  // (nor synchronized) on the host. The (vertex-sized by default) output
+  // grows to that bound once, unless its capacity limit (memory budget) is
+  // below it; then the exact number of edges to visit is computed every time.
+  if constexpr (output_type != advance_io_type_t::none) {
+    std::size_t bound = G.get_number_of_edges();
+    std::size_t limit = output->get_capacity_limit();
+    if (output->get_capacity() < bound && (limit == 0 || limit >= bound))
+      output->reserve(bound);
+
+    if (output->get_capacity() < bound &&
+        input_type != advance_io_type_t::graph) {
+      // Exact number of edges to visit (synchronizes), read-only pass over
+      // the input frontier, unlike the scan of the unfused advance.
+      auto input_data = input->data();
+      bound = thrust::transform_reduce(
+          context.execution_policy(),
+          thrust::make_counting_iterator<std::size_t>(0),
+          thrust::make_counting_iterator<std::size_t>(
+              input->get_number_of_elements()),
+          [=] __device__(std::size_t const& i) -> std::size_t {
+            type_t v = input_data[i];
+            return gunrock::util::limits::is_valid(v)
+                       ? (std::size_t)G.get_number_of_neighbors(v)
+                       : 0;
+          },
+          (std::size_t)0, thrust::plus<std::size_t>());
+    }
+    if (output->get_capacity() < bound)
+      output->reserve(bound);
+  }
+
+  // Grid: exact if the input size is known on the host, otherwise
+  // over-provisioned (blocks loop over the device-resident size).
+  std::size_t known_input_size = 0;
+  counter_t const* input_size = nullptr;
+  if (input_type == advance_io_type_t::graph) {
+    known_input_size = G.get_number_of_vertices();
+  } else if (input->is_size_on_host()) {
+    known_input_size = input->get_number_of_elements();
+  } else {
+    input_size = input->get_device_number_of_elements(stream);
+    known_input_size = input->get_capacity();
+  }
+
+  int grid_size = (known_input_size + block_size - 1) / block_size;
+  if (input_size)
+    grid_size = std::min(grid_size, context.props().multiProcessorCount *
+                                        (2048 / block_size));
+
+  counter_t* output_counter = nullptr;
+  if constexpr (output_type != advance_io_type_t::none) {
+    output_counter = output->get_device_number_of_elements(stream);
+    cudaMemsetAsync(output_counter, 0, sizeof(counter_t), stream);
+    output->set_number_of_elements_on_device(stream);
+  }
+
+  if (grid_size == 0)
+    return;
+
+  // Launch fused blocked-mapped advance and filter kernel.
+  block_mapped_kernel<block_size, input_type, output_type>
+      <<<grid_size, block_size, 0, stream>>>(
+          G, advance_op, filter_op, input->data(), output->data(),
+          (counter_t)known_input_size, input_size, output_counter,
+          reinterpret_cast<counter_t*>(edges_visited));
+}
+
+}  // namespace block_mapped
+
+/**
+ * @brief Fused advance and filter operator. Generates the neighbors of the
+ * input frontier (just like `advance::execute`) and keeps only those for which
+ * the filter predicate also holds (just like `filter::execute`), without
+ * materializing the intermediate edge-sized frontier.
+ *
+ * @par Overview
+ * The unfused sequence, advance -> filter -> uniquify, makes three
+ * device-wide passes per iteration over an O(m) sized buffer with invalid
+ * slots. The fused operator evaluates `filter_op(neighbor)` right after
+ * `advance_op(source, neighbor, edge, weight)` returns `true` and writes the
+ * survivors directly to a compacted output frontier. The output is not
+ * uniquified, the filter predicate should drop the duplicates it cares about
+ * (e.g. through a visited map).
+ *
+ * The size of the output frontier is only written on the device (see
+ * `frontier_t::set_number_of_elements_on_device()`), and the grid is sized
+ * from the input's device-resident size when its host copy is stale, so
+ * back-to-back iterations never wait on the host. The output frontier is
+ * grown (once) to hold all the edges of the graph; under a capacity limit
+ * smaller than that (`enactor_properties_t::frontier_memory_budget`), the
+ * exact number of edges to visit is computed first instead, which
+ * synchronizes every call.
+ *
+ * @par Example
+ *  \code
+ *  operators::advance_filter::execute<operators::load_balance_t::block_mapped>(
+ *    G, E, advance_op, filter_op, context);
+ *  \endcode
+ *
+ * @tparam lb `gunrock::operators::load_balance_t` enum, only `block_mapped`
+ * is supported.
+ * @tparam input_type `advance_io_type_t`, vertices or the entire graph.
+ * @tparam output_type `advance_io_type_t`, vertices, edges or none.
+ * @param G input graph.
+ * @param advance_op advance lambda, `(source, neighbor, edge, weight) ->
+ * bool`.
+ * @param filter_op filter lambda, `(vertex) -> bool`, `true` keeps the item.
+ * @param input input frontier.
+ * @param output output frontier, contains only the survivors.
+ * @param segments scratch space (not used by `block_mapped`).
+ * @param context a `cuda::standard_context_t`.
+ * @param edges_visited (optional) device counter, the number of edges
+ * visited (advance operator calls) is added to it.
+ */
+template <load_balance_t lb,
+          advance_io_type_t input_type,
+          advance_io_type_t output_type,
+          typename graph_t,
+          typename advance_operator_t,
+          typename filter_operator_t,
+          typename frontier_t,
+          typename work_tiles_t>
+void execute(graph_t& G,
+             advance_operator_t advance_op,
+             filter_operator_t filter_op,
+             frontier_t* input,
+             frontier_t* output,
+             work_tiles_t& segments,
+             cuda::standard_context_t& context,
+             std::size_t* edges_visited = nullptr) {
+  profiler::operator_scope_t scope("advance_filter", input, context);
+  if (scope.is_active())
+    scope.set_edges((input_type == advance_io_type_t::graph)
+                        ? G.get_number_of_edges()
+                        : profiler::count_edges(G, input, context));
+
+  if (lb == load_balance_t::block_mapped) {
+    block_mapped::execute<input_type, output_type>(G, advance_op, filter_op,
+                                                   input, output, segments,
+                                                   context, edges_visited);
+  } else {
+    error::throw_if_exception(cudaErrorUnknown,
+                              "Advance-filter type not supported.");
+  }
+  scope.set_output(output);
+}
+
+/**
+ * @brief Fused advance and filter operator on a `cuda::multi_context_t`, with
+ * explicit frontiers (single-GPU only, use the enactor overload for multiple
+ * GPUs).
+ * @see execute() above for details.
+ */
+template <load_balance_t lb,
+          advance_io_type_t input_type,
+          advance_io_type_t output_type,
+          typename graph_t,
+          typename advance_operator_t,
+          typename filter_operator_t,
+          typename frontier_t,
+          typename work_tiles_t>
+void execute(graph_t& G,
+             advance_operator_t advance_op,
+             filter_operator_t filter_op,
+             frontier_t* input,
+             frontier_t* output,
+             work_tiles_t& segments,
+             cuda::multi_context_t& context,
+             std::size_t* edges_visited = nullptr) {
+  if (context.size() != 1)
+    error::throw_if_exception(cudaErrorUnknown,
+                              "`context.size() != 1` requires the enactor "
+                              "interface, see `multi_gpu::state_t`.");
+  execute<lb, input_type, output_type>(G, advance_op, filter_op, input, output,
+                                       segments, *(context.get_context(0)),
+                                       edges_visited);
+}
+
+/**
+ * @brief Multi-GPU fused advance and filter using the enactor's
+ * `multi_gpu::state_t`. Every GPU runs the fused operator over the portion of
+ * the input frontier it owns, the survivors are then exchanged (by owner) and
+ * gathered into the enactor's output frontier.
+ * @see execute() above for details.
+ */
+template <load_balance_t lb,
+          advance_io_type_t input_type,
+          advance_io_type_t output_type,
+          typename graph_t,
+          typename enactor_type,
+          typename advance_operator_t,
+          typename filter_operator_t>
+void multi_gpu_execute(graph_t& G,
+                       enactor_type* E,
+                       advance_operator_t advance_op,
+                       filter_operator_t filter_op,
+                       cuda::multi_context_t& context,
+                       std::size_t* edges_visited) {
+  auto& state = E->multi_gpu_state;
+  state.init(G, context);
+
+  int in = 0;
+  if constexpr (input_type != advance_io_type_t::graph)
+    in = state.acquire(E->get_input_frontier(), context);
+  int out = in ^ 1;
+
+  // Every GPU counts its visited edges locally.
+  std::vector<std::size_t> local_edges(context.size(), 0);
+  state.for_each_device(context, [&](int d, auto& slice, auto& local_context) {
+    vector_t<std::size_t, memory_space_t::device> counter(edges_visited ? 1
+                                                                        : 0);
+    if (edges_visited)
+      cudaMemsetAsync(counter.data().get(), 0, sizeof(std::size_t),
+                      local_context.stream());
+    execute<lb, input_type, output_type>(
+        slice.graph, advance_op, filter_op, &(slice.frontiers[in]),
+        &(slice.scratch), slice.segments, local_context,
+        edges_visited ? counter.data().get() : nullptr);
+    if (edges_visited) {
+      cudaMemcpyAsync(&local_edges[d], counter.data().get(),
+                      sizeof(std::size_t), cudaMemcpyDeviceToHost,
+                      local_context.stream());
+      local_context.synchronize();
+    }
+  });
+
+  if constexpr (output_type != advance_io_type_t::none) {
+    state.exchange(out, context);
+    state.gather(out, E->get_output_frontier(), context);
+  }
+
+  if (edges_visited) {
+    std::size_t total = 0;
+    cudaMemcpy(&total, edges_visited, sizeof(std::size_t),
+               cudaMemcpyDeviceToHost);
+    for (auto edges : local_edges)
+      total += edges;
+    cudaMemcpy(edges_visited, &total, sizeof(std::size_t),
+               cudaMemcpyHostToDevice);
+  }
+}
+
+/**
+ * @brief Fused advance and filter operator using the enactor's frontiers.
+ * @see execute() above for details.
+ *
+ * @param swap_buffers (default = `true`), swap input and output buffers of the
+ * enactor, such that the input buffer gets reused as the output buffer in the
+ * next iteration. Use `false` to disable the swap behavior.
+ * @param edges_visited (optional) device counter, the number of edges
+ * visited (advance operator calls) is added to it.
+ */
+template <load_balance_t lb = load_balance_t::block_mapped,
+          advance_io_type_t input_type = advance_io_type_t::vertices,
+          advance_io_type_t output_type = advance_io_type_t::vertices,
+          typename graph_t,
+          typename enactor_type,
+          typename advance_operator_t,
+          typename filter_operator_t>
+void execute(graph_t& G,
+             enactor_type* E,
+             advance_operator_t advance_op,
+             filter_operator_t filter_op,
+             cuda::multi_context_t& context,
+             bool swap_buffers = true,
+             std::size_t* edges_visited = nullptr) {
+  if (context.size() > 1)
+    multi_gpu_execute<lb, input_type, output_type>(G, E, advance_op, filter_op,
+                                                   context, edges_visited);
+  else
+    execute<lb, input_type, output_type>(
+        G,                         // graph
+        advance_op,                // advance operator
+        filter_op,                 // filter operator
+        E->get_input_frontier(),   // input frontier
+        E->get_output_frontier(),  // output frontier
+        E->scanned_work_domain,    // work segments
+        context,                   // gpu context
+        edges_visited              // visited edges counter (optional)
+    );
+
+  if (swap_buffers && (output_type != advance_io_type_t::none))
+    E->swap_frontier_buffers();
+}
+
+}  // namespace advance_filter
+}  // namespace operators
+}  // namespace gunrock
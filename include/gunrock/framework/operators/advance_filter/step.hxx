@@ -0,0 +1,61 @@
+/**
+ * @file step.hxx
+ * @author Muhammad Osama (mosama@ucdavis.edu)
+ * @brief One (unfused) advance and filter step over a pair of frontiers,
+ * outside of an enactor.
+ * @version 0.1
+ * @date 2021-06-28
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#pragma once
+
+#include <gunrock/cuda/context.hxx>
+#include <gunrock/framework/operators/configs.hxx>
+#include <gunrock/framework/operators/advance/advance.hxx>
+#include <gunrock/framework/operators/filter/filter.hxx>
+
+namespace gunrock {
+namespace operators {
+namespace advance_filter {
+
+/**
+ * @brief Advance `input` into `output` (block-mapped), then filter (and
+ * compact) `output` back into `input`: the next frontier is in `input`
+ * again. Used by the propagations that own their frontiers instead of an
+ * enactor (e.g., the incremental updates of bfs, pr and kcore).
+ *
+ * @param G graph.
+ * @param advance_op advance operator.
+ * @param filter_op filter operator.
+ * @param input input frontier, replaced by the filtered output.
+ * @param output scratch frontier (the raw advance output).
+ * @param segments work segments of the advance (`n` entries).
+ * @param context `cuda::standard_context_t`.
+ */
+template <typename graph_t,
+          typename advance_op_t,
+          typename filter_op_t,
+          typename frontier_t,
+          typename work_tiles_t>
+void step(graph_t& G,
+          advance_op_t advance_op,
+          filter_op_t filter_op,
+          frontier_t* input,
+          frontier_t* output,
+          work_tiles_t& segments,
+          cuda::standard_context_t& context) {
+  operators::advance::execute<operators::load_balance_t::block_mapped,
+                              operators::advance_direction_t::forward,
+                              operators::advance_io_type_t::vertices,
+                              operators::advance_io_type_t::vertices>(
+      G, advance_op, input, output, segments, context);
+  operators::filter::execute<operators::filter_algorithm_t::compact>(
+      G, filter_op, output, input, context);
+}
+
+}  // namespace advance_filter
+}  // namespace operators
+}  // namespace gunrock
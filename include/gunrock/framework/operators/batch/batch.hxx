@@ -1,7 +1,8 @@
 /**
  * @file batch.hxx
  * @author Muhammad Osama (mosama@ucdavis.edu)
- * @brief
+ * @brief Concurrent execution of independent jobs (e.g. one single-source
+ * run per job) on a bounded pool of workers, each with its own context.
  * @version 0.1
  * @date 2021-05-04
  *
@@ -11,17 +12,172 @@
 
 #pragma once
 
+#include <gunrock/error.hxx>
+#include <gunrock/memory_pool.hxx>
 #include <gunrock/cuda/context.hxx>
 
 #include <thrust/host_vector.h>
 #include <thrust/reduce.h>
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <memory>
+#include <mutex>
 #include <thread>
+#include <vector>
 
 namespace gunrock {
 namespace operators {
 namespace batch {
 
+/**
+ * @brief Throughput of a batch: wall-clock time of the whole batch, and the
+ * sum of the times reported by the jobs (their latency).
+ */
+struct report_t {
+  std::size_t number_of_jobs = 0;
+  float elapsed = 0;  // wall-clock (ms).
+  float summed = 0;   // sum of the per-job times (ms).
+
+  float jobs_per_second() const {
+    return (elapsed > 0) ? (1000.0f * number_of_jobs) / elapsed : 0;
+  }
+};
+
+/**
+ * @brief Bounded pool of workers, each worker owns a context (stream, event,
+ * memory pool and moderngpu context) which is created once and reused by all
+ * the jobs the worker runs, across batches. Jobs are claimed dynamically, so
+ * short and long jobs balance out between the workers.
+ *
+ * @par Example
+ *  \code
+ *  operators::batch::executor_t executor(4);  // 4 streams on GPU 0.
+ *  auto report = executor.execute(
+ *      [&](std::size_t job,
+ *          std::shared_ptr<cuda::multi_context_t>& context) -> float {
+ *        vertex_t source = job;
+ *        return gunrock::sssp::run(G, source, distances + job * n,
+ *                                  predecessors + job * n, nullptr, 0,
+ *                                  context);
+ *      },
+ *      n_jobs);
+ *  std::cout << report.jobs_per_second() << " jobs/s" << std::endl;
+ *  \endcode
+ */
+class executor_t {
+ public:
+  /**
+   * @param number_of_workers number of workers (and streams), `0` picks one
+   * per hardware thread, up to 8.
+   * @param device GPU the workers run on.
+   */
+  executor_t(std::size_t number_of_workers = 0, cuda::device_id_t device = 0) {
+    if (number_of_workers == 0)
+      number_of_workers =
+          std::max<std::size_t>(1, std::min<std::size_t>(
+                                       8, std::thread::hardware_concurrency()));
+
+    for (std::size_t w = 0; w < number_of_workers; ++w)
+      contexts.push_back(std::make_shared<cuda::multi_context_t>(device));
+  }
+
+  std::size_t size() const { return contexts.size(); }
+
+  std::shared_ptr<cuda::multi_context_t>& get_context(std::size_t worker) {
+    return contexts[worker];
+  }
+
+  /**
+   * @brief Run `job(j, context) -> float` for `j = 0 ... number_of_jobs - 1`,
+   * where `context` is the worker's (single-GPU) `multi_context_t` and the
+   * returned float is the job's own (reported) time.
+   *
+   * @return report_t throughput of the batch.
+   */
+  template <typename job_t>
+  report_t execute(job_t job, std::size_t number_of_jobs) {
+    return execute(
+        [](std::shared_ptr<cuda::multi_context_t>& context) { return 0; },
+        [&](int& session, std::size_t j,
+            std::shared_ptr<cuda::multi_context_t>& context) -> float {
+          return job(j, context);
+        },
+        number_of_jobs);
+  }
+
+  /**
+   * @brief Same as above, with a per-worker session built once, before the
+   * worker's first job, with `make_session(context)`, and passed to every
+   * job of the worker, `job(session, j, context) -> float`. Use it to
+   * preallocate the problem and enactor (or any scratch storage) once per
+   * worker rather than once per job.
+   *
+   * @return report_t throughput of the batch, the sessions are built within
+   * the measured time.
+   */
+  template <typename make_session_t, typename job_t>
+  report_t execute(make_session_t make_session,
+                   job_t job,
+                   std::size_t number_of_jobs) {
+    std::atomic<std::size_t> next(0);
+    std::vector<float> summed(size(), 0);
+    std::exception_ptr failure;
+    std::mutex failure_lock;
+
+    auto worker = [&](std::size_t w) {
+      try {
+        auto& context = contexts[w];
+        auto single_context = context->get_context(0);
+        cudaSetDevice(single_context->ordinal());
+        memory::pool_t::scoped_default_t scope(single_context->pool());
+
+        auto session = make_session(context);
+        for (std::size_t j = next++; j < number_of_jobs; j = next++)
+          summed[w] += job(session, j, context);
+        single_context->synchronize();
+      } catch (...) {
+        std::lock_guard<std::mutex> guard(failure_lock);
+        if (!failure)
+          failure = std::current_exception();
+        next = number_of_jobs;  // Stop the other workers.
+      }
+    };
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    std::size_t number_of_threads = std::min(size(), number_of_jobs);
+    for (std::size_t w = 0; w < number_of_threads; ++w)
+      threads.push_back(std::thread(worker, w));
+    for (auto& thread : threads)
+      thread.join();
+    auto stop = std::chrono::steady_clock::now();
+
+    if (failure)
+      std::rethrow_exception(failure);
+
+    report_t report;
+    report.number_of_jobs = number_of_jobs;
+    report.elapsed =
+        std::chrono::duration<float, std::milli>(stop - start).count();
+    for (auto& s : summed)
+      report.summed += s;
+    return report;
+  }
+
+ private:
+  std::vector<std::shared_ptr<cuda::multi_context_t>> contexts;
+};  // class executor_t
+
+/**
+ * @brief Run `f(j) -> float` for `j = 0 ... number_of_jobs - 1` on a bounded
+ * number of threads (one per hardware thread), `total_elapsed[0]` is the sum
+ * of the returned times. Jobs that launch GPU work should prefer
+ * `executor_t`, which also reuses a context per worker and reports the
+ * wall-clock throughput.
+ */
 template <typename function_t, typename... args_t>
 void execute(function_t f,
              std::size_t number_of_jobs,
@@ -29,9 +185,16 @@ void execute(function_t f,
              args_t&... args) {
   thrust::host_vector<float> elapsed(number_of_jobs);
   std::vector<std::thread> threads;
+  std::atomic<std::size_t> next(0);
 
-  for (std::size_t j = 0; j < number_of_jobs; j++) {
-    threads.push_back(std::thread([&, j]() { elapsed[j] = f(j); }));
+  std::size_t number_of_threads = std::min<std::size_t>(
+      number_of_jobs,
+      std::max<std::size_t>(1, std::thread::hardware_concurrency()));
+  for (std::size_t t = 0; t < number_of_threads; t++) {
+    threads.push_back(std::thread([&]() {
+      for (std::size_t j = next++; j < number_of_jobs; j = next++)
+        elapsed[j] = f(j);
+    }));
   }
 
   for (auto& thread : threads)
@@ -44,4 +207,4 @@ void execute(function_t f,
 
 }  // namespace batch
 }  // namespace operators
-}  // namespace gunrock
\ No newline at end of file
+}  // namespace gunrock
@@ -0,0 +1,305 @@
+/**
+ * @file multi_source.hxx
+ * @author Muhammad Osama (mosama@ucdavis.edu)
+ * @brief Bit-parallel multi-source traversal, up to 32 or 64 sources (lanes)
+ * share a single scan of the edges per iteration.
+ * @version 0.1
+ * @date 2021-06-10
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include <gunrock/error.hxx>
+#include <gunrock/util/math.hxx>
+#include <gunrock/cuda/context.hxx>
+#include <gunrock/container/vector.hxx>
+#include <gunrock/framework/frontier/frontier.hxx>
+#include <gunrock/framework/operators/configs.hxx>
+#include <gunrock/framework/operators/advance/advance.hxx>
+
+#include <thrust/copy.h>
+#include <thrust/fill.h>
+#include <thrust/for_each.h>
+#include <thrust/iterator/counting_iterator.h>
+
+namespace gunrock {
+namespace operators {
+namespace batch {
+namespace multi_source {
+
+/**
+ * @brief Call `f(lane)` for every set bit (lane) of `mask`, lowest first.
+ */
+template <typename mask_t, typename function_t>
+__host__ __device__ __forceinline__ void for_each_lane(mask_t mask,
+                                                       function_t f) {
+  while (mask) {
+    int lane;
+#ifdef __CUDA_ARCH__
+    if constexpr (sizeof(mask_t) == 8)
+      lane = __ffsll((long long int)mask) - 1;
+    else
+      lane = __ffs((int)mask) - 1;
+#else
+    lane = 0;
+    while (!((mask >> lane) & mask_t(1)))
+      ++lane;
+#endif
+    f(lane);
+    mask &= mask - 1;
+  }
+}
+
+/**
+ * @brief Per-vertex bitmasks of a multi-source traversal: bit `l` of
+ * `frontier[v]` is set if `v` is in the frontier of source (lane) `l`. The
+ * vertices with a non-zero frontier mask are kept in a (sparse) `active`
+ * frontier, which is the input of the advance.
+ *
+ * @par Overview
+ * A multi-source iteration is an `advance()`, which scans the edges of the
+ * active vertices once for all the lanes and sets the lanes accepted by the
+ * operator in `next[neighbor]`, followed by a `commit()`, which turns `next`
+ * into the new frontier (dropping the already visited lanes, for traversals
+ * that track the visited set, such as BFS).
+ *
+ * @tparam vertex_t vertex type.
+ * @tparam mask_t `std::uint32_t` (32 lanes) or `std::uint64_t` (64 lanes).
+ */
+template <typename vertex_t, typename mask_t = std::uint64_t>
+struct state_t {
+  using mask_type = mask_t;
+  static constexpr int lanes = 8 * sizeof(mask_t);
+
+  static_assert(std::is_unsigned<mask_t>::value &&
+                    (sizeof(mask_t) == 4 || sizeof(mask_t) == 8),
+                "Masks must be 32 or 64-bit unsigned integers.");
+
+  vertex_t number_of_vertices;
+  int number_of_sources;
+
+  /*!
+   * Lanes a vertex may only join once (BFS-like traversals). Disable for
+   * traversals that revisit vertices (e.g., Bellman-Ford, PPR push).
+   */
+  bool track_visited;
+
+  vector_t<mask_t, memory_space_t::device> frontier;
+  vector_t<mask_t, memory_space_t::device> next;
+  vector_t<mask_t, memory_space_t::device> visited;
+
+  gunrock::frontier_t<vertex_t> active;
+  vector_t<std::size_t, memory_space_t::device> segments;
+
+  state_t(vertex_t n, bool _track_visited = true)
+      : number_of_vertices(n),
+        number_of_sources(0),
+        track_visited(_track_visited),
+        frontier(n),
+        next(n),
+        visited(_track_visited ? n : 0),
+        segments(n) {
+    active.reserve(n);
+  }
+
+  /**
+   * @brief Start a new traversal from `count` sources, source `l` (host
+   * array) is assigned to lane `l`.
+   */
+  void reset(vertex_t const* sources,
+             int count,
+             cuda::standard_context_t& context) {
+    if (count < 0 || count > lanes)
+      error::throw_if_exception(cudaErrorUnknown,
+                                "Too many sources for the mask width.");
+
+    auto policy = context.execution_policy();
+    number_of_sources = count;
+    thrust::fill(policy, frontier.begin(), frontier.end(), mask_t(0));
+    thrust::fill(policy, next.begin(), next.end(), mask_t(0));
+    if (track_visited)
+      thrust::fill(policy, visited.begin(), visited.end(), mask_t(0));
+
+    vector_t<vertex_t, memory_space_t::device> d_sources(sources,
+                                                         sources + count);
+    auto source_data = d_sources.data().get();
+    auto frontier_data = frontier.data().get();
+    auto visited_data = visited.data().get();
+    bool track = track_visited;
+    thrust::for_each(policy, thrust::make_counting_iterator<int>(0),
+                     thrust::make_counting_iterator<int>(count),
+                     [=] __device__(int const& lane) {
+                       mask_t bit = mask_t(1) << lane;
+                       math::atomic::bit_or(frontier_data + source_data[lane],
+                                            bit);
+                       if (track)
+                         math::atomic::bit_or(visited_data + source_data[lane],
+                                              bit);
+                     });
+    compact(context);
+  }
+
+  bool is_empty() const { return active.is_empty(); }
+
+  /**
+   * @brief Replace the frontier with `count` (device) vertices and their
+   * lanes, e.g. to revisit a saved level of a traversal (backward passes).
+   */
+  void assign(vertex_t const* vertices,
+              mask_t const* masks,
+              std::size_t count,
+              cuda::standard_context_t& context) {
+    auto policy = context.execution_policy();
+    auto frontier_data = frontier.data().get();
+    thrust::for_each(
+        policy, active.begin(), active.end(),
+        [=] __device__(vertex_t const& v) { frontier_data[v] = 0; });
+
+    if (active.get_capacity() < count)
+      active.reserve(count);
+    thrust::copy(policy, vertices, vertices + count, active.begin());
+    active.set_number_of_elements(count);
+    thrust::for_each(policy, thrust::make_counting_iterator<std::size_t>(0),
+                     thrust::make_counting_iterator<std::size_t>(count),
+                     [=] __device__(std::size_t const& i) {
+                       frontier_data[vertices[i]] = masks[i];
+                     });
+  }
+
+  /**
+   * @brief Rebuild the active frontier from the frontier masks.
+   */
+  void compact(cuda::standard_context_t& context) {
+    auto frontier_data = frontier.data().get();
+    auto end = thrust::copy_if(
+        context.execution_policy(), thrust::make_counting_iterator<vertex_t>(0),
+        thrust::make_counting_iterator<vertex_t>(number_of_vertices),
+        active.begin(),
+        [=] __device__(vertex_t const& v) { return frontier_data[v] != 0; });
+    active.set_number_of_elements(thrust::distance(active.begin(), end));
+  }
+};
+
+/**
+ * @brief Scan the outgoing edges of the active vertices once, for all the
+ * lanes. `op(source, neighbor, edge, weight, lanes) -> mask_t` is given the
+ * lanes `source` is active in (minus the lanes `neighbor` was already
+ * visited in), and returns the lanes in which `neighbor` joins the next
+ * frontier.
+ *
+ * @tparam lb `load_balance_t` of the underlying advance.
+ */
+template <load_balance_t lb = load_balance_t::merge_path,
+          typename graph_t,
+          typename state_type,
+          typename operator_t>
+void advance(graph_t& G,
+             state_type& state,
+             operator_t op,
+             cuda::standard_context_t& context) {
+  using vertex_t = typename graph_t::vertex_type;
+  using edge_t = typename graph_t::edge_type;
+  using weight_t = typename graph_t::weight_type;
+  using mask_t = typename state_type::mask_type;
+
+  if (state.is_empty())
+    return;
+
+  auto frontier = state.frontier.data().get();
+  auto next = state.next.data().get();
+  auto visited = state.visited.data().get();
+  bool track = state.track_visited;
+
+  auto expand = [=] __device__(vertex_t const& source,
+                               vertex_t const& neighbor, edge_t const& edge,
+                               weight_t const& weight) -> bool {
+    mask_t incoming = frontier[source];
+    if (track)
+      incoming &= ~visited[neighbor];
+    if (!incoming)
+      return false;
+
+    mask_t accepted = op(source, neighbor, edge, weight, incoming);
+    if (accepted)
+      math::atomic::bit_or(next + neighbor, accepted);
+    return false;
+  };
+
+  operators::advance::execute<lb, advance_direction_t::forward,
+                              advance_io_type_t::vertices,
+                              advance_io_type_t::none>(
+      G, expand, &(state.active), &(state.active), state.segments, context);
+}
+
+/**
+ * @brief Make the lanes set in `next` the new frontier, calling
+ * `visit(vertex, lanes)` for every vertex that joined the frontier in at
+ * least one lane (e.g., to record the depth per lane).
+ */
+template <typename state_type, typename visit_t>
+void commit(state_type& state,
+            visit_t visit,
+            cuda::standard_context_t& context) {
+  using vertex_t = decltype(state.number_of_vertices);
+  using mask_t = typename state_type::mask_type;
+
+  auto frontier = state.frontier.data().get();
+  auto next = state.next.data().get();
+  auto visited = state.visited.data().get();
+  bool track = state.track_visited;
+
+  thrust::for_each(context.execution_policy(),
+                   thrust::make_counting_iterator<vertex_t>(0),
+                   thrust::make_counting_iterator<vertex_t>(
+                       state.number_of_vertices),
+                   [=] __device__(vertex_t const& v) {
+                     mask_t fresh = next[v];
+                     if (track)
+                       fresh &= ~visited[v];
+                     next[v] = 0;
+                     frontier[v] = fresh;
+                     if (fresh) {
+                       if (track)
+                         visited[v] |= fresh;
+                       visit(v, fresh);
+                     }
+                   });
+  state.compact(context);
+}
+
+/**
+ * @brief `commit()` without a visit operator.
+ */
+template <typename state_type>
+void commit(state_type& state, cuda::standard_context_t& context) {
+  using vertex_t = decltype(state.number_of_vertices);
+  using mask_t = typename state_type::mask_type;
+  commit(
+      state, [] __device__(vertex_t const& v, mask_t const& lanes) {},
+      context);
+}
+
+/**
+ * @brief Call `op(vertex, lanes)` for every active vertex, with the lanes it
+ * is active in.
+ */
+template <typename state_type, typename operator_t>
+void for_each_active(state_type& state,
+                     operator_t op,
+                     cuda::standard_context_t& context) {
+  using vertex_t = decltype(state.number_of_vertices);
+  auto frontier = state.frontier.data().get();
+  thrust::for_each(
+      context.execution_policy(), state.active.begin(), state.active.end(),
+      [=] __device__(vertex_t const& v) { op(v, frontier[v]); });
+}
+
+}  // namespace multi_source
+}  // namespace batch
+}  // namespace operators
+}  // namespace gunrock
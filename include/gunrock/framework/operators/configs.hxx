@@ -30,11 +30,12 @@ namespace operators {
  */
 enum load_balance_t {
   thread_mapped,  /// 1 element per thread
-  warp_mapped,    /// (wip) Equal # of elements per warp
+  warp_mapped,    /// 1 element per warp
   block_mapped,   /// Equal # of elements per block
-  bucketing,      /// (wip) Davidson et al. (SSSP)
+  bucketing,      /// Near-far piles, Davidson et al. (SSSP)
   merge_path,     /// Merrill & Garland (SpMV)
-  work_stealing,  /// (wip) <cite>
+  work_stealing,  /// Persistent warps steal equal-sized chunks of edges
+  automatic       /// Selected per call from the frontier's degree statistics
 };
 
 /**
@@ -76,11 +77,22 @@ enum filter_algorithm_t {
   bypass       /// Marks as invalid, instead of culling
 };
 
+/**
+ * @brief Underlying uniquify algorithm to use.
+ *
+ * @par Overview
+ * `unique` and `unique_copy` sort the frontier for 100% uniqueness, `bitmap`
+ * and `hash` never sort: `bitmap` is exact and costs a bit per id, `hash`
+ * costs two slots per item and trades uniqueness for fewer probes below 100%
+ * (or in the best-effort mode).
+ */
 enum uniquify_algorithm_t {
   unique,  /// Keep only the unique item for each consecutive group. Sort for
            /// 100% uniqueness.
-  unique_copy  /// Copy the unique items for each consecutive group. Sort for
-               /// 100% uniqueness.
+  unique_copy,  /// Copy the unique items for each consecutive group. Sort for
+                /// 100% uniqueness.
+  bitmap,       /// Keep the first occurrence, test-and-set a visited bitmap.
+  hash          /// Keep the first occurrence, warp match and hash set.
 };
 
 enum parallel_for_each_t {
@@ -0,0 +1,85 @@
+/**
+ * @file dense.hxx
+ * @author Muhammad Osama (mosama@ucdavis.edu)
+ * @brief Filter over dense (bitmap or boolmap) frontiers.
+ * @version 0.1
+ * @date 2021-06-28
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#pragma once
+
+#include <gunrock/cuda/context.hxx>
+#include <gunrock/framework/frontier/frontier.hxx>
+#include <gunrock/framework/operators/configs.hxx>
+
+#include <thrust/for_each.h>
+#include <thrust/iterator/counting_iterator.h>
+
+namespace gunrock {
+namespace operators {
+namespace filter {
+namespace dense {
+
+/**
+ * @brief Keep the active ids `v` of the dense `input` frontier for which
+ * `op(v)` holds, in the dense `output` frontier (of the same capacity). Every
+ * thread owns an output word (bitmap) or flag (boolmap), so no atomics and
+ * no uniquification are needed.
+ *
+ * @param G graph.
+ * @param op filter operator, `op(v) -> bool`.
+ * @param input dense input frontier.
+ * @param output dense output frontier.
+ * @param context `cuda::standard_context_t`.
+ */
+template <typename graph_t, typename operator_t, typename frontier_t>
+void execute(graph_t& G,
+             operator_t op,
+             frontier_t* input,
+             frontier_t* output,
+             cuda::standard_context_t& context) {
+  static_assert(frontier_t::is_dense,
+                "Dense filter requires bitmap or boolmap frontiers.");
+  using type_t = typename frontier_t::type_t;
+
+  std::size_t size = input->get_capacity();
+  if (output->get_capacity() < size)
+    output->reserve(size);
+
+  auto in = input->data();
+  auto out = output->data();
+  auto policy = context.execution_policy();
+  if constexpr (frontier_t::underlying_storage == frontier_storage_t::bitmap) {
+    using word_t = typename frontier_t::word_t;
+    constexpr std::size_t bits = frontier_t::bits_per_word;
+    thrust::for_each(policy, thrust::make_counting_iterator<std::size_t>(0),
+                     thrust::make_counting_iterator<std::size_t>(
+                         frontier_t::number_of_words(size)),
+                     [=] __device__(std::size_t const& w) {
+                       word_t word = in[w];
+                       word_t kept = 0;
+                       while (word) {
+                         int b = __ffs(word) - 1;
+                         word &= word - 1;
+                         if (op((type_t)(w * bits + b)))
+                           kept |= word_t(1) << b;
+                       }
+                       out[w] = kept;
+                     });
+  } else {
+    thrust::for_each(policy, thrust::make_counting_iterator<type_t>(0),
+                     thrust::make_counting_iterator<type_t>(size),
+                     [=] __device__(type_t const& v) {
+                       out[v] = in[v] && op(v);
+                     });
+  }
+  output->touch();
+}
+
+}  // namespace dense
+}  // namespace filter
+}  // namespace operators
+}  // namespace gunrock
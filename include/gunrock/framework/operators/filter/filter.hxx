@@ -1,6 +1,7 @@
 #pragma once
 
 #include <gunrock/cuda/context.hxx>
+#include <gunrock/framework/profiler.hxx>
 #include <gunrock/framework/operators/configs.hxx>
 #include <gunrock/util/type_limits.hxx>
 #include <gunrock/util/type_traits.hxx>
@@ -9,6 +10,7 @@
 #include <gunrock/framework/operators/filter/predicated.hxx>
 #include <gunrock/framework/operators/filter/bypass.hxx>
 #include <gunrock/framework/operators/filter/remove.hxx>
+#include <gunrock/framework/operators/filter/dense.hxx>
 
 #include <gunrock/framework/operators/uniquify/uniquify.hxx>
 
@@ -24,43 +26,96 @@ void execute(graph_t& G,
              operator_t op,
              frontier_t* input,
              frontier_t* output,
-             cuda::multi_context_t& context,
+             cuda::standard_context_t& context,
              bool filter_and_uniquify = true) {
-  if (context.size() == 1) {
-    auto single_context = context.get_context(0);
+  profiler::operator_scope_t scope("filter", input, context);
 
-    if constexpr (alg_type == filter_algorithm_t::compact) {
-      compact::execute(G, op, input, output, *single_context);
-    } else if (alg_type == filter_algorithm_t::predicated) {
-      predicated::execute(G, op, input, output, *single_context);
-    } else if (alg_type == filter_algorithm_t::bypass) {
-      bypass::execute(G, op, input, output, *single_context);
-    } else if (alg_type == filter_algorithm_t::remove) {
-      remove::execute(G, op, input, output, *single_context);
-    } else {
-      error::throw_if_exception(cudaErrorUnknown, "Filter type not supported.");
-    }
+  // Dense frontiers, word (flag) per thread and duplicate-free: the
+  // algorithm and the uniquification do not apply.
+  if constexpr (frontier_t::is_dense) {
+    dense::execute(G, op, input, output, context);
+    scope.set_output(output);
+    return;
+  } else if constexpr (alg_type == filter_algorithm_t::compact) {
+    compact::execute(G, op, input, output, context);
+  } else if (alg_type == filter_algorithm_t::predicated) {
+    predicated::execute(G, op, input, output, context);
+  } else if (alg_type == filter_algorithm_t::bypass) {
+    bypass::execute(G, op, input, output, context);
+  } else if (alg_type == filter_algorithm_t::remove) {
+    remove::execute(G, op, input, output, context);
+  } else {
+    error::throw_if_exception(cudaErrorUnknown, "Filter type not supported.");
+  }
 
-    /*!
-     * @todo Should filter really do uniquify? This is a tedious interface
-     * change.
-     */
-    if (filter_and_uniquify) {
-      operators::uniquify::execute<uniquify_algorithm_t::unique>(output, input,
-                                                                 context);
-      // Simple pointer swap since output is input and vice-versa after the
-      // uniquify.
-      frontier_t* temp = input;
-      input = output;
-      output = temp;
-      temp = nullptr;
-    }
+  /*!
+   * @todo Should filter really do uniquify? This is a tedious interface
+   * change.
+   */
+  if (filter_and_uniquify) {
+    // Exact and sort-free, a bit per vertex.
+    operators::uniquify::execute<uniquify_algorithm_t::bitmap>(
+        output, input, context, 100, false, G.get_number_of_vertices());
+    // Simple pointer swap since output is input and vice-versa after the
+    // uniquify.
+    frontier_t* temp = input;
+    input = output;
+    output = temp;
+    temp = nullptr;
+  }
+  scope.set_output(filter_and_uniquify ? input : output);
+}
+
+template <filter_algorithm_t alg_type,
+          typename graph_t,
+          typename operator_t,
+          typename frontier_t>
+void execute(graph_t& G,
+             operator_t op,
+             frontier_t* input,
+             frontier_t* output,
+             cuda::multi_context_t& context,
+             bool filter_and_uniquify = true) {
+  if (context.size() == 1) {
+    execute<alg_type>(G, op, input, output, *(context.get_context(0)),
+                      filter_and_uniquify);
   } else {
     error::throw_if_exception(cudaErrorUnknown,
-                              "`context.size() != 1` not supported");
+                              "`context.size() != 1` requires the enactor "
+                              "interface, see `multi_gpu::state_t`.");
   }
 }
 
+/**
+ * @brief Multi-GPU filter using the enactor's `multi_gpu::state_t`, every GPU
+ * filters (and uniquifies) the portion of the input frontier it owns. A vertex
+ * is only ever owned by one GPU, so the local uniquify removes all the
+ * duplicates and no exchange is needed, only the gather.
+ */
+template <filter_algorithm_t alg_type,
+          typename graph_t,
+          typename enactor_type,
+          typename operator_t>
+void multi_gpu_execute(graph_t& G,
+                       enactor_type* E,
+                       operator_t op,
+                       cuda::multi_context_t& context,
+                       bool filter_and_uniquify) {
+  auto& state = E->multi_gpu_state;
+  state.init(G, context);
+
+  int in = state.acquire(E->get_input_frontier(), context);
+  int out = in ^ 1;
+
+  state.for_each_device(context, [&](int d, auto& slice, auto& local_context) {
+    execute<alg_type>(slice.graph, op, &(slice.frontiers[in]),
+                      &(slice.frontiers[out]), local_context,
+                      filter_and_uniquify);
+  });
+
+  state.gather(out, E->get_output_frontier(), context);
+}
+
 template <filter_algorithm_t alg_type,
           typename graph_t,
           typename enactor_type,
@@ -71,13 +126,16 @@ void execute(graph_t& G,
              cuda::multi_context_t& context,
              bool filter_and_uniquify = true,
              bool swap_buffers = true) {
-  execute<alg_type>(G,                         // graph
-                    op,                        // operator_t
-                    E->get_input_frontier(),   // input frontier
-                    E->get_output_frontier(),  // output frontier
-                    context,                   // context
-                    filter_and_uniquify        // flag to deduplicate
-  );
+  if (context.size() > 1)
+    multi_gpu_execute<alg_type>(G, E, op, context, filter_and_uniquify);
+  else
+    execute<alg_type>(G,                         // graph
+                      op,                        // operator_t
+                      E->get_input_frontier(),   // input frontier
+                      E->get_output_frontier(),  // output frontier
+                      context,                   // context
+                      filter_and_uniquify        // flag to deduplicate
+    );
 
   /*!
    * @note if the Enactor interface is used, we, the library writers assume
@@ -1,7 +1,12 @@
 #pragma once
 
+#include <thread>
+#include <vector>
+
 #include <gunrock/cuda/context.hxx>
+#include <gunrock/graph/partition.hxx>
 
+#include <gunrock/framework/profiler.hxx>
 #include <gunrock/framework/operators/configs.hxx>
 
 #include <thrust/transform.h>
@@ -12,29 +17,64 @@ namespace gunrock {
 namespace operators {
 namespace parallel_for {
 
+/**
+ * @brief Apply `op` to every id in [begin, end) on one GPU.
+ */
+template <typename type_t, typename operator_t>
+void execute(type_t begin,
+             type_t end,
+             operator_t op,
+             cuda::standard_context_t& context) {
+  profiler::operator_scope_t scope("parallel_for", std::size_t(end - begin),
+                                   context);
+  auto apply = [=] __device__(type_t const& x) {
+    op(x);
+    return x;  // output ignored.
+  };
+
+  thrust::transform(
+      thrust::cuda::par.on(context.stream()),
+      thrust::make_counting_iterator<type_t>(begin),  // Begin: first id
+      thrust::make_counting_iterator<type_t>(end),    // End: last id + 1
+      thrust::make_discard_iterator(),  // output iterator: ignore
+      apply                             // Unary Operator
+  );
+}
+
+/**
+ * @brief Apply `op` to every vertex (or edge) of `G`. With more than one GPU
+ * in the context, the ids are split in contiguous ranges, one per GPU (the
+ * vertex ranges are those of `graph::partition_t`), and the GPUs run
+ * concurrently; `op` must then only touch memory accessible by all of them.
+ */
 template <parallel_for_each_t type, typename graph_t, typename operator_t>
 void execute(graph_t& G, operator_t op, cuda::multi_context_t& context) {
   using type_t = std::conditional_t<type == parallel_for_each_t::vertex,
                                     typename graph_t::vertex_type,
                                     typename graph_t::edge_type>;
 
-  auto single_context = context.get_context(0);
+  type_t size = (type == parallel_for_each_t::vertex)
+                    ? G.get_number_of_vertices()
+                    : G.get_number_of_edges();
 
-  std::size_t size = (type == parallel_for_each_t::vertex)
-                         ? G.get_number_of_vertices()
-                         : G.get_number_of_edges();
-  auto apply = [=] __device__(type_t const& x) {
-    op(x);
-    return x;  // output ignored.
-  };
+  if (context.size() == 1) {
+    execute(type_t(0), size, op, *(context.get_context(0)));
+    return;
+  }
 
-  thrust::transform(
-      thrust::cuda::par.on(single_context->stream()),
-      thrust::make_counting_iterator<type_t>(0),     // Begin: 0
-      thrust::make_counting_iterator<type_t>(size),  // End: # of Edges
-      thrust::make_discard_iterator(),               // output iterator: ignore
-      apply                                          // Unary Operator
-  );
+  int k = context.size();
+  graph::partition_t<type_t> ranges(size, k);
+  std::vector<std::thread> threads;
+  for (int d = 0; d < k; ++d) {
+    threads.emplace_back([&, d]() {
+      auto device_context = context.get_context(d);
+      cudaSetDevice(device_context->ordinal());
+      execute(ranges.begin(d), ranges.end(d), op, *device_context);
+      cudaStreamSynchronize(device_context->stream());
+    });
+  }
+  for (auto& thread : threads)
+    thread.join();
 }
 
 }  // namespace parallel_for
@@ -0,0 +1,129 @@
+/**
+ * @file launch.hxx
+ * @author Muhammad Osama (mosama@ucdavis.edu)
+ * @brief Compile-time launch configurations (`cuda::launch_box::launch_box_t`)
+ * of the operators' kernels, per SM architecture.
+ * @version 0.1
+ * @date 2021-06-21
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#pragma once
+
+#include <gunrock/cuda/launch_box.hxx>
+
+#include <type_traits>
+
+namespace gunrock {
+namespace operators {
+namespace launch {
+
+using namespace cuda::launch_box;
+
+/**
+ * @brief Operator kernels with a compile-time launch configuration.
+ */
+enum class kernel_t {
+  advance_block_mapped,   // block size, vertices per thread.
+  advance_warp_mapped,    // block size.
+  advance_work_stealing,  // block size, edges (of a chunk) per lane.
+  advance_merge_path,     // block size, work items per thread.
+  advance_captured,       // block size.
+  advance_persistent,     // block size.
+  advance_streamed,       // block size.
+  advance_filter,         // block size.
+  spmv,                   // block size, merge-path steps per thread.
+  uniquify_hash,          // block size.
+  neighbors_reduce        // block size (a multiple of the warp size).
+};
+
+/**
+ * @brief Default launch configuration of a kernel, the one used without a
+ * tuned configuration (see `tuned_t`).
+ */
+template <kernel_t kernel>
+struct defaults_t {
+  using type = launch_box_t<launch_params_1d_t<fallback, 128>>;
+};
+
+template <>
+struct defaults_t<kernel_t::advance_work_stealing> {
+  // Chunks of 8 * 32 = 256 edges per warp.
+  using type = launch_box_t<launch_params_1d_t<fallback, 256, 8>>;
+};
+
+template <>
+struct defaults_t<kernel_t::advance_merge_path> {
+  // moderngpu's default for `transform_lbs`.
+  using type = launch_box_t<launch_params_1d_t<fallback, 128, 11>>;
+};
+
+template <>
+struct defaults_t<kernel_t::advance_captured> {
+  using type = launch_box_t<launch_params_1d_t<fallback, 256>>;
+};
+
+template <>
+struct defaults_t<kernel_t::advance_persistent> {
+  using type = launch_box_t<launch_params_1d_t<fallback, 256>>;
+};
+
+template <>
+struct defaults_t<kernel_t::advance_streamed> {
+  using type = launch_box_t<launch_params_1d_t<fallback, 256>>;
+};
+
+template <>
+struct defaults_t<kernel_t::spmv> {
+  using type = launch_box_t<launch_params_1d_t<fallback, 128, 7>>;
+};
+
+template <>
+struct defaults_t<kernel_t::uniquify_hash> {
+  using type = launch_box_t<launch_params_1d_t<fallback, 256>>;
+};
+
+/**
+ * @brief Tuned launch configuration of a kernel, `void` if not tuned.
+ * Specialized by the header that `ESSENTIALS_LAUNCH_BOXES` names (generated
+ * per algorithm by `benchmarks/autotune.py`), e.g.
+ * \code
+ * template <>
+ * struct tuned_t<kernel_t::advance_block_mapped> {
+ *   using type = launch_box_t<launch_params_1d_t<sm_80, 256, 2>,
+ *                             launch_params_1d_t<fallback, 128>>;
+ * };
+ * \endcode
+ */
+template <kernel_t kernel>
+struct tuned_t {
+  using type = void;
+};
+
+}  // namespace launch
+}  // namespace operators
+}  // namespace gunrock
+
+#ifdef ESSENTIALS_LAUNCH_BOXES
+#include ESSENTIALS_LAUNCH_BOXES
+#endif
+
+namespace gunrock {
+namespace operators {
+namespace launch {
+
+/**
+ * @brief Launch configuration of `kernel` on the target architecture
+ * (`SM_TARGET`): `block_size`, `items_per_thread` and `tile_size`.
+ */
+template <kernel_t kernel>
+using launch_box_for_t =
+    std::conditional_t<std::is_void_v<typename tuned_t<kernel>::type>,
+                       typename defaults_t<kernel>::type,
+                       typename tuned_t<kernel>::type>;
+
+}  // namespace launch
+}  // namespace operators
+}  // namespace gunrock
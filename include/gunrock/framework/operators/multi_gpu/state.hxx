@@ -0,0 +1,564 @@
+/**
+ * @file state.hxx
+ * @author Muhammad Osama (mosama@ucdavis.edu)
+ * @brief Per-device bookkeeping for running the operators over a
+ * `cuda::multi_context_t` with more than one GPU.
+ * @version 0.1
+ * @date 2021-06-09
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#pragma once
+
+#include <mutex>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <exception>
+#include <functional>
+#include <condition_variable>
+
+#include <gunrock/error.hxx>
+#include <gunrock/cuda/context.hxx>
+#include <gunrock/util/type_limits.hxx>
+#include <gunrock/container/vector.hxx>
+#include <gunrock/graph/partition.hxx>
+
+#include <thrust/copy.h>
+#include <thrust/sort.h>
+#include <thrust/transform.h>
+#include <thrust/binary_search.h>
+#include <thrust/host_vector.h>
+#include <thrust/iterator/counting_iterator.h>
+
+namespace gunrock {
+namespace operators {
+namespace multi_gpu {
+
+/**
+ * @brief Everything a single GPU needs to run its share of an operator: the
+ * local subgraph (its partition's rows), a pair of local frontiers mirroring
+ * the enactor's input/output frontiers, and scratch space.
+ */
+template <typename graph_t, typename frontier_t>
+struct slice_t {
+  using vertex_t = typename graph_t::vertex_type;
+  using edge_t = typename graph_t::edge_type;
+  using weight_t = typename graph_t::weight_type;
+
+  graph::local_csr_t<vertex_t, edge_t, weight_t> storage;
+  graph_t graph;
+
+  /*!
+   * Local frontiers, slot `s` holds this device's (owned) portion of the
+   * global frontier mirrored in slot `s` (see `state_t::acquire()`).
+   */
+  frontier_t frontiers[2];
+
+  /*!
+   * Raw operator output, before it is exchanged between the devices.
+   */
+  frontier_t scratch;
+
+  /*!
+   * Work segments (scan of the work domain) of the local advance.
+   */
+  vector_t<edge_t, memory_space_t::device> segments;
+
+  /*!
+   * Local copy of the global frontier (on the first GPU), filtered by
+   * `state_t::distribute()`. Unused on the first GPU.
+   */
+  vector_t<typename frontier_t::type_t, memory_space_t::device> staging;
+
+  vector_t<int, memory_space_t::device> owners;
+  vector_t<std::size_t, memory_space_t::device> buckets;
+  thrust::host_vector<std::size_t> h_buckets;
+};
+
+/**
+ * @brief Persistent host threads, one per GPU of a `cuda::multi_context_t`
+ * (with the GPU current), that run the per-device parts of the multi-GPU
+ * operators. Created once per `state_t`, instead of spawning threads for
+ * every step of every operator.
+ */
+class workers_t {
+ public:
+  using task_t = std::function<void(int)>;
+
+  explicit workers_t(std::vector<int> const& ordinals)
+      : errors(ordinals.size()) {
+    for (std::size_t d = 0; d < ordinals.size(); ++d)
+      threads.emplace_back(&workers_t::work, this, (int)d, ordinals[d]);
+  }
+
+  workers_t(const workers_t& rhs) = delete;
+  workers_t& operator=(const workers_t& rhs) = delete;
+
+  ~workers_t() {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      stop = true;
+    }
+    wake.notify_all();
+    for (auto& thread : threads)
+      thread.join();
+  }
+
+  /**
+   * @brief Run `task(device)` on every worker and wait for all of them. The
+   * first exception thrown by any of the devices is rethrown. Not reentrant:
+   * `task` must not run the workers again.
+   */
+  void run(task_t const& task) {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      current = &task;
+      pending = threads.size();
+      ++generation;
+    }
+    wake.notify_all();
+
+    std::unique_lock<std::mutex> lock(mutex);
+    done.wait(lock, [&]() { return pending == 0; });
+    current = nullptr;
+    for (auto& e : errors)
+      if (e)
+        std::rethrow_exception(e);
+  }
+
+ private:
+  void work(int d, int ordinal) {
+    std::exception_ptr initialization;
+    try {
+      error::throw_if_exception(cudaSetDevice(ordinal));
+    } catch (...) {
+      initialization = std::current_exception();
+    }
+
+    std::size_t seen = 0;
+    while (true) {
+      task_t const* task = nullptr;
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        wake.wait(lock, [&]() { return stop || generation != seen; });
+        if (stop)
+          return;
+        seen = generation;
+        task = current;
+      }
+
+      std::exception_ptr e = initialization;
+      if (!e) {
+        try {
+          (*task)(d);
+        } catch (...) {
+          e = std::current_exception();
+        }
+      }
+
+      std::lock_guard<std::mutex> lock(mutex);
+      errors[d] = e;
+      if (--pending == 0)
+        done.notify_all();
+    }
+  }
+
+  std::mutex mutex;
+  std::condition_variable wake;  // a task was posted (or stop).
+  std::condition_variable done;  // all the workers finished the task.
+  task_t const* current = nullptr;
+  std::size_t generation = 0;
+  std::size_t pending = 0;
+  bool stop = false;
+  std::vector<std::exception_ptr> errors;
+  std::vector<std::thread> threads;
+};  // class workers_t
+
+/**
+ * @brief Multi-GPU state of an enactor, stored in the enactor (like the
+ * push-pull bookkeeping), and initialized on the first multi-GPU operator.
+ *
+ * @par Overview
+ * The vertices are partitioned in contiguous ranges (1D, `graph::partition_t`)
+ * and every GPU holds the outgoing edges of the vertices it owns. An operator
+ * runs concurrently on all the GPUs over their owned portion of the input
+ * frontier, the output (neighbors, which may belong to any partition) is then
+ * bucketed by owner and exchanged peer-to-peer, such that every GPU ends up
+ * with the part of the output it owns. The global output frontier (the
+ * enactor's, on the first GPU) is gathered from those parts, so the rest of
+ * the enactor (convergence checks, frontier sizes) is unchanged. As long as an
+ * operator consumes the frontier produced by the previous one, the gather is
+ * the only copy: the local parts are reused as the next input instead of
+ * scattering the global frontier again.
+ *
+ * @note User data indexed by vertex (e.g., distances, labels) must be
+ * accessible by all the GPUs, allocate it with unified memory or a
+ * `memory::striped_array_t` (with `vertices_per_partition` set to its
+ * `elements_per_partition()`, for the owner's data to be local; see
+ * `gunrock::vertex_array_t`, used by the algorithms' problems). Updates to
+ * neighbors owned by other GPUs (`math::atomic` in advance) are peer atomics,
+ * these require NVLink-connected devices.
+ *
+ * @tparam graph_t `gunrock::graph_t` struct (with a CSR view).
+ * @tparam frontier_t `gunrock::frontier_t` (vector storage).
+ */
+template <typename graph_t, typename frontier_t>
+class state_t {
+ public:
+  using vertex_t = typename graph_t::vertex_type;
+  using type_t = typename frontier_t::type_t;
+  using slice_type = slice_t<graph_t, frontier_t>;
+
+  /*!
+   * Vertices per partition, `0` (default) splits the vertices evenly between
+   * the GPUs. Must be set before the first multi-GPU operator.
+   */
+  vertex_t vertices_per_partition = 0;
+
+  state_t() = default;
+
+  state_t(const state_t& rhs) = delete;
+  state_t& operator=(const state_t& rhs) = delete;
+
+  /**
+   * @brief Release the per-device storage on its own device.
+   */
+  ~state_t() {
+    workers.reset();
+    int current = 0;
+    cudaGetDevice(&current);
+    for (std::size_t d = 0; d < slices.size(); ++d) {
+      cudaSetDevice(ordinals[d]);
+      slices[d].reset();
+    }
+    cudaSetDevice(current);
+  }
+
+  bool is_initialized() const { return !slices.empty(); }
+
+  graph::partition_t<vertex_t> const& get_partition() const {
+    return partition;
+  }
+
+  slice_type& get_slice(int d) { return *slices[d]; }
+
+  /**
+   * @brief Partition `G` and build the local subgraphs, once.
+   *
+   * @param G global graph (on the first GPU).
+   * @param context `cuda::multi_context_t`.
+   */
+  void init(graph_t const& G, cuda::multi_context_t& context) {
+    static_assert(!frontier_t::is_dense,
+                  "Multi-GPU operators require vector (sparse) frontiers.");
+    if (is_initialized())
+      return;
+
+    context.enable_peer_access();
+    int k = context.size();
+    partition = graph::partition_t<vertex_t>(G.get_number_of_vertices(), k,
+                                             vertices_per_partition);
+
+    ordinals.resize(k);
+    for (int d = 0; d < k; ++d)
+      ordinals[d] = context.get_context(d)->ordinal();
+    workers.reset(new workers_t(ordinals));
+
+    // Slices are constructed on their device, for their containers to draw
+    // from the device's pool.
+    slices.resize(k);
+    for_each_context(context, [&](int d,
+                                  cuda::standard_context_t& device_context) {
+      slices[d].reset(new slice_type);
+      auto& slice = *slices[d];
+      slice.graph = slice.storage.build(G, partition, d, device_context);
+      slice.segments.resize(G.get_number_of_vertices());
+    });
+  }
+
+  /**
+   * @brief Run `f(device, context)` concurrently on the persistent workers,
+   * one host thread per GPU (with the GPU current), and wait for all of them
+   * (and their streams). The first exception thrown by any of the devices is
+   * rethrown.
+   */
+  template <typename function_t>
+  void for_each_context(cuda::multi_context_t& context, function_t f) {
+    workers->run([&](int d) {
+      auto device_context = context.get_context(d);
+      f(d, *device_context);
+      error::throw_if_exception(
+          cudaStreamSynchronize(device_context->stream()));
+    });
+  }
+
+  /**
+   * @brief `for_each_context()`, also passing the device's slice:
+   * `f(device, slice, context)`.
+   */
+  template <typename function_t>
+  void for_each_device(cuda::multi_context_t& context, function_t f) {
+    for_each_context(context,
+                     [&](int d, cuda::standard_context_t& device_context) {
+                       f(d, *slices[d], device_context);
+                     });
+  }
+
+  /**
+   * @brief Local slot holding the (per-device parts of the) global frontier
+   * `input`. If `input` is not the output of the last multi-GPU operator, or
+   * it has been modified since, its elements are distributed to their owners.
+   *
+   * @param input global input frontier.
+   * @param context `cuda::multi_context_t`.
+   * @return int slot of the local input frontiers, the other slot is free to
+   * be used for the output.
+   */
+  int acquire(frontier_t* input, cuda::multi_context_t& context) {
+    for (int s = 0; s < 2; ++s)
+      if (mirrors[s].is_mirror_of(input))
+        return s;
+
+    int slot = 0;
+    std::size_t size = input->get_number_of_elements();
+    type_t* data = input->data();
+
+    // The global frontier was last written on the first GPU, by its context
+    // or (containers, `push_back()`) on its default stream.
+    auto root = context.get_context(0);
+    int current = 0;
+    cudaGetDevice(&current);
+    cudaSetDevice(root->ordinal());
+    root->pool()->order(0, root->stream());
+    root->synchronize();
+    cudaSetDevice(current);
+
+    for_each_device(context, [&](int d, slice_type& slice,
+                                 cuda::standard_context_t& device_context) {
+      distribute(data, size, d, slice, slice.frontiers[slot], device_context);
+    });
+
+    mirrors[slot].commit(input);
+    return slot;
+  }
+
+  /**
+   * @brief Bucket the `scratch` outputs of all the devices by owner and send
+   * every bucket to its owner (peer-to-peer), into the local frontiers of
+   * `slot`. Invalid elements are dropped.
+   *
+   * @param slot local output slot.
+   * @param context `cuda::multi_context_t`.
+   */
+  void exchange(int slot, cuda::multi_context_t& context) {
+    int k = context.size();
+    for_each_device(context, [&](int d, slice_type& slice,
+                                 cuda::standard_context_t& device_context) {
+      bucket(slice, device_context);
+    });
+
+    // Where device `d`'s bucket for device `j` goes in `j`'s frontier.
+    std::vector<std::size_t> incoming(k, 0);
+    std::vector<std::vector<std::size_t>> positions(
+        k, std::vector<std::size_t>(k, 0));
+    for (int d = 0; d < k; ++d) {
+      auto& buckets = slices[d]->h_buckets;
+      for (int j = 0; j < k; ++j) {
+        positions[d][j] = incoming[j];
+        incoming[j] += buckets[j + 1] - buckets[j];
+      }
+    }
+
+    for_each_device(context, [&](int d, slice_type& slice,
+                                 cuda::standard_context_t& device_context) {
+      auto& f = slice.frontiers[slot];
+      if (f.get_capacity() < incoming[d])
+        f.reserve(incoming[d]);
+      f.set_number_of_elements(incoming[d]);
+      // Container allocations are ordered on the default stream, the peers'
+      // copies into `f` follow the (synchronized) context stream.
+      device_context.pool()->order(0, device_context.stream());
+    });
+
+    for_each_device(context, [&](int d, slice_type& slice,
+                                 cuda::standard_context_t& device_context) {
+      auto& buckets = slice.h_buckets;
+      for (int j = 0; j < k; ++j) {
+        std::size_t count = buckets[j + 1] - buckets[j];
+        if (count == 0)
+          continue;
+        auto destination = context.get_context(j);
+        error::throw_if_exception(
+            cudaMemcpyPeerAsync(
+                slices[j]->frontiers[slot].data() + positions[d][j],
+                destination->ordinal(), slice.scratch.data() + buckets[j],
+                device_context.ordinal(), count * sizeof(type_t),
+                device_context.stream()),
+            "Multi-GPU frontier exchange failed.");
+      }
+    });
+  }
+
+  /**
+   * @brief Concatenate the local frontiers of `slot` into the global
+   * `output` frontier (first GPU), which then is the frontier mirrored by
+   * `slot`.
+   *
+   * @param slot local slot.
+   * @param output global output frontier.
+   * @param context `cuda::multi_context_t`.
+   */
+  void gather(int slot, frontier_t* output, cuda::multi_context_t& context) {
+    int k = context.size();
+    std::vector<std::size_t> positions(k + 1, 0);
+    for (int d = 0; d < k; ++d)
+      positions[d + 1] =
+          positions[d] + slices[d]->frontiers[slot].get_number_of_elements();
+
+    auto root = context.get_context(0);
+    int current = 0;
+    cudaGetDevice(&current);
+    cudaSetDevice(root->ordinal());
+    if (output->get_capacity() < positions[k])
+      output->reserve(positions[k]);
+    output->set_number_of_elements(positions[k]);
+    // The growth of `output` (default stream) precedes the peers' copies.
+    root->pool()->order(0, root->stream());
+    root->synchronize();
+    cudaSetDevice(current);
+
+    type_t* data = output->data();
+    for_each_device(context, [&](int d, slice_type& slice,
+                                 cuda::standard_context_t& device_context) {
+      std::size_t count = positions[d + 1] - positions[d];
+      if (count == 0)
+        return;
+      error::throw_if_exception(
+          cudaMemcpyPeerAsync(data + positions[d], root->ordinal(),
+                              slice.frontiers[slot].data(),
+                              device_context.ordinal(), count * sizeof(type_t),
+                              device_context.stream()),
+          "Multi-GPU frontier gather failed.");
+    });
+
+    mirrors[slot].commit(output);
+  }
+
+  /**
+   * @brief Forget the mirrored frontiers, e.g. after a frontier was modified
+   * in place without `frontier_t::touch()`.
+   */
+  void invalidate() {
+    mirrors[0] = mirror_t();
+    mirrors[1] = mirror_t();
+  }
+
+  /**
+   * @brief Copy the elements of the global frontier `data` (first GPU)
+   * owned by device `d` into its local frontier `f`. The other devices copy
+   * the global frontier peer-to-peer into their `staging` buffer and filter
+   * it there: kernels never read the memory of another GPU.
+   */
+  void distribute(type_t* data,
+                  std::size_t size,
+                  int d,
+                  slice_type& slice,
+                  frontier_t& f,
+                  cuda::standard_context_t& context) {
+    if (f.get_capacity() < size)
+      f.reserve(size);
+
+    type_t const* elements = data;
+    if (d != 0) {
+      if (slice.staging.size() < size)
+        slice.staging.resize(size);
+      elements = slice.staging.data().get();
+    }
+
+    // Container allocations are ordered on the default stream.
+    context.pool()->order(0, context.stream());
+    if (d != 0 && size)
+      error::throw_if_exception(
+          cudaMemcpyPeerAsync(slice.staging.data().get(), context.ordinal(),
+                              data, ordinals[0], size * sizeof(type_t),
+                              context.stream()),
+          "Multi-GPU frontier distribution failed.");
+
+    auto part = partition;
+    auto end = thrust::copy_if(
+        context.execution_policy(), elements, elements + size, f.begin(),
+        [=] __device__(type_t const& v) {
+          return gunrock::util::limits::is_valid(v) && (part.owner(v) == d);
+        });
+    f.set_number_of_elements(thrust::distance(f.begin(), end));
+  }
+
+  /**
+   * @brief Sort the `scratch` output of a device by owner (invalid elements
+   * last) and find the bucket boundaries.
+   */
+  void bucket(slice_type& slice, cuda::standard_context_t& context) {
+    auto policy = context.execution_policy();
+    auto part = partition;
+    int k = part.number_of_partitions;
+    std::size_t size = slice.scratch.get_number_of_elements();
+
+    slice.owners.resize(size);
+    slice.buckets.resize(k + 1);
+    context.pool()->order(0, context.stream());
+
+    int* owners = slice.owners.data().get();
+    thrust::transform(policy, slice.scratch.begin(), slice.scratch.end(),
+                      owners, [=] __device__(type_t const& v) -> int {
+                        return gunrock::util::limits::is_valid(v)
+                                   ? part.owner(v)
+                                   : part.number_of_partitions;
+                      });
+    thrust::stable_sort_by_key(policy, owners, owners + size,
+                               slice.scratch.begin());
+    thrust::lower_bound(policy, owners, owners + size,
+                        thrust::make_counting_iterator<int>(0),
+                        thrust::make_counting_iterator<int>(k + 1),
+                        slice.buckets.begin());
+
+    slice.h_buckets.resize(k + 1);
+    error::throw_if_exception(cudaMemcpyAsync(
+        slice.h_buckets.data(), slice.buckets.data().get(),
+        (k + 1) * sizeof(std::size_t), cudaMemcpyDeviceToHost,
+        context.stream()));
+    error::throw_if_exception(cudaStreamSynchronize(context.stream()));
+  }
+
+ private:
+  /*!
+   * Global frontier whose parts a local slot holds, and its version
+   * (`frontier_t::get_version()`) when they were committed: any later
+   * modification of the global frontier invalidates the slot.
+   */
+  struct mirror_t {
+    frontier_t* frontier = nullptr;
+    std::size_t version = 0;
+
+    bool is_mirror_of(frontier_t* f) const {
+      return frontier && (frontier == f) && (version == f->get_version());
+    }
+
+    void commit(frontier_t* f) {
+      frontier = f;
+      version = f->get_version();
+    }
+  };
+
+  graph::partition_t<vertex_t> partition;
+  std::vector<std::shared_ptr<slice_type>> slices;
+  std::vector<int> ordinals;
+  std::unique_ptr<workers_t> workers;
+  mirror_t mirrors[2];
+};  // class state_t
+
+}  // namespace multi_gpu
+}  // namespace operators
+}  // namespace gunrock
@@ -0,0 +1,352 @@
+/**
+ * @file neighbors_reduce.hxx
+ * @author Muhammad Osama (mosama@ucdavis.edu)
+ * @brief Neighbor-reduce operator, a user map/reduce over the neighbors of
+ * every vertex of a frontier (or of the graph), the neighbors of a vertex
+ * being shared by a thread, a warp or a block.
+ * @version 0.1
+ * @date 2021-06-22
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#pragma once
+
+#include <gunrock/error.hxx>
+#include <gunrock/util/type_limits.hxx>
+#include <gunrock/cuda/context.hxx>
+#include <gunrock/cuda/global.hxx>
+#include <gunrock/cuda/device_properties.hxx>
+#include <gunrock/graph/partition.hxx>
+
+#include <gunrock/framework/profiler.hxx>
+#include <gunrock/framework/operators/configs.hxx>
+#include <gunrock/framework/operators/launch.hxx>
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#include <cub/warp/warp_reduce.cuh>
+#include <cub/block/block_reduce.cuh>
+
+namespace gunrock {
+namespace operators {
+namespace neighbors_reduce {
+
+namespace detail {
+
+/**
+ * @brief Number of threads sharing the neighbors of a vertex.
+ */
+template <load_balance_t lb, int THREADS_PER_BLOCK>
+constexpr int group_size() {
+  return (lb == load_balance_t::thread_mapped) ? 1
+         : (lb == load_balance_t::warp_mapped)
+             ? cuda::properties::warp_max_threads()
+             : THREADS_PER_BLOCK;
+}
+
+/**
+ * @brief Reduction of the partial values of a group (thread_mapped: one
+ * thread, warp_mapped: a warp, block_mapped: the block); the result is only
+ * valid in the first thread of the group.
+ */
+template <load_balance_t lb, int THREADS_PER_BLOCK, typename type_t>
+struct group_reduce_t {
+  struct storage_t {};
+
+  template <typename reduce_t>
+  __device__ __forceinline__ static type_t reduce(storage_t& storage,
+                                                  type_t const& value,
+                                                  reduce_t op) {
+    return value;
+  }
+};
+
+template <int THREADS_PER_BLOCK, typename type_t>
+struct group_reduce_t<load_balance_t::warp_mapped, THREADS_PER_BLOCK, type_t> {
+  using warp_reduce_t = cub::WarpReduce<type_t>;
+  static constexpr int warps =
+      THREADS_PER_BLOCK / cuda::properties::warp_max_threads();
+
+  struct storage_t {
+    typename warp_reduce_t::TempStorage warp[warps];
+  };
+
+  template <typename reduce_t>
+  __device__ __forceinline__ static type_t reduce(storage_t& storage,
+                                                  type_t const& value,
+                                                  reduce_t op) {
+    int warp = cuda::thread::local::id::x() /
+               cuda::properties::warp_max_threads();
+    return warp_reduce_t(storage.warp[warp]).Reduce(value, op);
+  }
+};
+
+template <int THREADS_PER_BLOCK, typename type_t>
+struct group_reduce_t<load_balance_t::block_mapped, THREADS_PER_BLOCK, type_t> {
+  using block_reduce_t = cub::BlockReduce<type_t, THREADS_PER_BLOCK>;
+  using storage_t = typename block_reduce_t::TempStorage;
+
+  template <typename reduce_t>
+  __device__ __forceinline__ static type_t reduce(storage_t& storage,
+                                                  type_t const& value,
+                                                  reduce_t op) {
+    type_t result = block_reduce_t(storage).Reduce(value, op);
+    __syncthreads();  // storage is reused by the next vertex.
+    return result;
+  }
+};
+
+/**
+ * @brief One group of threads (see `group_size`) per input vertex (the groups
+ * stride over the input, or over the vertices [first, first + input_size) of
+ * the graph). The threads of a group map consecutive neighbors,
+ * so the neighbor list is read coalesced and the degree of a vertex is
+ * divided by the size of the group. All the threads of a group take the same
+ * trips through the loop, as the cooperative reductions require.
+ */
+template <int THREADS_PER_BLOCK,
+          load_balance_t lb,
+          advance_io_type_t input_type,
+          typename graph_t,
+          typename vertex_t,
+          typename type_t,
+          typename map_t,
+          typename reduce_t,
+          typename epilogue_t>
+__global__ void __launch_bounds__(THREADS_PER_BLOCK)
+    neighbors_reduce_kernel(graph_t const G,
+                            vertex_t const* input,
+                            std::size_t first,
+                            std::size_t input_size,
+                            map_t map,
+                            reduce_t reduce,
+                            type_t init,
+                            epilogue_t epilogue) {
+  constexpr int GROUP_SIZE = group_size<lb, THREADS_PER_BLOCK>();
+  using group_reduce_type = group_reduce_t<lb, THREADS_PER_BLOCK, type_t>;
+  __shared__ typename group_reduce_type::storage_t storage;
+
+  // 64-bit, a grid of one lane per edge exceeds `int` on large graphs.
+  std::size_t global_idx =
+      (std::size_t)blockIdx.x * blockDim.x + threadIdx.x;
+  int rank = threadIdx.x % GROUP_SIZE;
+  std::size_t group = global_idx / GROUP_SIZE;
+  std::size_t num_groups =
+      ((std::size_t)gridDim.x * blockDim.x) / GROUP_SIZE;
+
+  for (std::size_t idx = group; idx < input_size; idx += num_groups) {
+    vertex_t v = (input_type == advance_io_type_t::graph)
+                     ? vertex_t(first + idx)
+                     : input[idx];
+    if (!gunrock::util::limits::is_valid(v))
+      continue;
+
+    auto starting_edge = G.get_starting_edge(v);
+    auto total_edges = G.get_number_of_neighbors(v);
+
+    type_t partial = init;
+    for (auto i = rank; i < total_edges; i += GROUP_SIZE) {
+      auto e = i + starting_edge;            // edge id
+      auto n = G.get_destination_vertex(e);  // neighbor id
+      auto w = G.get_edge_weight(e);         // weight
+      partial = reduce(partial, map(v, n, e, w));
+    }
+
+    type_t result = group_reduce_type::reduce(storage, partial, reduce);
+    if (rank == 0)
+      epilogue(v, result);
+  }
+}
+
+/**
+ * @brief Launch `neighbors_reduce_kernel` over `size` input vertices.
+ */
+template <load_balance_t lb,
+          advance_io_type_t input_type,
+          typename graph_t,
+          typename vertex_t,
+          typename map_t,
+          typename reduce_t,
+          typename type_t,
+          typename epilogue_t>
+void launch(graph_t& G,
+            vertex_t const* input,
+            std::size_t first,
+            std::size_t size,
+            map_t map,
+            reduce_t reduce,
+            type_t init,
+            epilogue_t epilogue,
+            cuda::standard_context_t& context) {
+  using launch_box_t =
+      launch::launch_box_for_t<launch::kernel_t::neighbors_reduce>;
+  constexpr int block_size = launch_box_t::block_size;
+
+  static_assert(lb == load_balance_t::thread_mapped ||
+                    lb == load_balance_t::warp_mapped ||
+                    lb == load_balance_t::block_mapped,
+                "Unsupported load-balancing for neighbors reduce.");
+  static_assert(block_size % cuda::properties::warp_max_threads() == 0,
+                "Block size must be a multiple of the warp size.");
+
+  if (size == 0)
+    return;
+
+  auto kernel = neighbors_reduce_kernel<block_size, lb, input_type, graph_t,
+                                        vertex_t, type_t, map_t, reduce_t,
+                                        epilogue_t>;
+
+  // A few waves of resident blocks, the groups stride over the rest of the
+  // input.
+  int blocks_per_sm = 0;
+  error::throw_if_exception(cudaOccupancyMaxActiveBlocksPerMultiprocessor(
+      &blocks_per_sm, kernel, block_size, 0));
+  std::size_t max_grid_size =
+      4 * (std::size_t)context.props().multiProcessorCount *
+      std::max(blocks_per_sm, 1);
+
+  constexpr int groups_per_block = block_size / group_size<lb, block_size>();
+  std::size_t grid_size = (size + groups_per_block - 1) / groups_per_block;
+  grid_size = std::min(grid_size, max_grid_size);
+
+  kernel<<<grid_size, block_size, 0, context.stream()>>>(
+      G, input, first, size, map, reduce, init, epilogue);
+  error::throw_if_exception(cudaPeekAtLastError(),
+                            "Neighbors reduce launch failed.");
+}
+
+}  // namespace detail
+
+/**
+ * @brief Reduce the neighbors of every vertex of the input frontier (or of the
+ * graph): `epilogue(v, init + map(v, n0, e0, w0) + ... + map(v, nk, ek, wk))`
+ * with `+` the `reduce` operator, over the `k + 1` neighbors of `v`.
+ *
+ * @par Overview
+ * Replaces the per-vertex sequential loops over the neighbors (e.g. in a
+ * filter or a parallel_for), which serialize a hub on one thread and scatter
+ * the reads of a warp. `warp_mapped` shares the neighbors of a vertex among
+ * the lanes of a warp, `block_mapped` among the threads of a block (for
+ * graphs of very high degree), `thread_mapped` is the sequential loop; the
+ * partial values are combined with warp (or block) reductions. The order in
+ * which `reduce` combines the values is unspecified, it must be associative
+ * and commutative, and `init` must be its identity (every thread of a group
+ * starts from it). `epilogue` is called exactly once per valid input vertex.
+ *
+ * @par Example
+ *  \code
+ *  // Number of neighbors with a larger id.
+ *  operators::neighbors_reduce::execute<operators::load_balance_t::warp_mapped,
+ *                                       operators::advance_io_type_t::graph>(
+ *      G, (frontier_t*)nullptr,
+ *      [] __device__(vertex_t const& v, vertex_t const& n, edge_t const& e,
+ *                    weight_t const& w) -> int { return n > v; },
+ *      [] __device__(int const& a, int const& b) { return a + b; }, 0,
+ *      [=] __device__(vertex_t const& v, int const& count) {
+ *        counts[v] = count;
+ *      },
+ *      context);
+ *  \endcode
+ *
+ * @tparam lb `thread_mapped`, `warp_mapped` or `block_mapped`.
+ * @tparam input_type `vertices` (input frontier) or `graph` (all the vertices,
+ * the input frontier is ignored and can be `nullptr`).
+ * @param G input graph.
+ * @param input input frontier, may contain invalid vertices (skipped).
+ * @param map `(source, neighbor, edge, weight) -> type_t`.
+ * @param reduce `(type_t, type_t) -> type_t`, associative and commutative.
+ * @param init identity of `reduce`, the result of a vertex without neighbors.
+ * @param epilogue `(vertex, type_t result) -> void`.
+ * @param context `cuda::standard_context_t`.
+ */
+template <load_balance_t lb = load_balance_t::warp_mapped,
+          advance_io_type_t input_type = advance_io_type_t::vertices,
+          typename graph_t,
+          typename frontier_t,
+          typename map_t,
+          typename reduce_t,
+          typename type_t,
+          typename epilogue_t>
+void execute(graph_t& G,
+             frontier_t* input,
+             map_t map,
+             reduce_t reduce,
+             type_t init,
+             epilogue_t epilogue,
+             cuda::standard_context_t& context) {
+  using vertex_t = typename graph_t::vertex_type;
+  constexpr bool graph_as_frontier = (input_type == advance_io_type_t::graph);
+  static_assert(graph_as_frontier || input_type == advance_io_type_t::vertices,
+                "Neighbors reduce takes a vertex frontier or the graph.");
+
+  std::size_t work_size = graph_as_frontier ? G.get_number_of_vertices()
+                                            : input->get_number_of_elements();
+  profiler::operator_scope_t scope("neighbors_reduce", work_size, context);
+
+  vertex_t const* vertices = graph_as_frontier ? nullptr : input->data();
+  detail::launch<lb, input_type>(G, vertices, 0, work_size, map, reduce, init,
+                                 epilogue, context);
+}
+
+/**
+ * @brief Neighbors reduce on a `cuda::multi_context_t`. With more than one
+ * GPU in the context, the vertices of the graph (`input_type == graph`) are
+ * split in contiguous ranges, one per GPU (those of `graph::partition_t`),
+ * and the GPUs run concurrently; `map` and `epilogue` must then only touch
+ * memory accessible by all of them. Input frontiers require a single GPU.
+ * @see execute() above for the parameters.
+ */
+template <load_balance_t lb = load_balance_t::warp_mapped,
+          advance_io_type_t input_type = advance_io_type_t::vertices,
+          typename graph_t,
+          typename frontier_t,
+          typename map_t,
+          typename reduce_t,
+          typename type_t,
+          typename epilogue_t>
+void execute(graph_t& G,
+             frontier_t* input,
+             map_t map,
+             reduce_t reduce,
+             type_t init,
+             epilogue_t epilogue,
+             cuda::multi_context_t& context) {
+  using vertex_t = typename graph_t::vertex_type;
+
+  if (context.size() == 1) {
+    execute<lb, input_type>(G, input, map, reduce, init, epilogue,
+                            *(context.get_context(0)));
+    return;
+  }
+
+  if constexpr (input_type != advance_io_type_t::graph) {
+    error::throw_if_exception(cudaErrorUnknown,
+                              "Neighbors reduce of a frontier on more than "
+                              "one GPU is not supported.");
+  } else {
+    int k = context.size();
+    graph::partition_t<vertex_t> ranges(G.get_number_of_vertices(), k);
+    std::vector<std::thread> threads;
+    for (int d = 0; d < k; ++d) {
+      threads.emplace_back([&, d]() {
+        auto device_context = context.get_context(d);
+        cudaSetDevice(device_context->ordinal());
+        detail::launch<lb, input_type>(
+            G, (vertex_t const*)nullptr, ranges.begin(d),
+            ranges.end(d) - ranges.begin(d), map, reduce, init, epilogue,
+            *device_context);
+        cudaStreamSynchronize(device_context->stream());
+      });
+    }
+    for (auto& thread : threads)
+      thread.join();
+  }
+}
+
+}  // namespace neighbors_reduce
+}  // namespace operators
+}  // namespace gunrock
@@ -19,6 +19,11 @@ namespace operators {}  // namespace operators
 
 #include <gunrock/framework/operators/advance/advance.hxx>
 #include <gunrock/framework/operators/filter/filter.hxx>
+#include <gunrock/framework/operators/advance_filter/advance_filter.hxx>
+#include <gunrock/framework/operators/advance_filter/step.hxx>
 #include <gunrock/framework/operators/for/for.hxx>
 #include <gunrock/framework/operators/uniquify/uniquify.hxx>
-#include <gunrock/framework/operators/batch/batch.hxx>
\ No newline at end of file
+#include <gunrock/framework/operators/batch/batch.hxx>
+#include <gunrock/framework/operators/batch/multi_source.hxx>
+#include <gunrock/framework/operators/spmv/spmv.hxx>
+#include <gunrock/framework/operators/neighbors_reduce/neighbors_reduce.hxx>
\ No newline at end of file
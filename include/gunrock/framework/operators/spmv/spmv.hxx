@@ -0,0 +1,316 @@
+/**
+ * @file spmv.hxx
+ * @author Muhammad Osama (mosama@ucdavis.edu)
+ * @brief Merge-path load-balanced, atomic-free segmented reduction over the
+ * rows of a compressed sparse matrix (SpMV-like), with a fused per-row
+ * epilogue and a global reduction of the epilogue's results.
+ * @version 0.1
+ * @date 2021-06-10
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#pragma once
+
+#include <gunrock/error.hxx>
+#include <gunrock/cuda/context.hxx>
+#include <gunrock/memory_pool.hxx>
+#include <gunrock/framework/operators/launch.hxx>
+
+#include <thrust/reduce.h>
+
+#include <cub/block/block_scan.cuh>
+#include <cub/block/block_reduce.cuh>
+
+namespace gunrock {
+namespace operators {
+namespace spmv {
+
+namespace detail {
+
+/**
+ * @brief Partial sum of a row that is split between threads (or blocks).
+ * `open` marks a run of partial sums that started before the block, i.e. the
+ * row can only be completed once the preceding blocks are known.
+ */
+template <typename offset_t, typename value_t>
+struct carry_t {
+  offset_t row;
+  value_t value;
+  bool open;
+};
+
+/**
+ * @brief Segmented (by row) sum of the carries, associative because the
+ * carry rows are non-decreasing.
+ */
+struct carry_op_t {
+  template <typename carry_type>
+  __device__ __forceinline__ carry_type operator()(carry_type const& a,
+                                                   carry_type const& b) const {
+    return (a.row == b.row) ? carry_type{b.row, a.value + b.value, a.open} : b;
+  }
+};
+
+/**
+ * @brief Find the (row, nonzero) coordinate of a diagonal of the merge grid
+ * of the row end offsets and the nonzero indices.
+ */
+template <typename offset_t>
+__device__ __forceinline__ void merge_path_search(offset_t diagonal,
+                                                  offset_t const* row_ends,
+                                                  offset_t rows,
+                                                  offset_t nonzeros,
+                                                  offset_t& row,
+                                                  offset_t& nonzero) {
+  offset_t x_min = (diagonal > nonzeros) ? diagonal - nonzeros : 0;
+  offset_t x_max = (diagonal < rows) ? diagonal : rows;
+  while (x_min < x_max) {
+    offset_t pivot = (x_min + x_max) >> 1;
+    if (row_ends[pivot] <= diagonal - pivot - 1)
+      x_min = pivot + 1;
+    else
+      x_max = pivot;
+  }
+  row = x_min;
+  nonzero = diagonal - x_min;
+}
+
+/**
+ * @brief Every thread consumes `items` steps of the merge path, a step either
+ * accumulates a nonzero or completes a row. Rows completed within a block are
+ * passed to the epilogue right away, only the row continued from the previous
+ * block (at most one per block) is deferred to the fix-up kernel.
+ */
+template <int threads,
+          int items,
+          typename offset_t,
+          typename value_t,
+          typename transform_t,
+          typename epilogue_t,
+          typename reduction_t,
+          typename reduce_op_t>
+__global__ void __launch_bounds__(threads)
+    reduce_rows(offset_t const* offsets,
+                offset_t rows,
+                offset_t nonzeros,
+                transform_t transform,
+                epilogue_t epilogue,
+                reduction_t identity,
+                reduce_op_t reduce,
+                carry_t<offset_t, value_t>* heads,
+                carry_t<offset_t, value_t>* carries,
+                reduction_t* reductions) {
+  using carry_type = carry_t<offset_t, value_t>;
+  using block_scan_t = cub::BlockScan<carry_type, threads>;
+  using block_reduce_t = cub::BlockReduce<reduction_t, threads>;
+
+  __shared__ union {
+    typename block_scan_t::TempStorage scan;
+    typename block_reduce_t::TempStorage reduce;
+  } storage;
+
+  if (threadIdx.x == 0)
+    heads[blockIdx.x] = carry_type{rows, value_t(0), false};
+
+  offset_t total = rows + nonzeros;
+  offset_t begin = (offset_t)blockIdx.x * (threads * items) +
+                   (offset_t)threadIdx.x * items;
+  begin = (begin < total) ? begin : total;
+  offset_t end = (begin + items < total) ? begin + items : total;
+
+  offset_t row, nonzero;
+  merge_path_search(begin, offsets + 1, rows, nonzeros, row, nonzero);
+
+  // Did the first row start in a previous thread?
+  bool continued = (row < rows) && (nonzero > offsets[row]);
+
+  reduction_t local = identity;
+  value_t sum = value_t(0);
+  offset_t first_row = rows;
+  value_t first_value = value_t(0);
+  bool completed = false;
+
+  offset_t row_end = (row < rows) ? offsets[row + 1] : nonzeros;
+  for (offset_t step = begin; step < end; ++step) {
+    if (nonzero < row_end) {
+      sum += transform(nonzero);
+      ++nonzero;
+    } else {
+      if (!completed && continued) {
+        first_row = row;
+        first_value = sum;
+      } else {
+        local = reduce(local, epilogue(row, sum));
+      }
+      completed = true;
+      sum = value_t(0);
+      ++row;
+      row_end = (row < rows) ? offsets[row + 1] : nonzeros;
+    }
+  }
+
+  // Carry out the partial sum of the unfinished row; a run can only be open
+  // if it reaches back to the start of the block.
+  carry_type carry{row, sum, (threadIdx.x == 0) && continued && !completed};
+  carry_type prefix, aggregate;
+  block_scan_t(storage.scan).ExclusiveScan(carry, prefix, carry_op_t(),
+                                           aggregate);
+
+  if (first_row < rows) {
+    value_t value = first_value;
+    bool open = (threadIdx.x == 0);
+    if (threadIdx.x > 0) {
+      open = (prefix.row == first_row) && prefix.open;
+      if (prefix.row == first_row)
+        value += prefix.value;
+    }
+
+    if (open)
+      heads[blockIdx.x] = carry_type{first_row, value, true};
+    else
+      local = reduce(local, epilogue(first_row, value));
+  }
+
+  if (threadIdx.x == 0)
+    carries[blockIdx.x] = aggregate;
+
+  __syncthreads();
+  reduction_t block_total =
+      block_reduce_t(storage.reduce).Reduce(local, reduce);
+  if (threadIdx.x == 0)
+    reductions[blockIdx.x] = block_total;
+}
+
+/**
+ * @brief Complete the rows deferred by `reduce_rows`, adding the carries of
+ * the preceding blocks (in order, so the result is deterministic).
+ */
+template <typename offset_t,
+          typename value_t,
+          typename epilogue_t,
+          typename reduction_t>
+__global__ void fix_up(int blocks,
+                       epilogue_t epilogue,
+                       reduction_t identity,
+                       carry_t<offset_t, value_t> const* heads,
+                       carry_t<offset_t, value_t> const* carries,
+                       reduction_t* reductions) {
+  int block = blockIdx.x * blockDim.x + threadIdx.x;
+  if (block >= blocks)
+    return;
+
+  reduction_t result = identity;
+  auto head = heads[block];
+  if (head.open) {
+    value_t value = head.value;
+    for (int previous = block - 1; previous >= 0; --previous) {
+      auto carry = carries[previous];
+      if (carry.row != head.row)
+        break;
+      value += carry.value;
+      if (!carry.open)
+        break;
+    }
+    result = epilogue(head.row, value);
+  }
+  reductions[block] = result;
+}
+
+}  // namespace detail
+
+/**
+ * @brief Reduce every row of a compressed sparse matrix, `sum(row) =
+ * transform(offsets[row]) + ... + transform(offsets[row + 1] - 1)`, and hand
+ * each sum to the epilogue, `epilogue(row, sum)`, whose results are reduced
+ * with `reduce`.
+ *
+ * @par Overview
+ * The work is balanced with a merge path over the row ends and the nonzeros
+ * (every thread gets the same number of rows + nonzeros, independently of the
+ * degree distribution). Rows split between threads are combined with a block
+ * scan, rows split between blocks by a small fix-up kernel; no atomics are
+ * used, so the results are deterministic. Use it with a CSC view (offsets =
+ * column offsets) to pull over the in-neighbors of every vertex.
+ *
+ * @par Example
+ *  \code
+ *  // y = A * x, and the sum of y.
+ *  auto total = operators::spmv::execute(
+ *      offsets, n, nnz,
+ *      [=] __device__(edge_t const& e) { return values[e] * x[indices[e]]; },
+ *      [=] __device__(edge_t const& row, float const& sum) {
+ *        y[row] = sum;
+ *        return sum;
+ *      },
+ *      0.0f,
+ *      [] __device__(float const& a, float const& b) { return a + b; },
+ *      context);
+ *  \endcode
+ *
+ * @tparam offset_t offset type, `rows + nonzeros` must fit in it.
+ * @param offsets offsets (rows + 1 entries, device), `offsets[0] == 0`.
+ * @param rows number of rows.
+ * @param nonzeros number of nonzeros.
+ * @param transform `(nonzero) -> value_t`, value of a nonzero.
+ * @param epilogue `(row, value_t sum) -> reduction_t`, called exactly once per
+ * row.
+ * @param identity identity of `reduce`.
+ * @param reduce `(reduction_t, reduction_t) -> reduction_t`, associative.
+ * @param context `cuda::standard_context_t`.
+ * @return reduction_t reduction of the epilogue's results.
+ */
+template <typename offset_t,
+          typename transform_t,
+          typename epilogue_t,
+          typename reduction_t,
+          typename reduce_op_t>
+reduction_t execute(offset_t const* offsets,
+                    offset_t rows,
+                    offset_t nonzeros,
+                    transform_t transform,
+                    epilogue_t epilogue,
+                    reduction_t identity,
+                    reduce_op_t reduce,
+                    cuda::standard_context_t& context) {
+  using value_t = std::decay_t<decltype(transform(offset_t(0)))>;
+  using carry_type = detail::carry_t<offset_t, value_t>;
+
+  using launch_box_t = launch::launch_box_for_t<launch::kernel_t::spmv>;
+  constexpr int threads = launch_box_t::block_size;
+  constexpr int items = launch_box_t::items_per_thread;
+
+  if (rows == 0)
+    return identity;
+
+  std::size_t total = (std::size_t)rows + (std::size_t)nonzeros;
+  int blocks = (int)((total + threads * items - 1) / (threads * items));
+
+  auto pool = context.pool();
+  auto stream = context.stream();
+  auto heads = static_cast<carry_type*>(
+      pool->allocate(2 * blocks * sizeof(carry_type)));
+  auto carries = heads + blocks;
+  auto reductions = static_cast<reduction_t*>(
+      pool->allocate(2 * blocks * sizeof(reduction_t)));
+
+  detail::reduce_rows<threads, items><<<blocks, threads, 0, stream>>>(
+      offsets, rows, nonzeros, transform, epilogue, identity, reduce, heads,
+      carries, reductions);
+  detail::fix_up<<<(blocks + threads - 1) / threads, threads, 0, stream>>>(
+      blocks, epilogue, identity, heads, carries, reductions + blocks);
+  error::throw_if_exception(cudaPeekAtLastError(), "SpMV launch failed.");
+
+  reduction_t result =
+      thrust::reduce(context.execution_policy(), reductions,
+                     reductions + 2 * blocks, identity, reduce);
+
+  pool->deallocate(heads, 2 * blocks * sizeof(carry_type));
+  pool->deallocate(reductions, 2 * blocks * sizeof(reduction_t));
+  return result;
+}
+
+}  // namespace spmv
+}  // namespace operators
+}  // namespace gunrock
@@ -0,0 +1,91 @@
+/**
+ * @file bitmap.hxx
+ * @author Muhammad Osama (mosama@ucdavis.edu)
+ * @brief Exact, sort-free uniquify with a visited bitmap over the ids.
+ * @version 0.1
+ * @date 2021-06-12
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#pragma once
+
+#include <gunrock/error.hxx>
+#include <gunrock/util/math.hxx>
+#include <gunrock/util/type_limits.hxx>
+#include <gunrock/cuda/context.hxx>
+#include <gunrock/framework/operators/configs.hxx>
+
+#include <thrust/remove.h>
+#include <thrust/transform.h>
+#include <thrust/transform_reduce.h>
+#include <thrust/functional.h>
+
+namespace gunrock {
+namespace operators {
+namespace uniquify {
+namespace bitmap {
+
+/**
+ * @brief Keep the first occurrence of every id of the input frontier (in
+ * place, the order of the kept items is preserved). Every item test-and-sets
+ * its bit of a `number_of_ids`-bit bitmap and only the item that set it is
+ * kept, i.e. O(number_of_ids / 32 + size) work instead of a sort.
+ *
+ * @param input input (and output) frontier.
+ * @param number_of_ids ids are in `[0, number_of_ids)`, items beyond it are
+ * kept as they are; `0` finds the bound with a reduction.
+ * @param context `cuda::standard_context_t`.
+ */
+template <typename frontier_t>
+void execute(frontier_t* input,
+             std::size_t number_of_ids,
+             cuda::standard_context_t& context) {
+  using type_t = typename frontier_t::type_t;
+
+  std::size_t size = input->get_number_of_elements();
+  if (size == 0)
+    return;
+
+  auto policy = context.execution_policy();
+  if (number_of_ids == 0)
+    number_of_ids = thrust::transform_reduce(
+        policy, input->begin(), input->end(),
+        [] __device__(type_t const& v) -> std::size_t {
+          return gunrock::util::limits::is_valid(v) ? std::size_t(v) + 1 : 0;
+        },
+        std::size_t(0), thrust::maximum<std::size_t>());
+
+  std::size_t words = (number_of_ids + 31) / 32;
+  auto pool = context.pool();
+  auto visited = static_cast<unsigned int*>(
+      pool->allocate(words * sizeof(unsigned int)));
+  auto kept = static_cast<char*>(pool->allocate(size * sizeof(char)));
+  cudaMemsetAsync(visited, 0, words * sizeof(unsigned int), context.stream());
+
+  thrust::transform(policy, input->begin(), input->end(), kept,
+                    [=] __device__(type_t const& v) -> char {
+                      if (!gunrock::util::limits::is_valid(v))
+                        return 0;
+                      if (std::size_t(v) >= number_of_ids)
+                        return 1;
+                      unsigned int bit = 1u << (v & 31);
+                      unsigned int old =
+                          math::atomic::bit_or(visited + (v >> 5), bit);
+                      return (old & bit) ? 0 : 1;
+                    });
+
+  auto new_end = thrust::remove_if(
+      policy, input->begin(), input->end(), kept,
+      [] __device__(char const& keep) { return keep == 0; });
+  input->set_number_of_elements(thrust::distance(input->begin(), new_end));
+
+  pool->deallocate(visited, words * sizeof(unsigned int));
+  pool->deallocate(kept, size * sizeof(char));
+}
+
+}  // namespace bitmap
+}  // namespace uniquify
+}  // namespace operators
+}  // namespace gunrock
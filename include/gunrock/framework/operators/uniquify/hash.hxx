@@ -0,0 +1,153 @@
+/**
+ * @file hash.hxx
+ * @author Muhammad Osama (mosama@ucdavis.edu)
+ * @brief Sort-free uniquify with a warp-level culling pass followed by an
+ * open-addressed hash set, whose probing is bounded by the requested
+ * uniquification percentage.
+ * @version 0.1
+ * @date 2021-06-12
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#pragma once
+
+#include <gunrock/error.hxx>
+#include <gunrock/util/math.hxx>
+#include <gunrock/util/type_limits.hxx>
+#include <gunrock/cuda/context.hxx>
+#include <gunrock/framework/operators/configs.hxx>
+#include <gunrock/framework/operators/launch.hxx>
+
+#include <thrust/fill.h>
+#include <thrust/remove.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace gunrock {
+namespace operators {
+namespace uniquify {
+namespace hash {
+
+/**
+ * @brief Flag the first occurrence of every item. The lanes of a warp holding
+ * the same item are matched first (only the lowest lane goes on), then the
+ * item is inserted in the hash set with at most `probes` linear probes; an
+ * item that finds its own id is a duplicate, one that runs out of probes is
+ * kept (possibly a duplicate).
+ */
+template <typename type_t>
+__global__ void cull(type_t const* items,
+                     std::size_t size,
+                     type_t* table,
+                     std::size_t table_mask,
+                     std::size_t probes,
+                     char* kept) {
+  constexpr unsigned int all_lanes = 0xffffffff;
+  int lane = threadIdx.x & 31;
+  std::size_t warp = (blockIdx.x * (std::size_t)blockDim.x + threadIdx.x) / 32;
+  std::size_t warps = (gridDim.x * (std::size_t)blockDim.x) / 32;
+
+  // Warp-uniform loop, every lane takes part in the match.
+  for (std::size_t base = warp * 32; base < size; base += warps * 32) {
+    std::size_t i = base + lane;
+    type_t v = gunrock::numeric_limits<type_t>::invalid();
+    if (i < size)
+      v = items[i];
+
+    unsigned int peers = __match_any_sync(all_lanes, v);
+    bool keep = gunrock::util::limits::is_valid(v) &&
+                ((__ffs(peers) - 1) == lane);
+
+    if (keep) {
+      std::size_t slot = ((std::size_t)v * 2654435761u) & table_mask;
+      for (std::size_t p = 0; p < probes; ++p) {
+        type_t old = math::atomic::cas(
+            table + slot, gunrock::numeric_limits<type_t>::invalid(), v);
+        if (!gunrock::util::limits::is_valid(old))
+          break;  // Inserted, first occurrence.
+        if (old == v) {
+          keep = false;  // Already inserted by another warp.
+          break;
+        }
+        slot = (slot + 1) & table_mask;
+      }
+    }
+
+    if (i < size)
+      kept[i] = keep ? 1 : 0;
+  }
+}
+
+/**
+ * @brief Remove the duplicates of the input frontier (in place, the order of
+ * the kept items is preserved) without sorting it.
+ *
+ * @par Overview
+ * The hash set has twice as many slots as the frontier has items. With
+ * unbounded probing (100% uniquification) the result is exact, with fewer
+ * probes the set tolerates collisions by keeping the colliding items, and the
+ * best-effort mode uses a single probe and is only guaranteed to remove the
+ * duplicates within a warp.
+ *
+ * @param input input (and output) frontier.
+ * @param context `cuda::standard_context_t`.
+ * @param uniquification_percent of the duplicates to remove (0 - 100), scales
+ * the bound on the number of probes.
+ * @param best_effort_uniquification single probe.
+ */
+template <typename frontier_t>
+void execute(frontier_t* input,
+             cuda::standard_context_t& context,
+             const float& uniquification_percent = 100,
+             bool best_effort_uniquification = false) {
+  using type_t = typename frontier_t::type_t;
+  using launch_box_t =
+      launch::launch_box_for_t<launch::kernel_t::uniquify_hash>;
+  constexpr int threads = launch_box_t::block_size;
+  constexpr std::size_t max_bounded_probes = 32;
+
+  std::size_t size = input->get_number_of_elements();
+  if (size == 0)
+    return;
+
+  std::size_t table_size = 1;
+  while (table_size < 2 * size)
+    table_size <<= 1;
+
+  std::size_t probes = table_size;
+  if (best_effort_uniquification)
+    probes = 1;
+  else if (uniquification_percent < 100)
+    probes = std::max<std::size_t>(
+        1, std::ceil(max_bounded_probes * uniquification_percent / 100));
+
+  auto pool = context.pool();
+  auto table =
+      static_cast<type_t*>(pool->allocate(table_size * sizeof(type_t)));
+  auto kept = static_cast<char*>(pool->allocate(size * sizeof(char)));
+  thrust::fill(context.execution_policy(), table, table + table_size,
+               gunrock::numeric_limits<type_t>::invalid());
+
+  std::size_t blocks = std::min<std::size_t>(
+      (size + threads - 1) / threads,
+      context.props().multiProcessorCount * 16);
+  cull<<<blocks, threads, 0, context.stream()>>>(
+      input->data(), size, table, table_size - 1, probes, kept);
+  error::throw_if_exception(cudaPeekAtLastError(), "Uniquify launch failed.");
+
+  auto new_end = thrust::remove_if(
+      context.execution_policy(), input->begin(), input->end(), kept,
+      [] __device__(char const& keep) { return keep == 0; });
+  input->set_number_of_elements(thrust::distance(input->begin(), new_end));
+
+  pool->deallocate(table, table_size * sizeof(type_t));
+  pool->deallocate(kept, size * sizeof(char));
+}
+
+}  // namespace hash
+}  // namespace uniquify
+}  // namespace operators
+}  // namespace gunrock
@@ -34,7 +34,7 @@ void execute(frontier_t* input,
       output->begin()                          // output iterator: begin
   );
 
-  auto new_size = thrust::distance(input->begin(), new_end);
+  auto new_size = thrust::distance(output->begin(), new_end);
   output->set_number_of_elements(new_size);
 }
 
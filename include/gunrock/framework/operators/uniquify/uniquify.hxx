@@ -1,43 +1,99 @@
 #pragma once
 
 #include <gunrock/cuda/context.hxx>
+#include <gunrock/framework/profiler.hxx>
 #include <gunrock/framework/operators/configs.hxx>
 #include <gunrock/util/type_limits.hxx>
 #include <gunrock/util/type_traits.hxx>
 
 #include <gunrock/framework/operators/uniquify/unique.hxx>
 #include <gunrock/framework/operators/uniquify/unique_copy.hxx>
+#include <gunrock/framework/operators/uniquify/bitmap.hxx>
+#include <gunrock/framework/operators/uniquify/hash.hxx>
 
 namespace gunrock {
 namespace operators {
 namespace uniquify {
 
+/**
+ * @brief Remove the duplicates of the input frontier. `unique_copy` writes
+ * them to the output frontier, every other algorithm works in place.
+ *
+ * @par Overview
+ * Exact uniquification (100% and not best-effort) sorts the frontier for
+ * `unique` and `unique_copy`; otherwise they, and `hash`, cull the duplicates
+ * with the sort-free hash set of `hash::execute()`, whose probing is bounded
+ * by the percentage. `bitmap` is always exact and never sorts.
+ *
+ * @param input input frontier.
+ * @param output output frontier (`unique_copy` only).
+ * @param context `cuda::standard_context_t`.
+ * @param uniquification_percent of the duplicates to remove (0 - 100).
+ * @param best_effort_uniquification cheapest culling, no guarantee.
+ * @param number_of_ids ids are in `[0, number_of_ids)` (`bitmap` only, `0`
+ * finds the bound).
+ */
 template <uniquify_algorithm_t type, typename frontier_t>
 void execute(frontier_t* input,
              frontier_t* output,
-             cuda::multi_context_t& context,
+             cuda::standard_context_t& context,
              const float& uniquification_percent = 100,
-             bool best_effort_uniquification = false) {
-  if (context.size() == 1) {
-    auto single_context = context.get_context(0);
-
+             bool best_effort_uniquification = false,
+             std::size_t number_of_ids = 0) {
+  // Dense (bitmap/boolmap) frontiers are duplicate-free by construction, skip
+  // the sort and unique steps entirely (`unique_copy` still copies).
+  if constexpr (frontier_t::is_dense) {
+    if (type == uniquify_algorithm_t::unique_copy)
+      output->assign(*input, context.stream());
+  } else {
+    profiler::operator_scope_t scope("uniquify", input, context);
+    bool exact = !best_effort_uniquification && (uniquification_percent == 100);
     if (type == uniquify_algorithm_t::unique) {
-      if (!best_effort_uniquification && (uniquification_percent == 100))
-        input->sort(sort::order_t::ascending, single_context->stream());
-      unique::execute(input, output, *single_context);
+      if (exact) {
+        input->sort(sort::order_t::ascending, context.stream());
+        unique::execute(input, output, context);
+      } else {
+        hash::execute(input, context, uniquification_percent,
+                      best_effort_uniquification);
+      }
     } else if (type == uniquify_algorithm_t::unique_copy) {
-      if (!best_effort_uniquification && (uniquification_percent == 100))
-        input->sort(sort::order_t::ascending, single_context->stream());
-      unique_copy::execute(input, output, *single_context);
+      if (exact)
+        input->sort(sort::order_t::ascending, context.stream());
+      else
+        hash::execute(input, context, uniquification_percent,
+                      best_effort_uniquification);
+      unique_copy::execute(input, output, context);
+    } else if (type == uniquify_algorithm_t::bitmap) {
+      bitmap::execute(input, number_of_ids, context);
+    } else if (type == uniquify_algorithm_t::hash) {
+      hash::execute(input, context, uniquification_percent,
+                    best_effort_uniquification);
     } else {
       error::throw_if_exception(cudaErrorUnknown, "Unqiue type not supported.");
     }
+    scope.set_output((type == uniquify_algorithm_t::unique_copy) ? output
+                                                                 : input);
+  }
+}
+
+template <uniquify_algorithm_t type, typename frontier_t>
+void execute(frontier_t* input,
+             frontier_t* output,
+             cuda::multi_context_t& context,
+             const float& uniquification_percent = 100,
+             bool best_effort_uniquification = false,
+             std::size_t number_of_ids = 0) {
+  if (context.size() == 1) {
+    execute<type>(input, output, *(context.get_context(0)),
+                  uniquification_percent, best_effort_uniquification,
+                  number_of_ids);
   }
 
-  // Multi-GPU not supported.
+  // Multi-GPU requires the enactor interface.
   else {
     error::throw_if_exception(cudaErrorUnknown,
-                              "`context.size() != 1` not supported");
+                              "`context.size() != 1` requires the enactor "
+                              "interface, see `multi_gpu::state_t`.");
   }
 }
 
@@ -47,27 +103,62 @@ void execute(enactor_type* E,
              const float& uniquification_percent = 100,
              bool best_effort_uniquification = false,
              bool swap_buffers = true) {
-  if (!best_effort_uniquification)
-    if (uniquification_percent < 0 || uniquification_percent > 100)
-      error::throw_if_exception(
-          cudaErrorUnknown,
-          "Uniquification percentage must be a +ve float between 0 and 100.");
+  // Dense frontiers need no uniquification, the input is copied to the
+  // output (O(n / 32) words for a bitmap) such that the buffers swap as
+  // for the other frontiers.
+  using frontier_t = std::remove_pointer_t<decltype(E->get_input_frontier())>;
+  if constexpr (frontier_t::is_dense) {
+    E->get_output_frontier()->assign(*(E->get_input_frontier()),
+                                     context.get_context(0)->stream());
+    if (swap_buffers)
+      E->swap_frontier_buffers();
+  } else {
+    if (!best_effort_uniquification)
+      if (uniquification_percent < 0 || uniquification_percent > 100)
+        error::throw_if_exception(
+            cudaErrorUnknown,
+            "Uniquification percentage must be a +ve float between 0 and 100.");
+
+    // Frontiers of vertices (ids beyond the bound are kept by `bitmap`).
+    auto& G = E->get_problem()->get_graph();
+    std::size_t number_of_ids = G.get_number_of_vertices();
 
-  execute<type>(E->get_input_frontier(),    // input frontier
-                E->get_output_frontier(),   // output frontier
-                context,                    // context
-                uniquification_percent,     // percentage in float
-                best_effort_uniquification  // best effort attempt
-  );
+    if (context.size() > 1) {
+      // Each GPU only holds (and uniquifies) the vertices it owns.
+      auto& state = E->multi_gpu_state;
+      state.init(G, context);
+      int in = state.acquire(E->get_input_frontier(), context);
+      int out = in ^ 1;
 
-  /*!
-   * @note if the Enactor interface is used, we, the library writers assume
-   * control of the frontiers and swap the input/output buffers as needed,
-   * meaning; Swap frontier buffers, output buffer now becomes the input buffer
-   * and vice-versa. This can be overridden by `swap_buffers`.
-   */
-  if (swap_buffers)
-    E->swap_frontier_buffers();
+      state.for_each_device(context, [&](int d, auto& slice,
+                                         auto& local_context) {
+        execute<type>(&(slice.frontiers[in]), &(slice.frontiers[out]),
+                      local_context, uniquification_percent,
+                      best_effort_uniquification, number_of_ids);
+      });
+
+      // Only `unique_copy` writes to the output slot.
+      int result = (type == uniquify_algorithm_t::unique_copy) ? out : in;
+      state.gather(result, E->get_output_frontier(), context);
+    } else {
+      execute<type>(E->get_input_frontier(),     // input frontier
+                    E->get_output_frontier(),    // output frontier
+                    context,                     // context
+                    uniquification_percent,      // percentage in float
+                    best_effort_uniquification,  // best effort attempt
+                    number_of_ids                // bound on the ids
+      );
+    }
+
+    /*!
+     * @note if the Enactor interface is used, we, the library writers assume
+     * control of the frontiers and swap the input/output buffers as needed,
+     * meaning; Swap frontier buffers, output buffer now becomes the input
+     * buffer and vice-versa. This can be overridden by `swap_buffers`.
+     */
+    if (swap_buffers)
+      E->swap_frontier_buffers();
+  }
 }
 
 }  // namespace uniquify
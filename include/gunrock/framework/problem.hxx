@@ -12,6 +12,7 @@
 #pragma once
 
 #include <gunrock/graph/graph.hxx>
+#include <gunrock/container/vertex_array.hxx>
 
 namespace gunrock {
 /**
@@ -28,6 +29,7 @@ namespace gunrock {
  */
 template <typename graph_t>
 struct problem_t {
+  using graph_type = graph_t;
   using vertex_t = typename graph_t::vertex_type;
   using edge_t = typename graph_t::edge_type;
   using weight_t = typename graph_t::weight_type;
@@ -46,9 +48,28 @@ struct problem_t {
     return context->get_context(device);
   }
 
+  /**
+   * @brief Vertices per partition of the multi-GPU operators, aligned to the
+   * stripes of the problem's `vertex_array_t`s (set on the enactor's
+   * multi-GPU state at construction), `0` on a single GPU.
+   */
+  std::size_t get_vertices_per_partition() {
+    if (!context)
+      return 0;
+    return vertex_array_t<vertex_t>::get_vertices_per_partition(
+        graph_slice.get_number_of_vertices(), *context);
+  }
+
   virtual void init() = 0;
   virtual void reset() = 0;
 
+  /**
+   * @brief Runs once the enactor converged (at the end of
+   * `enactor_t::enact()`), e.g., to copy the results staged in (striped)
+   * vertex arrays to the user's outputs.
+   */
+  virtual void finalize() {}
+
   /*! Disable copy ctor and assignment operator. We do not want to let user copy
    * only a slice. Explanation:
    * https://www.geeksforgeeks.org/preventing-object-copy-in-cpp-3-different-ways/
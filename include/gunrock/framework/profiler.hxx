@@ -0,0 +1,467 @@
+/**
+ * @file profiler.hxx
+ * @author Muhammad Osama (mosama@ucdavis.edu)
+ * @brief Pluggable instrumentation of the enactor's iterations and of the
+ * operators (frontier sizes, edges traversed, CUDA event timings on the
+ * context's stream, optional NVTX ranges and allocator growth).
+ * @version 0.1
+ * @date 2021-06-13
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#pragma once
+
+#include <cstring>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gunrock/error.hxx>
+#include <gunrock/cuda/context.hxx>
+#include <gunrock/util/type_limits.hxx>
+
+#include <thrust/functional.h>
+#include <thrust/transform_reduce.h>
+
+#ifdef ESSENTIALS_NVTX
+#include <nvtx3/nvToolsExt.h>
+#endif
+
+namespace gunrock {
+namespace profiler {
+
+/**
+ * @brief Instrumentation interface, inherit it for a custom sink. The enactor
+ * calls the iteration callbacks around every `loop()`, and the operators call
+ * the operator callbacks around their execution, on the calling thread's
+ * active hook (see `scoped_hook_t`).
+ *
+ * @note Frontier sizes are read on the host to be reported, which
+ * synchronizes the sizes that live on the device; only pay for it when a hook
+ * is active.
+ */
+class hook_t {
+ public:
+  virtual ~hook_t() = default;
+
+  virtual void begin_iteration(int iteration,
+                               std::size_t input_size,
+                               cuda::standard_context_t& context) {}
+  virtual void end_iteration(int iteration,
+                             std::size_t output_size,
+                             cuda::standard_context_t& context) {}
+  virtual void begin_operator(char const* name,
+                              std::size_t input_size,
+                              cuda::standard_context_t& context) {}
+  virtual void end_operator(char const* name,
+                            std::size_t output_size,
+                            std::size_t edges,
+                            cuda::standard_context_t& context) {}
+
+  /**
+   * @brief Called once the enactor is done (e.g., to resolve the timings).
+   */
+  virtual void finish(cuda::standard_context_t& context) {}
+};  // class hook_t
+
+namespace detail {
+inline hook_t*& active() {
+  thread_local hook_t* hook = nullptr;
+  return hook;
+}
+
+inline std::vector<char const*>& open_operators() {
+  thread_local std::vector<char const*> names;
+  return names;
+}
+}  // namespace detail
+
+/**
+ * @brief Hook of the calling thread, `nullptr` if none is active.
+ */
+inline hook_t* get_active() {
+  return detail::active();
+}
+
+/**
+ * @brief Make `hook` the active hook of the calling thread, as long as the
+ * guard is alive (`enactor_t::enact()` does it for its properties' hook).
+ */
+class scoped_hook_t {
+ public:
+  scoped_hook_t(hook_t* hook) : previous(detail::active()) {
+    detail::active() = hook;
+  }
+  ~scoped_hook_t() { detail::active() = previous; }
+
+  scoped_hook_t(const scoped_hook_t& rhs) = delete;
+  scoped_hook_t& operator=(const scoped_hook_t& rhs) = delete;
+
+ private:
+  hook_t* previous;
+};  // class scoped_hook_t
+
+/**
+ * @brief Reports an operator to the active hook for the lifetime of the
+ * scope. An operator nested in an operator of the same name (e.g. an
+ * `automatic` advance dispatching to the selected advance) is not reported
+ * again.
+ */
+class operator_scope_t {
+ public:
+  operator_scope_t(char const* _name,
+                   std::size_t input_size,
+                   cuda::standard_context_t& _context)
+      : operator_scope_t(_name, _context) {
+    if (hook)
+      hook->begin_operator(name, input_size, context);
+  }
+
+  template <typename frontier_t>
+  operator_scope_t(char const* _name,
+                   frontier_t* input,
+                   cuda::standard_context_t& _context)
+      : operator_scope_t(_name, _context) {
+    if (hook)
+      hook->begin_operator(name, input ? input->get_number_of_elements() : 0,
+                           context);
+  }
+
+  ~operator_scope_t() {
+    if (hook) {
+      hook->end_operator(name, output_size, edges, context);
+      detail::open_operators().pop_back();
+    }
+  }
+
+  operator_scope_t(const operator_scope_t& rhs) = delete;
+  operator_scope_t& operator=(const operator_scope_t& rhs) = delete;
+
+  bool is_active() const { return hook != nullptr; }
+
+  template <typename frontier_t>
+  void set_output(frontier_t* output) {
+    if (hook && output)
+      output_size = output->get_number_of_elements();
+  }
+
+  void set_output_size(std::size_t size) { output_size = size; }
+  void set_edges(std::size_t _edges) { edges = _edges; }
+
+ private:
+  operator_scope_t(char const* _name, cuda::standard_context_t& _context)
+      : name(_name),
+        context(_context),
+        hook(get_active()),
+        output_size(0),
+        edges(0) {
+    auto& open = detail::open_operators();
+    if (hook && !open.empty() && std::strcmp(open.back(), name) == 0)
+      hook = nullptr;
+    if (hook)
+      open.push_back(name);
+  }
+
+  char const* name;
+  cuda::standard_context_t& context;
+  hook_t* hook;
+  std::size_t output_size;
+  std::size_t edges;
+};  // class operator_scope_t
+
+/**
+ * @brief Number of edges an advance traverses from `input` (sum of the
+ * out-degrees of the valid vertices).
+ */
+template <typename graph_t, typename frontier_t>
+std::size_t count_edges(graph_t& G,
+                        frontier_t* input,
+                        cuda::standard_context_t& context) {
+  using vertex_t = typename graph_t::vertex_type;
+  if constexpr (frontier_t::is_dense) {
+    return 0;
+  } else {
+    if (!input || input->get_number_of_elements() == 0)
+      return 0;
+    return thrust::transform_reduce(
+        context.execution_policy(), input->begin(), input->end(),
+        [G] __device__(vertex_t const& v) -> std::size_t {
+          return gunrock::util::limits::is_valid(v)
+                     ? (std::size_t)G.get_number_of_neighbors(v)
+                     : 0;
+        },
+        std::size_t(0), thrust::plus<std::size_t>());
+  }
+}
+
+/**
+ * @brief Default hook: records every iteration and operator with CUDA events
+ * on the context's stream (resolved once, in `finish()`, so the host does not
+ * wait on the events while the algorithm runs), opens NVTX ranges when built
+ * with `ESSENTIALS_NVTX`, and samples the memory pool's reserved bytes after
+ * every iteration to record its growth.
+ *
+ * @par Example
+ *  \code
+ *  auto p = std::make_shared<profiler::profiler_t>();
+ *  enactor_properties_t properties;
+ *  properties.profiler = p;
+ *  float elapsed = gunrock::bfs::run(G, source, distances, predecessors,
+ *                                    nullptr, properties);
+ *  io::json json("bfs", "bfs.json");
+ *  p->write(json);
+ *  json.write();
+ *  \endcode
+ */
+class profiler_t : public hook_t {
+ public:
+  struct iteration_record_t {
+    int iteration;
+    std::size_t input_size;
+    std::size_t output_size;
+    std::size_t edges;  // traversed by the iteration's advances.
+    float elapsed;      // (ms)
+
+    float mteps() const { return (elapsed > 0) ? edges / (elapsed * 1e3) : 0; }
+  };
+
+  struct operator_record_t {
+    std::string name;
+    int iteration;  // `-1` outside of the iterations.
+    std::size_t input_size;
+    std::size_t output_size;
+    std::size_t edges;
+    float elapsed;  // (ms)
+  };
+
+  struct allocation_record_t {
+    int iteration;
+    std::size_t reserved_bytes;  // after the iteration.
+    std::size_t grown_bytes;
+  };
+
+  profiler_t() : current(-1), reserved(0), next_event(0) {}
+
+  ~profiler_t() {
+    for (auto& event : events)
+      cudaEventDestroy(event);
+  }
+
+  profiler_t(const profiler_t& rhs) = delete;
+  profiler_t& operator=(const profiler_t& rhs) = delete;
+
+  void begin_iteration(int iteration,
+                       std::size_t input_size,
+                       cuda::standard_context_t& context) override {
+    current = iteration;
+    iterations.push_back({iteration, input_size, 0, 0, 0});
+    iteration_events.push_back({record(context), 0});
+    range_push("iteration");
+  }
+
+  void end_iteration(int iteration,
+                     std::size_t output_size,
+                     cuda::standard_context_t& context) override {
+    range_pop();
+    iterations.back().output_size = output_size;
+    iteration_events.back().second = record(context);
+    current = -1;
+
+    std::size_t now = context.pool()->get_reserved_bytes();
+    if (now > reserved)
+      allocations.push_back({iteration, now, now - reserved});
+    reserved = now;
+  }
+
+  void begin_operator(char const* name,
+                      std::size_t input_size,
+                      cuda::standard_context_t& context) override {
+    open.push_back(operators.size());
+    operators.push_back({name, current, input_size, 0, 0, 0});
+    operator_events.push_back({record(context), 0});
+    range_push(name);
+  }
+
+  void end_operator(char const* name,
+                    std::size_t output_size,
+                    std::size_t edges,
+                    cuda::standard_context_t& context) override {
+    range_pop();
+    std::size_t index = open.back();
+    open.pop_back();
+    operators[index].output_size = output_size;
+    operators[index].edges = edges;
+    operator_events[index].second = record(context);
+  }
+
+  /**
+   * @brief Wait for the recorded events and compute the elapsed times, the
+   * edges and the MTEPS of the iterations.
+   */
+  void finish(cuda::standard_context_t& context) override {
+    context.synchronize();
+    for (std::size_t i = 0; i < operators.size(); ++i)
+      operators[i].elapsed = elapsed(operator_events[i]);
+    for (std::size_t i = 0; i < iterations.size(); ++i)
+      iterations[i].elapsed = elapsed(iteration_events[i]);
+
+    std::map<int, std::size_t> edges;
+    for (auto& op : operators)
+      edges[op.iteration] += op.edges;
+    for (auto& it : iterations)
+      it.edges = edges[it.iteration];
+  }
+
+  /**
+   * @brief Drop the records (e.g. between two runs), the events are reused.
+   */
+  void reset() {
+    iterations.clear();
+    operators.clear();
+    allocations.clear();
+    iteration_events.clear();
+    operator_events.clear();
+    open.clear();
+    current = -1;
+    next_event = 0;
+  }
+
+  std::vector<iteration_record_t> const& get_iterations() const {
+    return iterations;
+  }
+  std::vector<operator_record_t> const& get_operators() const {
+    return operators;
+  }
+  std::vector<allocation_record_t> const& get_allocations() const {
+    return allocations;
+  }
+
+  std::size_t get_number_of_edges() const {
+    std::size_t total = 0;
+    for (auto& it : iterations)
+      total += it.edges;
+    return total;
+  }
+
+  float get_elapsed() const {
+    float total = 0;
+    for (auto& it : iterations)
+      total += it.elapsed;
+    return total;
+  }
+
+  float get_mteps() const {
+    float total = get_elapsed();
+    return (total > 0) ? get_number_of_edges() / (total * 1e3) : 0;
+  }
+
+  /**
+   * @brief Add the records to a json document (`gunrock::io::json`, or any
+   * type with the same `set_val(name, value)` interface); times are in
+   * milliseconds, per-operator entries are named `<operator>-<field>`.
+   */
+  template <typename json_t>
+  void write(json_t& json) const {
+    std::vector<int> ids;
+    std::vector<std::size_t> inputs, outputs, edges;
+    std::vector<float> times, mteps;
+    for (auto& it : iterations) {
+      ids.push_back(it.iteration);
+      inputs.push_back(it.input_size);
+      outputs.push_back(it.output_size);
+      edges.push_back(it.edges);
+      times.push_back(it.elapsed);
+      mteps.push_back(it.mteps());
+    }
+    json.set_val("iterations", ids);
+    json.set_val("iteration-input-sizes", inputs);
+    json.set_val("iteration-output-sizes", outputs);
+    json.set_val("iteration-edges", edges);
+    json.set_val("iteration-times", times);
+    json.set_val("iteration-mteps", mteps);
+    json.set_val("total-edges", get_number_of_edges());
+    json.set_val("total-time", get_elapsed());
+    json.set_val("mteps", get_mteps());
+
+    std::map<std::string, std::vector<int>> op_iterations;
+    std::map<std::string, std::vector<std::size_t>> op_inputs, op_outputs;
+    std::map<std::string, std::vector<float>> op_times;
+    for (auto& op : operators) {
+      op_iterations[op.name].push_back(op.iteration);
+      op_inputs[op.name].push_back(op.input_size);
+      op_outputs[op.name].push_back(op.output_size);
+      op_times[op.name].push_back(op.elapsed);
+    }
+    for (auto& entry : op_times) {
+      auto& name = entry.first;
+      float total = 0;
+      for (auto& t : entry.second)
+        total += t;
+      json.set_val(name + "-iterations", op_iterations[name]);
+      json.set_val(name + "-input-sizes", op_inputs[name]);
+      json.set_val(name + "-output-sizes", op_outputs[name]);
+      json.set_val(name + "-times", entry.second);
+      json.set_val(name + "-total-time", total);
+    }
+
+    std::vector<int> grown_at;
+    std::vector<std::size_t> grown_to, grown_by;
+    for (auto& a : allocations) {
+      grown_at.push_back(a.iteration);
+      grown_to.push_back(a.reserved_bytes);
+      grown_by.push_back(a.grown_bytes);
+    }
+    json.set_val("allocation-iterations", grown_at);
+    json.set_val("allocation-reserved-bytes", grown_to);
+    json.set_val("allocation-grown-bytes", grown_by);
+  }
+
+ private:
+  std::size_t record(cuda::standard_context_t& context) {
+    if (next_event == events.size()) {
+      cuda::event_t event;
+      error::throw_if_exception(cudaEventCreate(&event),
+                                "Failed to create a profiler event.");
+      events.push_back(event);
+    }
+    cudaEventRecord(events[next_event], context.stream());
+    return next_event++;
+  }
+
+  float elapsed(std::pair<std::size_t, std::size_t> const& range) {
+    float ms = 0;
+    cudaEventElapsedTime(&ms, events[range.first], events[range.second]);
+    return ms;
+  }
+
+  void range_push(char const* name) {
+#ifdef ESSENTIALS_NVTX
+    nvtxRangePushA(name);
+#endif
+  }
+
+  void range_pop() {
+#ifdef ESSENTIALS_NVTX
+    nvtxRangePop();
+#endif
+  }
+
+  std::vector<iteration_record_t> iterations;
+  std::vector<operator_record_t> operators;
+  std::vector<allocation_record_t> allocations;
+
+  std::vector<std::pair<std::size_t, std::size_t>> iteration_events;
+  std::vector<std::pair<std::size_t, std::size_t>> operator_events;
+  std::vector<std::size_t> open;
+  int current;
+  std::size_t reserved;
+
+  std::vector<cuda::event_t> events;
+  std::size_t next_event;
+};  // class profiler_t
+
+}  // namespace profiler
+}  // namespace gunrock
@@ -0,0 +1,80 @@
+/**
+ * @file session.hxx
+ * @author Muhammad Osama (mosama@ucdavis.edu)
+ * @brief Persistent problem and enactor, built once for a graph and reused
+ * by repeated queries.
+ * @version 0.1
+ * @date 2021-06-15
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#pragma once
+
+#include <memory>
+
+#include <gunrock/cuda/cuda.hxx>
+#include <gunrock/framework/problem.hxx>
+#include <gunrock/framework/enactor.hxx>
+
+namespace gunrock {
+
+/**
+ * @brief Owns a context, a problem and an enactor for the lifetime of the
+ * session. The problem is initialized (`init()`) and the enactor's frontiers
+ * and scratch space are allocated once, at construction; every `enact()`
+ * then only resets the problem and the enactor.
+ *
+ * @par Overview
+ * Algorithms expose a typed session on top of it (e.g. `sssp::session_t`),
+ * which sets the query's parameters on the problem before `enact()`. The
+ * problem's constructor arguments are given to the session's constructor,
+ * without the trailing context.
+ *
+ * @tparam problem_type algorithm's problem.
+ * @tparam enactor_type algorithm's enactor.
+ */
+template <typename problem_type, typename enactor_type>
+class session_t {
+ public:
+  /**
+   * @param _context context (`nullptr` creates one on GPU 0).
+   * @param properties enactor properties.
+   * @param args problem's constructor arguments, except the context.
+   */
+  template <typename... args_t>
+  session_t(std::shared_ptr<cuda::multi_context_t> _context,
+            enactor_properties_t properties,
+            args_t... args)
+      : context(_context ? _context
+                         : std::make_shared<cuda::multi_context_t>(0)),
+        problem(args..., context),
+        enactor((problem.init(), &problem), context, properties) {}
+
+  session_t(const session_t& rhs) = delete;
+  session_t& operator=(const session_t& rhs) = delete;
+
+  /**
+   * @brief Answer a query: reset the problem (with its current parameters)
+   * and the enactor, then enact.
+   *
+   * @return float elapsed time (ms).
+   */
+  float enact() {
+    problem.reset();
+    enactor.reset();
+    return enactor.enact();
+  }
+
+  problem_type& get_problem() { return problem; }
+  enactor_type& get_enactor() { return enactor; }
+  std::shared_ptr<cuda::multi_context_t> get_context() { return context; }
+
+ private:
+  std::shared_ptr<cuda::multi_context_t> context;
+  problem_type problem;
+  enactor_type enactor;
+};  // class session_t
+
+}  // namespace gunrock
@@ -29,9 +29,104 @@ auto from_csr(vertex_t const& r,
               vertex_t* J,
               weight_t* X,
               vertex_t* I = nullptr,
-              edge_t* Aj = nullptr) {
+              edge_t* Aj = nullptr,
+              weight_t* Xc = nullptr) {
   // static_assert(); // TODO: check for flags and nullptrs
-  return detail::from_csr<space, build_views>(r, c, nnz, Ap, J, X, I, Aj);
+  return detail::from_csr<space, build_views>(r, c, nnz, Ap, J, X, I, Aj, Xc);
+}
+
+/**
+ * @brief Build a graph from a coordinate format (`format::coo_t`) sorted by
+ * (row, column), e.g. with `coo.sort(remove_self_loops, remove_duplicates)`.
+ * The views share the coordinate format's arrays, CSR needs `r + 1` row
+ * offsets and CSC needs `c + 1` column offsets, and `nnz` column-major row
+ * indices and values.
+ */
+template <memory_space_t space,
+          view_t build_views,
+          typename edge_t,
+          typename vertex_t,
+          typename weight_t>
+auto from_coo(format::coo_t<space, vertex_t, edge_t, weight_t>& coo,
+              edge_t* row_offsets = nullptr,
+              edge_t* column_offsets = nullptr,
+              vertex_t* column_row_indices = nullptr,
+              weight_t* column_values = nullptr) {
+  return detail::from_coo<space, build_views>(
+      coo.number_of_rows, coo.number_of_columns, coo.number_of_nonzeros,
+      memory::raw_pointer_cast(coo.row_indices.data()),
+      memory::raw_pointer_cast(coo.column_indices.data()),
+      memory::raw_pointer_cast(coo.nonzero_values.data()), row_offsets,
+      column_offsets, column_row_indices, column_values);
+}
+
+/**
+ * @brief Build an unweighted graph from CSR row offsets and column indices,
+ * over the weightless CSR view (every edge weighs 1, no values are stored).
+ * `weight_t` is the type of the (constant) weights.
+ */
+template <memory_space_t space,
+          typename weight_t = float,
+          typename edge_t,
+          typename vertex_t>
+auto from_csr_weightless(vertex_t const& r,
+                         vertex_t const& c,
+                         edge_t const& nnz,
+                         edge_t* Ap,
+                         vertex_t* J) {
+  using view_t = graph::graph_weightless_csr_t<vertex_t, edge_t, weight_t>;
+  graph::graph_t<space, vertex_t, edge_t, weight_t, view_t> G;
+  G.template set<view_t>(r, nnz, Ap, J);
+  return G;
+}
+
+/**
+ * @brief Build a graph over a compressed CSR (`format::compressed_csr_t`),
+ * whose column indices are decoded by the operators on the fly; unweighted if
+ * the compressed CSR holds no values.
+ */
+template <memory_space_t space,
+          typename edge_t,
+          typename vertex_t,
+          typename weight_t>
+auto from_compressed_csr(
+    format::compressed_csr_t<space, vertex_t, edge_t, weight_t>& csr) {
+  using view_t = graph::graph_compressed_csr_t<vertex_t, edge_t, weight_t>;
+  graph::graph_t<space, vertex_t, edge_t, weight_t, view_t> G;
+  G.template set<view_t>(
+      csr.number_of_rows, csr.number_of_nonzeros,
+      memory::raw_pointer_cast(csr.row_offsets.data()),
+      memory::raw_pointer_cast(csr.block_bases.data()),
+      memory::raw_pointer_cast(csr.block_widths.data()),
+      memory::raw_pointer_cast(csr.block_words.data()),
+      memory::raw_pointer_cast(csr.words.data()),
+      csr.nonzero_values.size()
+          ? memory::raw_pointer_cast(csr.nonzero_values.data())
+          : nullptr);
+  return G;
+}
+
+/**
+ * @brief Build a graph over a dynamic (gap-buffered) CSR
+ * (`format::dynamic_csr_t`). Insertions and deletions of the dynamic CSR may
+ * lay it out again, build the graph again after every batch.
+ */
+template <memory_space_t space,
+          typename edge_t,
+          typename vertex_t,
+          typename weight_t>
+auto from_dynamic_csr(
+    format::dynamic_csr_t<space, vertex_t, edge_t, weight_t>& csr) {
+  using view_t = graph::graph_dynamic_csr_t<vertex_t, edge_t, weight_t>;
+  graph::graph_t<space, vertex_t, edge_t, weight_t, view_t> G;
+  G.template set<view_t>(
+      csr.number_of_rows, csr.number_of_nonzeros,
+      (edge_t)csr.get_number_of_slots(),
+      memory::raw_pointer_cast(csr.row_offsets.data()),
+      memory::raw_pointer_cast(csr.row_sizes.data()),
+      memory::raw_pointer_cast(csr.column_indices.data()),
+      memory::raw_pointer_cast(csr.nonzero_values.data()));
+  return G;
 }
 
 }  // namespace build
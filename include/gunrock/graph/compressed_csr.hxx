@@ -0,0 +1,173 @@
+/**
+ * @file compressed_csr.hxx
+ * @author Muhammad Osama (mosama@ucdavis.edu)
+ * @brief Graph view over a `format::compressed_csr_t`, the column indices are
+ * decoded on the fly.
+ * @version 0.1
+ * @date 2021-06-18
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include <gunrock/memory.hxx>
+#include <gunrock/util/type_limits.hxx>
+#include <gunrock/graph/vertex_pair.hxx>
+
+#include <thrust/binary_search.h>
+#include <thrust/iterator/counting_iterator.h>
+
+namespace gunrock {
+namespace graph {
+
+using namespace memory;
+
+/**
+ * @brief CSR view whose column indices are bit-packed per block of 32 edges
+ * (see `format::compressed_csr_t`); `get_destination_vertex()` decodes one or
+ * two words. Without values, every edge weighs 1.
+ */
+template <typename vertex_t, typename edge_t, typename weight_t>
+class graph_compressed_csr_t {
+  using vertex_type = vertex_t;
+  using edge_type = edge_t;
+  using weight_type = weight_t;
+
+  using vertex_pair_type = vertex_pair_t<vertex_type>;
+  using word_t = std::uint32_t;
+
+  static constexpr edge_type block_size = 32;
+
+ public:
+  __host__ __device__ graph_compressed_csr_t()
+      : offsets(nullptr),
+        bases(nullptr),
+        widths(nullptr),
+        block_words(nullptr),
+        words(nullptr),
+        values(nullptr) {}
+
+  __host__ __device__ __forceinline__ edge_type
+  get_number_of_neighbors(vertex_type const& v) const {
+    return (offsets[v + 1] - offsets[v]);
+  }
+
+  __host__ __device__ __forceinline__ vertex_type
+  get_source_vertex(edge_type const& e) const {
+    auto keys = get_row_offsets();
+    auto key = e;
+
+    // returns `it` such that everything to the left is <= e.
+    // This will be one element to the right of the node id.
+    auto it = thrust::lower_bound(
+        thrust::seq, thrust::counting_iterator<edge_t>(0),
+        thrust::counting_iterator<edge_t>(this->number_of_vertices), key,
+        [keys] __host__ __device__(const edge_t& pivot, const edge_t& key) {
+          return keys[pivot] <= key;
+        });
+
+    return (*it) - 1;
+  }
+
+  __host__ __device__ __forceinline__ vertex_type
+  get_destination_vertex(edge_type const& e) const {
+    edge_type block = e / block_size;
+    unsigned int width = widths[block];
+    if (width == 0)
+      return bases[block];
+
+    std::uint64_t bit = (std::uint64_t)(e % block_size) * width;
+    edge_type word = block_words[block] + (edge_type)(bit >> 5);
+    std::uint64_t pair =
+        (std::uint64_t)words[word] | ((std::uint64_t)words[word + 1] << 32);
+    std::uint64_t mask =
+        (width == 32) ? 0xffffffffull : ((std::uint64_t)1 << width) - 1;
+    return bases[block] + (vertex_type)((pair >> (bit & 31)) & mask);
+  }
+
+  __host__ __device__ __forceinline__ edge_type
+  get_starting_edge(vertex_type const& v) const {
+    return offsets[v];
+  }
+
+  __host__ __device__ __forceinline__ vertex_pair_type
+  get_source_and_destination_vertices(const edge_type& e) const {
+    return {get_source_vertex(e), get_destination_vertex(e)};
+  }
+
+  /**
+   * @brief Edge from `source` to `destination` (binary search over the
+   * decoded, sorted neighbors), invalid if there is none.
+   */
+  __host__ __device__ __forceinline__ edge_type
+  get_edge(const vertex_type& source, const vertex_type& destination) const {
+    edge_type begin = offsets[source];
+    edge_type end = offsets[source + 1];
+    while (begin < end) {
+      edge_type mid = begin + (end - begin) / 2;
+      if (get_destination_vertex(mid) < destination)
+        begin = mid + 1;
+      else
+        end = mid;
+    }
+    return (begin < offsets[source + 1] &&
+            get_destination_vertex(begin) == destination)
+               ? begin
+               : gunrock::numeric_limits<edge_type>::invalid();
+  }
+
+  __host__ __device__ __forceinline__ weight_type
+  get_edge_weight(edge_type const& e) const {
+    return values ? values[e] : (weight_type)1;
+  }
+
+  // Representation specific functions
+  // ...
+  __host__ __device__ __forceinline__ auto get_row_offsets() const {
+    return offsets;
+  }
+
+  __host__ __device__ __forceinline__ auto get_nonzero_values() const {
+    return values;
+  }
+
+ protected:
+  __host__ __device__ void set(vertex_type const& _number_of_vertices,
+                               edge_type const& _number_of_edges,
+                               edge_type* _row_offsets,
+                               vertex_type* _block_bases,
+                               unsigned char* _block_widths,
+                               edge_type* _block_words,
+                               word_t* _words,
+                               weight_type* _values) {
+    this->number_of_vertices = _number_of_vertices;
+    this->number_of_edges = _number_of_edges;
+    // Set raw pointers
+    offsets = raw_pointer_cast<edge_type>(_row_offsets);
+    bases = raw_pointer_cast<vertex_type>(_block_bases);
+    widths = raw_pointer_cast<unsigned char>(_block_widths);
+    block_words = raw_pointer_cast<edge_type>(_block_words);
+    words = raw_pointer_cast<word_t>(_words);
+    values = raw_pointer_cast<weight_type>(_values);
+  }
+
+ private:
+  // Underlying data storage
+  vertex_type number_of_vertices;  // XXX: redundant
+  edge_type number_of_edges;       // XXX: redundant
+
+  edge_type* offsets;
+  vertex_type* bases;
+  unsigned char* widths;
+  edge_type* block_words;
+  word_t* words;
+  weight_type* values;  // nullptr: unweighted.
+
+};  // struct graph_compressed_csr_t
+
+}  // namespace graph
+}  // namespace gunrock
@@ -20,11 +20,12 @@ void offsets_to_indices(const index_t* offsets,
                         offset_t const& size_of_offsets,
                         offset_t* indices,
                         index_t const& size_of_indices) {
-  using execution_policy_t = std::conditional_t<space == memory_space_t::device,
-                                                decltype(thrust::cuda::par.on(
-                                                    0)),  // XXX: does this
-                                                          // work on stream 0?
-                                                decltype(thrust::host)>;
+  using execution_policy_t =
+      std::conditional_t<memory::is_device_accessible(space),
+                         decltype(thrust::cuda::par.on(0)),  // XXX: does this
+                                                             // work on stream
+                                                             // 0?
+                         decltype(thrust::host)>;
   execution_policy_t exec;
   // convert compressed offsets into uncompressed indices
   thrust::fill(exec, indices + 0, indices + size_of_indices, offset_t(0));
@@ -53,7 +54,7 @@ void indices_to_offsets(const index_t* indices,
                         offset_t* offsets,
                         offset_t const& size_of_offsets) {
   using execution_policy_t =
-      std::conditional_t<space == memory_space_t::device,
+      std::conditional_t<memory::is_device_accessible(space),
                          decltype(thrust::device), decltype(thrust::host)>;
   execution_policy_t exec;
   // convert uncompressed indices into compressed offsets
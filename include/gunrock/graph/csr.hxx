@@ -135,5 +135,32 @@ class graph_csr_t {
 
 };  // struct graph_csr_t
 
+/**
+ * @brief CSR view without values (unweighted graphs, pattern matrices):
+ * every edge weighs 1 and no values are stored, `get_nonzero_values()` is
+ * `nullptr`.
+ */
+template <typename vertex_t, typename edge_t, typename weight_t>
+class graph_weightless_csr_t : public graph_csr_t<vertex_t, edge_t, weight_t> {
+  using base_t = graph_csr_t<vertex_t, edge_t, weight_t>;
+
+ public:
+  __host__ __device__ graph_weightless_csr_t() : base_t() {}
+
+  __host__ __device__ __forceinline__ weight_t
+  get_edge_weight(edge_t const& e) const {
+    return (weight_t)1;
+  }
+
+ protected:
+  __host__ __device__ void set(vertex_t const& _number_of_vertices,
+                               edge_t const& _number_of_edges,
+                               edge_t* _row_offsets,
+                               vertex_t* _column_indices) {
+    base_t::set(_number_of_vertices, _number_of_edges, _row_offsets,
+                _column_indices, nullptr);
+  }
+};  // struct graph_weightless_csr_t
+
 }  // namespace graph
 }  // namespace gunrock
\ No newline at end of file
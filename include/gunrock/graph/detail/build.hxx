@@ -29,7 +29,9 @@ auto builder(vertex_t const& r,
              vertex_t* column_indices,
              edge_t* row_offsets,
              edge_t* column_offsets,
-             weight_t* values) {
+             weight_t* values,
+             weight_t* column_values = nullptr,
+             vertex_t* column_row_indices = nullptr) {
   // Enable the types based on the different views required.
   // Enable CSR.
   using csr_v_t =
@@ -59,13 +61,35 @@ auto builder(vertex_t const& r,
   }
 
   if constexpr (has(build_views, view_t::csc)) {
-    G.template set<csc_v_t>(r, nnz, column_offsets, row_indices, values);
+    // CSC's nonzero values (and row indices) are in column-major order, if
+    // separate buffers are provided use them (required when built together
+    // with CSR, or with COO for the row indices).
+    G.template set<csc_v_t>(
+        r, nnz, column_offsets,
+        column_row_indices ? column_row_indices : row_indices,
+        column_values ? column_values : values);
   }
 
   if constexpr (has(build_views, view_t::coo)) {
     G.template set<coo_v_t>(r, nnz, row_indices, column_indices, values);
   }
 
+  // Unified memory: the topology is only read by the operators, replicate it
+  // on the device instead of migrating it (see `advance::prefetch`).
+  if constexpr (space == memory_space_t::managed) {
+    int device = 0;
+    cudaGetDevice(&device);
+    memory::advise_read_mostly(row_offsets, (r + 1) * sizeof(edge_t), device);
+    memory::advise_read_mostly(column_offsets, (c + 1) * sizeof(edge_t),
+                               device);
+    memory::advise_read_mostly(row_indices, nnz * sizeof(vertex_t), device);
+    memory::advise_read_mostly(column_indices, nnz * sizeof(vertex_t), device);
+    memory::advise_read_mostly(values, nnz * sizeof(weight_t), device);
+    memory::advise_read_mostly(column_values, nnz * sizeof(weight_t), device);
+    memory::advise_read_mostly(column_row_indices, nnz * sizeof(vertex_t),
+                               device);
+  }
+
   return G;
 }
 
@@ -81,11 +105,21 @@ auto from_csr(vertex_t const& r,
               vertex_t* column_indices,
               weight_t* values,
               vertex_t* row_indices = nullptr,
-              edge_t* column_offsets = nullptr) {
-  if constexpr (has(build_views, view_t::csc) &&
-                has(build_views, view_t::csr)) {
-    error::throw_if_exception(cudaErrorUnknown,
-                              "CSC & CSR view not yet supported together.");
+              edge_t* column_offsets = nullptr,
+              weight_t* column_values = nullptr) {
+  constexpr bool csr_and_csc =
+      has(build_views, view_t::csc) && has(build_views, view_t::csr);
+
+  if constexpr (csr_and_csc && has(build_views, view_t::coo)) {
+    error::throw_if_exception(
+        cudaErrorUnknown, "CSC, CSR & COO views not yet supported together.");
+  }
+
+  if constexpr (csr_and_csc) {
+    if (column_values == nullptr)
+      error::throw_if_exception(cudaErrorUnknown,
+                                "CSC & CSR views together require a separate "
+                                "buffer for the column-major values.");
   }
 
   if constexpr (has(build_views, view_t::csc) ||
@@ -97,24 +131,117 @@ auto from_csr(vertex_t const& r,
 
   if constexpr (has(build_views, view_t::csc)) {
     using execution_policy_t =
-        std::conditional_t<space == memory_space_t::device,
+        std::conditional_t<memory::is_device_accessible(space),
                            decltype(thrust::device), decltype(thrust::host)>;
     execution_policy_t exec;
-    thrust::sort_by_key(exec, column_indices, column_indices + nnz,
-                        thrust::make_zip_iterator(
-                            thrust::make_tuple(row_indices, values))  // values
-    );
-
     const edge_t size_of_offsets = r + 1;
-    convert::indices_to_offsets<space>(column_indices, nnz, column_offsets,
-                                       size_of_offsets);
+
+    if constexpr (csr_and_csc) {
+      // CSR needs its column indices and values intact, so sort a copy of the
+      // column indices (keys) along with the row indices and a copy of the
+      // values. Stable sort keeps the rows ascending within each column.
+      vector_t<vertex_t, space> column_keys(nnz);
+      thrust::copy(exec, column_indices, column_indices + nnz,
+                   column_keys.begin());
+      thrust::copy(exec, values, values + nnz, column_values);
+
+      thrust::stable_sort_by_key(
+          exec, column_keys.begin(), column_keys.end(),
+          thrust::make_zip_iterator(
+              thrust::make_tuple(row_indices, column_values))  // values
+      );
+
+      convert::indices_to_offsets<space>(
+          memory::raw_pointer_cast(column_keys.data()), nnz, column_offsets,
+          size_of_offsets);
+    } else {
+      thrust::sort_by_key(
+          exec, column_indices, column_indices + nnz,
+          thrust::make_zip_iterator(
+              thrust::make_tuple(row_indices, values))  // values
+      );
+
+      convert::indices_to_offsets<space>(column_indices, nnz, column_offsets,
+                                         size_of_offsets);
+    }
   }
 
   return builder<space,       // build for host
                  build_views  // supported views
                  >(r, c, nnz, row_indices, column_indices, row_offsets,
-                   column_offsets, values);
+                   column_offsets, values, column_values);
 }
+
+/**
+ * @brief Build the views from a coordinate format sorted by (row, column),
+ * see `format::coo_t::sort()`. CSR and COO views share the sorted edge list:
+ * COO uses it as is, CSR only adds the row offsets (a vectorized binary search
+ * over the sorted row indices). CSC additionally requires its own row indices
+ * and values in column-major order, obtained with one stable radix sort of
+ * the (row-sorted) edge list by column.
+ */
+template <memory_space_t space,
+          view_t build_views,
+          typename edge_t,
+          typename vertex_t,
+          typename weight_t>
+auto from_coo(vertex_t const& r,
+              vertex_t const& c,
+              edge_t const& nnz,
+              vertex_t* row_indices,
+              vertex_t* column_indices,
+              weight_t* values,
+              edge_t* row_offsets = nullptr,
+              edge_t* column_offsets = nullptr,
+              vertex_t* column_row_indices = nullptr,
+              weight_t* column_values = nullptr) {
+  using execution_policy_t =
+      std::conditional_t<memory::is_device_accessible(space),
+                         decltype(thrust::device), decltype(thrust::host)>;
+  execution_policy_t exec;
+
+  if constexpr (has(build_views, view_t::csr)) {
+    if (row_offsets == nullptr)
+      error::throw_if_exception(cudaErrorUnknown,
+                                "CSR view requires a row offsets buffer.");
+    const edge_t size_of_offsets = r + 1;
+    convert::indices_to_offsets<space>(row_indices, nnz, row_offsets,
+                                       size_of_offsets);
+  }
+
+  if constexpr (has(build_views, view_t::csc)) {
+    if (column_offsets == nullptr || column_row_indices == nullptr ||
+        column_values == nullptr)
+      error::throw_if_exception(
+          cudaErrorUnknown,
+          "CSC view requires column offsets, row indices and values buffers.");
+
+    // The edge list is shared with the other views, sort a copy of the column
+    // indices (keys) along with copies of the row indices and values. Stable
+    // sort keeps the rows ascending within each column.
+    vector_t<vertex_t, space> column_keys(nnz);
+    auto keys = memory::raw_pointer_cast(column_keys.data());
+    thrust::copy(exec, column_indices, column_indices + nnz, keys);
+    thrust::copy(exec, row_indices, row_indices + nnz, column_row_indices);
+    thrust::copy(exec, values, values + nnz, column_values);
+
+    auto rows_values = thrust::make_zip_iterator(
+        thrust::make_tuple(column_row_indices, column_values));
+    if constexpr (memory::is_device_accessible(space))
+      sort::radix::sort_pairs(keys, rows_values, nnz);
+    else
+      thrust::stable_sort_by_key(exec, keys, keys + nnz, rows_values);
+
+    const edge_t size_of_offsets = c + 1;
+    convert::indices_to_offsets<space>(keys, nnz, column_offsets,
+                                       size_of_offsets);
+  }
+
+  return builder<space, build_views>(r, c, nnz, row_indices, column_indices,
+                                     row_offsets, column_offsets, values,
+                                     column_values, column_row_indices);
+}
+
 }  // namespace detail
 }  // namespace build
 }  // namespace graph
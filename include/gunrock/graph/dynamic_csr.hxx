@@ -0,0 +1,159 @@
+/**
+ * @file dynamic_csr.hxx
+ * @author Muhammad Osama (mosama@ucdavis.edu)
+ * @brief Graph view over a `format::dynamic_csr_t` (gap-buffered CSR).
+ * @version 0.1
+ * @date 2021-06-20
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#pragma once
+
+#include <gunrock/memory.hxx>
+#include <gunrock/util/type_limits.hxx>
+#include <gunrock/graph/vertex_pair.hxx>
+
+#include <thrust/binary_search.h>
+#include <thrust/iterator/counting_iterator.h>
+
+namespace gunrock {
+namespace graph {
+
+using namespace memory;
+
+/**
+ * @brief CSR view with a gap after every row (see `format::dynamic_csr_t`):
+ * the neighbors of `v` are the `get_number_of_neighbors(v)` edges from
+ * `get_starting_edge(v)` on. Edge ids are slots, within
+ * `[0, get_number_of_slots())`; the number of edges counts the live ones.
+ * The neighbors of a vertex are not sorted.
+ *
+ * @note Operators visiting the neighbors of vertices (advance, also over the
+ * whole graph) are supported; those over the range of edge ids are not, they
+ * would miss the slots beyond the number of (live) edges.
+ */
+template <typename vertex_t, typename edge_t, typename weight_t>
+class graph_dynamic_csr_t {
+  using vertex_type = vertex_t;
+  using edge_type = edge_t;
+  using weight_type = weight_t;
+
+  using vertex_pair_type = vertex_pair_t<vertex_type>;
+
+ public:
+  __host__ __device__ graph_dynamic_csr_t()
+      : offsets(nullptr), sizes(nullptr), indices(nullptr), values(nullptr) {}
+
+  __host__ __device__ __forceinline__ edge_type
+  get_number_of_neighbors(vertex_type const& v) const {
+    return sizes[v];
+  }
+
+  __host__ __device__ __forceinline__ vertex_type
+  get_source_vertex(edge_type const& e) const {
+    auto keys = get_row_offsets();
+    auto key = e;
+
+    // returns `it` such that everything to the left is <= e.
+    // This will be one element to the right of the node id.
+    auto it = thrust::lower_bound(
+        thrust::seq, thrust::counting_iterator<edge_t>(0),
+        thrust::counting_iterator<edge_t>(this->number_of_vertices), key,
+        [keys] __host__ __device__(const edge_t& pivot, const edge_t& key) {
+          return keys[pivot] <= key;
+        });
+
+    return (*it) - 1;
+  }
+
+  __host__ __device__ __forceinline__ vertex_type
+  get_destination_vertex(edge_type const& e) const {
+    return indices[e];
+  }
+
+  __host__ __device__ __forceinline__ edge_type
+  get_starting_edge(vertex_type const& v) const {
+    return offsets[v];
+  }
+
+  __host__ __device__ __forceinline__ vertex_pair_type
+  get_source_and_destination_vertices(const edge_type& e) const {
+    return {get_source_vertex(e), get_destination_vertex(e)};
+  }
+
+  /**
+   * @brief Edge from `source` to `destination` (linear search over the
+   * unsorted neighbors), invalid if there is none.
+   */
+  __host__ __device__ __forceinline__ edge_type
+  get_edge(const vertex_type& source, const vertex_type& destination) const {
+    edge_type begin = offsets[source];
+    edge_type end = begin + sizes[source];
+    for (edge_type e = begin; e < end; ++e)
+      if (indices[e] == destination)
+        return e;
+    return gunrock::numeric_limits<edge_type>::invalid();
+  }
+
+  __host__ __device__ __forceinline__ weight_type
+  get_edge_weight(edge_type const& e) const {
+    return values[e];
+  }
+
+  // Representation specific functions
+  // ...
+  __host__ __device__ __forceinline__ auto get_row_offsets() const {
+    return offsets;
+  }
+
+  __host__ __device__ __forceinline__ auto get_row_sizes() const {
+    return sizes;
+  }
+
+  __host__ __device__ __forceinline__ auto get_column_indices() const {
+    return indices;
+  }
+
+  __host__ __device__ __forceinline__ auto get_nonzero_values() const {
+    return values;
+  }
+
+  __host__ __device__ __forceinline__ edge_type get_number_of_slots() const {
+    return number_of_slots;
+  }
+
+ protected:
+  __host__ __device__ void set(vertex_type const& _number_of_vertices,
+                               edge_type const& _number_of_edges,
+                               edge_type const& _number_of_slots,
+                               edge_type* _row_offsets,
+                               edge_type* _row_sizes,
+                               vertex_type* _column_indices,
+                               weight_type* _values) {
+    this->number_of_vertices = _number_of_vertices;
+    this->number_of_edges = _number_of_edges;
+    this->number_of_slots = _number_of_slots;
+    // Set raw pointers
+    offsets = raw_pointer_cast<edge_type>(_row_offsets);
+    sizes = raw_pointer_cast<edge_type>(_row_sizes);
+    indices = raw_pointer_cast<vertex_type>(_column_indices);
+    values = raw_pointer_cast<weight_type>(_values);
+  }
+
+ private:
+  // Underlying data storage
+  vertex_type number_of_vertices;  // XXX: redundant
+  edge_type number_of_edges;       // XXX: redundant
+  edge_type number_of_slots;
+
+  edge_type* offsets;
+  edge_type* sizes;
+  vertex_type* indices;
+  weight_type* values;
+
+};  // struct graph_dynamic_csr_t
+
+}  // namespace graph
+}  // namespace gunrock
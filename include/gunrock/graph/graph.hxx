@@ -17,6 +17,8 @@
 #include <gunrock/graph/coo.hxx>
 #include <gunrock/graph/csc.hxx>
 #include <gunrock/graph/csr.hxx>
+#include <gunrock/graph/compressed_csr.hxx>
+#include <gunrock/graph/dynamic_csr.hxx>
 
 namespace gunrock {
 namespace graph {
@@ -41,6 +43,10 @@ struct empty_graph_t {};
  * | insert edge   | O(1)             | O(1) | O(1) or O(d) | O(m+n)  | (x)
  * | delete edge   | O(1)             | O(m) | O(d)         | O(m+n)  | (x)
  *
+ * Batched edge insertions and deletions are supported by the gap-buffered
+ * dynamic CSR (`format::dynamic_csr_t`, view `graph_dynamic_csr_t`), O(d)
+ * per edge unless a row runs out of gap (O(m+n) relayout).
+ *
  *
  * @tparam space
  * @tparam vertex_t
@@ -78,8 +84,28 @@ class graph_t : public graph_view_t... {
   using graph_type =
       graph_t<space, vertex_type, edge_type, weight_type, graph_view_t...>;
 
-  // Different supported graph representation views.
-  using graph_csr_view_t = graph_csr_t<vertex_type, edge_type, weight_type>;
+  // Different supported graph representation views. The row-major view is
+  // the compressed, the weightless or the dynamic CSR if the graph holds one
+  // of them.
+  using graph_compressed_csr_view_t =
+      graph_compressed_csr_t<vertex_type, edge_type, weight_type>;
+  using graph_weightless_csr_view_t =
+      graph_weightless_csr_t<vertex_type, edge_type, weight_type>;
+  using graph_dynamic_csr_view_t =
+      graph_dynamic_csr_t<vertex_type, edge_type, weight_type>;
+  using graph_csr_view_t = std::conditional_t<
+      std::disjunction_v<
+          std::is_same<graph_compressed_csr_view_t, graph_view_t>...>,
+      graph_compressed_csr_view_t,
+      std::conditional_t<
+          std::disjunction_v<
+              std::is_same<graph_weightless_csr_view_t, graph_view_t>...>,
+          graph_weightless_csr_view_t,
+          std::conditional_t<
+              std::disjunction_v<
+                  std::is_same<graph_dynamic_csr_view_t, graph_view_t>...>,
+              graph_dynamic_csr_view_t,
+              graph_csr_t<vertex_type, edge_type, weight_type>>>>;
   using graph_csc_view_t = graph_csc_t<vertex_type, edge_type, weight_type>;
   using graph_coo_view_t = graph_coo_t<vertex_type, edge_type, weight_type>;
 
@@ -108,7 +134,7 @@ class graph_t : public graph_view_t... {
   }
 
   template <typename input_view_t>
-  constexpr bool contains_representation() {
+  static constexpr bool contains_representation() {
     return std::disjunction_v<std::is_same<input_view_t, graph_view_t>...>;
   }
 
@@ -0,0 +1,164 @@
+/**
+ * @file partition.hxx
+ * @author Muhammad Osama (mosama@ucdavis.edu)
+ * @brief 1D (vertex range) partitioning of a graph over multiple GPUs.
+ * @version 0.1
+ * @date 2021-06-09
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#pragma once
+
+#include <gunrock/memory.hxx>
+#include <gunrock/container/vector.hxx>
+#include <gunrock/cuda/context.hxx>
+
+#include <thrust/copy.h>
+#include <thrust/transform.h>
+#include <thrust/iterator/counting_iterator.h>
+
+namespace gunrock {
+namespace graph {
+
+/**
+ * @brief 1D partition of the vertices into contiguous ranges, partition `p`
+ * owns vertices [p * vertices_per_partition, (p + 1) * vertices_per_partition)
+ * and all their outgoing edges. Ranges can be aligned to the stripes of a
+ * `memory::striped_array_t` (see `vertices_per_partition`), such that the
+ * vertex data of a partition is resident on the partition's GPU.
+ *
+ * @tparam vertex_t vertex type.
+ */
+template <typename vertex_t>
+struct partition_t {
+  vertex_t number_of_vertices;
+  int number_of_partitions;
+  vertex_t vertices_per_partition;
+
+  partition_t()
+      : number_of_vertices(0),
+        number_of_partitions(1),
+        vertices_per_partition(1) {}
+
+  /**
+   * @param n number of vertices.
+   * @param k number of partitions.
+   * @param per vertices per partition, `0` (default) splits the vertices
+   * evenly.
+   */
+  partition_t(vertex_t n, int k, vertex_t per = 0)
+      : number_of_vertices(n), number_of_partitions(k) {
+    vertices_per_partition = per > 0 ? per : (n + k - 1) / k;
+    if (vertices_per_partition == 0)
+      vertices_per_partition = 1;
+  }
+
+  __host__ __device__ __forceinline__ int owner(vertex_t const& v) const {
+    return (int)(v / vertices_per_partition);
+  }
+
+  __host__ __device__ __forceinline__ vertex_t begin(int p) const {
+    vertex_t b = (vertex_t)p * vertices_per_partition;
+    return (b < number_of_vertices) ? b : number_of_vertices;
+  }
+
+  __host__ __device__ __forceinline__ vertex_t end(int p) const {
+    return begin(p + 1);
+  }
+};
+
+/**
+ * @brief Storage of the local subgraph of a partition, in CSR, on the GPU of
+ * the partition. The local subgraph keeps the global vertex ids: its row
+ * offsets span all the vertices, and the rows of the vertices owned by other
+ * partitions are empty. Edge ids are local to the subgraph.
+ */
+template <typename vertex_t, typename edge_t, typename weight_t>
+struct local_csr_t {
+  vector_t<edge_t, memory_space_t::device> row_offsets;
+  vector_t<vertex_t, memory_space_t::device> column_indices;
+  vector_t<weight_t, memory_space_t::device> nonzero_values;
+
+  /**
+   * @brief Copy the rows of partition `p` out of the global CSR view of `G`
+   * (the global graph may live on another GPU: its rows are copied
+   * peer-to-peer, kernels only touch the local copies). Must be called with
+   * the partition's GPU current.
+   *
+   * @return graph_t a copy of `G` whose CSR view is the local subgraph (the
+   * other views, if any, still refer to the global graph).
+   */
+  template <typename graph_t>
+  graph_t build(graph_t const& G,
+                partition_t<vertex_t> const& partition,
+                int p,
+                cuda::standard_context_t& context) {
+    using csr_view_t = typename graph_t::graph_csr_view_t;
+    static_assert(graph_t::template contains_representation<csr_view_t>(),
+                  "Partitioning requires a CSR view of the graph.");
+    auto policy = context.execution_policy();
+    auto stream = context.stream();
+
+    vertex_t n = G.get_number_of_vertices();
+    vertex_t first = partition.begin(p);
+    vertex_t last = partition.end(p);
+
+    auto global_offsets = G.csr_view_t::get_row_offsets();
+    auto global_indices = G.csr_view_t::get_column_indices();
+    auto global_values = G.csr_view_t::get_nonzero_values();
+    edge_t h_first_edge, h_last_edge;
+    error::throw_if_exception(
+        cudaMemcpyAsync(&h_first_edge, global_offsets + first, sizeof(edge_t),
+                        cudaMemcpyDefault, stream));
+    error::throw_if_exception(
+        cudaMemcpyAsync(&h_last_edge, global_offsets + last, sizeof(edge_t),
+                        cudaMemcpyDefault, stream));
+    error::throw_if_exception(cudaStreamSynchronize(stream));
+    edge_t local_edges = h_last_edge - h_first_edge;
+
+    row_offsets.resize(n + 1);
+    column_indices.resize(local_edges);
+    nonzero_values.resize(local_edges);
+    // Container allocations are ordered on the default stream.
+    context.pool()->order(0, stream);
+
+    // The partition's rows (`cudaMemcpyDefault`: peer-to-peer, or within
+    // the device if the global graph is local).
+    auto offsets = row_offsets.data().get();
+    error::throw_if_exception(cudaMemcpyAsync(
+        offsets + first, global_offsets + first,
+        (last - first + 1) * sizeof(edge_t), cudaMemcpyDefault, stream));
+    error::throw_if_exception(cudaMemcpyAsync(
+        column_indices.data().get(), global_indices + h_first_edge,
+        local_edges * sizeof(vertex_t), cudaMemcpyDefault, stream));
+    error::throw_if_exception(cudaMemcpyAsync(
+        nonzero_values.data().get(), global_values + h_first_edge,
+        local_edges * sizeof(weight_t), cudaMemcpyDefault, stream));
+
+    // Rebase the rows, rows before the partition start at 0, rows after it
+    // are empty (in place: row `v` only reads itself or a bound).
+    auto first_edge = h_first_edge;
+    thrust::transform(policy, thrust::make_counting_iterator<vertex_t>(0),
+                      thrust::make_counting_iterator<vertex_t>(n + 1),
+                      row_offsets.begin(),
+                      [=] __device__(vertex_t const& v) -> edge_t {
+                        if (v < first)
+                          return 0;
+                        if (v > last)
+                          return h_last_edge - first_edge;
+                        return offsets[v] - first_edge;
+                      });
+    error::throw_if_exception(cudaStreamSynchronize(stream));
+
+    graph_t local = G;
+    local.template set<csr_view_t>(n, local_edges, row_offsets.data().get(),
+                                   column_indices.data().get(),
+                                   nonzero_values.data().get());
+    return local;
+  }
+};
+
+}  // namespace graph
+}  // namespace gunrock
@@ -0,0 +1,343 @@
+/**
+ * @file binary.hxx
+ * @author Muhammad Osama (mosama@ucdavis.edu)
+ * @brief Versioned binary container format for compressed sparse (CSR/CSC)
+ * graphs, loaded zero-parse through a memory-mapped file.
+ * @version 0.1
+ * @date 2021-06-08
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#pragma once
+
+#include <string>
+#include <cstdio>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include <gunrock/error.hxx>
+#include <gunrock/io/detail/mapped_file.hxx>
+
+namespace gunrock {
+namespace io {
+namespace binary {
+
+/**
+ * @brief Binary graph file (version 1) layout.
+ *
+ * +------------------------------------------------+
+ * | header_t (magic, version, layout, type widths, | <--- 128 bytes
+ * |           sizes, section positions)            |
+ * | offsets  (rows + 1 or columns + 1 entries)     | <--+
+ * | indices  (nonzeros entries)                    |    |-- each section
+ * | values   (nonzeros entries)                    | <--+   64-byte aligned
+ * +------------------------------------------------+
+ *
+ * Files written before the header was introduced (rows, columns and nonzeros
+ * followed by the CSR arrays, no padding) are still readable as version 0,
+ * the type widths are then assumed to match the reader's.
+ */
+constexpr char magic[8] = {'G', 'U', 'N', 'R', 'O', 'C', 'K', 'B'};
+constexpr std::uint32_t version = 1;
+constexpr std::size_t alignment = 64;
+
+enum layout_t : std::uint32_t { csr = 0, csc = 1 };
+enum value_kind_t : std::uint32_t { integral = 0, floating_point = 1 };
+
+struct header_t {
+  char magic[8];
+  std::uint32_t version;
+  std::uint32_t layout;        // layout_t
+  std::uint32_t index_width;   // sizeof(index_t), column/row indices.
+  std::uint32_t offset_width;  // sizeof(offset_t), row/column offsets.
+  std::uint32_t value_width;   // sizeof(value_t), nonzero values.
+  std::uint32_t value_kind;    // value_kind_t
+  std::uint64_t number_of_rows;
+  std::uint64_t number_of_columns;
+  std::uint64_t number_of_nonzeros;
+  std::uint64_t offsets_position;  // byte position of the offsets.
+  std::uint64_t indices_position;  // byte position of the indices.
+  std::uint64_t values_position;   // byte position of the values.
+  std::uint8_t reserved[48];
+};
+
+static_assert(sizeof(header_t) == 2 * alignment,
+              "Binary header must be a multiple of the section alignment.");
+
+inline std::uint64_t align_up(std::uint64_t position) {
+  return (position + alignment - 1) / alignment * alignment;
+}
+
+/**
+ * @brief Build the header of a file holding the given types and sizes.
+ *
+ * @tparam index_t column (CSR) or row (CSC) index type.
+ * @tparam offset_t offset type.
+ * @tparam value_t nonzero value type.
+ */
+template <typename index_t, typename offset_t, typename value_t>
+header_t make_header(layout_t layout,
+                     std::uint64_t rows,
+                     std::uint64_t columns,
+                     std::uint64_t nonzeros) {
+  header_t header;
+  std::memset(&header, 0, sizeof(header_t));
+  std::memcpy(header.magic, magic, sizeof(magic));
+  header.version = version;
+  header.layout = layout;
+  header.index_width = sizeof(index_t);
+  header.offset_width = sizeof(offset_t);
+  header.value_width = sizeof(value_t);
+  header.value_kind = std::is_floating_point<value_t>::value
+                          ? value_kind_t::floating_point
+                          : value_kind_t::integral;
+  header.number_of_rows = rows;
+  header.number_of_columns = columns;
+  header.number_of_nonzeros = nonzeros;
+
+  std::uint64_t number_of_offsets =
+      ((layout == layout_t::csr) ? rows : columns) + 1;
+  header.offsets_position = sizeof(header_t);
+  header.indices_position = align_up(header.offsets_position +
+                                     number_of_offsets * sizeof(offset_t));
+  header.values_position =
+      align_up(header.indices_position + nonzeros * sizeof(index_t));
+  return header;
+}
+
+/**
+ * @brief Number of entries of the offsets section.
+ */
+inline std::uint64_t get_number_of_offsets(header_t const& header) {
+  return ((header.layout == layout_t::csr) ? header.number_of_rows
+                                           : header.number_of_columns) +
+         1;
+}
+
+/**
+ * @brief Read and validate the header of a mapped file against the reader's
+ * layout and types.
+ *
+ * @tparam index_t column (CSR) or row (CSC) index type.
+ * @tparam offset_t offset type.
+ * @tparam value_t nonzero value type.
+ * @param file mapped file.
+ * @param layout expected layout.
+ * @return header_t
+ */
+template <typename index_t, typename offset_t, typename value_t>
+header_t read_header(mapped_file_t const& file, layout_t layout) {
+  header_t header;
+  auto bytes = file.size();
+
+  if (bytes >= sizeof(header_t) &&
+      std::memcmp(file.data(), magic, sizeof(magic)) == 0) {
+    std::memcpy(&header, file.data(), sizeof(header_t));
+
+    if (header.version > version)
+      error::throw_if_exception(cudaErrorUnknown,
+                                "Unsupported binary graph version.");
+    if (header.layout != layout)
+      error::throw_if_exception(cudaErrorUnknown,
+                                "Binary graph layout mismatch (CSR vs. CSC).");
+    if (header.index_width != sizeof(index_t) ||
+        header.offset_width != sizeof(offset_t) ||
+        header.value_width != sizeof(value_t))
+      error::throw_if_exception(
+          cudaErrorUnknown,
+          "Binary graph type widths do not match the requested types.");
+    if (header.value_kind != (std::is_floating_point<value_t>::value
+                                  ? value_kind_t::floating_point
+                                  : value_kind_t::integral))
+      error::throw_if_exception(
+          cudaErrorUnknown,
+          "Binary graph value type (integral vs. floating-point) mismatch.");
+  } else {
+    // Version 0, headerless CSR: rows, columns, nonzeros then the arrays.
+    if (layout != layout_t::csr)
+      error::throw_if_exception(cudaErrorUnknown,
+                                "Headerless binary graphs are CSR only.");
+    constexpr std::size_t metadata =
+        2 * sizeof(index_t) + sizeof(offset_t);
+    if (bytes < metadata)
+      error::throw_if_exception(cudaErrorUnknown,
+                                "Binary graph file is truncated.");
+
+    index_t rows, columns;
+    offset_t nonzeros;
+    std::memcpy(&rows, file.data(), sizeof(index_t));
+    std::memcpy(&columns, file.data() + sizeof(index_t), sizeof(index_t));
+    std::memcpy(&nonzeros, file.data() + 2 * sizeof(index_t),
+                sizeof(offset_t));
+
+    header = make_header<index_t, offset_t, value_t>(layout_t::csr, rows,
+                                                     columns, nonzeros);
+    header.version = 0;
+    header.offsets_position = metadata;
+    header.indices_position =
+        header.offsets_position + (rows + 1) * sizeof(offset_t);
+    header.values_position =
+        header.indices_position + nonzeros * sizeof(index_t);
+  }
+
+  if (bytes < header.values_position +
+                  header.number_of_nonzeros * header.value_width)
+    error::throw_if_exception(cudaErrorUnknown,
+                              "Binary graph file is truncated.");
+  return header;
+}
+
+/**
+ * @brief Write a compressed sparse graph (host arrays) to a binary file.
+ *
+ * @param filename output file.
+ * @param header header built with `make_header()`.
+ * @param offsets offsets (host).
+ * @param indices indices (host).
+ * @param values nonzero values (host).
+ */
+template <typename index_t, typename offset_t, typename value_t>
+void write(std::string const& filename,
+           header_t const& header,
+           offset_t const* offsets,
+           index_t const* indices,
+           value_t const* values) {
+  FILE* file = fopen(filename.c_str(), "wb");
+  if (!file)
+    error::throw_if_exception(cudaErrorUnknown,
+                              "Failed to open " + filename + ".");
+
+  char padding[alignment] = {0};
+  std::uint64_t position = 0;
+  auto section = [&](std::uint64_t start, void const* data,
+                     std::uint64_t bytes) {
+    fwrite(padding, 1, start - position, file);
+    fwrite(data, 1, bytes, file);
+    position = start + bytes;
+  };
+
+  section(0, &header, sizeof(header_t));
+  section(header.offsets_position, offsets,
+          get_number_of_offsets(header) * sizeof(offset_t));
+  section(header.indices_position, indices,
+          header.number_of_nonzeros * sizeof(index_t));
+  section(header.values_position, values,
+          header.number_of_nonzeros * sizeof(value_t));
+
+  bool failed = ferror(file);
+  fclose(file);
+  if (failed)
+    error::throw_if_exception(cudaErrorUnknown,
+                              "Failed to write " + filename + ".");
+}
+
+/**
+ * @brief Double-buffered host-to-device copies through pinned staging
+ * buffers. While one chunk is being transferred (DMA) from a staging buffer,
+ * the next chunk is copied (and its pages faulted in, for a mapped file) into
+ * the other one.
+ */
+class stager_t {
+ public:
+  stager_t(std::size_t _chunk_bytes = 64 << 20) : chunk_bytes(_chunk_bytes) {
+    for (int b = 0; b < 2; ++b) {
+      error::throw_if_exception(cudaMallocHost(&buffers[b], chunk_bytes),
+                                "Failed to allocate pinned staging buffers.");
+      cudaEventCreateWithFlags(&copied[b], cudaEventDisableTiming);
+    }
+  }
+
+  ~stager_t() {
+    for (int b = 0; b < 2; ++b) {
+      cudaEventSynchronize(copied[b]);
+      cudaEventDestroy(copied[b]);
+      cudaFreeHost(buffers[b]);
+    }
+  }
+
+  stager_t(const stager_t& rhs) = delete;
+  stager_t& operator=(const stager_t& rhs) = delete;
+
+  /**
+   * @brief Enqueue the copy of `bytes` from (pageable) `source` to device
+   * `destination` on `stream`. Returns once the last chunk is staged, the
+   * caller synchronizes the stream before using the data.
+   */
+  void copy(void* destination,
+            void const* source,
+            std::size_t bytes,
+            cudaStream_t stream) {
+    auto d = static_cast<char*>(destination);
+    auto s = static_cast<char const*>(source);
+    for (std::size_t position = 0; position < bytes;
+         position += chunk_bytes) {
+      std::size_t size = std::min(chunk_bytes, bytes - position);
+
+      // Wait for the previous transfer out of this buffer.
+      error::throw_if_exception(cudaEventSynchronize(copied[current]));
+      std::memcpy(buffers[current], s + position, size);
+      error::throw_if_exception(
+          cudaMemcpyAsync(d + position, buffers[current], size,
+                          cudaMemcpyHostToDevice, stream),
+          "Staged host to device copy failed.");
+      cudaEventRecord(copied[current], stream);
+      current ^= 1;
+    }
+  }
+
+ private:
+  std::size_t chunk_bytes;
+  void* buffers[2];
+  cudaEvent_t copied[2];
+  int current = 0;
+};  // class stager_t
+
+/**
+ * @brief Load the sections of a mapped file into preallocated arrays, which
+ * are either device arrays (staged, stream-ordered copies) or host arrays
+ * (plain copies out of the mapping).
+ *
+ * @param file mapped file.
+ * @param header header returned by `read_header()`.
+ * @param offsets offsets destination.
+ * @param indices indices destination.
+ * @param values values destination.
+ * @param on_device destination arrays are on the device.
+ * @param stream stream of the (device) copies.
+ */
+template <typename index_t, typename offset_t, typename value_t>
+void read(mapped_file_t const& file,
+          header_t const& header,
+          offset_t* offsets,
+          index_t* indices,
+          value_t* values,
+          bool on_device,
+          cudaStream_t stream = 0) {
+  std::size_t offsets_bytes = get_number_of_offsets(header) * sizeof(offset_t);
+  std::size_t indices_bytes = header.number_of_nonzeros * sizeof(index_t);
+  std::size_t values_bytes = header.number_of_nonzeros * sizeof(value_t);
+
+  auto source = file.data();
+  if (on_device) {
+    stager_t stager;
+    stager.copy(offsets, source + header.offsets_position, offsets_bytes,
+                stream);
+    stager.copy(indices, source + header.indices_position, indices_bytes,
+                stream);
+    stager.copy(values, source + header.values_position, values_bytes,
+                stream);
+    error::throw_if_exception(cudaStreamSynchronize(stream));
+  } else {
+    std::memcpy(offsets, source + header.offsets_position, offsets_bytes);
+    std::memcpy(indices, source + header.indices_position, indices_bytes);
+    std::memcpy(values, source + header.values_position, values_bytes);
+  }
+}
+
+}  // namespace binary
+}  // namespace io
+}  // namespace gunrock
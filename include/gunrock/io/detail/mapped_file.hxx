@@ -0,0 +1,78 @@
+/**
+ * @file mapped_file.hxx
+ * @author Muhammad Osama (mosama@ucdavis.edu)
+ * @brief Read-only memory-mapped files, shared by the graph readers.
+ * @version 0.1
+ * @date 2021-06-08
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#pragma once
+
+#include <string>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include <gunrock/error.hxx>
+
+namespace gunrock {
+namespace io {
+
+/**
+ * @brief Read-only, memory-mapped file. Pages are faulted in on first touch,
+ * the kernel is advised of the sequential access pattern.
+ */
+class mapped_file_t {
+ public:
+  mapped_file_t(std::string const& filename)
+      : descriptor(-1), bytes(0), mapping(nullptr) {
+    descriptor = open(filename.c_str(), O_RDONLY);
+    if (descriptor < 0)
+      error::throw_if_exception(cudaErrorUnknown,
+                                "Failed to open " + filename + ".");
+
+    struct stat status;
+    if (fstat(descriptor, &status) != 0) {
+      close(descriptor);
+      error::throw_if_exception(cudaErrorUnknown,
+                                "Failed to stat " + filename + ".");
+    }
+    bytes = status.st_size;
+
+    if (bytes > 0) {
+      mapping = mmap(nullptr, bytes, PROT_READ, MAP_PRIVATE, descriptor, 0);
+      if (mapping == MAP_FAILED) {
+        close(descriptor);
+        error::throw_if_exception(cudaErrorUnknown,
+                                  "Failed to map " + filename + ".");
+      }
+      madvise(mapping, bytes, MADV_SEQUENTIAL);
+    }
+  }
+
+  ~mapped_file_t() {
+    if (mapping && mapping != MAP_FAILED)
+      munmap(mapping, bytes);
+    if (descriptor >= 0)
+      close(descriptor);
+  }
+
+  mapped_file_t(const mapped_file_t& rhs) = delete;
+  mapped_file_t& operator=(const mapped_file_t& rhs) = delete;
+
+  char const* data() const { return static_cast<char const*>(mapping); }
+  std::size_t size() const { return bytes; }
+
+ private:
+  int descriptor;
+  std::size_t bytes;
+  void* mapping;
+};  // class mapped_file_t
+
+}  // namespace io
+}  // namespace gunrock
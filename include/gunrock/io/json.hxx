@@ -7,14 +7,24 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cassert>
 #include <cmath>
 #include <cstdio>
 #include <ctime>
+#include <iostream>
+#include <sstream>
+#include <string>
 #include <time.h>
+#include <typeindex>
 #include <vector>
 
-// RapidJSON includes (required)
+// RapidJSON includes (required), with the std::string API.
+#ifndef RAPIDJSON_HAS_STDSTRING
+#define RAPIDJSON_HAS_STDSTRING 1
+#endif
 #include <rapidjson/document.h>
+#include <rapidjson/stringbuffer.h>
 #include <rapidjson/filewritestream.h>
 #include <rapidjson/prettywriter.h>
 
@@ -47,9 +57,9 @@ class json {
 
  public:
   /**
-   * @brief info default constructor
+   * @brief json default constructor
    */
-  info()
+  json()
       : _time_str(""),
         _application_name(""),
         _filename(""),
@@ -58,7 +68,7 @@ class json {
         _file(nullptr),
         _document(nullptr) {}
 
-  info(std::string application, std::string filename)
+  json(std::string application, std::string filename = "")
       : _time_str(""),
         _application_name(application),
         _filename(filename),
@@ -69,7 +79,7 @@ class json {
     init();
   }
 
-  ~info() {
+  ~json() {
     _time_str = "";
     _application_name = "";
     _filename = "";
@@ -138,7 +148,7 @@ class json {
     // ever write incomplete files. With a FileWriteStream, rapidjson will
     // decide to start writing whenever the buffer we provide is full
     _stream = new buffer_t();
-    _writer = new writer_t(*stream);
+    _writer = new writer_t(*_stream);
 
     // Write the initial copy of the file with an invalid json-integrity
     /*
@@ -146,9 +156,9 @@ class json {
      */
 
     // Traverse the document for writing events
-    if (stream != NULL) {
-      _document->Accept(*writer);
-      assert(writer->IsComplete());
+    if (_stream != NULL) {
+      _document->Accept(*_writer);
+      assert(_writer->IsComplete());
     }
     if (_filename != "") {
       _file = std::fopen(_filename.c_str(), "w");
@@ -336,7 +346,8 @@ class json {
       std::string str = ostr.str();
 
       value_t key(name, _document->GetAllocator());
-      json_object.AddMember(key, str, _document->GetAllocator());
+      value_t text(str, _document->GetAllocator());
+      json_object.AddMember(key, text, _document->GetAllocator());
     }
   }
 
@@ -393,6 +404,30 @@ class json {
   }
   // set <end>
 
+  /**
+   * @brief Write the document to the json file, or to stdout if the
+   * filename is empty.
+   */
+  void write() {
+    if (_document == NULL)
+      return;
+
+    buffer_t buffer;
+    writer_t writer(buffer);
+    _document->Accept(writer);
+
+    if (_filename != "") {
+      _file = std::fopen(_filename.c_str(), "w");
+      if (_file == NULL)
+        error::throw_if_exception(cudaErrorUnknown,
+                                  "Failed to open the json file.");
+      std::fputs(buffer.GetString(), _file);
+      std::fclose(_file);
+    } else {
+      std::cout << buffer.GetString() << std::endl;
+    }
+  }
+
 };  // class json
 
 }  // namespace io
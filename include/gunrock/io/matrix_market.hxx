@@ -11,14 +11,28 @@
 
 #pragma once
 
+#include <cmath>
+#include <limits>
 #include <string>
+#include <thread>
+#include <vector>
+#include <numeric>
+#include <algorithm>
 
 #include <gunrock/io/detail/mmio.hxx>
+#include <gunrock/io/detail/mapped_file.hxx>
 
 #include <gunrock/util/filepath.hxx>
+#include <gunrock/util/math.hxx>
 #include <gunrock/formats/formats.hxx>
+#include <gunrock/container/vector.hxx>
+#include <gunrock/cuda/context.hxx>
 #include <gunrock/memory.hxx>
 
+#include <thrust/binary_search.h>
+#include <thrust/scan.h>
+#include <thrust/iterator/counting_iterator.h>
+
 namespace gunrock {
 namespace io {
 
@@ -46,6 +60,263 @@ enum matrix_market_data_t { real, complex, pattern, integer };
  */
 enum matrix_market_storage_scheme_t { general, hermitian, symmetric, skew };
 
+namespace detail {
+
+/**
+ * @brief Beginning of the line after the one `p` points into.
+ */
+inline char const* next_line(char const* p, char const* end) {
+  while (p < end && *p != '\n')
+    ++p;
+  return (p < end) ? p + 1 : end;
+}
+
+inline bool is_blank(char c) {
+  return c == ' ' || c == '\t' || c == '\r';
+}
+
+/**
+ * @brief Whether the line starting at `p` holds an entry (and is neither
+ * blank nor a comment).
+ */
+inline bool is_entry(char const* p, char const* end) {
+  while (p < end && is_blank(*p))
+    ++p;
+  return p < end && *p != '\n' && *p != '%';
+}
+
+/**
+ * @brief Number of entries (lines) within [begin, end), both on line
+ * boundaries.
+ */
+inline std::size_t count_entries(char const* begin, char const* end) {
+  std::size_t count = 0;
+  for (char const* p = begin; p < end; p = next_line(p, end))
+    if (is_entry(p, end))
+      ++count;
+  return count;
+}
+
+/**
+ * @brief Parse an unsigned integer at `p`, skipping leading blanks, and
+ * advance `p` past it.
+ */
+inline unsigned long long parse_integer(char const*& p, char const* end) {
+  while (p < end && is_blank(*p))
+    ++p;
+  unsigned long long value = 0;
+  while (p < end && *p >= '0' && *p <= '9')
+    value = value * 10 + (*p++ - '0');
+  return value;
+}
+
+/**
+ * @brief Parse a (signed, optionally fractional and/or exponent) real number
+ * at `p`, skipping leading blanks, and advance `p` past it.
+ */
+inline double parse_real(char const*& p, char const* end) {
+  while (p < end && is_blank(*p))
+    ++p;
+
+  bool negative = false;
+  if (p < end && (*p == '-' || *p == '+'))
+    negative = (*p++ == '-');
+
+  // Accumulate all the digits into the mantissa, scale once at the end.
+  double mantissa = 0;
+  int exponent = 0;
+  while (p < end && *p >= '0' && *p <= '9')
+    mantissa = mantissa * 10 + (*p++ - '0');
+
+  if (p < end && *p == '.') {
+    ++p;
+    while (p < end && *p >= '0' && *p <= '9') {
+      mantissa = mantissa * 10 + (*p++ - '0');
+      --exponent;
+    }
+  }
+
+  if (p < end && (*p == 'e' || *p == 'E')) {
+    ++p;
+    bool negative_exponent = false;
+    if (p < end && (*p == '-' || *p == '+'))
+      negative_exponent = (*p++ == '-');
+    int e = 0;
+    while (p < end && *p >= '0' && *p <= '9')
+      e = e * 10 + (*p++ - '0');
+    exponent += negative_exponent ? -e : e;
+  }
+
+  double value =
+      (exponent == 0) ? mantissa : mantissa * std::pow(10.0, exponent);
+  return negative ? -value : value;
+}
+
+/**
+ * @brief Run `op(i)` for i in [0, n), one thread per index.
+ */
+template <typename operator_t>
+void parallel_for(std::size_t n, operator_t op) {
+  std::vector<std::thread> threads;
+  threads.reserve(n);
+  for (std::size_t i = 0; i < n; ++i)
+    threads.emplace_back(op, i);
+  for (auto& thread : threads)
+    thread.join();
+}
+
+/**
+ * @brief Split [begin, end) into `n` parts on line boundaries.
+ *
+ * @return std::vector<char const*> `n + 1` boundaries.
+ */
+inline std::vector<char const*> split_lines(char const* begin,
+                                            char const* end,
+                                            std::size_t n) {
+  std::vector<char const*> parts(n + 1, end);
+  parts[0] = begin;
+  for (std::size_t c = 1; c < n; ++c) {
+    char const* split = begin + ((end - begin) / n) * c;  // approximate split
+    if (split < parts[c - 1])
+      split = parts[c - 1];
+    parts[c] = next_line(split, end);
+  }
+  return parts;
+}
+
+/**
+ * @brief Entries of every part (counted in parallel), as a prefix sum: the
+ * position of every part's first entry, and the total last.
+ */
+inline std::vector<std::size_t> count_parts(
+    std::vector<char const*> const& parts) {
+  std::size_t n = parts.size() - 1;
+  std::vector<std::size_t> entries(n + 1, 0);
+  parallel_for(n, [&](std::size_t c) {
+    entries[c + 1] = count_entries(parts[c], parts[c + 1]);
+  });
+  std::partial_sum(entries.begin(), entries.end(), entries.begin());
+  return entries;
+}
+
+/**
+ * @brief Parse the entries of every part (in parallel) at the positions
+ * given by `count_parts()`, into 0-based (I, J, V).
+ *
+ * @return std::vector<std::size_t> off-diagonal entries of every part, as a
+ * prefix sum.
+ */
+template <typename vertex_t, typename weight_t>
+std::vector<std::size_t> parse_parts(std::vector<char const*> const& parts,
+                                     std::vector<std::size_t> const& entries,
+                                     bool pattern,
+                                     vertex_t* I,
+                                     vertex_t* J,
+                                     weight_t* V) {
+  std::size_t n = parts.size() - 1;
+  std::vector<std::size_t> off_diagonals(n + 1, 0);
+  parallel_for(n, [&](std::size_t c) {
+    std::size_t count = 0;
+    std::size_t i = entries[c];
+    for (char const* p = parts[c]; p < parts[c + 1];
+         p = next_line(p, parts[c + 1])) {
+      if (!is_entry(p, parts[c + 1]))
+        continue;
+
+      // adjust from 1-based to 0-based indexing
+      I[i] = (vertex_t)(parse_integer(p, parts[c + 1]) - 1);
+      J[i] = (vertex_t)(parse_integer(p, parts[c + 1]) - 1);
+      // pattern matrix defines sparsity pattern, but not values, use value
+      // 1.0 for all nonzero entries
+      V[i] = pattern ? (weight_t)1.0 : (weight_t)parse_real(p, parts[c + 1]);
+      if (I[i] != J[i])
+        ++count;
+      ++i;
+    }
+    off_diagonals[c + 1] = count;
+  });
+  std::partial_sum(off_diagonals.begin(), off_diagonals.end(),
+                   off_diagonals.begin());
+  return off_diagonals;
+}
+
+/**
+ * @brief Append (in parallel) the mirrored off-diagonal entries of every
+ * part, from position `base` on (symmetric matrices).
+ */
+template <typename vertex_t, typename weight_t>
+void mirror_parts(std::vector<std::size_t> const& entries,
+                  std::vector<std::size_t> const& off_diagonals,
+                  std::size_t base,
+                  vertex_t* I,
+                  vertex_t* J,
+                  weight_t* V) {
+  parallel_for(entries.size() - 1, [&](std::size_t c) {
+    std::size_t mirror = base + off_diagonals[c];
+    for (std::size_t i = entries[c]; i < entries[c + 1]; ++i) {
+      if (I[i] != J[i]) {
+        I[mirror] = J[i];
+        J[mirror] = I[i];
+        V[mirror] = V[i];
+        ++mirror;
+      }
+    }
+  });
+}
+
+/**
+ * @brief Count the row degrees of the entries `[0, size)` of `rows`.
+ */
+template <typename vertex_t, typename edge_t>
+__global__ void count_degrees(vertex_t const* rows,
+                              std::size_t size,
+                              edge_t* degrees) {
+  for (std::size_t i = blockIdx.x * blockDim.x + threadIdx.x; i < size;
+       i += gridDim.x * blockDim.x)
+    math::atomic::add(degrees + rows[i], (edge_t)1);
+}
+
+/**
+ * @brief Pinned (page-locked) host buffers of one chunk of entries, grown on
+ * demand.
+ */
+template <typename vertex_t, typename weight_t>
+struct staging_t {
+  vertex_t* I = nullptr;
+  vertex_t* J = nullptr;
+  weight_t* V = nullptr;
+  std::size_t capacity = 0;
+
+  staging_t() = default;
+  staging_t(staging_t const&) = delete;
+  staging_t& operator=(staging_t const&) = delete;
+  ~staging_t() { release(); }
+
+  void reserve(std::size_t size) {
+    if (size <= capacity)
+      return;
+    release();
+    I = memory::allocate<vertex_t>(size * sizeof(vertex_t),
+                                   memory_space_t::host);
+    J = memory::allocate<vertex_t>(size * sizeof(vertex_t),
+                                   memory_space_t::host);
+    V = memory::allocate<weight_t>(size * sizeof(weight_t),
+                                   memory_space_t::host);
+    capacity = size;
+  }
+
+  void release() {
+    memory::free(I, memory_space_t::host);
+    memory::free(J, memory_space_t::host);
+    memory::free(V, memory_space_t::host);
+    I = J = nullptr;
+    V = nullptr;
+    capacity = 0;
+  }
+};
+
+}  // namespace detail
+
 /**
  * @brief Reads a MARKET graph from an input-stream
  * into a specified sparse format
@@ -86,15 +357,260 @@ struct matrix_market_t {
   matrix_market_t() {}
   ~matrix_market_t() {}
 
+  /*!
+   * Number of threads used to parse the nonzeros.
+   */
+  unsigned int num_threads = std::max(1u, std::thread::hardware_concurrency());
+
+  /*!
+   * Bytes of the file parsed at a time by `load_csr()`.
+   */
+  std::size_t chunk_size = std::size_t(64) << 20;
+
   /**
    * @brief Loads the given .mtx file into a coordinate format, and returns the
    * coordinate array. This needs to be further extended to support dense
    * arrays, those are the only two formats mtx are written in.
    *
+   * @par Overview
+   * The banner and the size line are read with mmio, the nonzeros are parsed
+   * in parallel straight out of the memory-mapped file: the body is split into
+   * one chunk per thread on line boundaries, a first pass counts the entries
+   * of every chunk and a prefix sum over the counts gives each chunk its
+   * position in the coordinate arrays. Symmetric matrices are expanded in
+   * place, the mirrored off-diagonal entries of every chunk are appended at
+   * the position given by a prefix sum over the per-chunk off-diagonal counts.
+   *
    * @param _filename input file name (.mtx)
    * @return coordinate sparse format
    */
   auto load(std::string _filename) {
+    unsigned long long num_rows = 0, num_columns = 0, num_nonzeros = 0;
+    std::size_t body = read_info(_filename, num_rows, num_columns,
+                                 num_nonzeros);
+    bool symmetric = (scheme == matrix_market_storage_scheme_t::symmetric);
+
+    mapped_file_t mapping(filename);
+    char const* begin = mapping.data() + body;
+    char const* end = mapping.data() + mapping.size();
+
+    // Split the body into chunks on line boundaries, and find the entries of
+    // every chunk, and their positions.
+    auto chunks = detail::split_lines(begin, end, num_threads);
+    auto entries = detail::count_parts(chunks);
+    check_entries(entries.back(), num_nonzeros);
+
+    // Parse, and count the off-diagonals of every chunk.
+    format::coo_t<memory_space_t::host, vertex_t, edge_t, weight_t> coo;
+    coo.number_of_rows = (vertex_t)num_rows;
+    coo.number_of_columns = (vertex_t)num_columns;
+    coo.row_indices.resize(num_nonzeros);
+    coo.column_indices.resize(num_nonzeros);
+    coo.nonzero_values.resize(num_nonzeros);
+
+    bool pattern = (data == matrix_market_data_t::pattern);
+    auto off_diagonals = detail::parse_parts(
+        chunks, entries, pattern, coo.row_indices.data(),
+        coo.column_indices.data(), coo.nonzero_values.data());
+
+    std::size_t total_nonzeros = num_nonzeros;
+    if (symmetric)  // duplicate off diagonal entries
+      total_nonzeros += off_diagonals.back();
+    check_nonzeros(total_nonzeros);
+    coo.number_of_nonzeros = (edge_t)total_nonzeros;
+
+    if (symmetric) {
+      coo.row_indices.resize(total_nonzeros);
+      coo.column_indices.resize(total_nonzeros);
+      coo.nonzero_values.resize(total_nonzeros);
+
+      detail::mirror_parts(entries, off_diagonals, num_nonzeros,
+                           coo.row_indices.data(), coo.column_indices.data(),
+                           coo.nonzero_values.data());
+    }  // end symmetric case
+
+    return coo;
+  }
+
+  /**
+   * @brief Loads the given .mtx file straight into a device CSR, through a
+   * pipeline that overlaps parsing, host to device copies and the CSR build.
+   *
+   * @par Overview
+   * The file is parsed `chunk_size` bytes at a time (each chunk in parallel,
+   * as in `load()`) into one of two pinned staging buffers. While the host
+   * parses chunk k + 1, chunk k is copied into the device coordinate arrays
+   * on a copy stream, and its row degrees are counted on the compute stream
+   * (the context's stream), such that the row offsets are ready, a scan
+   * away, when the last chunk lands. The nonzeros are then sorted by (row,
+   * column) on the device (see `coo_t::sort()`). Removing the self-loops or
+   * the duplicates changes the degrees, the offsets are then derived from
+   * the sorted rows instead (as in `csr_t::from_coo()`).
+   *
+   * @param _filename input file name (.mtx).
+   * @param csr output device CSR.
+   * @param context context whose stream builds the CSR (`nullptr`: a stream
+   * of its own).
+   * @param remove_self_loops remove (i, i) entries.
+   * @param remove_duplicates keep only one of the (i, j) entries.
+   */
+  void load_csr(
+      std::string _filename,
+      format::csr_t<memory_space_t::device, vertex_t, edge_t, weight_t>& csr,
+      cuda::standard_context_t* context = nullptr,
+      bool remove_self_loops = false,
+      bool remove_duplicates = false) {
+    unsigned long long num_rows = 0, num_columns = 0, num_nonzeros = 0;
+    std::size_t body = read_info(_filename, num_rows, num_columns,
+                                 num_nonzeros);
+    bool symmetric = (scheme == matrix_market_storage_scheme_t::symmetric);
+    bool pattern = (data == matrix_market_data_t::pattern);
+    bool count_degrees = !remove_self_loops && !remove_duplicates;
+
+    mapped_file_t mapping(filename);
+    char const* begin = mapping.data() + body;
+    char const* end = mapping.data() + mapping.size();
+
+    std::size_t capacity = symmetric ? 2 * num_nonzeros : num_nonzeros;
+    format::coo_t<memory_space_t::device, vertex_t, edge_t, weight_t> coo;
+    coo.number_of_rows = (vertex_t)num_rows;
+    coo.number_of_columns = (vertex_t)num_columns;
+    coo.row_indices.resize(capacity);
+    coo.column_indices.resize(capacity);
+    coo.nonzero_values.resize(capacity);
+    vector_t<edge_t, memory_space_t::device> degrees(
+        count_degrees ? num_rows + 1 : 0, 0);
+    // The containers are initialized on the default stream.
+    error::throw_if_exception(cudaStreamSynchronize(0));
+
+    cudaStream_t own_stream = nullptr, copy_stream = nullptr;
+    if (!context)
+      error::throw_if_exception(
+          cudaStreamCreateWithFlags(&own_stream, cudaStreamNonBlocking));
+    cudaStream_t stream = context ? context->stream() : own_stream;
+    error::throw_if_exception(
+        cudaStreamCreateWithFlags(&copy_stream, cudaStreamNonBlocking));
+
+    detail::staging_t<vertex_t, weight_t> staging[2];
+    cudaEvent_t copied[2];
+    for (int b = 0; b < 2; ++b)
+      error::throw_if_exception(
+          cudaEventCreateWithFlags(&copied[b], cudaEventDisableTiming));
+
+    auto I = coo.row_indices.data().get();
+    auto J = coo.column_indices.data().get();
+    auto V = coo.nonzero_values.data().get();
+    auto D = degrees.data().get();
+
+    std::size_t position = 0, parsed = 0;
+    int turn = 0;
+    for (char const* chunk = begin; chunk < end; ++turn) {
+      char const* chunk_end =
+          ((std::size_t)(end - chunk) > chunk_size)
+              ? detail::next_line(chunk + chunk_size, end)
+              : end;
+      int b = turn % 2;
+      auto& buffer = staging[b];
+
+      // The copy that last read this staging buffer is done.
+      error::throw_if_exception(cudaEventSynchronize(copied[b]));
+
+      auto parts = detail::split_lines(chunk, chunk_end, num_threads);
+      auto entries = detail::count_parts(parts);
+      std::size_t count = entries.back();
+      parsed += count;
+      if (parsed > num_nonzeros)
+        check_entries(parsed, num_nonzeros);
+
+      buffer.reserve(symmetric ? 2 * count : count);
+      auto off_diagonals = detail::parse_parts(parts, entries, pattern,
+                                               buffer.I, buffer.J, buffer.V);
+      std::size_t size = count;
+      if (symmetric) {
+        detail::mirror_parts(entries, off_diagonals, count, buffer.I,
+                             buffer.J, buffer.V);
+        size += off_diagonals.back();
+      }
+
+      if (size) {
+        error::throw_if_exception(
+            cudaMemcpyAsync(I + position, buffer.I, size * sizeof(vertex_t),
+                            cudaMemcpyHostToDevice, copy_stream));
+        error::throw_if_exception(
+            cudaMemcpyAsync(J + position, buffer.J, size * sizeof(vertex_t),
+                            cudaMemcpyHostToDevice, copy_stream));
+        error::throw_if_exception(
+            cudaMemcpyAsync(V + position, buffer.V, size * sizeof(weight_t),
+                            cudaMemcpyHostToDevice, copy_stream));
+      }
+      error::throw_if_exception(cudaEventRecord(copied[b], copy_stream));
+
+      // Degrees of the chunk, while the host parses the next one.
+      if (count_degrees && size) {
+        error::throw_if_exception(cudaStreamWaitEvent(stream, copied[b], 0));
+        unsigned int blocks =
+            (unsigned int)std::min<std::size_t>((size + 255) / 256, 4096);
+        detail::count_degrees<<<blocks, 256, 0, stream>>>(I + position, size,
+                                                          D);
+        error::throw_if_exception(cudaPeekAtLastError());
+      }
+
+      position += size;
+      chunk = chunk_end;
+    }
+
+    check_entries(parsed, num_nonzeros);
+    check_nonzeros(position);
+
+    error::throw_if_exception(cudaStreamSynchronize(copy_stream));
+    error::throw_if_exception(cudaStreamSynchronize(stream));
+    for (int b = 0; b < 2; ++b)
+      cudaEventDestroy(copied[b]);
+    cudaStreamDestroy(copy_stream);
+
+    coo.number_of_nonzeros = (edge_t)position;
+    coo.row_indices.resize(position);
+    coo.column_indices.resize(position);
+    coo.nonzero_values.resize(position);
+    coo.sort(remove_self_loops, remove_duplicates);
+
+    csr.number_of_rows = coo.number_of_rows;
+    csr.number_of_columns = coo.number_of_columns;
+    csr.number_of_nonzeros = coo.number_of_nonzeros;
+    csr.row_offsets.resize(num_rows + 1);
+
+    // Same (default) stream as the sort.
+    auto policy = thrust::device;
+    if (count_degrees) {
+      // degrees[num_rows] is 0, the scan ends with the number of nonzeros.
+      thrust::exclusive_scan(policy, degrees.begin(), degrees.end(),
+                             csr.row_offsets.begin());
+    } else {
+      auto rows = coo.row_indices.data().get();
+      thrust::lower_bound(
+          policy, rows, rows + csr.number_of_nonzeros,
+          thrust::counting_iterator<vertex_t>(0),
+          thrust::counting_iterator<vertex_t>(coo.number_of_rows + 1),
+          csr.row_offsets.begin());
+    }
+    if (own_stream)
+      cudaStreamDestroy(own_stream);
+
+    csr.column_indices.swap(coo.column_indices);
+    csr.nonzero_values.swap(coo.nonzero_values);
+  }
+
+ private:
+  /**
+   * @brief Read the banner and the size line of the file, and the format,
+   * data type and storage scheme it declares.
+   *
+   * @return std::size_t position of the body (first entry) in the file.
+   */
+  std::size_t read_info(std::string _filename,
+                        unsigned long long& num_rows,
+                        unsigned long long& num_columns,
+                        unsigned long long& num_nonzeros) {
     filename = _filename;
     dataset = util::extract_dataset(util::extract_filename(filename));
 
@@ -111,101 +627,65 @@ struct matrix_market_t {
       exit(1);
     }
 
-    int num_rows, num_columns, num_nonzeros;  // XXX: requires all ints intially
-    if ((mm_read_mtx_crd_size(file, &num_rows, &num_columns, &num_nonzeros)) !=
-        0) {
+    // Size line (64-bit), skipping the comments.
+    char line[MM_MAX_LINE_LENGTH];
+    do {
+      if (fgets(line, MM_MAX_LINE_LENGTH, file) == NULL) {
+        std::cerr << "Could not read file info (M, N, NNZ)" << std::endl;
+        exit(1);
+      }
+    } while (line[0] == '%');
+    if (sscanf(line, "%llu %llu %llu", &num_rows, &num_columns,
+               &num_nonzeros) != 3) {
       std::cerr << "Could not read file info (M, N, NNZ)" << std::endl;
       exit(1);
     }
+    std::size_t body = ftell(file);
+    fclose(file);
 
-    // mtx are generally written as coordinate formaat
-    format::coo_t<memory_space_t::host, vertex_t, edge_t, weight_t> coo(
-        (vertex_t)num_rows, (vertex_t)num_columns, (edge_t)num_nonzeros);
+    if (num_rows > (unsigned long long)std::numeric_limits<vertex_t>::max() ||
+        num_columns >
+            (unsigned long long)std::numeric_limits<vertex_t>::max()) {
+      std::cerr << "Number of rows/columns exceeds the vertex type"
+                << std::endl;
+      exit(1);
+    }
 
     if (mm_is_coordinate(code))
       format = matrix_market_format_t::coordinate;
     else
       format = matrix_market_format_t::array;
 
-    if (mm_is_pattern(code)) {
+    if (mm_is_pattern(code))
       data = matrix_market_data_t::pattern;
-
-      // pattern matrix defines sparsity pattern, but not values
-      for (vertex_t i = 0; i < num_nonzeros; ++i) {
-        assert(fscanf(file, " %d %d \n", &(coo.row_indices[i]),
-                      &(coo.column_indices[i])) == 2);
-        coo.row_indices[i]--;  // adjust from 1-based to 0-based indexing
-        coo.column_indices[i]--;
-        coo.nonzero_values[i] =
-            (weight_t)1.0;  // use value 1.0 for all nonzero entries
-      }
-    } else if (mm_is_real(code) || mm_is_integer(code)) {
-      if (mm_is_real(code))
-        data = matrix_market_data_t::real;
-      else
-        data = matrix_market_data_t::integer;
-
-      for (vertex_t i = 0; i < coo.number_of_nonzeros; ++i) {
-        vertex_t I, J;
-        double V;  // always read in a double and convert later if necessary
-
-        assert(fscanf(file, " %d %d %lf \n", &I, &J, &V) == 3);
-
-        coo.row_indices[i] = (vertex_t)I - 1;
-        coo.column_indices[i] = (vertex_t)J - 1;
-        coo.nonzero_values[i] = (weight_t)V;
-      }
-    } else {
+    else if (mm_is_real(code))
+      data = matrix_market_data_t::real;
+    else if (mm_is_integer(code))
+      data = matrix_market_data_t::integer;
+    else {
       std::cerr << "Unrecognized matrix market format type" << std::endl;
       exit(1);
     }
 
-    if (mm_is_symmetric(code)) {  // duplicate off diagonal entries
-      scheme = matrix_market_storage_scheme_t::symmetric;
-      vertex_t off_diagonals = 0;
-      for (vertex_t i = 0; i < coo.number_of_nonzeros; ++i) {
-        if (coo.row_indices[i] != coo.column_indices[i])
-          ++off_diagonals;
-      }
-
-      vertex_t _nonzeros =
-          2 * off_diagonals + (coo.number_of_nonzeros - off_diagonals);
-
-      vector_t<vertex_t, memory_space_t::host> new_I(_nonzeros);
-      vector_t<vertex_t, memory_space_t::host> new_J(_nonzeros);
-      vector_t<weight_t, memory_space_t::host> new_V(_nonzeros);
-
-      vertex_t* _I = new_I.data();
-      vertex_t* _J = new_J.data();
-      weight_t* _V = new_V.data();
-
-      vertex_t ptr = 0;
-      for (vertex_t i = 0; i < coo.number_of_nonzeros; ++i) {
-        if (coo.row_indices[i] != coo.column_indices[i]) {
-          _I[ptr] = coo.row_indices[i];
-          _J[ptr] = coo.column_indices[i];
-          _V[ptr] = coo.nonzero_values[i];
-          ++ptr;
-          _J[ptr] = coo.row_indices[i];
-          _I[ptr] = coo.column_indices[i];
-          _V[ptr] = coo.nonzero_values[i];
-          ++ptr;
-        } else {
-          _I[ptr] = coo.row_indices[i];
-          _J[ptr] = coo.column_indices[i];
-          _V[ptr] = coo.nonzero_values[i];
-          ++ptr;
-        }
-      }
-      coo.row_indices = new_I;
-      coo.column_indices = new_J;
-      coo.nonzero_values = new_V;
-      coo.number_of_nonzeros = _nonzeros;
-    }  // end symmetric case
+    scheme = mm_is_symmetric(code) ? matrix_market_storage_scheme_t::symmetric
+                                   : matrix_market_storage_scheme_t::general;
+    return body;
+  }
 
-    fclose(file);
+  void check_entries(std::size_t entries, unsigned long long num_nonzeros) {
+    if (entries != num_nonzeros) {
+      std::cerr << "Number of entries (" << entries
+                << ") does not match the file info (" << num_nonzeros << ")"
+                << std::endl;
+      exit(1);
+    }
+  }
 
-    return coo;
+  void check_nonzeros(std::size_t total_nonzeros) {
+    if (total_nonzeros > (std::size_t)std::numeric_limits<edge_t>::max()) {
+      std::cerr << "Number of nonzeros exceeds the edge type" << std::endl;
+      exit(1);
+    }
   }
 };
 
@@ -15,14 +15,17 @@
 #include <memory>
 
 #include <thrust/device_ptr.h>
+#include <thrust/device_malloc_allocator.h>
 #include <gunrock/error.hxx>
+#include <gunrock/memory_pool.hxx>
 
 namespace gunrock {
 namespace memory {
 
 /**
- * @brief memory space; cuda (device) or host.
- * Can be extended to support uvm and multi-gpu.
+ * @brief memory space; cuda (device), host or managed (unified memory,
+ * `cudaMallocManaged`, migrates between host and device on demand and can
+ * oversubscribe the device memory).
  *
  * @todo change this enum to support cudaMemoryType
  * (see ref;  std::underlying_type<cudaMemoryType>::type)
@@ -31,10 +34,26 @@ namespace memory {
  * for this.
  *
  */
-enum memory_space_t { device, host };
+enum memory_space_t { device, host, managed };
 
 /**
- * @brief allocate a pointer with size on a specfied memory space.
+ * @brief Is a memory space accessible by device kernels (and hence by
+ * thrust's device execution policy)? Device and managed memory are.
+ *
+ * @param space memory space.
+ * @return bool
+ */
+__host__ __device__ constexpr bool is_device_accessible(memory_space_t space) {
+  return space != memory_space_t::host;
+}
+
+/**
+ * @brief allocate a pointer with size on a specfied memory space. Device
+ * memory is drawn from the default pool of the current device (see
+ * `memory::pool_t`, `cudaMalloc` if no context exists yet), and returns to
+ * the same pool on `free()`. Pinned host memory (`cudaMallocHost`) and
+ * managed memory are not pooled, they are meant for long-lived buffers
+ * (staging, graph data).
  *
  * @tparam T return type of the pointer being allocated.
  * @param size size in bytes (bytes to be allocated).
@@ -44,9 +63,12 @@ enum memory_space_t { device, host };
 template <typename type_t>
 inline type_t* allocate(std::size_t size, memory_space_t space) {
   void* pointer = nullptr;
-  if (size) {
-    error::error_t status = (device == space) ? cudaMalloc(&pointer, size)
-                                              : cudaMallocHost(&pointer, size);
+  if (size && device == space)
+    pointer = owned_allocations_t::allocate(size);
+  else if (size) {
+    error::error_t status = (managed == space)
+                                ? cudaMallocManaged(&pointer, size)
+                                : cudaMallocHost(&pointer, size);
     error::throw_if_exception(status);
   }
 
@@ -62,13 +84,104 @@ inline type_t* allocate(std::size_t size, memory_space_t space) {
  */
 template <typename type_t>
 inline void free(type_t* pointer, memory_space_t space) {
-  if (pointer) {
-    error::error_t status = (device == space) ? cudaFree((void*)pointer)
-                                              : cudaFreeHost((void*)pointer);
+  if (pointer && device == space)
+    owned_allocations_t::release((void*)pointer);
+  else if (pointer) {
+    error::error_t status = (host == space) ? cudaFreeHost((void*)pointer)
+                                            : cudaFree((void*)pointer);
     error::throw_if_exception(status);
   }
 }
 
+/**
+ * @brief Hint that managed memory is mostly read (graph topology): the driver
+ * keeps read-only copies where it is accessed instead of migrating the pages
+ * back and forth. No-op on memory that is not managed.
+ *
+ * @param pointer managed memory.
+ * @param size size in bytes.
+ * @param device device that accesses the memory.
+ */
+inline void advise_read_mostly(void const* pointer,
+                               std::size_t size,
+                               int device = 0) {
+  cudaPointerAttributes attributes;
+  if (!pointer || !size)
+    return;
+  if (cudaPointerGetAttributes(&attributes, pointer) != cudaSuccess) {
+    cudaGetLastError();  // unregistered host memory (pre CUDA 11).
+    return;
+  }
+  if (attributes.type != cudaMemoryTypeManaged)
+    return;
+
+  error::throw_if_exception(cudaMemAdvise(pointer, size,
+                                          cudaMemAdviseSetReadMostly, device));
+  error::throw_if_exception(cudaMemAdvise(
+      pointer, size, cudaMemAdviseSetAccessedBy, device));
+}
+
+/**
+ * @brief Migrate (asynchronously) a range of managed memory to a device
+ * ahead of its use, instead of on demand (page faults) by the kernels.
+ *
+ * @param pointer managed memory.
+ * @param size size in bytes.
+ * @param device destination device.
+ * @param stream stream the migration is ordered on.
+ */
+inline void prefetch(void const* pointer,
+                     std::size_t size,
+                     int device,
+                     cudaStream_t stream = 0) {
+  if (pointer && size)
+    error::throw_if_exception(
+        cudaMemPrefetchAsync(pointer, size, device, stream));
+}
+
+/**
+ * @brief Allocator of the managed vectors (`vector_t<type_t, managed>`),
+ * `cudaMallocManaged`/`cudaFree`. Managed memory is not drawn from the
+ * stream-ordered pool, it is meant for the (large, long-lived) graph data.
+ *
+ * @tparam type_t value type.
+ */
+template <typename type_t>
+struct managed_allocator_t : thrust::device_malloc_allocator<type_t> {
+  using super_t = thrust::device_malloc_allocator<type_t>;
+  using pointer = typename super_t::pointer;
+  using size_type = typename super_t::size_type;
+
+  template <typename other_t>
+  struct rebind {
+    using other = managed_allocator_t<other_t>;
+  };
+
+  managed_allocator_t() = default;
+
+  template <typename other_t>
+  managed_allocator_t(managed_allocator_t<other_t> const&) {}
+
+  pointer allocate(size_type n) {
+    return pointer(memory::allocate<type_t>(n * sizeof(type_t),
+                                            memory_space_t::managed));
+  }
+
+  void deallocate(pointer p, size_type) {
+    memory::free(thrust::raw_pointer_cast(p), memory_space_t::managed);
+  }
+
+  template <typename other_t>
+  bool operator==(managed_allocator_t<other_t> const&) const {
+    return true;
+  }
+
+  template <typename other_t>
+  bool operator!=(managed_allocator_t<other_t> const&) const {
+    return false;
+  }
+};
+
 /**
  * @brief Wrapper around thrust::raw_pointer_cast() to accept .data() or raw
  * pointer and return a raw pointer. Useful when we would like to return a raw
@@ -0,0 +1,562 @@
+/**
+ * @file memory_pool.hxx
+ * @author Muhammad Osama (mosama@ucdavis.edu)
+ * @brief Stream-ordered memory pool, and thrust-compatible allocators drawing
+ * from it.
+ * @version 0.1
+ * @date 2021-06-07
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#pragma once
+
+#include <map>
+#include <set>
+#include <algorithm>
+#include <mutex>
+#include <unordered_map>
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include <iostream>
+
+#include <thrust/device_ptr.h>
+#include <thrust/device_malloc_allocator.h>
+
+#include <gunrock/error.hxx>
+
+namespace gunrock {
+namespace memory {
+
+/**
+ * @brief Stream-ordered, device memory pool.
+ *
+ * @par Overview
+ * With CUDA 11.2 or newer, the pool is a `cudaMemPool_t` whose release
+ * threshold is raised such that freed memory stays reserved for the pool.
+ * Allocations go through `cudaMallocFromPoolAsync` and `cudaFreeAsync` on the
+ * pool's stream, so once the pool is warm, no allocation reaches the driver.
+ * With older toolkits, a caching arena is used instead: freed blocks are kept
+ * (binned by power-of-two sizes) and reused once the work enqueued before
+ * their release has completed.
+ *
+ * A `cuda::standard_context_t` owns one pool for its device, runs on the
+ * pool's stream, and attaches it to the device (see `pool_t::attach()`).
+ * The allocators below draw from the device's default pool (see
+ * `pool_t::get_default()`): the calling thread's scoped default if any, else
+ * the one made default explicitly (`pool_t::set_default()`), else the first
+ * attached pool still alive. Contexts created later (e.g., by an algorithm's
+ * `run()` without a context) do not replace it.
+ */
+class pool_t {
+ public:
+  /**
+   * @param _device device of the pool.
+   *
+   * The pool creates (and owns) its stream, a non-blocking stream of
+   * `_device`: containers drawing from the pool keep it, and hence the
+   * stream their releases are ordered on, alive beyond the context.
+   */
+  pool_t(int _device) : device(_device) {
+    cudaSetDevice(device);
+    error::throw_if_exception(
+        cudaStreamCreateWithFlags(&stream, cudaStreamNonBlocking),
+        "Failed to create the stream of the memory pool.");
+#if CUDART_VERSION >= 11020
+    cudaMemPoolProps props = {};
+    props.allocType = cudaMemAllocationTypePinned;
+    props.handleTypes = cudaMemHandleTypeNone;
+    props.location.type = cudaMemLocationTypeDevice;
+    props.location.id = device;
+    error::throw_if_exception(cudaMemPoolCreate(&pool, &props),
+                              "Failed to create the memory pool.");
+
+    // Keep all the freed memory within the pool (never trim on sync).
+    std::uint64_t threshold = UINT64_MAX;
+    cudaMemPoolSetAttribute(pool, cudaMemPoolAttrReleaseThreshold, &threshold);
+#endif
+    cudaEventCreateWithFlags(&ordering_event, cudaEventDisableTiming);
+  }
+
+  ~pool_t() {
+    // The last release may happen on any thread and device.
+    int current = 0;
+    cudaGetDevice(&current);
+    cudaSetDevice(device);
+    cudaStreamSynchronize(stream);
+#if CUDART_VERSION >= 11020
+    cudaMemPoolDestroy(pool);
+#else
+    for (auto& block : cache) {
+      cudaEventDestroy(block.second.released);
+      cudaFree(block.second.pointer);
+    }
+#endif
+    cudaEventDestroy(ordering_event);
+    cudaStreamDestroy(stream);
+    cudaSetDevice(current);
+  }
+
+  pool_t(const pool_t& rhs) = delete;
+  pool_t& operator=(const pool_t& rhs) = delete;
+
+  /**
+   * @brief Allocate `bytes` (ordered on the pool's stream).
+   *
+   * @param bytes size in bytes.
+   * @return void* device pointer.
+   */
+  void* allocate(std::size_t bytes) {
+    void* pointer = nullptr;
+    if (!bytes)
+      return pointer;
+
+#if CUDART_VERSION >= 11020
+    error::throw_if_exception(
+        cudaMallocFromPoolAsync(&pointer, bytes, pool, stream),
+        "Pool allocation failed.");
+#else
+    std::lock_guard<std::mutex> guard(lock);
+    std::size_t bin = bin_size(bytes);
+    auto range = cache.equal_range(bin);
+    for (auto it = range.first; it != range.second; ++it) {
+      if (cudaEventQuery(it->second.released) == cudaSuccess) {
+        pointer = it->second.pointer;
+        cudaEventDestroy(it->second.released);
+        cache.erase(it);
+        return pointer;
+      }
+    }
+    error::throw_if_exception(cudaMalloc(&pointer, bin),
+                              "Pool allocation failed.");
+    reserved += bin;
+#endif
+    return pointer;
+  }
+
+  /**
+   * @brief Release a pointer allocated with `allocate()` (ordered on the
+   * pool's stream), the memory is returned to the pool, not the driver.
+   *
+   * @param pointer device pointer.
+   * @param bytes size in bytes used during allocation.
+   */
+  void deallocate(void* pointer, std::size_t bytes) {
+    if (!pointer)
+      return;
+
+#if CUDART_VERSION >= 11020
+    error::throw_if_exception(cudaFreeAsync(pointer, stream),
+                              "Pool deallocation failed.");
+#else
+    std::lock_guard<std::mutex> guard(lock);
+    cached_block_t block;
+    block.pointer = pointer;
+    cudaEventCreateWithFlags(&block.released, cudaEventDisableTiming);
+    cudaEventRecord(block.released, stream);
+    cache.emplace(bin_size(bytes), block);
+#endif
+  }
+
+  /**
+   * @brief Order the legacy default stream after all the work enqueued on the
+   * pool's stream (such as an allocation), or the other way around. Used by
+   * `pool_allocator_t`, because thrust containers run their internal
+   * operations on the default stream.
+   *
+   * @param from stream to wait on.
+   * @param to stream that waits.
+   */
+  void order(cudaStream_t from, cudaStream_t to) {
+    std::lock_guard<std::mutex> guard(lock);
+    cudaEventRecord(ordering_event, from);
+    cudaStreamWaitEvent(to, ordering_event, 0);
+  }
+
+  /**
+   * @brief Order the pool's stream after all the work enqueued so far on
+   * the legacy default stream and on the streams of the other pools
+   * attached to the device. The (non-blocking) context streams do not wait
+   * for each other, and a container drawing from this pool may be used on
+   * any of them; a release ordered after this is safe for all of them.
+   */
+  void order_after_device() {
+    order(0, stream);
+    for (auto& other : get_attached(device))
+      if (other.get() != this)
+        order(other->get_stream(), stream);
+  }
+
+  /**
+   * @brief Device memory reserved by the pool (in use or cached), grows when
+   * an allocation reaches the driver.
+   *
+   * @return std::size_t bytes.
+   */
+  std::size_t get_reserved_bytes() {
+#if CUDART_VERSION >= 11020
+    std::uint64_t bytes = 0;
+    cudaMemPoolGetAttribute(pool, cudaMemPoolAttrReservedMemCurrent, &bytes);
+    return bytes;
+#else
+    std::lock_guard<std::mutex> guard(lock);
+    return reserved;
+#endif
+  }
+
+  /**
+   * @brief Let `peer` read and write the memory of this pool. Peer access
+   * between devices (`cudaDeviceEnablePeerAccess()`) does not extend to the
+   * allocations of a `cudaMemPool_t`, their access is granted per pool. The
+   * (pre CUDA 11.2) caching arena draws from `cudaMalloc`, which peer access
+   * already covers.
+   *
+   * @param peer device.
+   */
+  void set_peer_access(int peer) {
+#if CUDART_VERSION >= 11020
+    if (peer == device)
+      return;
+    cudaMemAccessDesc access = {};
+    access.location.type = cudaMemLocationTypeDevice;
+    access.location.id = peer;
+    access.flags = cudaMemAccessFlagsProtReadWrite;
+    error::throw_if_exception(cudaMemPoolSetAccess(pool, &access, 1),
+                              "Failed to grant peer access to the pool.");
+#endif
+  }
+
+  cudaStream_t get_stream() const { return stream; }
+  int get_device() const { return device; }
+
+  /**
+   * @brief Default pool of the current device (the calling thread's own, if
+   * set with `scoped_default_t`), `nullptr` if no context (and hence no pool)
+   * exists for the device.
+   *
+   * @return std::shared_ptr<pool_t>
+   */
+  static std::shared_ptr<pool_t> get_default() {
+    int current = 0;
+    cudaGetDevice(&current);
+    auto& local = thread_default();
+    if (local && local->get_device() == current)
+      return local;
+
+    std::lock_guard<std::mutex> guard(registry_lock());
+    auto it = registry().find(current);
+    if (it != registry().end())
+      if (auto p = it->second.lock())
+        return p;
+
+    // First attached pool still alive.
+    for (auto& attached : attachments()[current])
+      if (auto p = attached.lock())
+        return p;
+    return nullptr;
+  }
+
+  /**
+   * @brief Make `p` the default pool of its device (for all the threads),
+   * explicitly and until `p` is released or another pool is made default.
+   *
+   * @param p pool.
+   */
+  static void set_default(std::shared_ptr<pool_t> const& p) {
+    std::lock_guard<std::mutex> guard(registry_lock());
+    registry()[p->get_device()] = p;
+  }
+
+  /**
+   * @brief Attach `p` to its device: see `order_after_device()`, and
+   * `get_default()` for when an attached pool is the default one.
+   *
+   * @param p pool.
+   */
+  static void attach(std::shared_ptr<pool_t> const& p) {
+    std::lock_guard<std::mutex> guard(registry_lock());
+    auto& pools = attachments()[p->get_device()];
+    pools.erase(std::remove_if(pools.begin(), pools.end(),
+                               [](std::weak_ptr<pool_t> const& w) {
+                                 return w.expired();
+                               }),
+                pools.end());
+    pools.push_back(p);
+
+    for (auto& peer : peers()[p->get_device()])
+      p->set_peer_access(peer);
+  }
+
+  /**
+   * @brief Let `peer` access the pools of `device`: the ones attached so far
+   * and the ones attached later (see `cuda::multi_context_t`'s
+   * `enable_peer_access()`).
+   *
+   * @param device device of the pools.
+   * @param peer device granted access.
+   */
+  static void grant_peer_access(int device, int peer) {
+    std::lock_guard<std::mutex> guard(registry_lock());
+    if (!peers()[device].insert(peer).second)
+      return;
+    for (auto& attached : attachments()[device])
+      if (auto p = attached.lock())
+        p->set_peer_access(peer);
+  }
+
+  /**
+   * @brief Attached pools of `device` still alive.
+   */
+  static std::vector<std::shared_ptr<pool_t>> get_attached(int device) {
+    std::lock_guard<std::mutex> guard(registry_lock());
+    std::vector<std::shared_ptr<pool_t>> pools;
+    for (auto& attached : attachments()[device])
+      if (auto p = attached.lock())
+        pools.push_back(p);
+    return pools;
+  }
+
+  /**
+   * @brief Make `p` the default pool of its device for the calling thread
+   * only, as long as the guard is alive. Used by threads that each own a
+   * context (stream), such that their allocations are ordered on their own
+   * stream (see `operators::batch::executor_t`).
+   */
+  class scoped_default_t {
+   public:
+    scoped_default_t(std::shared_ptr<pool_t> const& p)
+        : previous(thread_default()) {
+      thread_default() = p;
+    }
+    ~scoped_default_t() { thread_default() = previous; }
+
+    scoped_default_t(const scoped_default_t& rhs) = delete;
+    scoped_default_t& operator=(const scoped_default_t& rhs) = delete;
+
+   private:
+    std::shared_ptr<pool_t> previous;
+  };  // class scoped_default_t
+
+ private:
+  int device;
+  cudaStream_t stream;
+  cudaEvent_t ordering_event;
+  std::mutex lock;
+
+#if CUDART_VERSION >= 11020
+  cudaMemPool_t pool;
+#else
+  struct cached_block_t {
+    void* pointer;
+    cudaEvent_t released;
+  };
+  std::multimap<std::size_t, cached_block_t> cache;
+  std::size_t reserved = 0;
+
+  static std::size_t bin_size(std::size_t bytes) {
+    std::size_t bin = 256;  // smallest bin, cudaMalloc alignment.
+    while (bin < bytes)
+      bin <<= 1;
+    return bin;
+  }
+#endif
+
+  static std::map<int, std::weak_ptr<pool_t>>& registry() {
+    static std::map<int, std::weak_ptr<pool_t>> pools;
+    return pools;
+  }
+
+  static std::map<int, std::vector<std::weak_ptr<pool_t>>>& attachments() {
+    static std::map<int, std::vector<std::weak_ptr<pool_t>>> pools;
+    return pools;
+  }
+
+  static std::map<int, std::set<int>>& peers() {
+    static std::map<int, std::set<int>> granted;
+    return granted;
+  }
+
+  static std::mutex& registry_lock() {
+    static std::mutex registry_mutex;
+    return registry_mutex;
+  }
+
+  static std::shared_ptr<pool_t>& thread_default() {
+    thread_local std::shared_ptr<pool_t> local;
+    return local;
+  }
+};  // class pool_t
+
+/**
+ * @brief thrust container allocator (e.g. `thrust::device_vector<type_t,
+ * pool_allocator_t<type_t>>`), draws from the default pool of the current
+ * device at the time the allocator (container) is constructed. Falls back to
+ * `cudaMalloc`/`cudaFree` when there is no pool.
+ *
+ * @note Containers run their internal operations (fill, copy) on the default
+ * stream, those are ordered after the (stream-ordered) allocation. The
+ * release is ordered after them and after the work of all the contexts of
+ * the device (`pool_t::order_after_device()`), any of which may have used
+ * the container.
+ *
+ * @tparam type_t value type.
+ */
+template <typename type_t>
+struct pool_allocator_t : thrust::device_malloc_allocator<type_t> {
+  using super_t = thrust::device_malloc_allocator<type_t>;
+  using pointer = typename super_t::pointer;
+  using size_type = typename super_t::size_type;
+
+  template <typename other_t>
+  struct rebind {
+    using other = pool_allocator_t<other_t>;
+  };
+
+  std::shared_ptr<pool_t> pool;
+
+  pool_allocator_t() : pool(pool_t::get_default()) {}
+
+  template <typename other_t>
+  pool_allocator_t(pool_allocator_t<other_t> const& other)
+      : pool(other.pool) {}
+
+  pointer allocate(size_type n) {
+    if (!pool)
+      return super_t::allocate(n);
+
+    auto raw = static_cast<type_t*>(pool->allocate(n * sizeof(type_t)));
+    pool->order(pool->get_stream(), 0);
+    return pointer(raw);
+  }
+
+  void deallocate(pointer p, size_type n) {
+    if (!pool)
+      return super_t::deallocate(p, n);
+
+    pool->order_after_device();
+    pool->deallocate(thrust::raw_pointer_cast(p), n * sizeof(type_t));
+  }
+
+  template <typename other_t>
+  bool operator==(pool_allocator_t<other_t> const& other) const {
+    return pool == other.pool;
+  }
+
+  template <typename other_t>
+  bool operator!=(pool_allocator_t<other_t> const& other) const {
+    return pool != other.pool;
+  }
+};
+
+/**
+ * @brief Allocator for thrust's temporary storage, passed to the execution
+ * policy (`thrust::cuda::par(allocator).on(stream)`). The temporary storage
+ * is used on the pool's stream only, so no extra ordering is required.
+ */
+struct temporary_allocator_t {
+  using value_type = char;
+
+  std::shared_ptr<pool_t> pool;
+
+  temporary_allocator_t(std::shared_ptr<pool_t> const& _pool) : pool(_pool) {}
+
+  char* allocate(std::ptrdiff_t bytes) {
+    if (pool)
+      return static_cast<char*>(pool->allocate(bytes));
+
+    void* pointer = nullptr;
+    error::throw_if_exception(cudaMalloc(&pointer, bytes));
+    return static_cast<char*>(pointer);
+  }
+
+  void deallocate(char* pointer, std::size_t bytes) {
+    if (pool)
+      pool->deallocate(pointer, bytes);
+    else
+      error::throw_if_exception(cudaFree(pointer));
+  }
+};
+
+/**
+ * @brief Device allocations of `memory::allocate()` and `memory::free()`,
+ * each one with the pool it was drawn from (kept alive until the release)
+ * and its size, such that it returns to that pool whichever pool is the
+ * default one when it is released.
+ */
+class owned_allocations_t {
+ public:
+  /**
+   * @brief Allocate `bytes` from the default pool of the current device, or
+   * with `cudaMalloc` if there is no pool. The allocation is ordered on the
+   * pool's (context) stream, the default stream waits for it as with
+   * `pool_allocator_t`.
+   *
+   * @param bytes size in bytes.
+   * @return void* device pointer.
+   */
+  static void* allocate(std::size_t bytes) {
+    void* pointer = nullptr;
+    if (!bytes)
+      return pointer;
+
+    auto pool = pool_t::get_default();
+    if (!pool) {
+      error::throw_if_exception(cudaMalloc(&pointer, bytes));
+      return pointer;
+    }
+
+    pointer = pool->allocate(bytes);
+    pool->order(pool->get_stream(), 0);
+    std::lock_guard<std::mutex> guard(lock());
+    owners()[pointer] = {pool, bytes};
+    return pointer;
+  }
+
+  /**
+   * @brief Release a pointer of `allocate()`, to its own pool (ordered after
+   * the work of all the contexts of its device), or with `cudaFree` if it
+   * was not drawn from a pool.
+   */
+  static void release(void* pointer) {
+    if (!pointer)
+      return;
+
+    owner_t owner;
+    {
+      std::lock_guard<std::mutex> guard(lock());
+      auto it = owners().find(pointer);
+      if (it != owners().end()) {
+        owner = it->second;
+        owners().erase(it);
+      }
+    }
+
+    if (!owner.pool) {
+      error::throw_if_exception(cudaFree(pointer));
+      return;
+    }
+    owner.pool->order_after_device();
+    owner.pool->deallocate(pointer, owner.bytes);
+  }
+
+ private:
+  struct owner_t {
+    std::shared_ptr<pool_t> pool;
+    std::size_t bytes = 0;
+  };
+
+  static std::unordered_map<void*, owner_t>& owners() {
+    static std::unordered_map<void*, owner_t> allocations;
+    return allocations;
+  }
+
+  static std::mutex& lock() {
+    static std::mutex owners_mutex;
+    return owners_mutex;
+  }
+};  // class owned_allocations_t
+
+}  // namespace memory
+}  // namespace gunrock
@@ -26,5 +26,9 @@ bool is_binary_csr(std::string filename) {
   return filename.substr(filename.size() - 4) == ".csr";
 }
 
+bool is_binary_csc(std::string filename) {
+  return filename.substr(filename.size() - 4) == ".csc";
+}
+
 }  // namespace util
 }  // namespace gunrock
\ No newline at end of file
@@ -10,6 +10,7 @@
 #include <cmath>
 #include <cstdlib>
 #include <functional>
+#include <type_traits>
 
 #include <gunrock/cuda/atomic_functions.hxx>
 
@@ -71,7 +72,7 @@ namespace atomic {
 template <typename type_t>
 __host__ __device__ __forceinline__ type_t add(type_t* address, type_t value) {
 #ifdef __CUDA_ARCH__
-  return atomicAdd(address, value);
+  return cuda::atomicAdd(address, value);
 #else
   // use std::atomic::fetch_add();
   auto old_value = *address;
@@ -103,7 +104,7 @@ __host__ __device__ __forceinline__ type_t cas(type_t* address,
                                                type_t compare,
                                                type_t value) {
 #ifdef __CUDA_ARCH__
-  return atomicCAS(address, compare, value);
+  return cuda::atomicCAS(address, compare, value);
 #else
   type_t old = *address;
   *address = (old == compare) ? value : old;  // use std::atomic;
@@ -111,6 +112,56 @@ __host__ __device__ __forceinline__ type_t cas(type_t* address,
 #endif
 }
 
+/**
+ * @brief Atomic bitwise or, used to set bits of a (32 or 64-bit) mask.
+ */
+template <typename type_t>
+__host__ __device__ __forceinline__ type_t bit_or(type_t* address,
+                                                  type_t value) {
+  static_assert(std::is_integral<type_t>::value &&
+                    (sizeof(type_t) == 4 || sizeof(type_t) == 8),
+                "bit_or requires a 32 or 64-bit integral type.");
+#ifdef __CUDA_ARCH__
+  if constexpr (sizeof(type_t) == 8)
+    return (type_t)atomicOr((unsigned long long int*)address,
+                            (unsigned long long int)value);
+  else
+    return (type_t)atomicOr((unsigned int*)address, (unsigned int)value);
+#else
+  type_t old = *address;
+  *address |= value;  // use std::atomic;
+  return old;
+#endif
+}
+
+/**
+ * @brief Warp-aggregated atomic add: the active lanes of a warp adding to the
+ * same address are combined into one atomic (by the first of them). `value`
+ * must be the same for all these lanes; each lane gets the value it would
+ * have read had the adds been issued one by one (in lane order), e.g. exactly
+ * one lane decrementing a counter sees it at 1.
+ */
+template <typename type_t>
+__host__ __device__ __forceinline__ type_t aggregated_add(type_t* address,
+                                                          type_t value) {
+#if defined(__CUDA_ARCH__) && (__CUDA_ARCH__ >= 700)
+  unsigned int active = __activemask();
+  unsigned int peers =
+      __match_any_sync(active, reinterpret_cast<unsigned long long>(address));
+  int lane = threadIdx.x & 31;
+  int leader = __ffs(peers) - 1;
+  int rank = __popc(peers & ((1u << lane) - 1));
+
+  type_t old = type_t(0);
+  if (lane == leader)
+    old = cuda::atomicAdd(address, value * type_t(__popc(peers)));
+  old = __shfl_sync(peers, old, leader);
+  return old + value * type_t(rank);
+#else
+  return add(address, value);
+#endif
+}
+
 }  // namespace atomic
 }  // namespace math
 }  // namespace gunrock
\ No newline at end of file
@@ -17,10 +17,10 @@ namespace util {
 struct timer_t {
   float time;
 
-  timer_t() {
+  timer_t(cudaStream_t stream = 0) : stream_(stream) {
     cudaEventCreate(&start_);
     cudaEventCreate(&stop_);
-    cudaEventRecord(start_);
+    cudaEventRecord(start_, stream_);
   }
 
   ~timer_t() {
@@ -28,12 +28,15 @@ struct timer_t {
     cudaEventDestroy(stop_);
   }
 
+  // Record the events on `stream` (e.g. a context's stream) from now on.
+  void set_stream(cudaStream_t stream) { stream_ = stream; }
+
   // Alias of each other, start the timer.
-  void begin() { cudaEventRecord(start_); }
+  void begin() { cudaEventRecord(start_, stream_); }
   void start() { this->begin(); }
 
   float end() {
-    cudaEventRecord(stop_);
+    cudaEventRecord(stop_, stream_);
     cudaEventSynchronize(stop_);
     cudaEventElapsedTime(&time, start_, stop_);
 
@@ -45,6 +48,7 @@ struct timer_t {
 
  private:
   cudaEvent_t start_, stop_;
+  cudaStream_t stream_;
 };
 
 }  // namespace util
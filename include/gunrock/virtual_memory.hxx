@@ -12,6 +12,9 @@
 
 #include <iostream>
 #include <memory>
+#include <vector>
+
+#include <cuda.h>
 
 #include <gunrock/error.hxx>
 
@@ -49,7 +52,15 @@ struct physical_memory_t {
 
   std::vector<int> resident_devices;
 
-  physical_memory_t(std::size_t _size, const std::vector<int> _resident_devices)
+  /**
+   * @param _size size (bytes).
+   * @param _resident_devices devices backing the stripes, in order.
+   * @param _stripe_size size (bytes) of a stripe, `0` (default) splits the
+   * (padded) size evenly; rounded up to the granularity.
+   */
+  physical_memory_t(std::size_t _size,
+                    const std::vector<int> _resident_devices,
+                    std::size_t _stripe_size = 0)
       : size(_size),
         resident_devices(_resident_devices),
         flags(0),
@@ -59,23 +70,22 @@ struct physical_memory_t {
     prop.type = CU_MEM_ALLOCATION_TYPE_PINNED;
     prop.location.type = CU_MEM_LOCATION_TYPE_DEVICE;
 
-    // Find the minimum granularity needed for the resident devices.
-    for (std::size_t idx = 0; idx < resident_devices.size(); idx++) {
-      std::size_t _granularity = 0;
-      // get the minnimum granularity for residentDevices[idx]
-      prop.location.id = resident_devices[idx];
-      cuMemGetAllocationGranularity(&_granularity, &prop,
-                                    CU_MEM_ALLOC_GRANULARITY_MINIMUM);
-      if (granularity < _granularity)
-        granularity = _granularity;
-    }
+    granularity = get_granularity(resident_devices);
 
     // Round up the size such that it can evenly split into a stripe size that
     // meets the granularity requirement. padded_size = N * GPUs * granularity,
     // since each of the piece of the allocation will be N * granularity and the
     // granularity applies to each stripe_size piece of the allocation.
-    padded_size = round_up(size, resident_devices.size() * granularity);
-    stripe_size = padded_size / resident_devices.size();
+    if (_stripe_size) {
+      stripe_size = round_up(_stripe_size, granularity);
+      padded_size = stripe_size * resident_devices.size();
+      if (padded_size < size)
+        error::throw_if_exception(cudaErrorInvalidValue,
+                                  "Stripes too small for the allocation.");
+    } else {
+      padded_size = round_up(size, resident_devices.size() * granularity);
+      stripe_size = padded_size / resident_devices.size();
+    }
 
     // Create the backings on each GPU.
     alloc_handle.resize(resident_devices.size());
@@ -93,6 +103,27 @@ struct physical_memory_t {
   static std::size_t round_up(std::size_t x, std::size_t y) {
     return ((x + y - 1) / y) * y;
   }
+
+  /**
+   * @brief Minimum granularity (bytes) of a pinned allocation on all of
+   * `devices`.
+   */
+  static std::size_t get_granularity(const std::vector<int>& devices) {
+    allocation_properties_t properties = {};
+    properties.type = CU_MEM_ALLOCATION_TYPE_PINNED;
+    properties.location.type = CU_MEM_LOCATION_TYPE_DEVICE;
+
+    std::size_t largest = 1;
+    for (auto device : devices) {
+      std::size_t _granularity = 0;
+      properties.location.id = device;
+      cuMemGetAllocationGranularity(&_granularity, &properties,
+                                    CU_MEM_ALLOC_GRANULARITY_MINIMUM);
+      if (largest < _granularity)
+        largest = _granularity;
+    }
+    return largest;
+  }
 };
 
 /**
@@ -161,17 +192,21 @@ class striped_memory_mapper_t {
       : virt(virt_arg), phys(phys_arg) {
     const size_t stripe_size = phys.stripe_size;
 
-    for (auto& device : phys.resident_devices)
-      cuMemMap((CUdeviceptr)virt.ptr + (stripe_size * device), stripe_size, 0,
-               phys.alloc_handle[device], 0);
+    // Stripe `idx` of the range is backed by the `idx`-th resident device.
+    for (std::size_t idx = 0; idx < phys.resident_devices.size(); idx++)
+      cuMemMap((CUdeviceptr)virt.ptr + (stripe_size * idx), stripe_size, 0,
+               phys.alloc_handle[idx], 0);
 
     std::vector<CUmemAccessDesc> access_descriptors(mapping_devices.size());
 
-    for (auto& local : phys.resident_devices) {
-      for (auto& remote : mapping_devices) {
+    for (std::size_t stripe = 0; stripe < phys.resident_devices.size();
+         stripe++) {
+      auto local = phys.resident_devices[stripe];
+      for (std::size_t idx = 0; idx < mapping_devices.size(); idx++) {
+        auto remote = mapping_devices[idx];
         access_flags_t access;
-        access_descriptors[remote].location.type = CU_MEM_LOCATION_TYPE_DEVICE;
-        access_descriptors[remote].location.id = remote;
+        access_descriptors[idx].location.type = CU_MEM_LOCATION_TYPE_DEVICE;
+        access_descriptors[idx].location.id = remote;
 
         // If the device being mapped to is where the physical memory resides
         // use the resident_access access flag, otherwise, use remote_access.
@@ -191,8 +226,9 @@ class striped_memory_mapper_t {
           access_descriptors[idx].flags = CU_MEM_ACCESS_FLAGS_PROT_MAX;
       }
 
-      cuMemSetAccess((CUdeviceptr)virt.ptr + (stripe_size * local), stripe_size,
-                     access_descriptors.data(), access_descriptors.size());
+      cuMemSetAccess((CUdeviceptr)virt.ptr + (stripe_size * stripe),
+                     stripe_size, access_descriptors.data(),
+                     access_descriptors.size());
     }
   }
 
@@ -211,5 +247,60 @@ class striped_memory_mapper_t {
   }
 };
 
+/**
+ * @brief Array striped over the physical memory of multiple GPUs, behind one
+ * contiguous virtual address range accessible (read-write) from all of them.
+ * Used for vertex arrays shared by the partitions of a multi-GPU execution:
+ * with the partitions aligned to the stripes (see
+ * `graph::partition_t::vertices_per_partition` and
+ * `striped_vertices_per_partition()`), the data of the vertices a GPU owns is
+ * local to that GPU, and the rest is reached over peer-to-peer accesses.
+ *
+ * @tparam type_t element type.
+ */
+template <typename type_t>
+class striped_array_t {
+  physical_memory_t<type_t> phys;
+  virtual_memory_t<type_t> virt;
+  striped_memory_mapper_t<type_t> mapper;
+
+ public:
+  /**
+   * @param number_of_elements number of elements.
+   * @param devices devices backing the stripes, in order.
+   * @param elements_per_stripe elements per stripe (device), `0` (default)
+   * splits the elements evenly (up to the granularity).
+   */
+  striped_array_t(std::size_t number_of_elements,
+                  const std::vector<int>& devices,
+                  std::size_t elements_per_stripe = 0)
+      : phys(number_of_elements * sizeof(type_t),
+             devices,
+             elements_per_stripe * sizeof(type_t)),
+        virt(phys.padded_size),
+        mapper(virt, phys, devices) {}
+
+  type_t* data() { return mapper.data(); }
+  std::size_t size() { return mapper.number_of_elements(); }
+  std::size_t elements_per_partition() {
+    return mapper.elements_per_partition();
+  }
+};
+
+/**
+ * @brief Vertices per stripe (and partition) common to the striped arrays of
+ * any element type over `devices`: the even split of `number_of_vertices`,
+ * rounded up to the allocation granularity (in elements, such that a stripe
+ * of any element size is a whole number of granules).
+ */
+inline std::size_t striped_vertices_per_partition(
+    std::size_t number_of_vertices,
+    const std::vector<int>& devices) {
+  std::size_t k = devices.size();
+  std::size_t granularity = physical_memory_t<char>::get_granularity(devices);
+  return physical_memory_t<char>::round_up((number_of_vertices + k - 1) / k,
+                                           granularity);
+}
+
 }  // namespace memory
 }  // namespace gunrock
\ No newline at end of file
@@ -0,0 +1,246 @@
+#include <gunrock/algorithms/bfs.hxx>
+#include <gunrock/algorithms/pr.hxx>
+#include <gunrock/algorithms/kcore.hxx>
+
+#include <set>
+#include <cmath>
+#include <random>
+#include <utility>
+
+using namespace gunrock;
+using namespace memory;
+
+using vertex_t = int;
+using edge_t = int;
+using weight_t = float;
+
+using csr_t = format::csr_t<memory_space_t::device, vertex_t, edge_t, weight_t>;
+using dynamic_csr_t =
+    format::dynamic_csr_t<memory_space_t::device, vertex_t, edge_t, weight_t>;
+using batch_t = format::edge_batch_t<vertex_t, weight_t>;
+using edges_t = std::set<std::pair<vertex_t, vertex_t>>;  // u < v.
+
+/**
+ * @brief Undirected edges as a batch, every edge once (`both == false`, as
+ * kcore expects) or in both directions (bfs and pr over a symmetric graph).
+ */
+struct edge_list_t {
+  thrust::device_vector<vertex_t> sources;
+  thrust::device_vector<vertex_t> destinations;
+
+  edge_list_t(edges_t const& edges, bool both) {
+    thrust::host_vector<vertex_t> s, d;
+    for (auto& e : edges) {
+      s.push_back(e.first);
+      d.push_back(e.second);
+      if (both) {
+        s.push_back(e.second);
+        d.push_back(e.first);
+      }
+    }
+    sources = s;
+    destinations = d;
+  }
+
+  batch_t batch() {
+    batch_t b;
+    b.sources = sources.data().get();
+    b.destinations = destinations.data().get();
+    b.size = sources.size();
+    return b;
+  }
+};
+
+/**
+ * @brief One batch of edge deletions and insertions.
+ */
+struct update_t {
+  std::string name;
+  edges_t inserts;
+  edges_t deletes;
+};
+
+/**
+ * @brief A few batches over the (symmetric) graph `edges`, kept up-to-date:
+ * random insertions, deletions of existing edges, a hub (vertex 0) gaining
+ * more neighbors than the gap of its row (the dynamic CSR overflows and is
+ * laid out again), and a mix.
+ */
+std::vector<update_t> make_updates(edges_t& edges, vertex_t n) {
+  std::mt19937 generator(7);
+  std::uniform_int_distribution<vertex_t> vertex(0, n - 1);
+  auto random_new_edges = [&](std::size_t count) {
+    edges_t added;
+    for (std::size_t tries = 0; added.size() < count && tries < 100 * count;
+         ++tries) {
+      vertex_t u = vertex(generator), v = vertex(generator);
+      auto e = std::make_pair(std::min(u, v), std::max(u, v));
+      if (u != v && !edges.count(e))
+        added.insert(e);
+    }
+    return added;
+  };
+  auto some_edges = [&](std::size_t stride) {
+    edges_t picked;
+    std::size_t i = 0;
+    for (auto& e : edges)
+      if (i++ % stride == 0)
+        picked.insert(e);
+    return picked;
+  };
+  auto apply = [&](update_t const& u) {
+    for (auto& e : u.deletes)
+      edges.erase(e);
+    for (auto& e : u.inserts)
+      edges.insert(e);
+  };
+
+  std::vector<update_t> updates;
+
+  updates.push_back({"insert", random_new_edges(n / 4 + 1), {}});
+  apply(updates.back());
+
+  updates.push_back({"delete", {}, some_edges(7)});
+  apply(updates.back());
+
+  update_t hub{"hub (overflow)", {}, {}};
+  for (vertex_t v = 1; v < n && hub.inserts.size() < 64; ++v)
+    if (!edges.count({0, v}))
+      hub.inserts.insert({0, v});
+  updates.push_back(hub);
+  apply(updates.back());
+
+  edges_t deleted = some_edges(11);
+  updates.push_back({"mixed", random_new_edges(n / 8 + 1), deleted});
+  apply(updates.back());
+
+  return updates;
+}
+
+template <typename type_t>
+thrust::host_vector<type_t> to_host(thrust::device_vector<type_t> const& v) {
+  return v;
+}
+
+/**
+ * @brief `incremental_t::update()` of bfs, pr and kcore against their full
+ * `run()` after every batch.
+ */
+void test_dynamic(int num_arguments, char** argument_array) {
+  if (num_arguments != 2) {
+    std::cerr << "usage: ./bin/<program-name> filename.mtx (symmetric)"
+              << std::endl;
+    exit(1);
+  }
+
+  // --
+  // IO
+
+  std::string filename = argument_array[1];
+  io::matrix_market_t<vertex_t, edge_t, weight_t> mm;
+  csr_t csr;
+  mm.load_csr(filename, csr);
+  vertex_t n = csr.number_of_rows;
+
+  edges_t edges;
+  {
+    thrust::host_vector<edge_t> offsets = csr.row_offsets;
+    thrust::host_vector<vertex_t> columns = csr.column_indices;
+    for (vertex_t u = 0; u < n; ++u)
+      for (edge_t e = offsets[u]; e < offsets[u + 1]; ++e)
+        if (u < columns[e])
+          edges.insert({u, columns[e]});
+  }
+
+  // Unit weights, such that inserted edges (weight 1) match the others.
+  thrust::fill(csr.nonzero_values.begin(), csr.nonzero_values.end(),
+               weight_t(1));
+
+  // One dynamic graph per algorithm, updated by its incremental_t.
+  dynamic_csr_t D_bfs, D_pr, D_kcore;
+  D_bfs.from_csr(csr);
+  D_pr.from_csr(csr);
+  D_kcore.from_csr(csr);
+
+  // --
+  // Incremental and reference (full run) instances
+
+  vertex_t source = 0;
+  weight_t alpha = 0.85;
+  weight_t tol = 1e-9;
+
+  thrust::device_vector<vertex_t> distances(n), ref_distances(n);
+  thrust::device_vector<weight_t> ranks(n), ref_ranks(n);
+  thrust::device_vector<int> cores(n), ref_cores(n);
+
+  bfs::incremental_t<vertex_t, edge_t, weight_t> dynamic_bfs(
+      D_bfs, source, distances.data().get());
+  bfs::incremental_t<vertex_t, edge_t, weight_t> ref_bfs(
+      D_bfs, source, ref_distances.data().get());
+  pr::incremental_t<vertex_t, edge_t, weight_t> dynamic_pr(
+      D_pr, alpha, tol, ranks.data().get());
+  pr::incremental_t<vertex_t, edge_t, weight_t> ref_pr(
+      D_pr, alpha, tol, ref_ranks.data().get());
+  kcore::incremental_t<vertex_t, edge_t, weight_t> dynamic_kcore(
+      D_kcore, cores.data().get());
+  kcore::incremental_t<vertex_t, edge_t, weight_t> ref_kcore(
+      D_kcore, ref_cores.data().get());
+
+  dynamic_bfs.run();
+  dynamic_pr.run();
+  dynamic_kcore.run();
+
+  bool ok = true;
+  for (auto& u : make_updates(edges, n)) {
+    edge_list_t inserts_once(u.inserts, false), deletes_once(u.deletes, false);
+    edge_list_t inserts(u.inserts, true), deletes(u.deletes, true);
+
+    std::size_t slots = D_bfs.get_number_of_slots();
+    dynamic_bfs.update(inserts.batch(), deletes.batch());
+    dynamic_pr.update(inserts.batch(), deletes.batch());
+    dynamic_kcore.update(inserts_once.batch(), deletes_once.batch());
+    bool relaid = (D_bfs.get_number_of_slots() != slots);
+
+    ref_bfs.run();
+    ref_pr.run();
+    ref_kcore.run();
+
+    auto h_distances = to_host(distances);
+    auto h_ref_distances = to_host(ref_distances);
+    auto h_ranks = to_host(ranks);
+    auto h_ref_ranks = to_host(ref_ranks);
+    auto h_cores = to_host(cores);
+    auto h_ref_cores = to_host(ref_cores);
+
+    int bfs_errors = 0, kcore_errors = 0;
+    float pr_difference = 0;
+    for (vertex_t v = 0; v < n; ++v) {
+      bfs_errors += (h_distances[v] != h_ref_distances[v]);
+      kcore_errors += (h_cores[v] != h_ref_cores[v]);
+      pr_difference =
+          std::max(pr_difference, std::abs(h_ranks[v] - h_ref_ranks[v]));
+    }
+    pr_difference *= n;  // relative to the average rank.
+
+    std::cout << u.name << ": +" << u.inserts.size() << " -"
+              << u.deletes.size() << " edges"
+              << (relaid ? " (relaid out)" : "") << std::endl;
+    std::cout << "  BFS Errors                          : " << bfs_errors
+              << std::endl;
+    std::cout << "  k-core Errors                       : " << kcore_errors
+              << std::endl;
+    std::cout << "  PageRank max |difference| / (1 / n) : " << pr_difference
+              << std::endl;
+
+    ok = ok && !bfs_errors && !kcore_errors && pr_difference < 1e-2;
+    if (u.name == "hub (overflow)")
+      ok = ok && relaid;
+  }
+
+  if (!ok)
+    exit(EXIT_FAILURE);
+}
+
+int main(int argc, char** argv) {
+  test_dynamic(argc, argv);
+}
@@ -0,0 +1,118 @@
+#include <gunrock/error.hxx>
+#include <gunrock/cuda/context.hxx>
+#include <gunrock/framework/frontier/frontier.hxx>
+#include <gunrock/framework/operators/advance/advance.hxx>
+#include <gunrock/framework/operators/filter/filter.hxx>
+#include <gunrock/graph/build.hxx>
+
+#include <vector>
+
+using namespace gunrock;
+using namespace memory;
+
+int failures = 0;
+
+void check(bool condition, std::string const& what) {
+  std::cout << (condition ? "PASS: " : "FAIL: ") << what << std::endl;
+  if (!condition)
+    ++failures;
+}
+
+template <typename frontier_type>
+std::vector<int> elements_of(frontier_type& f) {
+  thrust::host_vector<int> h(f.begin(), f.end());
+  return std::vector<int>(h.begin(), h.end());
+}
+
+template <typename frontier_type>
+std::vector<int> bits_of(frontier_type& f, cuda::standard_context_t& context) {
+  frontier_t<int> sparse;
+  frontier::to_sparse(&f, &sparse, context);
+  context.synchronize();
+  return elements_of(sparse);
+}
+
+void test_frontier() {
+  using vertex_t = int;
+  constexpr std::size_t n = 100;
+
+  cuda::device_id_t device = 0;
+  cuda::standard_context_t context(device);
+
+  // Sparse frontier with duplicates and an invalid entry.
+  frontier_t<vertex_t> sparse;
+  sparse.push_back(7);
+  sparse.push_back(3);
+  sparse.push_back(7);
+  sparse.push_back(gunrock::numeric_limits<vertex_t>::invalid());
+  sparse.push_back(64);
+  check(sparse.get_number_of_elements() == 5, "sparse push_back");
+
+  // Sparse -> dense.
+  frontier_t<vertex_t, frontier_storage_t::bitmap> bitmap(n);
+  frontier::to_dense(&sparse, &bitmap, n, context);
+  frontier_t<vertex_t, frontier_storage_t::boolmap> boolmap(n);
+  frontier::to_dense(&sparse, &boolmap, n, context);
+  context.synchronize();
+
+  check(bitmap.get_number_of_elements() == 3, "bitmap elements");
+  check(boolmap.get_number_of_elements() == 3, "boolmap elements");
+  check(frontier::get_density(&bitmap, n) == 3.0f / n, "bitmap density");
+
+  // Dense -> sparse, sorted and without duplicates.
+  std::vector<int> expected = {3, 7, 64};
+  check(bits_of(bitmap, context) == expected, "bitmap to sparse");
+  check(bits_of(boolmap, context) == expected, "boolmap to sparse");
+
+  // Dense sequence, the cached count follows the modifications.
+  bitmap.clear();
+  check(bitmap.get_number_of_elements() == 0, "bitmap clear");
+  bitmap.sequence(10, 5);
+  check(bitmap.get_number_of_elements() == 5, "bitmap sequence");
+  check(bits_of(bitmap, context) == std::vector<int>({10, 11, 12, 13, 14}),
+        "bitmap sequence elements");
+
+  // Dense advance and filter over 0 -> {1, 2}, {1, 2} -> 3.
+  thrust::device_vector<int> offsets = std::vector<int>({0, 2, 3, 4, 4});
+  thrust::device_vector<int> indices = std::vector<int>({1, 2, 3, 3});
+  thrust::device_vector<float> values(4, 1.0f);
+  auto G = graph::build::from_csr<memory_space_t::device, graph::view_t::csr>(
+      4, 4, 4, offsets.data().get(), indices.data().get(),
+      values.data().get());
+
+  auto all = [] __device__(int const& source, int const& neighbor,
+                           int const& edge, float const& weight) -> bool {
+    return true;
+  };
+  vector_t<int, memory_space_t::device> segments(4);
+  frontier_t<vertex_t, frontier_storage_t::bitmap> input(4), output(4);
+  input.push_back(0);
+  operators::advance::execute<operators::load_balance_t::thread_mapped,
+                              operators::advance_direction_t::forward,
+                              operators::advance_io_type_t::vertices,
+                              operators::advance_io_type_t::vertices>(
+      G, all, &input, &output, segments, context);
+  check(bits_of(output, context) == std::vector<int>({1, 2}),
+        "dense advance");
+
+  operators::advance::execute<operators::load_balance_t::thread_mapped,
+                              operators::advance_direction_t::forward,
+                              operators::advance_io_type_t::vertices,
+                              operators::advance_io_type_t::vertices>(
+      G, all, &output, &input, segments, context);
+  check(bits_of(input, context) == std::vector<int>({3}),
+        "dense advance, duplicate-free");
+
+  auto odd = [] __device__(int const& v) -> bool { return v % 2; };
+  frontier_t<vertex_t, frontier_storage_t::boolmap> flags(4), kept(4);
+  flags.sequence(0, 4);
+  operators::filter::execute<operators::filter_algorithm_t::compact>(
+      G, odd, &flags, &kept, context);
+  check(bits_of(kept, context) == std::vector<int>({1, 3}), "dense filter");
+}
+
+int main(int argc, char** argv) {
+  test_frontier();
+  if (failures)
+    exit(EXIT_FAILURE);
+}
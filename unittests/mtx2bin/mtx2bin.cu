@@ -5,11 +5,43 @@
 using namespace gunrock;
 using namespace memory;
 
-void test_mtx2bin(int num_arguments, char** argument_array) {
-  if (num_arguments != 2) {
-    std::cerr << "usage: ./bin/mtx2bin <inpath>" << std::endl;
+void usage() {
+  std::cerr << "usage: ./bin/mtx2bin <inpath> [csr|csc|both] [outpath]"
+            << std::endl
+            << "  Converts a Matrix Market file into the binary CSR (.csr) "
+               "and/or CSC (.csc) graph format, and verifies the output by "
+               "loading it back."
+            << std::endl;
+  exit(1);
+}
+
+template <typename format_t>
+void print(std::string name, format_t const& format, std::string path) {
+  std::cout << name << ".number_of_rows     = " << format.number_of_rows
+            << std::endl;
+  std::cout << name << ".number_of_columns  = " << format.number_of_columns
+            << std::endl;
+  std::cout << name << ".number_of_nonzeros = " << format.number_of_nonzeros
+            << std::endl;
+  std::cout << "writing to             = " << path << std::endl;
+}
+
+template <typename format_t>
+void verify(format_t const& written, std::string path) {
+  format_t loaded;
+  loaded.read_binary(path);
+  if (loaded.number_of_rows != written.number_of_rows ||
+      loaded.number_of_columns != written.number_of_columns ||
+      loaded.number_of_nonzeros != written.number_of_nonzeros) {
+    std::cerr << "verification of " << path << " failed." << std::endl;
     exit(1);
   }
+  std::cout << "verified               = " << path << std::endl;
+}
+
+void test_mtx2bin(int num_arguments, char** argument_array) {
+  if (num_arguments < 2 || num_arguments > 4)
+    usage();
 
   // --
   // Define types
@@ -22,26 +54,57 @@ void test_mtx2bin(int num_arguments, char** argument_array) {
   // IO
 
   std::string inpath = argument_array[1];
-  std::string outpath = inpath + ".csr";
+  std::string layout = (num_arguments > 2) ? argument_array[2] : "csr";
+  std::string outpath = (num_arguments > 3) ? argument_array[3] : inpath;
+
+  bool to_csr = (layout == "csr" || layout == "both");
+  bool to_csc = (layout == "csc" || layout == "both");
+  if (!to_csr && !to_csc)
+    usage();
 
   io::matrix_market_t<vertex_t, edge_t, weight_t> mm;
+  auto coo = mm.load(inpath);
 
-  using csr_t =
-      format::csr_t<memory::memory_space_t::device, vertex_t, edge_t, weight_t>;
-  csr_t csr;
-  csr.from_coo(mm.load(inpath));
+  if (to_csr) {
+    using csr_t =
+        format::csr_t<memory_space_t::host, vertex_t, edge_t, weight_t>;
+    csr_t csr;
+    csr.from_coo(coo);
 
-  std::cout << "csr.number_of_rows     = " << csr.number_of_rows << std::endl;
-  std::cout << "csr.number_of_columns  = " << csr.number_of_columns
-            << std::endl;
-  std::cout << "csr.number_of_nonzeros = " << csr.number_of_nonzeros
-            << std::endl;
-  std::cout << "writing to             = " << outpath << std::endl;
+    std::string path = outpath + ".csr";
+    print("csr", csr, path);
+    csr.write_binary(path);
+    verify(csr, path);
+  }
 
-  csr.write_binary(outpath);
+  if (to_csc) {
+    // CSC of A is the CSR of A's transpose.
+    format::coo_t<memory_space_t::host, vertex_t, edge_t, weight_t> transpose =
+        coo;
+    std::swap(transpose.number_of_rows, transpose.number_of_columns);
+    transpose.row_indices.swap(transpose.column_indices);
+
+    format::csr_t<memory_space_t::host, vertex_t, edge_t, weight_t> csr;
+    csr.from_coo(transpose);
+
+    using csc_t =
+        format::csc_t<memory_space_t::host, vertex_t, edge_t, weight_t>;
+    csc_t csc;
+    csc.number_of_rows = coo.number_of_rows;
+    csc.number_of_columns = coo.number_of_columns;
+    csc.number_of_nonzeros = coo.number_of_nonzeros;
+    csc.column_offsets.swap(csr.row_offsets);
+    csc.row_indices.swap(csr.column_indices);
+    csc.nonzero_values.swap(csr.nonzero_values);
+
+    std::string path = outpath + ".csc";
+    print("csc", csc, path);
+    csc.write_binary(path);
+    verify(csc, path);
+  }
 }
 
 int main(int argc, char** argv) {
   test_mtx2bin(argc, argv);
   return EXIT_SUCCESS;
-}
\ No newline at end of file
+}
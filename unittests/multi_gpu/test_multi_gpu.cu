@@ -0,0 +1,140 @@
+#include <gunrock/algorithms/bfs.hxx>
+#include <gunrock/algorithms/sssp.hxx>
+#include <gunrock/algorithms/pr.hxx>
+
+#include <cmath>
+
+using namespace gunrock;
+using namespace memory;
+
+/**
+ * @brief bfs, sssp and (push) pr on all the visible GPUs, with the vertex
+ * arrays striped over them (`vertex_array_t`), against the same algorithms
+ * on the first GPU.
+ */
+void test_multi_gpu(int num_arguments, char** argument_array) {
+  if (num_arguments != 2) {
+    std::cerr << "usage: ./bin/<program-name> filename.mtx" << std::endl;
+    exit(1);
+  }
+
+  int number_of_devices = 0;
+  error::throw_if_exception(cudaGetDeviceCount(&number_of_devices));
+  if (number_of_devices < 2) {
+    std::cout << "Skipped: " << number_of_devices << " GPU(s) visible, "
+              << "at least 2 are needed." << std::endl;
+    return;
+  }
+
+  // --
+  // Define types
+
+  using vertex_t = int;
+  using edge_t = int;
+  using weight_t = float;
+
+  // --
+  // IO
+
+  std::string filename = argument_array[1];
+
+  io::matrix_market_t<vertex_t, edge_t, weight_t> mm;
+
+  using csr_t =
+      format::csr_t<memory_space_t::device, vertex_t, edge_t, weight_t>;
+  csr_t csr;
+  mm.load_csr(filename, csr);
+
+  // --
+  // Build graph (CSR only: fused advance-filter in bfs, push pr)
+
+  auto G = graph::build::from_csr<memory_space_t::device, graph::view_t::csr>(
+      csr.number_of_rows,               // rows
+      csr.number_of_columns,            // columns
+      csr.number_of_nonzeros,           // nonzeros
+      csr.row_offsets.data().get(),     // row_offsets
+      csr.column_indices.data().get(),  // column_indices
+      csr.nonzero_values.data().get()   // values
+  );
+
+  vertex_t n_vertices = G.get_number_of_vertices();
+  vertex_t single_source = 0;
+
+  thrust::host_vector<cuda::device_id_t> devices;
+  for (int d = 0; d < number_of_devices; ++d)
+    devices.push_back(d);
+  auto single = std::make_shared<cuda::multi_context_t>(0);
+  auto multi = std::make_shared<cuda::multi_context_t>(devices);
+
+  std::cout << "GPUs                    : " << number_of_devices << std::endl;
+  std::cout << "Vertices per partition  : "
+            << vertex_array_t<vertex_t>::get_vertices_per_partition(
+                   n_vertices, *multi)
+            << std::endl;
+
+  // --
+  // BFS
+
+  thrust::device_vector<vertex_t> bfs_single(n_vertices);
+  thrust::device_vector<vertex_t> bfs_multi(n_vertices);
+  thrust::device_vector<vertex_t> predecessors(n_vertices);
+  bfs::run(G, single_source, bfs_single.data().get(),
+           predecessors.data().get(), single);
+  bfs::run(G, single_source, bfs_multi.data().get(),
+           predecessors.data().get(), multi);
+
+  thrust::host_vector<vertex_t> h_bfs_single = bfs_single;
+  thrust::host_vector<vertex_t> h_bfs_multi = bfs_multi;
+  int bfs_errors = 0;
+  for (vertex_t v = 0; v < n_vertices; ++v)
+    if (h_bfs_single[v] != h_bfs_multi[v])
+      ++bfs_errors;
+
+  // --
+  // SSSP
+
+  thrust::device_vector<weight_t> sssp_single(n_vertices);
+  thrust::device_vector<weight_t> sssp_multi(n_vertices);
+  sssp::run(G, single_source, sssp_single.data().get(),
+            predecessors.data().get(), nullptr, weight_t(0), single);
+  sssp::run(G, single_source, sssp_multi.data().get(),
+            predecessors.data().get(), nullptr, weight_t(0), multi);
+
+  thrust::host_vector<weight_t> h_sssp_single = sssp_single;
+  thrust::host_vector<weight_t> h_sssp_multi = sssp_multi;
+  int sssp_errors = 0;
+  for (vertex_t v = 0; v < n_vertices; ++v)
+    if (std::abs(h_sssp_single[v] - h_sssp_multi[v]) > 1e-4)
+      ++sssp_errors;
+
+  // --
+  // PageRank (push, atomics may reorder the sums)
+
+  weight_t alpha = 0.85;
+  weight_t tol = 1e-6;
+  thrust::device_vector<weight_t> pr_single(n_vertices);
+  thrust::device_vector<weight_t> pr_multi(n_vertices);
+  pr::run(G, alpha, tol, pr_single.data().get(), single);
+  pr::run(G, alpha, tol, pr_multi.data().get(), multi);
+
+  thrust::host_vector<weight_t> h_pr_single = pr_single;
+  thrust::host_vector<weight_t> h_pr_multi = pr_multi;
+  int pr_errors = 0;
+  for (vertex_t v = 0; v < n_vertices; ++v)
+    if (std::abs(h_pr_single[v] - h_pr_multi[v]) > 1e-4)
+      ++pr_errors;
+
+  // --
+  // Log
+
+  std::cout << "BFS Errors  : " << bfs_errors << std::endl;
+  std::cout << "SSSP Errors : " << sssp_errors << std::endl;
+  std::cout << "PR Errors   : " << pr_errors << std::endl;
+
+  if (bfs_errors || sssp_errors || pr_errors)
+    exit(1);
+}
+
+int main(int argc, char** argv) {
+  test_multi_gpu(argc, argv);
+}
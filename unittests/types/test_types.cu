@@ -0,0 +1,159 @@
+#include <gunrock/algorithms/bfs.hxx>
+#include <gunrock/algorithms/pr.hxx>
+
+#include <cuda_fp16.h>
+#include <cuda_bf16.h>
+
+#include <cmath>
+
+using namespace gunrock;
+using namespace memory;
+
+/**
+ * @brief Loads `filename` as a CSR + CSC graph with `vertex_t` and `edge_t`,
+ * and writes its BFS distances (from 0) and PageRank, with the ranks stored
+ * as `rank_t`, to the host.
+ */
+template <typename vertex_t, typename edge_t, typename rank_t = float>
+void run(std::string filename,
+         thrust::host_vector<vertex_t>& distances,
+         thrust::host_vector<float>& ranks) {
+  using weight_t = float;
+
+  format::csr_t<memory_space_t::device, vertex_t, edge_t, weight_t> csr;
+  io::matrix_market_t<vertex_t, edge_t, weight_t> mm;
+  mm.load_csr(filename, csr);
+
+  thrust::device_vector<vertex_t> row_indices(csr.number_of_nonzeros);
+  thrust::device_vector<edge_t> column_offsets(csr.number_of_columns + 1);
+  thrust::device_vector<weight_t> column_values(csr.number_of_nonzeros);
+
+  auto G =
+      graph::build::from_csr<memory_space_t::device,
+                             graph::view_t::csr | graph::view_t::csc>(
+          csr.number_of_rows, csr.number_of_columns, csr.number_of_nonzeros,
+          csr.row_offsets.data().get(), csr.column_indices.data().get(),
+          csr.nonzero_values.data().get(), row_indices.data().get(),
+          column_offsets.data().get(), column_values.data().get());
+
+  vertex_t n = G.get_number_of_vertices();
+  vertex_t source = 0;
+  thrust::device_vector<vertex_t> d(n);
+  thrust::device_vector<vertex_t> predecessors(n);
+  bfs::run(G, source, d.data().get(), predecessors.data().get());
+  distances = d;
+
+  thrust::device_vector<weight_t> p(n);
+  pr::run<rank_t>(G, weight_t(0.85), weight_t(1e-6), p.data().get());
+  ranks = p;
+}
+
+/**
+ * @brief Every thread adds 1 to `sum` and min/max-es its id into `lo`/`hi`.
+ */
+template <typename type_t>
+__global__ void atomics(type_t* sum, type_t* lo, type_t* hi, type_t* agg) {
+  int i = blockIdx.x * blockDim.x + threadIdx.x;
+  math::atomic::add(sum, type_t(1.0f));
+  math::atomic::min(lo, type_t(float(i % 100)));
+  math::atomic::max(hi, type_t(float(i % 100)));
+  math::atomic::aggregated_add(agg + (i % 2), type_t(1.0f));
+}
+
+template <typename type_t>
+bool test_atomics(char const* name, float expected_sum) {
+  thrust::device_vector<type_t> v(5);
+  v[0] = type_t(0.0f);
+  v[1] = type_t(100.0f);
+  v[2] = type_t(0.0f);
+  v[3] = type_t(0.0f);
+  v[4] = type_t(0.0f);
+  auto data = v.data().get();
+  atomics<<<2, 128>>>(data, data + 1, data + 2, data + 3);
+  error::throw_if_exception(cudaDeviceSynchronize());
+
+  thrust::host_vector<type_t> h = v;
+  bool ok = float(h[0]) == expected_sum && float(h[1]) == 0.0f &&
+            float(h[2]) == 99.0f &&
+            float(h[3]) + float(h[4]) == expected_sum;
+  std::cout << name << " atomics: " << (ok ? "ok" : "FAILED") << std::endl;
+  return ok;
+}
+
+/**
+ * @brief A hub rank far above the average of a large graph (where the
+ * scaled `__half` would exceed 65504) is stored without overflowing.
+ */
+bool test_rank_range() {
+  using ranks_type = pr::ranks_t<float, __half>;
+  auto R = ranks_type::for_vertices(1e7f);
+  bool ok = true;
+  for (float rank : {1.0f, 0.5f, 1e-2f}) {
+    float loaded = R.load(R.store(rank));
+    ok = ok && std::isfinite(loaded) && std::abs(loaded - rank) < 1e-3f * rank;
+  }
+  std::cout << "__half rank range: " << (ok ? "ok" : "FAILED") << std::endl;
+  return ok;
+}
+
+float max_difference(thrust::host_vector<float> const& a,
+                     thrust::host_vector<float> const& b) {
+  float difference = 0;
+  for (std::size_t i = 0; i < a.size(); ++i)
+    difference = std::max(difference, std::abs(a[i] - b[i]));
+  return difference;
+}
+
+void test_types(int num_arguments, char** argument_array) {
+  if (num_arguments != 2) {
+    std::cerr << "usage: ./bin/<program-name> filename.mtx" << std::endl;
+    exit(1);
+  }
+
+  std::string filename = argument_array[1];
+  bool ok = true;
+
+  // 32-bit vertices with 64-bit edges, same results as 32-bit edges.
+  thrust::host_vector<int> distances, wide_distances;
+  thrust::host_vector<float> ranks, wide_ranks;
+  run<int, int>(filename, distances, ranks);
+  run<int, long>(filename, wide_distances, wide_ranks);
+
+  bool same_bfs = (distances == wide_distances);
+  float pr_difference = max_difference(ranks, wide_ranks);
+  std::cout << "int/long BFS: " << (same_bfs ? "ok" : "FAILED") << std::endl;
+  std::cout << "int/long PageRank max |difference| = " << pr_difference
+            << std::endl;
+  ok = ok && same_bfs && pr_difference < 1e-6;
+
+  // Narrow ranks, within their precision (relative to the average rank).
+  float average = 1.0f / ranks.size();
+  thrust::host_vector<float> half_ranks, bf16_ranks;
+  run<int, int, __half>(filename, distances, half_ranks);
+  run<int, int, __nv_bfloat16>(filename, distances, bf16_ranks);
+
+  float half_difference = max_difference(ranks, half_ranks) / average;
+  float bf16_difference = max_difference(ranks, bf16_ranks) / average;
+  std::cout << "__half PageRank max |difference| / (1 / n) = "
+            << half_difference << std::endl;
+  std::cout << "__nv_bfloat16 PageRank max |difference| / (1 / n) = "
+            << bf16_difference << std::endl;
+  ok = ok && half_difference < 1e-2 && bf16_difference < 5e-2;
+  ok = test_rank_range() && ok;
+
+  // 256 threads, sums are exact in every type.
+  ok = test_atomics<int>("int", 256) && ok;
+  ok = test_atomics<long>("long", 256) && ok;
+  ok = test_atomics<unsigned long>("unsigned long", 256) && ok;
+  ok = test_atomics<float>("float", 256) && ok;
+  ok = test_atomics<double>("double", 256) && ok;
+  ok = test_atomics<__half>("__half", 256) && ok;
+  ok = test_atomics<__nv_bfloat16>("__nv_bfloat16", 256) && ok;
+
+  if (!ok)
+    exit(EXIT_FAILURE);
+}
+
+int main(int argc, char** argv) {
+  test_types(argc, argv);
+}